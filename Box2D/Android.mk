@@ -6,9 +6,12 @@ LOCAL_MODULE := libbox2d
 
 LOCAL_SRC_FILES := \
 Collision/Shapes/b2CircleShape.cpp \
+Collision/Shapes/b2ChainShape.cpp \
+Collision/Shapes/b2EdgeShape.cpp \
 Collision/Shapes/b2PolygonShape.cpp \
 Collision/b2BroadPhase.cpp \
 Collision/b2CollideCircle.cpp \
+Collision/b2CollideEdge.cpp \
 Collision/b2CollidePolygon.cpp \
 Collision/b2Collision.cpp \
 Collision/b2Distance.cpp \
@@ -19,6 +22,10 @@ Common/b2Math.cpp \
 Common/b2Settings.cpp \
 Common/b2StackAllocator.cpp \
 Dynamics/Contacts/b2CircleContact.cpp \
+Dynamics/Contacts/b2ChainAndCircleContact.cpp \
+Dynamics/Contacts/b2ChainAndPolygonContact.cpp \
+Dynamics/Contacts/b2EdgeAndCircleContact.cpp \
+Dynamics/Contacts/b2EdgeAndPolygonContact.cpp \
 Dynamics/Contacts/b2Contact.cpp \
 Dynamics/Contacts/b2ContactSolver.cpp \
 Dynamics/Contacts/b2PolygonAndCircleContact.cpp \
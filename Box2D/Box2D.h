@@ -34,6 +34,8 @@ For discussion please visit http://box2d.org/forum
 #include "Common/b2Settings.h"
 
 #include "Collision/Shapes/b2CircleShape.h"
+#include "Collision/Shapes/b2EdgeShape.h"
+#include "Collision/Shapes/b2ChainShape.h"
 #include "Collision/Shapes/b2PolygonShape.h"
 
 #include "Collision/b2BroadPhase.h"
@@ -27,6 +27,11 @@ b2Shape* b2PolygonShape::Clone(b2BlockAllocator* allocator) const
 	return clone;
 }
 
+int32 b2PolygonShape::GetChildCount() const
+{
+	return 1;
+}
+
 void b2PolygonShape::SetAsBox(float32 hx, float32 hy)
 {
 	m_vertexCount = 4;
@@ -198,8 +203,11 @@ bool b2PolygonShape::TestPoint(const b2Transform& xf, const b2Vec2& p) const
 	return true;
 }
 
-bool b2PolygonShape::RayCast(b2RayCastOutput* output, const b2RayCastInput& input, const b2Transform& xf) const
+bool b2PolygonShape::RayCast(b2RayCastOutput* output, const b2RayCastInput& input,
+							const b2Transform& xf, int32 childIndex) const
 {
+	B2_NOT_USED(childIndex);
+
 	// Put the ray into the polygon's frame of reference.
 	b2Vec2 p1 = b2MulT(xf.R, input.p1 - xf.position);
 	b2Vec2 p2 = b2MulT(xf.R, input.p2 - xf.position);
@@ -321,8 +329,10 @@ bool b2PolygonShape::RayCast(b2RayCastOutput* output, const b2RayCastInput& inpu
 	return false;
 }
 
-void b2PolygonShape::ComputeAABB(b2AABB* aabb, const b2Transform& xf) const
+void b2PolygonShape::ComputeAABB(b2AABB* aabb, const b2Transform& xf, int32 childIndex) const
 {
+	B2_NOT_USED(childIndex);
+
 	b2Vec2 lower = b2Mul(xf, m_vertices[0]);
 	b2Vec2 upper = lower;
 
@@ -48,7 +48,9 @@ public:
 		e_unknown= -1,
 		e_circle = 0,
 		e_polygon = 1,
-		e_typeCount = 2,
+		e_edge = 2,
+		e_chain = 3,
+		e_typeCount = 4,
 	};
 
 	b2Shape() { m_type = e_unknown; }
@@ -61,6 +63,10 @@ public:
 	/// @return the shape type.
 	Type GetType() const;
 
+	/// Get the number of child primitives. Chain shapes have one child per edge,
+	/// every other shape has a single child.
+	virtual int32 GetChildCount() const = 0;
+
 	/// Test a point for containment in this shape. This only works for convex shapes.
 	/// @param xf the shape world transform.
 	/// @param p a point in world coordinates.
@@ -70,12 +76,15 @@ public:
 	/// @param output the ray-cast results.
 	/// @param input the ray-cast input parameters.
 	/// @param transform the transform to be applied to the shape.
-	virtual bool RayCast(b2RayCastOutput* output, const b2RayCastInput& input, const b2Transform& transform) const = 0;
+	/// @param childIndex the child shape index
+	virtual bool RayCast(b2RayCastOutput* output, const b2RayCastInput& input,
+						const b2Transform& transform, int32 childIndex) const = 0;
 
 	/// Given a transform, compute the associated axis aligned bounding box for this shape.
 	/// @param aabb returns the axis aligned box.
 	/// @param xf the world transform of the shape.
-	virtual void ComputeAABB(b2AABB* aabb, const b2Transform& xf) const = 0;
+	/// @param childIndex the child shape
+	virtual void ComputeAABB(b2AABB* aabb, const b2Transform& xf, int32 childIndex) const = 0;
 
 	/// Compute the mass properties of this shape using its dimensions and density.
 	/// The inertia tensor is computed about the local origin.
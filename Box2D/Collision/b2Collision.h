@@ -28,6 +28,7 @@
 
 class b2Shape;
 class b2CircleShape;
+class b2EdgeShape;
 class b2PolygonShape;
 
 const uint8 b2_nullFeature = UCHAR_MAX;
@@ -204,12 +205,23 @@ void b2CollidePolygons(b2Manifold* manifold,
 					   const b2PolygonShape* polygon1, const b2Transform& xf1,
 					   const b2PolygonShape* polygon2, const b2Transform& xf2);
 
+/// Compute the collision manifold between an edge and a circle.
+void b2CollideEdgeAndCircle(b2Manifold* manifold,
+							const b2EdgeShape* edgeA, const b2Transform& xfA,
+							const b2CircleShape* circleB, const b2Transform& xfB);
+
+/// Compute the collision manifold between an edge and a polygon.
+void b2CollideEdgeAndPolygon(b2Manifold* manifold,
+							 const b2EdgeShape* edgeA, const b2Transform& xfA,
+							 const b2PolygonShape* polygonB, const b2Transform& xfB);
+
 /// Clipping for contact manifolds.
 int32 b2ClipSegmentToLine(b2ClipVertex vOut[2], const b2ClipVertex vIn[2],
 							const b2Vec2& normal, float32 offset);
 
 /// Determine if two generic shapes overlap.
-bool b2TestOverlap(const b2Shape* shapeA, const b2Shape* shapeB,
+bool b2TestOverlap(const b2Shape* shapeA, int32 indexA,
+				   const b2Shape* shapeB, int32 indexB,
 				   const b2Transform& xfA, const b2Transform& xfB);
 
 // ---------------- Inline Functions ------------------------------------------
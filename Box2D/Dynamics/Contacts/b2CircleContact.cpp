@@ -25,8 +25,10 @@
 
 #include <new>
 
-b2Contact* b2CircleContact::Create(b2Fixture* fixtureA, b2Fixture* fixtureB, b2BlockAllocator* allocator)
+b2Contact* b2CircleContact::Create(b2Fixture* fixtureA, int32 indexA, b2Fixture* fixtureB, int32 indexB, b2BlockAllocator* allocator)
 {
+	B2_NOT_USED(indexA);
+	B2_NOT_USED(indexB);
 	void* mem = allocator->Allocate(sizeof(b2CircleContact));
 	return new (mem) b2CircleContact(fixtureA, fixtureB);
 }
@@ -38,7 +40,7 @@ void b2CircleContact::Destroy(b2Contact* contact, b2BlockAllocator* allocator)
 }
 
 b2CircleContact::b2CircleContact(b2Fixture* fixtureA, b2Fixture* fixtureB)
-	: b2Contact(fixtureA, fixtureB)
+	: b2Contact(fixtureA, 0, fixtureB, 0)
 {
 	b2Assert(m_fixtureA->GetType() == b2Shape::e_circle);
 	b2Assert(m_fixtureB->GetType() == b2Shape::e_circle);
@@ -33,7 +33,9 @@ class b2BlockAllocator;
 class b2StackAllocator;
 class b2ContactListener;
 
-typedef b2Contact* b2ContactCreateFcn(b2Fixture* fixtureA, b2Fixture* fixtureB, b2BlockAllocator* allocator);
+typedef b2Contact* b2ContactCreateFcn(	b2Fixture* fixtureA, int32 indexA,
+										b2Fixture* fixtureB, int32 indexB,
+										b2BlockAllocator* allocator);
 typedef void b2ContactDestroyFcn(b2Contact* contact, b2BlockAllocator* allocator);
 
 struct b2ContactRegister
@@ -90,10 +92,16 @@ public:
 	b2Fixture* GetFixtureA();
 	const b2Fixture* GetFixtureA() const;
 
+	/// Get the child primitive index for fixture A.
+	int32 GetChildIndexA() const;
+
 	/// Get the second fixture in this contact.
 	b2Fixture* GetFixtureB();
 	const b2Fixture* GetFixtureB() const;
 
+	/// Get the child primitive index for fixture B.
+	int32 GetChildIndexB() const;
+
 	/// Evaluate this contact with your own manifold and transforms.
 	virtual void Evaluate(b2Manifold* manifold, const b2Transform& xfA, const b2Transform& xfB) = 0;
 
@@ -130,12 +138,12 @@ protected:
 	static void AddType(b2ContactCreateFcn* createFcn, b2ContactDestroyFcn* destroyFcn,
 						b2Shape::Type typeA, b2Shape::Type typeB);
 	static void InitializeRegisters();
-	static b2Contact* Create(b2Fixture* fixtureA, b2Fixture* fixtureB, b2BlockAllocator* allocator);
+	static b2Contact* Create(b2Fixture* fixtureA, int32 indexA, b2Fixture* fixtureB, int32 indexB, b2BlockAllocator* allocator);
 	static void Destroy(b2Contact* contact, b2Shape::Type typeA, b2Shape::Type typeB, b2BlockAllocator* allocator);
 	static void Destroy(b2Contact* contact, b2BlockAllocator* allocator);
 
 	b2Contact() : m_fixtureA(NULL), m_fixtureB(NULL) {}
-	b2Contact(b2Fixture* fixtureA, b2Fixture* fixtureB);
+	b2Contact(b2Fixture* fixtureA, int32 indexA, b2Fixture* fixtureB, int32 indexB);
 	virtual ~b2Contact() {}
 
 	void Update(b2ContactListener* listener);
@@ -156,6 +164,9 @@ protected:
 	b2Fixture* m_fixtureA;
 	b2Fixture* m_fixtureB;
 
+	int32 m_indexA;
+	int32 m_indexB;
+
 	b2Manifold m_manifold;
 
 	int32 m_toiCount;
@@ -224,6 +235,11 @@ inline const b2Fixture* b2Contact::GetFixtureA() const
 	return m_fixtureA;
 }
 
+inline int32 b2Contact::GetChildIndexA() const
+{
+	return m_indexA;
+}
+
 inline b2Fixture* b2Contact::GetFixtureB()
 {
 	return m_fixtureB;
@@ -234,6 +250,11 @@ inline const b2Fixture* b2Contact::GetFixtureB() const
 	return m_fixtureB;
 }
 
+inline int32 b2Contact::GetChildIndexB() const
+{
+	return m_indexB;
+}
+
 inline void b2Contact::FlagForFiltering()
 {
 	m_flags |= e_filterFlag;
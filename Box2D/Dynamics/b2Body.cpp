@@ -235,13 +235,13 @@ void b2Body::DestroyFixture(b2Fixture* fixture)
 
 	if (m_flags & e_activeFlag)
 	{
-		b2Assert(fixture->m_proxyId != b2BroadPhase::e_nullProxy);
+		b2Assert(fixture->m_proxyCount > 0);
 		b2BroadPhase* broadPhase = &m_world->m_contactManager.m_broadPhase;
 		fixture->DestroyProxy(broadPhase);
 	}
 	else
 	{
-		b2Assert(fixture->m_proxyId == b2BroadPhase::e_nullProxy);
+		b2Assert(fixture->m_proxyCount == 0);
 	}
 
 	fixture->Destroy(allocator);
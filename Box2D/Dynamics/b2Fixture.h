@@ -87,6 +87,15 @@ struct b2FixtureDef
 	b2Filter filter;
 };
 
+/// This proxy is used internally to connect fixtures to the broad-phase.
+/// A fixture gets one proxy per child shape.
+struct b2FixtureProxy
+{
+	b2AABB aabb;
+	b2Fixture* fixture;
+	int32 childIndex;
+	int32 proxyId;
+};
 
 /// A fixture is used to attach a shape to a body for collision detection. A fixture
 /// inherits its transform from its parent. Fixtures hold additional non-geometric data
@@ -145,7 +154,8 @@ public:
 	/// Cast a ray against this shape.
 	/// @param output the ray-cast results.
 	/// @param input the ray-cast input parameters.
-	bool RayCast(b2RayCastOutput* output, const b2RayCastInput& input) const;
+	/// @param childIndex the child shape index (e.g. edge index of a chain).
+	bool RayCast(b2RayCastOutput* output, const b2RayCastInput& input, int32 childIndex) const;
 
 	/// Get the mass data for this fixture. The mass data is based on the density and
 	/// the shape. The rotational inertia is about the shape's origin. This operation
@@ -171,10 +181,13 @@ public:
 	/// Set the coefficient of restitution.
 	void SetRestitution(float32 restitution);
 
-	/// Get the fixture's AABB. This AABB may be enlarge and/or stale.
+	/// Get the fixture's AABB for a child shape. This AABB may be enlarge and/or stale.
 	/// If you need a more accurate AABB, compute it using the shape and
 	/// the body transform.
-	const b2AABB& GetAABB() const;
+	const b2AABB& GetAABB(int32 childIndex) const;
+
+	/// Get the number of broad-phase proxies, one per child shape while the body is active.
+	int32 GetProxyCount() const;
 
 protected:
 
@@ -197,8 +210,6 @@ protected:
 
 	void Synchronize(b2BroadPhase* broadPhase, const b2Transform& xf1, const b2Transform& xf2);
 
-	b2AABB m_aabb;
-
 	float32 m_density;
 
 	b2Fixture* m_next;
@@ -209,7 +220,9 @@ protected:
 	float32 m_friction;
 	float32 m_restitution;
 
-	int32 m_proxyId;
+	b2FixtureProxy* m_proxies;
+	int32 m_proxyCount;
+
 	b2Filter m_filter;
 
 	bool m_isSensor;
@@ -308,9 +321,9 @@ inline bool b2Fixture::TestPoint(const b2Vec2& p) const
 	return m_shape->TestPoint(m_body->GetTransform(), p);
 }
 
-inline bool b2Fixture::RayCast(b2RayCastOutput* output, const b2RayCastInput& input) const
+inline bool b2Fixture::RayCast(b2RayCastOutput* output, const b2RayCastInput& input, int32 childIndex) const
 {
-	return m_shape->RayCast(output, input, m_body->GetTransform());
+	return m_shape->RayCast(output, input, m_body->GetTransform(), childIndex);
 }
 
 inline void b2Fixture::GetMassData(b2MassData* massData) const
@@ -318,9 +331,15 @@ inline void b2Fixture::GetMassData(b2MassData* massData) const
 	m_shape->ComputeMass(massData, m_density);
 }
 
-inline const b2AABB& b2Fixture::GetAABB() const
+inline const b2AABB& b2Fixture::GetAABB(int32 childIndex) const
+{
+	b2Assert(0 <= childIndex && childIndex < m_proxyCount);
+	return m_proxies[childIndex].aabb;
+}
+
+inline int32 b2Fixture::GetProxyCount() const
 {
-	return m_aabb;
+	return m_proxyCount;
 }
 
 #endif
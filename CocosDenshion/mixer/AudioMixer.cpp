@@ -0,0 +1,873 @@
+#include "AudioMixer.h"
+#include "AudioThread.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MIXER_USE_SSE2
+#elif defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define MIXER_USE_NEON
+#endif
+
+#define BREAK_IF(cond)  if (cond) break;
+
+namespace CocosDenshion {
+
+typedef enum
+{
+    kCommandPlay,
+    kCommandStop,
+    kCommandStopAll,
+    kCommandSetMasterGain,
+    kCommandUnload,
+    kCommandPlayMusic,
+    kCommandStopMusic,
+    kCommandPauseMusic,
+    kCommandResumeMusic,
+    kCommandSetMusicGain,
+} tCommandType;
+
+struct AudioMixer::Command
+{
+    tCommandType    type;
+    tPcmSound*      pSound;
+    unsigned int    nVoiceId;
+    int             nGainLeft;
+    int             nGainRight;
+    int             nPriority;
+    bool            bLoop;
+    MusicStream*    pStream;
+    unsigned int    nFadeFrames;
+};
+
+struct AudioMixer::Voice
+{
+    tPcmSound*      pSound;     // NULL when the voice is free
+    unsigned int    nPosition;
+    unsigned int    nId;
+    unsigned int    nOrder;
+    int             nGainLeft;  // Q15
+    int             nGainRight;
+    int             nPriority;
+    bool            bLoop;
+};
+
+struct AudioMixer::MusicSlot
+{
+    MusicStream*    pStream;    // NULL when the slot is free
+    float           fGain;
+    float           fStep;      // added to the gain every frame
+};
+
+void freePcmSound(tPcmSound* pSound)
+{
+    if (pSound)
+    {
+        delete [] pSound->pSamples;
+        delete pSound;
+    }
+}
+
+static int _ToGain(float fValue)
+{
+    if (fValue <= 0.0f)
+    {
+        return 0;
+    }
+    if (fValue >= 1.0f)
+    {
+        return 32767;
+    }
+    return (int)(fValue * 32767.0f);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// mixing kernels
+//////////////////////////////////////////////////////////////////////////
+
+// pAccum[i] += pSrc[i] * gain >> 15, the gains alternate left/right
+static void _MixFrames(const short* pSrc, int* pAccum, unsigned int nFrames, int nGainLeft, int nGainRight)
+{
+    unsigned int i = 0;
+
+#if defined(MIXER_USE_SSE2)
+    __m128i gain = _mm_set_epi16((short)nGainRight, (short)nGainLeft, (short)nGainRight, (short)nGainLeft,
+                                 (short)nGainRight, (short)nGainLeft, (short)nGainRight, (short)nGainLeft);
+    for (; i + 4 <= nFrames; i += 4)
+    {
+        __m128i samples = _mm_loadu_si128((const __m128i*)(pSrc + i * 2));
+        __m128i lo      = _mm_mullo_epi16(samples, gain);
+        __m128i hi      = _mm_mulhi_epi16(samples, gain);
+        __m128i p0      = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+        __m128i p1      = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+
+        __m128i* pDst   = (__m128i*)(pAccum + i * 2);
+        _mm_storeu_si128(pDst,     _mm_add_epi32(_mm_loadu_si128(pDst),     p0));
+        _mm_storeu_si128(pDst + 1, _mm_add_epi32(_mm_loadu_si128(pDst + 1), p1));
+    }
+#elif defined(MIXER_USE_NEON)
+    const short gains[4] = { (short)nGainLeft, (short)nGainRight, (short)nGainLeft, (short)nGainRight };
+    int16x4_t gain = vld1_s16(gains);
+    for (; i + 2 <= nFrames; i += 2)
+    {
+        int32x4_t product = vshrq_n_s32(vmull_s16(vld1_s16(pSrc + i * 2), gain), 15);
+        vst1q_s32(pAccum + i * 2, vaddq_s32(vld1q_s32(pAccum + i * 2), product));
+    }
+#endif
+
+    for (; i < nFrames; ++i)
+    {
+        pAccum[i * 2]     += (pSrc[i * 2]     * nGainLeft)  >> 15;
+        pAccum[i * 2 + 1] += (pSrc[i * 2 + 1] * nGainRight) >> 15;
+    }
+}
+
+// saturate the accumulated samples into 16 bit
+static void _ClampSamples(const int* pAccum, short* pOut, unsigned int nSamples)
+{
+    unsigned int i = 0;
+
+#if defined(MIXER_USE_SSE2)
+    for (; i + 8 <= nSamples; i += 8)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*)(pAccum + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(pAccum + i + 4));
+        _mm_storeu_si128((__m128i*)(pOut + i), _mm_packs_epi32(a, b));
+    }
+#elif defined(MIXER_USE_NEON)
+    for (; i + 4 <= nSamples; i += 4)
+    {
+        vst1_s16(pOut + i, vqmovn_s32(vld1q_s32(pAccum + i)));
+    }
+#endif
+
+    for (; i < nSamples; ++i)
+    {
+        int nValue = pAccum[i];
+        if (nValue > 32767)
+        {
+            nValue = 32767;
+        }
+        else if (nValue < -32768)
+        {
+            nValue = -32768;
+        }
+        pOut[i] = (short)nValue;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// audio thread
+//////////////////////////////////////////////////////////////////////////
+
+void _MixerThreadMain(AudioMixer* pMixer)
+{
+    pMixer->run();
+}
+
+static void _MixerThreadProc(void* pData)
+{
+    _MixerThreadMain((AudioMixer*)pData);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// AudioMixer
+//////////////////////////////////////////////////////////////////////////
+
+AudioMixer::AudioMixer()
+: m_pQueue(NULL)
+, m_nQueueRead(0)
+, m_nQueueWrite(0)
+, m_pVoices(NULL)
+, m_nVoices(0)
+, m_nActiveVoices(0)
+, m_nNextVoiceId(0)
+, m_nPlayOrder(0)
+, m_nMasterGain(32767)
+, m_fMasterVolume(1.0f)
+, m_pAccum(NULL)
+, m_pMusicSlots(NULL)
+, m_pMusicBuffer(NULL)
+, m_fMusicGain(1.0f)
+, m_bMusicPaused(false)
+, m_nRetiredRead(0)
+, m_nRetiredWrite(0)
+, m_pCurrentMusic(NULL)
+, m_bCurrentMusicPaused(false)
+, m_fMusicVolume(1.0f)
+, m_nSampleRate(0)
+, m_pOutput(NULL)
+, m_pThread(NULL)
+, m_bRunning(false)
+{
+}
+
+AudioMixer::~AudioMixer()
+{
+    stop();
+}
+
+bool AudioMixer::start(unsigned int nSampleRate, unsigned int nVoices, AudioOutput* pOutput)
+{
+    bool bRet = false;
+
+    do 
+    {
+        BREAK_IF(m_pVoices || ! nSampleRate || ! nVoices);
+
+        m_nSampleRate   = nSampleRate;
+        m_nVoices       = nVoices;
+        m_pVoices       = new Voice[nVoices];
+        memset(m_pVoices, 0, sizeof(Voice) * nVoices);
+        m_pQueue        = new Command[kQueueSize];
+        m_pAccum        = new int[kBufferFrames * 2];
+        m_pMusicSlots   = new MusicSlot[kMusicSlots];
+        memset(m_pMusicSlots, 0, sizeof(MusicSlot) * kMusicSlots);
+        m_pMusicBuffer  = new short[kBufferFrames * 2];
+        m_nQueueRead    = 0;
+        m_nQueueWrite   = 0;
+        m_nActiveVoices = 0;
+
+        if (! pOutput)
+        {
+            // pulled with render()
+            bRet = true;
+            break;
+        }
+
+        BREAK_IF(! pOutput->open(nSampleRate));
+        m_pOutput  = pOutput;
+        m_bRunning = true;
+
+        m_pThread = startAudioThread(_MixerThreadProc, this);
+        if (! m_pThread)
+        {
+            m_bRunning = false;
+            break;
+        }
+
+        bRet = true;
+    } while (0);
+
+    if (! bRet)
+    {
+        if (pOutput && pOutput == m_pOutput)
+        {
+            m_pOutput->close();
+            delete m_pOutput;
+            m_pOutput = NULL;
+        }
+        else if (pOutput)
+        {
+            delete pOutput;
+        }
+        stop();
+    }
+
+    return bRet;
+}
+
+void AudioMixer::stop()
+{
+    if (m_pThread)
+    {
+        m_bRunning = false;
+        joinAudioThread(m_pThread);
+        m_pThread = NULL;
+    }
+
+    if (m_pOutput)
+    {
+        m_pOutput->close();
+        delete m_pOutput;
+        m_pOutput = NULL;
+    }
+
+    // no one mixes any more, free the sounds still waiting to be unloaded
+    if (m_pQueue)
+    {
+        processCommands();
+    }
+
+    if (m_pMusicSlots)
+    {
+        for (unsigned int i = 0; i < kMusicSlots; ++i)
+        {
+            delete m_pMusicSlots[i].pStream;
+        }
+        delete [] m_pMusicSlots;
+        m_pMusicSlots = NULL;
+    }
+    collectMusic();
+    m_pCurrentMusic = NULL;
+    m_bCurrentMusicPaused = false;
+
+    delete [] m_pMusicBuffer;
+    m_pMusicBuffer = NULL;
+
+    delete [] m_pVoices;
+    m_pVoices = NULL;
+    m_nVoices = 0;
+    m_nActiveVoices = 0;
+
+    delete [] m_pQueue;
+    m_pQueue = NULL;
+
+    delete [] m_pAccum;
+    m_pAccum = NULL;
+}
+
+bool AudioMixer::pushCommand(const Command& cmd)
+{
+    if (! m_pQueue)
+    {
+        return false;
+    }
+
+    unsigned int nWrite = m_nQueueWrite;
+    if (nWrite - m_nQueueRead >= kQueueSize)
+    {
+        // full
+        return false;
+    }
+
+    m_pQueue[nWrite & (kQueueSize - 1)] = cmd;
+
+    // the command must be visible before the audio thread sees the new index
+    AUDIO_MEMORY_BARRIER();
+    m_nQueueWrite = nWrite + 1;
+    return true;
+}
+
+unsigned int AudioMixer::play(tPcmSound* pSound, float fVolume, float fPan, int nPriority, bool bLoop)
+{
+    if (! pSound || ! pSound->nFrames)
+    {
+        return 0;
+    }
+
+    if (++m_nNextVoiceId == 0)
+    {
+        ++m_nNextVoiceId;
+    }
+
+    if (fPan < -1.0f)
+    {
+        fPan = -1.0f;
+    }
+    else if (fPan > 1.0f)
+    {
+        fPan = 1.0f;
+    }
+
+    Command cmd;
+    cmd.type        = kCommandPlay;
+    cmd.pSound      = pSound;
+    cmd.nVoiceId    = m_nNextVoiceId;
+    cmd.nGainLeft   = _ToGain(fVolume * (fPan > 0.0f ? 1.0f - fPan : 1.0f));
+    cmd.nGainRight  = _ToGain(fVolume * (fPan < 0.0f ? 1.0f + fPan : 1.0f));
+    cmd.nPriority   = nPriority;
+    cmd.bLoop       = bLoop;
+
+    return pushCommand(cmd) ? m_nNextVoiceId : 0;
+}
+
+void AudioMixer::stopVoice(unsigned int nVoiceId)
+{
+    Command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type     = kCommandStop;
+    cmd.nVoiceId = nVoiceId;
+    pushCommand(cmd);
+}
+
+void AudioMixer::stopAllVoices()
+{
+    Command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type = kCommandStopAll;
+    pushCommand(cmd);
+}
+
+void AudioMixer::setMasterVolume(float fVolume)
+{
+    m_fMasterVolume = fVolume;
+
+    Command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type      = kCommandSetMasterGain;
+    cmd.nGainLeft = _ToGain(fVolume);
+    pushCommand(cmd);
+}
+
+float AudioMixer::getMasterVolume()
+{
+    return m_fMasterVolume;
+}
+
+void AudioMixer::unloadSound(tPcmSound* pSound)
+{
+    if (! pSound)
+    {
+        return;
+    }
+
+    if (! m_pQueue)
+    {
+        // not started, no voice can play it
+        freePcmSound(pSound);
+        return;
+    }
+
+    Command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type   = kCommandUnload;
+    cmd.pSound = pSound;
+
+    // the sound must not be freed while a voice plays it, wait for room in the queue
+    while (! pushCommand(cmd))
+    {
+        if (! m_bRunning)
+        {
+            // nobody else drains the queue, run the pending commands here,
+            // the unload then comes after every play of the sound
+            processCommands();
+            continue;
+        }
+        sleepAudioThread(1);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// music
+//////////////////////////////////////////////////////////////////////////
+
+static unsigned int _ToFrames(float fSeconds, unsigned int nSampleRate)
+{
+    return (fSeconds > 0.0f) ? (unsigned int)(fSeconds * nSampleRate) : 0;
+}
+
+void AudioMixer::playMusic(MusicStream* pStream, float fFadeSeconds)
+{
+    collectMusic();
+
+    if (! pStream)
+    {
+        return;
+    }
+
+    Command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type        = kCommandPlayMusic;
+    cmd.pStream     = pStream;
+    cmd.nFadeFrames = _ToFrames(fFadeSeconds, m_nSampleRate);
+
+    if (! pushCommand(cmd))
+    {
+        delete pStream;
+        return;
+    }
+
+    m_pCurrentMusic = pStream;
+    resumeMusic();
+}
+
+void AudioMixer::stopMusic(float fFadeSeconds)
+{
+    collectMusic();
+
+    Command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type        = kCommandStopMusic;
+    cmd.nFadeFrames = _ToFrames(fFadeSeconds, m_nSampleRate);
+    pushCommand(cmd);
+
+    m_pCurrentMusic = NULL;
+}
+
+void AudioMixer::pauseMusic()
+{
+    Command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type = kCommandPauseMusic;
+    if (pushCommand(cmd))
+    {
+        m_bCurrentMusicPaused = true;
+    }
+}
+
+void AudioMixer::resumeMusic()
+{
+    Command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type = kCommandResumeMusic;
+    if (pushCommand(cmd))
+    {
+        m_bCurrentMusicPaused = false;
+    }
+}
+
+bool AudioMixer::isMusicPlaying()
+{
+    collectMusic();
+    return m_pCurrentMusic && ! m_bCurrentMusicPaused && ! m_pCurrentMusic->isFinished();
+}
+
+void AudioMixer::setMusicVolume(float fVolume)
+{
+    m_fMusicVolume = fVolume;
+
+    Command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type      = kCommandSetMusicGain;
+    cmd.nGainLeft = _ToGain(fVolume);
+    pushCommand(cmd);
+}
+
+float AudioMixer::getMusicVolume()
+{
+    return m_fMusicVolume;
+}
+
+void AudioMixer::collectMusic()
+{
+    unsigned int nWrite = m_nRetiredWrite;
+    AUDIO_MEMORY_BARRIER();
+
+    unsigned int nRead = m_nRetiredRead;
+    while (nRead != nWrite)
+    {
+        MusicStream* pStream = m_pRetired[nRead & (kRetiredSize - 1)];
+        if (pStream == m_pCurrentMusic)
+        {
+            // played to its end
+            m_pCurrentMusic = NULL;
+        }
+        delete pStream;
+        ++nRead;
+    }
+
+    AUDIO_MEMORY_BARRIER();
+    m_nRetiredRead = nRead;
+}
+
+void AudioMixer::retireMusic(MusicSlot& slot)
+{
+    // never full, see kRetiredSize
+    unsigned int nWrite = m_nRetiredWrite;
+    m_pRetired[nWrite & (kRetiredSize - 1)] = slot.pStream;
+    AUDIO_MEMORY_BARRIER();
+    m_nRetiredWrite = nWrite + 1;
+
+    slot.pStream = NULL;
+}
+
+void AudioMixer::fadeOutMusic(unsigned int nFadeFrames)
+{
+    for (unsigned int i = 0; i < kMusicSlots; ++i)
+    {
+        MusicSlot& slot = m_pMusicSlots[i];
+        if (! slot.pStream)
+        {
+            continue;
+        }
+
+        if (nFadeFrames)
+        {
+            slot.fStep = -1.0f / nFadeFrames;
+        }
+        else
+        {
+            retireMusic(slot);
+        }
+    }
+}
+
+void AudioMixer::startMusic(const Command& cmd)
+{
+    fadeOutMusic(cmd.nFadeFrames);
+
+    // a free slot, else cut the quietest of the fading ones
+    MusicSlot* pSlot = NULL;
+    for (unsigned int i = 0; i < kMusicSlots; ++i)
+    {
+        MusicSlot* pCandidate = m_pMusicSlots + i;
+        if (! pCandidate->pStream)
+        {
+            pSlot = pCandidate;
+            break;
+        }
+
+        if (! pSlot || pCandidate->fGain < pSlot->fGain)
+        {
+            pSlot = pCandidate;
+        }
+    }
+
+    if (pSlot->pStream)
+    {
+        retireMusic(*pSlot);
+    }
+
+    pSlot->pStream = cmd.pStream;
+    pSlot->fGain   = (cmd.nFadeFrames) ? 0.0f : 1.0f;
+    pSlot->fStep   = (cmd.nFadeFrames) ? 1.0f / cmd.nFadeFrames : 0.0f;
+}
+
+void AudioMixer::mixMusic(int* pAccum, unsigned int nFrames)
+{
+    for (unsigned int i = 0; i < kMusicSlots; ++i)
+    {
+        MusicSlot& slot = m_pMusicSlots[i];
+        if (! slot.pStream)
+        {
+            continue;
+        }
+
+        unsigned int nRead = slot.pStream->read(m_pMusicBuffer, nFrames);
+
+        float fGain = slot.fGain;
+        for (unsigned int j = 0; j < nRead; ++j)
+        {
+            int nGain = (int)(fGain * m_fMusicGain * 32767.0f);
+            pAccum[j * 2]     += (m_pMusicBuffer[j * 2]     * nGain) >> 15;
+            pAccum[j * 2 + 1] += (m_pMusicBuffer[j * 2 + 1] * nGain) >> 15;
+
+            fGain += slot.fStep;
+            if (fGain >= 1.0f)
+            {
+                fGain = 1.0f;
+                slot.fStep = 0.0f;
+            }
+            else if (fGain <= 0.0f)
+            {
+                fGain = 0.0f;
+                break;
+            }
+        }
+        slot.fGain = fGain;
+
+        if ((slot.fGain <= 0.0f && slot.fStep < 0.0f) || slot.pStream->isFinished())
+        {
+            retireMusic(slot);
+        }
+    }
+}
+
+void AudioMixer::processCommands()
+{
+    unsigned int nWrite = m_nQueueWrite;
+    AUDIO_MEMORY_BARRIER();
+
+    unsigned int nRead = m_nQueueRead;
+    while (nRead != nWrite)
+    {
+        const Command& cmd = m_pQueue[nRead & (kQueueSize - 1)];
+
+        switch (cmd.type)
+        {
+        case kCommandPlay:
+            startVoice(cmd);
+            break;
+
+        case kCommandStop:
+            for (unsigned int i = 0; i < m_nVoices; ++i)
+            {
+                if (m_pVoices[i].pSound && m_pVoices[i].nId == cmd.nVoiceId)
+                {
+                    m_pVoices[i].pSound = NULL;
+                    --m_nActiveVoices;
+                }
+            }
+            break;
+
+        case kCommandStopAll:
+            for (unsigned int i = 0; i < m_nVoices; ++i)
+            {
+                m_pVoices[i].pSound = NULL;
+            }
+            m_nActiveVoices = 0;
+            break;
+
+        case kCommandSetMasterGain:
+            m_nMasterGain = cmd.nGainLeft;
+            break;
+
+        case kCommandUnload:
+            for (unsigned int i = 0; i < m_nVoices; ++i)
+            {
+                if (m_pVoices[i].pSound == cmd.pSound)
+                {
+                    m_pVoices[i].pSound = NULL;
+                    --m_nActiveVoices;
+                }
+            }
+            freePcmSound(cmd.pSound);
+            break;
+
+        case kCommandPlayMusic:
+            startMusic(cmd);
+            break;
+
+        case kCommandStopMusic:
+            fadeOutMusic(cmd.nFadeFrames);
+            break;
+
+        case kCommandPauseMusic:
+            m_bMusicPaused = true;
+            break;
+
+        case kCommandResumeMusic:
+            m_bMusicPaused = false;
+            break;
+
+        case kCommandSetMusicGain:
+            m_fMusicGain = cmd.nGainLeft / 32767.0f;
+            break;
+        }
+
+        ++nRead;
+    }
+
+    // the slots are read, hand them back to the game thread
+    AUDIO_MEMORY_BARRIER();
+    m_nQueueRead = nRead;
+}
+
+void AudioMixer::startVoice(const Command& cmd)
+{
+    Voice* pVoice = NULL;
+
+    // a free voice, else the lowest priority one, the oldest of them
+    for (unsigned int i = 0; i < m_nVoices; ++i)
+    {
+        Voice* pCandidate = m_pVoices + i;
+        if (! pCandidate->pSound)
+        {
+            pVoice = pCandidate;
+            break;
+        }
+
+        if (! pVoice
+            || pCandidate->nPriority < pVoice->nPriority
+            || (pCandidate->nPriority == pVoice->nPriority && pCandidate->nOrder < pVoice->nOrder))
+        {
+            pVoice = pCandidate;
+        }
+    }
+
+    if (! pVoice || (pVoice->pSound && pVoice->nPriority > cmd.nPriority))
+    {
+        // every voice plays something more important
+        return;
+    }
+
+    if (! pVoice->pSound)
+    {
+        ++m_nActiveVoices;
+    }
+
+    pVoice->pSound      = cmd.pSound;
+    pVoice->nPosition   = 0;
+    pVoice->nId         = cmd.nVoiceId;
+    pVoice->nOrder      = ++m_nPlayOrder;
+    pVoice->nGainLeft   = cmd.nGainLeft;
+    pVoice->nGainRight  = cmd.nGainRight;
+    pVoice->nPriority   = cmd.nPriority;
+    pVoice->bLoop       = cmd.bLoop;
+}
+
+void AudioMixer::mixVoice(Voice& voice, int* pAccum, unsigned int nFrames)
+{
+    int nGainLeft  = (voice.nGainLeft  * m_nMasterGain) >> 15;
+    int nGainRight = (voice.nGainRight * m_nMasterGain) >> 15;
+    tPcmSound* pSound = voice.pSound;
+
+    while (nFrames)
+    {
+        unsigned int nCount = pSound->nFrames - voice.nPosition;
+        if (nCount > nFrames)
+        {
+            nCount = nFrames;
+        }
+
+        _MixFrames(pSound->pSamples + voice.nPosition * 2, pAccum, nCount, nGainLeft, nGainRight);
+
+        voice.nPosition += nCount;
+        pAccum          += nCount * 2;
+        nFrames         -= nCount;
+
+        if (voice.nPosition >= pSound->nFrames)
+        {
+            if (! voice.bLoop)
+            {
+                voice.pSound = NULL;
+                --m_nActiveVoices;
+                break;
+            }
+            voice.nPosition = 0;
+        }
+    }
+}
+
+void AudioMixer::mix(short* pOut, unsigned int nFrames)
+{
+    memset(m_pAccum, 0, sizeof(int) * nFrames * 2);
+
+    if (! m_bMusicPaused)
+    {
+        mixMusic(m_pAccum, nFrames);
+    }
+
+    if (m_nActiveVoices)
+    {
+        for (unsigned int i = 0; i < m_nVoices; ++i)
+        {
+            if (m_pVoices[i].pSound)
+            {
+                mixVoice(m_pVoices[i], m_pAccum, nFrames);
+            }
+        }
+    }
+
+    _ClampSamples(m_pAccum, pOut, nFrames * 2);
+}
+
+void AudioMixer::render(short* pOut, unsigned int nFrames)
+{
+    if (! m_pVoices)
+    {
+        memset(pOut, 0, sizeof(short) * nFrames * 2);
+        return;
+    }
+
+    processCommands();
+
+    while (nFrames)
+    {
+        unsigned int nCount = (nFrames > kBufferFrames) ? (unsigned int)kBufferFrames : nFrames;
+        mix(pOut, nCount);
+        pOut    += nCount * 2;
+        nFrames -= nCount;
+    }
+}
+
+void AudioMixer::run()
+{
+    short* pBuffer = new short[kBufferFrames * 2];
+
+    while (m_bRunning)
+    {
+        processCommands();
+        mix(pBuffer, kBufferFrames);
+        m_pOutput->write(pBuffer, kBufferFrames);
+    }
+
+    delete [] pBuffer;
+}
+
+} // end of namespace CocosDenshion
@@ -0,0 +1,175 @@
+#ifndef _AUDIO_MIXER_H_
+#define _AUDIO_MIXER_H_
+
+#include "AudioOutput.h"
+#include "MusicStream.h"
+
+namespace CocosDenshion {
+
+/**
+@struct tPcmSound
+@brief  A decoded sound, interleaved signed 16 bit stereo at the sample rate of the mixer
+*/
+typedef struct _PcmSound
+{
+    short*          pSamples;
+    unsigned int    nFrames;
+} tPcmSound;
+
+/**
+@brief Free a sound returned by WaveDecoder, only call it for sounds the mixer never played,
+       use AudioMixer::unloadSound for the others
+*/
+void freePcmSound(tPcmSound* pSound);
+
+/**
+@class AudioMixer
+@brief A software mixer playing preloaded PCM sounds on a fixed pool of voices,
+       over streamed music.
+
+All the methods must be called from the same (game) thread. They only push commands
+into a lock-free queue, the mixing is done by the audio thread which drains the queue
+before every buffer. On platforms without threads, or when no output is given, call
+render() to pull the mixed samples yourself.
+*/
+class AudioMixer
+{
+public:
+    enum
+    {
+        kDefaultVoices  = 32,
+        kBufferFrames   = 512,      // frames mixed per buffer
+        kQueueSize      = 256,      // must be a power of two
+        kMusicSlots     = 2,        // the music playing and the one fading out
+        // must be a power of two. Every stream played since the last collectMusic() fits:
+        // the ones in the queue and in the slots, plus the one pushed after it
+        kRetiredSize    = 512,
+    };
+
+    AudioMixer();
+    ~AudioMixer();
+
+    /**
+    @brief Start mixing
+    @param nSampleRate The output sample rate, sounds are converted to it when decoded
+    @param nVoices     The size of the voice pool
+    @param pOutput     The sink the audio thread writes to, the mixer takes its ownership.
+                       If NULL, no thread is started and render() must be called
+    @return false if the output or the thread could not be started
+    */
+    bool start(unsigned int nSampleRate, unsigned int nVoices, AudioOutput* pOutput);
+
+    /**
+    @brief Stop the audio thread and close the output. The sounds stay owned by the caller
+    */
+    void stop();
+
+    /**
+    @brief Play a sound on a free voice, or steal the voice with the lowest priority
+    @param fVolume   0.0 ~ 1.0
+    @param fPan      -1.0 (left) ~ 1.0 (right)
+    @param nPriority Voices playing sounds with a higher priority are never stolen
+    @return The id of the voice, 0 if the queue is full
+    */
+    unsigned int play(tPcmSound* pSound, float fVolume = 1.0f, float fPan = 0.0f, int nPriority = 0, bool bLoop = false);
+
+    void stopVoice(unsigned int nVoiceId);
+    void stopAllVoices();
+
+    /**
+    @brief Set the volume applied to all the voices, 0.0 ~ 1.0
+    */
+    void setMasterVolume(float fVolume);
+    float getMasterVolume();
+
+    /**
+    @brief Stop the voices playing the sound then free it. The sound is freed by the audio thread
+    */
+    void unloadSound(tPcmSound* pSound);
+
+    /**
+    @brief Play a streamed music
+    @param pStream      The mixer takes its ownership, the stream is deleted once it ended or faded out
+    @param fFadeSeconds How long the current music fades out while the new one fades in, 0 to cut
+    */
+    void playMusic(MusicStream* pStream, float fFadeSeconds = 0.0f);
+    void stopMusic(float fFadeSeconds = 0.0f);
+    void pauseMusic();
+    void resumeMusic();
+    bool isMusicPlaying();
+
+    /**
+    @brief The volume of the music, 0.0 ~ 1.0. It is not affected by the master volume of the effects
+    */
+    void setMusicVolume(float fVolume);
+    float getMusicVolume();
+
+    /**
+    @brief Mix nFrames stereo frames into pOut, only call it when the mixer has no output
+    */
+    void render(short* pOut, unsigned int nFrames);
+
+    unsigned int getSampleRate()            { return m_nSampleRate; }
+
+    /**
+    @brief The number of voices playing, as seen by the audio thread
+    */
+    unsigned int getActiveVoices()          { return m_nActiveVoices; }
+
+private:
+    struct Command;
+    struct Voice;
+    struct MusicSlot;
+
+    bool pushCommand(const Command& cmd);
+    void processCommands();
+    void startVoice(const Command& cmd);
+    void mix(short* pOut, unsigned int nFrames);
+    void mixVoice(Voice& voice, int* pAccum, unsigned int nFrames);
+    void startMusic(const Command& cmd);
+    void fadeOutMusic(unsigned int nFadeFrames);
+    void retireMusic(MusicSlot& slot);
+    void mixMusic(int* pAccum, unsigned int nFrames);
+    void collectMusic();
+
+    friend void _MixerThreadMain(AudioMixer* pMixer);
+    void run();
+
+    Command*                m_pQueue;
+    volatile unsigned int   m_nQueueRead;
+    volatile unsigned int   m_nQueueWrite;
+
+    Voice*                  m_pVoices;
+    unsigned int            m_nVoices;
+    unsigned int            m_nActiveVoices;
+    unsigned int            m_nNextVoiceId;
+    unsigned int            m_nPlayOrder;
+    int                     m_nMasterGain;      // Q15, only touched by the audio thread
+    float                   m_fMasterVolume;
+    int*                    m_pAccum;
+
+    // music, the slots belong to the audio thread
+    MusicSlot*              m_pMusicSlots;
+    short*                  m_pMusicBuffer;
+    float                   m_fMusicGain;
+    bool                    m_bMusicPaused;
+
+    // streams the audio thread is done with, deleted on the game thread
+    MusicStream*            m_pRetired[kRetiredSize];
+    volatile unsigned int   m_nRetiredRead;
+    volatile unsigned int   m_nRetiredWrite;
+
+    // the game thread view of the music
+    MusicStream*            m_pCurrentMusic;
+    bool                    m_bCurrentMusicPaused;
+    float                   m_fMusicVolume;
+
+    unsigned int            m_nSampleRate;
+    AudioOutput*            m_pOutput;
+    void*                   m_pThread;
+    volatile bool           m_bRunning;
+};
+
+} // end of namespace CocosDenshion
+
+#endif
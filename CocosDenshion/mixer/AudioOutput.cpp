@@ -0,0 +1,127 @@
+#include "AudioOutput.h"
+
+#include <string.h>
+
+namespace CocosDenshion {
+
+//////////////////////////////////////////////////////////////////////////
+// NullAudioOutput
+//////////////////////////////////////////////////////////////////////////
+
+NullAudioOutput::NullAudioOutput()
+: m_nFramesWritten(0)
+{
+}
+
+bool NullAudioOutput::open(unsigned int /*nSampleRate*/)
+{
+    m_nFramesWritten = 0;
+    return true;
+}
+
+void NullAudioOutput::close()
+{
+}
+
+void NullAudioOutput::write(const short* /*pSamples*/, unsigned int nFrames)
+{
+    m_nFramesWritten += nFrames;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// WavFileAudioOutput
+//////////////////////////////////////////////////////////////////////////
+
+static void _PutLE32(unsigned char* pDst, unsigned int nValue)
+{
+    pDst[0] = (unsigned char)(nValue);
+    pDst[1] = (unsigned char)(nValue >> 8);
+    pDst[2] = (unsigned char)(nValue >> 16);
+    pDst[3] = (unsigned char)(nValue >> 24);
+}
+
+static void _PutLE16(unsigned char* pDst, unsigned int nValue)
+{
+    pDst[0] = (unsigned char)(nValue);
+    pDst[1] = (unsigned char)(nValue >> 8);
+}
+
+WavFileAudioOutput::WavFileAudioOutput(const char* pszFileName)
+: m_pFile(NULL)
+, m_nSampleRate(0)
+, m_nDataBytes(0)
+{
+    m_szFileName[0] = 0;
+    if (pszFileName)
+    {
+        strncpy(m_szFileName, pszFileName, sizeof(m_szFileName) - 1);
+        m_szFileName[sizeof(m_szFileName) - 1] = 0;
+    }
+}
+
+WavFileAudioOutput::~WavFileAudioOutput()
+{
+    close();
+}
+
+bool WavFileAudioOutput::open(unsigned int nSampleRate)
+{
+    close();
+
+    m_pFile = fopen(m_szFileName, "wb");
+    if (! m_pFile)
+    {
+        return false;
+    }
+
+    m_nSampleRate = nSampleRate;
+    m_nDataBytes  = 0;
+
+    // sizes are patched by close()
+    writeHeader(0);
+    return true;
+}
+
+void WavFileAudioOutput::close()
+{
+    if (m_pFile)
+    {
+        fseek(m_pFile, 0, SEEK_SET);
+        writeHeader(m_nDataBytes);
+        fclose(m_pFile);
+        m_pFile = NULL;
+    }
+}
+
+void WavFileAudioOutput::write(const short* pSamples, unsigned int nFrames)
+{
+    if (! m_pFile)
+    {
+        return;
+    }
+
+    // wave data is little endian, as are all the platforms we run on
+    m_nDataBytes += (unsigned int)fwrite(pSamples, 1, nFrames * 2 * sizeof(short), m_pFile);
+}
+
+void WavFileAudioOutput::writeHeader(unsigned int nDataBytes)
+{
+    unsigned char header[44];
+
+    memcpy(header, "RIFF", 4);
+    _PutLE32(header + 4, 36 + nDataBytes);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    _PutLE32(header + 16, 16);                  // fmt chunk size
+    _PutLE16(header + 20, 1);                   // PCM
+    _PutLE16(header + 22, 2);                   // channels
+    _PutLE32(header + 24, m_nSampleRate);
+    _PutLE32(header + 28, m_nSampleRate * 4);   // bytes per second
+    _PutLE16(header + 32, 4);                   // block align
+    _PutLE16(header + 34, 16);                  // bits per sample
+    memcpy(header + 36, "data", 4);
+    _PutLE32(header + 40, nDataBytes);
+
+    fwrite(header, 1, sizeof(header), m_pFile);
+}
+
+} // end of namespace CocosDenshion
@@ -0,0 +1,75 @@
+#ifndef _AUDIO_OUTPUT_H_
+#define _AUDIO_OUTPUT_H_
+
+#include <stdio.h>
+
+namespace CocosDenshion {
+
+/**
+@class AudioOutput
+@brief The sink the audio thread of AudioMixer writes the mixed samples to.
+       Samples are interleaved signed 16 bit stereo.
+*/
+class AudioOutput
+{
+public:
+    virtual ~AudioOutput() {}
+
+    virtual bool open(unsigned int nSampleRate) = 0;
+    virtual void close() = 0;
+
+    /**
+    @brief Write a buffer. A device output blocks until it has room for it, this paces the audio thread
+    */
+    virtual void write(const short* pSamples, unsigned int nFrames) = 0;
+};
+
+/**
+@class NullAudioOutput
+@brief Throws the samples away without blocking, the mixer then runs as fast as it can.
+       Use it to benchmark the mixing, or when the device has no sound.
+*/
+class NullAudioOutput : public AudioOutput
+{
+public:
+    NullAudioOutput();
+
+    virtual bool open(unsigned int nSampleRate);
+    virtual void close();
+    virtual void write(const short* pSamples, unsigned int nFrames);
+
+    /**
+    @brief The number of frames written since open()
+    */
+    unsigned long getFramesWritten()        { return m_nFramesWritten; }
+
+private:
+    volatile unsigned long m_nFramesWritten;
+};
+
+/**
+@class WavFileAudioOutput
+@brief Writes the samples into a .wav file, to check the output of the mixer offline
+*/
+class WavFileAudioOutput : public AudioOutput
+{
+public:
+    WavFileAudioOutput(const char* pszFileName);
+    virtual ~WavFileAudioOutput();
+
+    virtual bool open(unsigned int nSampleRate);
+    virtual void close();
+    virtual void write(const short* pSamples, unsigned int nFrames);
+
+private:
+    void writeHeader(unsigned int nDataBytes);
+
+    char            m_szFileName[260];
+    FILE*           m_pFile;
+    unsigned int    m_nSampleRate;
+    unsigned int    m_nDataBytes;
+};
+
+} // end of namespace CocosDenshion
+
+#endif
@@ -0,0 +1,115 @@
+#include "AudioThread.h"
+
+#if ! defined(_WIN32) && ! defined(AUDIO_NO_THREAD)
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+namespace CocosDenshion {
+
+typedef struct _ThreadStartInfo
+{
+    AUDIO_THREAD_FUNC   pfnFunc;
+    void*               pData;
+} tThreadStartInfo;
+
+#if defined(_WIN32)
+
+static DWORD WINAPI _ThreadEntry(LPVOID pParam)
+{
+    tThreadStartInfo info = *(tThreadStartInfo*)pParam;
+    delete (tThreadStartInfo*)pParam;
+    info.pfnFunc(info.pData);
+    return 0;
+}
+
+void* startAudioThread(AUDIO_THREAD_FUNC pfnFunc, void* pData)
+{
+    tThreadStartInfo* pInfo = new tThreadStartInfo;
+    pInfo->pfnFunc = pfnFunc;
+    pInfo->pData   = pData;
+
+    HANDLE hThread = CreateThread(NULL, 0, _ThreadEntry, pInfo, 0, NULL);
+    if (! hThread)
+    {
+        delete pInfo;
+        return NULL;
+    }
+
+    // keep the mixing smooth while the game thread is busy
+    SetThreadPriority(hThread, THREAD_PRIORITY_ABOVE_NORMAL);
+    return hThread;
+}
+
+void joinAudioThread(void* pThread)
+{
+    if (pThread)
+    {
+        WaitForSingleObject((HANDLE)pThread, INFINITE);
+        CloseHandle((HANDLE)pThread);
+    }
+}
+
+void sleepAudioThread(unsigned int nMilliseconds)
+{
+    Sleep(nMilliseconds);
+}
+
+#elif ! defined(AUDIO_NO_THREAD)
+
+static void* _ThreadEntry(void* pParam)
+{
+    tThreadStartInfo info = *(tThreadStartInfo*)pParam;
+    delete (tThreadStartInfo*)pParam;
+    info.pfnFunc(info.pData);
+    return NULL;
+}
+
+void* startAudioThread(AUDIO_THREAD_FUNC pfnFunc, void* pData)
+{
+    tThreadStartInfo* pInfo = new tThreadStartInfo;
+    pInfo->pfnFunc = pfnFunc;
+    pInfo->pData   = pData;
+
+    pthread_t* pThread = new pthread_t;
+    if (pthread_create(pThread, NULL, _ThreadEntry, pInfo) != 0)
+    {
+        delete pInfo;
+        delete pThread;
+        return NULL;
+    }
+    return pThread;
+}
+
+void joinAudioThread(void* pThread)
+{
+    if (pThread)
+    {
+        pthread_join(*(pthread_t*)pThread, NULL);
+        delete (pthread_t*)pThread;
+    }
+}
+
+void sleepAudioThread(unsigned int nMilliseconds)
+{
+    usleep(nMilliseconds * 1000);
+}
+
+#else
+
+void* startAudioThread(AUDIO_THREAD_FUNC pfnFunc, void* pData)
+{
+    return NULL;
+}
+
+void joinAudioThread(void* pThread)
+{
+}
+
+void sleepAudioThread(unsigned int nMilliseconds)
+{
+}
+
+#endif
+
+} // end of namespace CocosDenshion
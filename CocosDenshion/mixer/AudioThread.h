@@ -0,0 +1,37 @@
+#ifndef _AUDIO_THREAD_H_
+#define _AUDIO_THREAD_H_
+
+#if defined(_WIN32)
+    #include <windows.h>
+    #define AUDIO_MEMORY_BARRIER()  MemoryBarrier()
+#elif defined(__GNUC__)
+    #define AUDIO_MEMORY_BARRIER()  __sync_synchronize()
+#else
+    #define AUDIO_MEMORY_BARRIER()
+#endif
+
+// uphone has no thread api
+#if defined(_TRANZDA_VM_)
+    #define AUDIO_NO_THREAD
+#endif
+
+namespace CocosDenshion {
+
+typedef void (*AUDIO_THREAD_FUNC)(void* pData);
+
+/**
+@brief Start a thread running pfnFunc(pData)
+@return The handle to pass to joinAudioThread, NULL if the thread could not be started
+*/
+void* startAudioThread(AUDIO_THREAD_FUNC pfnFunc, void* pData);
+
+/**
+@brief Wait for the thread to return and free its handle
+*/
+void joinAudioThread(void* pThread);
+
+void sleepAudioThread(unsigned int nMilliseconds);
+
+} // end of namespace CocosDenshion
+
+#endif
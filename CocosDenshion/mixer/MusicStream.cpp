@@ -0,0 +1,467 @@
+#include "MusicStream.h"
+#include "AudioThread.h"
+
+#include <string.h>
+
+#define BREAK_IF(cond)  if (cond) break;
+
+namespace CocosDenshion {
+
+static unsigned int _GetLE32(const unsigned char* pSrc)
+{
+    return pSrc[0] | (pSrc[1] << 8) | (pSrc[2] << 16) | ((unsigned int)pSrc[3] << 24);
+}
+
+static unsigned int _GetLE16(const unsigned char* pSrc)
+{
+    return pSrc[0] | (pSrc[1] << 8);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FileStreamSource
+//////////////////////////////////////////////////////////////////////////
+
+FileStreamSource::FileStreamSource(FILE* pFile, unsigned int nBase, unsigned int nLength)
+: m_pFile(pFile)
+, m_nBase(nBase)
+, m_nLength(nLength)
+, m_nPosition(0)
+{
+    fseek(m_pFile, m_nBase, SEEK_SET);
+}
+
+FileStreamSource::~FileStreamSource()
+{
+    if (m_pFile)
+    {
+        fclose(m_pFile);
+    }
+}
+
+FileStreamSource* FileStreamSource::openFile(const char* pszFilePath)
+{
+    FILE* pFile = (pszFilePath) ? fopen(pszFilePath, "rb") : NULL;
+    if (! pFile)
+    {
+        return NULL;
+    }
+
+    fseek(pFile, 0, SEEK_END);
+    long nLength = ftell(pFile);
+    if (nLength <= 0)
+    {
+        fclose(pFile);
+        return NULL;
+    }
+
+    return new FileStreamSource(pFile, 0, (unsigned int)nLength);
+}
+
+FileStreamSource* FileStreamSource::openZipEntry(const char* pszZipFilePath, const char* pszEntryName)
+{
+    FileStreamSource* pRet = NULL;
+    FILE* pFile = NULL;
+
+    do 
+    {
+        BREAK_IF(! pszZipFilePath || ! pszEntryName);
+
+        pFile = fopen(pszZipFilePath, "rb");
+        BREAK_IF(! pFile);
+
+        unsigned int nNameLen = (unsigned int)strlen(pszEntryName);
+        unsigned char header[30];
+        char szName[260];
+
+        // walk the local file headers
+        while (fread(header, 1, sizeof(header), pFile) == sizeof(header))
+        {
+            BREAK_IF(_GetLE32(header) != 0x04034b50);
+
+            unsigned int nFlags      = _GetLE16(header + 6);
+            unsigned int nMethod     = _GetLE16(header + 8);
+            unsigned int nCompressed = _GetLE32(header + 18);
+            unsigned int nFileName   = _GetLE16(header + 26);
+            unsigned int nExtra      = _GetLE16(header + 28);
+
+            // sizes written after the data, the headers can't be walked any further
+            BREAK_IF(nFlags & 0x08);
+
+            bool bMatch = false;
+            if (nFileName == nNameLen && nFileName < sizeof(szName))
+            {
+                BREAK_IF(fread(szName, 1, nFileName, pFile) != nFileName);
+                bMatch = ! memcmp(szName, pszEntryName, nNameLen);
+                fseek(pFile, nExtra, SEEK_CUR);
+            }
+            else
+            {
+                fseek(pFile, nFileName + nExtra, SEEK_CUR);
+            }
+
+            if (bMatch)
+            {
+                if (nMethod == 0)
+                {
+                    pRet = new FileStreamSource(pFile, (unsigned int)ftell(pFile), nCompressed);
+                    pFile = NULL;
+                }
+                break;
+            }
+
+            fseek(pFile, nCompressed, SEEK_CUR);
+        }
+    } while (0);
+
+    if (pFile)
+    {
+        fclose(pFile);
+    }
+    return pRet;
+}
+
+unsigned int FileStreamSource::read(void* pBuffer, unsigned int nSize)
+{
+    if (nSize > m_nLength - m_nPosition)
+    {
+        nSize = m_nLength - m_nPosition;
+    }
+
+    unsigned int nRead = (unsigned int)fread(pBuffer, 1, nSize, m_pFile);
+    m_nPosition += nRead;
+    return nRead;
+}
+
+bool FileStreamSource::seek(unsigned int nOffset)
+{
+    if (nOffset > m_nLength || fseek(m_pFile, m_nBase + nOffset, SEEK_SET))
+    {
+        return false;
+    }
+
+    m_nPosition = nOffset;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// decoding thread
+//////////////////////////////////////////////////////////////////////////
+
+void _MusicStreamThreadMain(MusicStream* pStream)
+{
+    while (! pStream->m_bQuit)
+    {
+        pStream->fill();
+        sleepAudioThread(10);
+    }
+}
+
+static void _MusicStreamThreadProc(void* pData)
+{
+    _MusicStreamThreadMain((MusicStream*)pData);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// MusicStream
+//////////////////////////////////////////////////////////////////////////
+
+MusicStream::MusicStream()
+: m_pSource(NULL)
+, m_nChannels(0)
+, m_nBits(0)
+, m_nSourceRate(0)
+, m_nDataOffset(0)
+, m_nDataSize(0)
+, m_nDataRead(0)
+, m_nSampleRate(0)
+, m_nStep(0)
+, m_nPosition(0)
+, m_pSourceFrames(NULL)
+, m_nSourceFrames(0)
+, m_pReadBuffer(NULL)
+, m_bSourceEnded(false)
+, m_pRing(NULL)
+, m_nRingRead(0)
+, m_nRingWrite(0)
+, m_bLoop(false)
+, m_bEnded(false)
+, m_bQuit(false)
+, m_pThread(NULL)
+{
+}
+
+MusicStream::~MusicStream()
+{
+    m_bQuit = true;
+    joinAudioThread(m_pThread);
+
+    delete m_pSource;
+    delete [] m_pSourceFrames;
+    delete [] m_pReadBuffer;
+    delete [] m_pRing;
+}
+
+MusicStream* MusicStream::create(StreamSource* pSource, unsigned int nSampleRate, bool bLoop)
+{
+    if (! pSource)
+    {
+        return NULL;
+    }
+
+    MusicStream* pRet = new MusicStream();
+    pRet->m_pSource     = pSource;
+    pRet->m_nSampleRate = nSampleRate;
+    pRet->m_bLoop       = bLoop;
+
+    if (! nSampleRate || ! pRet->parseHeader())
+    {
+        delete pRet;
+        return NULL;
+    }
+
+    pRet->m_nStep         = (unsigned int)(((double)pRet->m_nSourceRate / nSampleRate) * 65536.0);
+    pRet->m_pSourceFrames = new short[(kChunkFrames + 1) * 2];
+    pRet->m_pReadBuffer   = new unsigned char[kChunkFrames * pRet->m_nChannels * pRet->m_nBits / 8];
+    pRet->m_pRing         = new short[kRingFrames * 2];
+
+    // have the start ready before the mixer asks for it
+    pRet->fill();
+    pRet->m_pThread = startAudioThread(_MusicStreamThreadProc, pRet);
+    return pRet;
+}
+
+bool MusicStream::parseHeader()
+{
+    unsigned char header[16];
+
+    if (m_pSource->read(header, 12) != 12 || memcmp(header, "RIFF", 4) || memcmp(header + 8, "WAVE", 4))
+    {
+        return false;
+    }
+
+    unsigned int nOffset = 12;
+    while (m_pSource->read(header, 8) == 8)
+    {
+        unsigned int nChunkSize = _GetLE32(header + 4);
+        nOffset += 8;
+
+        if (! memcmp(header, "fmt ", 4))
+        {
+            if (nChunkSize < 16 || m_pSource->read(header, 16) != 16 || _GetLE16(header) != 1)
+            {
+                // PCM only
+                return false;
+            }
+            m_nChannels   = _GetLE16(header + 2);
+            m_nSourceRate = _GetLE32(header + 4);
+            m_nBits       = _GetLE16(header + 14);
+        }
+        else if (! memcmp(header, "data", 4))
+        {
+            m_nDataOffset = nOffset;
+            m_nDataSize   = nChunkSize;
+            break;
+        }
+
+        nOffset += nChunkSize + (nChunkSize & 1);
+        if (! m_pSource->seek(nOffset))
+        {
+            return false;
+        }
+    }
+
+    if (! m_nDataOffset || ! m_nSourceRate
+        || (m_nChannels != 1 && m_nChannels != 2)
+        || (m_nBits != 8 && m_nBits != 16))
+    {
+        return false;
+    }
+
+    // drop a partial frame at the end
+    unsigned int nFrameBytes = m_nChannels * m_nBits / 8;
+    m_nDataSize -= m_nDataSize % nFrameBytes;
+    return m_nDataSize > 0 && m_pSource->seek(m_nDataOffset);
+}
+
+bool MusicStream::readSourceFrames()
+{
+    // keep the last frame, it is the left side of the next interpolation
+    if (m_nSourceFrames)
+    {
+        m_pSourceFrames[0] = m_pSourceFrames[(m_nSourceFrames - 1) * 2];
+        m_pSourceFrames[1] = m_pSourceFrames[(m_nSourceFrames - 1) * 2 + 1];
+        m_nPosition -= (m_nSourceFrames - 1) << 16;
+        m_nSourceFrames = 1;
+    }
+
+    unsigned int nFrameBytes = m_nChannels * m_nBits / 8;
+    unsigned int nAdded = 0;
+    unsigned int nEmptyReads = 0;
+
+    while (nAdded < kChunkFrames)
+    {
+        if (m_nDataRead >= m_nDataSize)
+        {
+            if (! m_bLoop || ! m_pSource->seek(m_nDataOffset))
+            {
+                m_bSourceEnded = true;
+                break;
+            }
+            // gapless, the first frame follows the last one
+            m_nDataRead = 0;
+        }
+
+        unsigned int nWant = (m_nDataSize - m_nDataRead) / nFrameBytes;
+        if (nWant > kChunkFrames - nAdded)
+        {
+            nWant = kChunkFrames - nAdded;
+        }
+
+        unsigned int nGot = m_pSource->read(m_pReadBuffer, nWant * nFrameBytes) / nFrameBytes;
+        if (! nGot)
+        {
+            // truncated file, loop on what could be read if anything
+            m_nDataRead = m_nDataSize;
+            if (! m_bLoop || ++nEmptyReads > 1)
+            {
+                m_bSourceEnded = true;
+                break;
+            }
+            continue;
+        }
+        nEmptyReads = 0;
+        m_nDataRead += nGot * nFrameBytes;
+
+        short* pDst = m_pSourceFrames + m_nSourceFrames * 2;
+        for (unsigned int i = 0; i < nGot; ++i)
+        {
+            for (unsigned int c = 0; c < 2; ++c)
+            {
+                // mono goes to both sides
+                unsigned int nIndex = i * m_nChannels + ((m_nChannels == 2) ? c : 0);
+                int nSample = (m_nBits == 8)
+                    ? ((int)m_pReadBuffer[nIndex] - 128) << 8
+                    : (short)_GetLE16(m_pReadBuffer + nIndex * 2);
+                pDst[i * 2 + c] = (short)nSample;
+            }
+        }
+
+        m_nSourceFrames += nGot;
+        nAdded += nGot;
+    }
+
+    return nAdded > 0;
+}
+
+unsigned int MusicStream::decodeChunk(short* pOut, unsigned int nFrames)
+{
+    unsigned int i = 0;
+
+    while (i < nFrames)
+    {
+        unsigned int nFrame = m_nPosition >> 16;
+
+        if (nFrame + 1 >= m_nSourceFrames)
+        {
+            if (! m_bSourceEnded && readSourceFrames())
+            {
+                continue;
+            }
+
+            // the end, no right side to interpolate with
+            if (nFrame >= m_nSourceFrames)
+            {
+                break;
+            }
+            pOut[i * 2]     = m_pSourceFrames[nFrame * 2];
+            pOut[i * 2 + 1] = m_pSourceFrames[nFrame * 2 + 1];
+        }
+        else
+        {
+            int nFrac = m_nPosition & 0xffff;
+            const short* pA = m_pSourceFrames + nFrame * 2;
+            const short* pB = pA + 2;
+            pOut[i * 2]     = (short)(pA[0] + (((pB[0] - pA[0]) * nFrac) >> 16));
+            pOut[i * 2 + 1] = (short)(pA[1] + (((pB[1] - pA[1]) * nFrac) >> 16));
+        }
+
+        m_nPosition += m_nStep;
+        ++i;
+    }
+
+    return i;
+}
+
+void MusicStream::fill()
+{
+    short chunk[kChunkFrames * 2];
+
+    while (! m_bEnded && ! m_bQuit)
+    {
+        unsigned int nWrite = m_nRingWrite;
+        if (kRingFrames - (nWrite - m_nRingRead) < kChunkFrames)
+        {
+            // full
+            break;
+        }
+
+        unsigned int nFrames = decodeChunk(chunk, kChunkFrames);
+
+        // copy into the ring, wrapping around
+        unsigned int nStart = nWrite & (kRingFrames - 1);
+        unsigned int nFirst = kRingFrames - nStart;
+        if (nFirst > nFrames)
+        {
+            nFirst = nFrames;
+        }
+        memcpy(m_pRing + nStart * 2, chunk, nFirst * 2 * sizeof(short));
+        memcpy(m_pRing, chunk + nFirst * 2, (nFrames - nFirst) * 2 * sizeof(short));
+
+        AUDIO_MEMORY_BARRIER();
+        m_nRingWrite = nWrite + nFrames;
+
+        if (nFrames < kChunkFrames)
+        {
+            m_bEnded = true;
+        }
+    }
+}
+
+unsigned int MusicStream::read(short* pOut, unsigned int nFrames)
+{
+    if (! m_pThread)
+    {
+        // no decoding thread, decode from the audio thread
+        fill();
+    }
+
+    unsigned int nRead  = m_nRingRead;
+    unsigned int nWrite = m_nRingWrite;
+    AUDIO_MEMORY_BARRIER();
+
+    if (nFrames > nWrite - nRead)
+    {
+        nFrames = nWrite - nRead;
+    }
+
+    unsigned int nStart = nRead & (kRingFrames - 1);
+    unsigned int nFirst = kRingFrames - nStart;
+    if (nFirst > nFrames)
+    {
+        nFirst = nFrames;
+    }
+    memcpy(pOut, m_pRing + nStart * 2, nFirst * 2 * sizeof(short));
+    memcpy(pOut + nFirst * 2, m_pRing, (nFrames - nFirst) * 2 * sizeof(short));
+
+    // the frames are copied before the decoder may overwrite them
+    AUDIO_MEMORY_BARRIER();
+    m_nRingRead = nRead + nFrames;
+    return nFrames;
+}
+
+bool MusicStream::isFinished()
+{
+    return m_bEnded && m_nRingRead == m_nRingWrite;
+}
+
+} // end of namespace CocosDenshion
@@ -0,0 +1,152 @@
+#ifndef _MUSIC_STREAM_H_
+#define _MUSIC_STREAM_H_
+
+#include <stdio.h>
+
+namespace CocosDenshion {
+
+/**
+@class StreamSource
+@brief Where a MusicStream reads the encoded data from
+*/
+class StreamSource
+{
+public:
+    virtual ~StreamSource() {}
+
+    /**
+    @return The number of bytes read, 0 at the end
+    */
+    virtual unsigned int read(void* pBuffer, unsigned int nSize) = 0;
+
+    /**
+    @brief Seek to an offset from the start of the source
+    */
+    virtual bool seek(unsigned int nOffset) = 0;
+};
+
+/**
+@class FileStreamSource
+@brief Reads a file, or a part of it
+*/
+class FileStreamSource : public StreamSource
+{
+public:
+    /**
+    @brief Open a file
+    @return NULL if the file can not be opened
+    */
+    static FileStreamSource* openFile(const char* pszFilePath);
+
+    /**
+    @brief Open an entry of a .zip file, in place.
+    @warning Only the entries stored without compression can be streamed,
+             which is how the audio should be packed anyway.
+    */
+    static FileStreamSource* openZipEntry(const char* pszZipFilePath, const char* pszEntryName);
+
+    virtual ~FileStreamSource();
+
+    virtual unsigned int read(void* pBuffer, unsigned int nSize);
+    virtual bool seek(unsigned int nOffset);
+
+private:
+    FileStreamSource(FILE* pFile, unsigned int nBase, unsigned int nLength);
+
+    FILE*           m_pFile;
+    unsigned int    m_nBase;
+    unsigned int    m_nLength;
+    unsigned int    m_nPosition;
+};
+
+/**
+@class MusicStream
+@brief Decodes a PCM .wav music in small chunks into a ring buffer on a background thread.
+       The memory used is fixed whatever the length of the track.
+
+The decoding thread is the only writer of the ring, the audio thread of AudioMixer
+the only reader. Looping is done by the decoder, so there is no gap at the loop point.
+*/
+class MusicStream
+{
+public:
+    enum
+    {
+        kRingFrames     = 16384,    // about 0.37 second at 44100Hz, must be a power of two
+        kChunkFrames    = 1024,     // frames decoded at a time
+    };
+
+    /**
+    @brief Parse the header of the music and start decoding
+    @param pSource     The stream takes its ownership
+    @param nSampleRate The rate of the mixer, the music is resampled to it
+    @return NULL if the source is not a PCM wave
+    */
+    static MusicStream* create(StreamSource* pSource, unsigned int nSampleRate, bool bLoop);
+
+    /**
+    @brief Stop the decoding thread and close the source
+    */
+    ~MusicStream();
+
+    /**
+    @brief Copy the decoded frames out of the ring, called by the audio thread
+    @return The number of frames copied, less than nFrames if the decoder is late or the music ended
+    */
+    unsigned int read(short* pOut, unsigned int nFrames);
+
+    /**
+    @brief Whether the music played to its end, never true for a looping one
+    */
+    bool isFinished();
+
+    void setLoop(bool bLoop)            { m_bLoop = bLoop; }
+    bool isLoop()                       { return m_bLoop; }
+
+    /**
+    @brief Decode until the ring is full. The decoding thread calls it,
+           call it yourself on the platforms without threads.
+    */
+    void fill();
+
+private:
+    MusicStream();
+
+    bool parseHeader();
+    bool readSourceFrames();
+    unsigned int decodeChunk(short* pOut, unsigned int nFrames);
+
+    friend void _MusicStreamThreadMain(MusicStream* pStream);
+
+    StreamSource*           m_pSource;
+
+    // format of the source
+    unsigned int            m_nChannels;
+    unsigned int            m_nBits;
+    unsigned int            m_nSourceRate;
+    unsigned int            m_nDataOffset;
+    unsigned int            m_nDataSize;
+    unsigned int            m_nDataRead;
+
+    // resampling state, the source frames are converted to stereo first
+    unsigned int            m_nSampleRate;
+    unsigned int            m_nStep;            // 16.16 source frames per output frame
+    unsigned int            m_nPosition;        // 16.16 position in m_pSourceFrames
+    short*                  m_pSourceFrames;
+    unsigned int            m_nSourceFrames;
+    unsigned char*          m_pReadBuffer;
+    bool                    m_bSourceEnded;
+
+    short*                  m_pRing;
+    volatile unsigned int   m_nRingRead;
+    volatile unsigned int   m_nRingWrite;
+
+    volatile bool           m_bLoop;
+    volatile bool           m_bEnded;           // the decoder wrote the last frame
+    volatile bool           m_bQuit;
+    void*                   m_pThread;
+};
+
+} // end of namespace CocosDenshion
+
+#endif
@@ -0,0 +1,146 @@
+#include "WaveDecoder.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define BREAK_IF(cond)  if (cond) break;
+
+namespace CocosDenshion {
+
+static unsigned int _GetLE32(const unsigned char* pSrc)
+{
+    return pSrc[0] | (pSrc[1] << 8) | (pSrc[2] << 16) | ((unsigned int)pSrc[3] << 24);
+}
+
+static unsigned int _GetLE16(const unsigned char* pSrc)
+{
+    return pSrc[0] | (pSrc[1] << 8);
+}
+
+// one sample of the source as signed 16 bit
+static int _ReadSample(const unsigned char* pData, unsigned int nBits, unsigned int nIndex)
+{
+    if (nBits == 8)
+    {
+        return ((int)pData[nIndex] - 128) << 8;
+    }
+    return (short)_GetLE16(pData + nIndex * 2);
+}
+
+tPcmSound* WaveDecoder::decode(const unsigned char* pData, unsigned int nSize, unsigned int nSampleRate)
+{
+    tPcmSound* pRet = NULL;
+
+    do 
+    {
+        BREAK_IF(! pData || nSize < 12 || ! nSampleRate);
+        BREAK_IF(memcmp(pData, "RIFF", 4) || memcmp(pData + 8, "WAVE", 4));
+
+        unsigned int nChannels  = 0;
+        unsigned int nBits      = 0;
+        unsigned int nRate      = 0;
+        const unsigned char* pSamples = NULL;
+        unsigned int nDataSize  = 0;
+
+        // walk the chunks
+        unsigned int nOffset = 12;
+        while (nOffset + 8 <= nSize)
+        {
+            const unsigned char* pChunk = pData + nOffset;
+            unsigned int nChunkSize = _GetLE32(pChunk + 4);
+            unsigned int nAvailable = nSize - nOffset - 8;
+            if (nChunkSize > nAvailable)
+            {
+                // truncated file, keep what is there
+                nChunkSize = nAvailable;
+            }
+
+            if (! memcmp(pChunk, "fmt ", 4) && nChunkSize >= 16)
+            {
+                BREAK_IF(_GetLE16(pChunk + 8) != 1);    // PCM only
+                nChannels = _GetLE16(pChunk + 10);
+                nRate     = _GetLE32(pChunk + 12);
+                nBits     = _GetLE16(pChunk + 22);
+            }
+            else if (! memcmp(pChunk, "data", 4))
+            {
+                pSamples  = pChunk + 8;
+                nDataSize = nChunkSize;
+            }
+
+            // chunks are word aligned
+            nOffset += 8 + nChunkSize + (nChunkSize & 1);
+        }
+
+        BREAK_IF(! pSamples || ! nRate);
+        BREAK_IF(nChannels != 1 && nChannels != 2);
+        BREAK_IF(nBits != 8 && nBits != 16);
+
+        unsigned int nSrcFrames = nDataSize / (nChannels * nBits / 8);
+        BREAK_IF(! nSrcFrames);
+
+        // resample to the mixer rate, 16.16 fixed point step with linear interpolation
+        unsigned int nFrames = (unsigned int)((double)nSrcFrames * nSampleRate / nRate);
+        BREAK_IF(! nFrames);
+
+        pRet = new tPcmSound;
+        pRet->nFrames  = nFrames;
+        pRet->pSamples = new short[nFrames * 2];
+
+        unsigned int nStep = (unsigned int)(((double)nRate / nSampleRate) * 65536.0);
+        unsigned int nPos  = 0;
+        short* pDst = pRet->pSamples;
+
+        for (unsigned int i = 0; i < nFrames; ++i, nPos += nStep)
+        {
+            unsigned int nFrame = nPos >> 16;
+            unsigned int nNext  = (nFrame + 1 < nSrcFrames) ? nFrame + 1 : nFrame;
+            int nFrac = nPos & 0xffff;
+
+            for (unsigned int c = 0; c < 2; ++c)
+            {
+                // mono goes to both sides
+                unsigned int nChannel = (nChannels == 2) ? c : 0;
+                int a = _ReadSample(pSamples, nBits, nFrame * nChannels + nChannel);
+                int b = _ReadSample(pSamples, nBits, nNext * nChannels + nChannel);
+                pDst[i * 2 + c] = (short)(a + (((b - a) * nFrac) >> 16));
+            }
+        }
+    } while (0);
+
+    return pRet;
+}
+
+tPcmSound* WaveDecoder::decodeFile(const char* pszFilePath, unsigned int nSampleRate)
+{
+    tPcmSound* pRet = NULL;
+    unsigned char* pBuffer = NULL;
+    FILE* pFile = NULL;
+
+    do 
+    {
+        BREAK_IF(! pszFilePath);
+
+        pFile = fopen(pszFilePath, "rb");
+        BREAK_IF(! pFile);
+
+        fseek(pFile, 0, SEEK_END);
+        long nSize = ftell(pFile);
+        fseek(pFile, 0, SEEK_SET);
+        BREAK_IF(nSize <= 0);
+
+        pBuffer = new unsigned char[nSize];
+        BREAK_IF(fread(pBuffer, 1, nSize, pFile) != (size_t)nSize);
+
+        pRet = decode(pBuffer, (unsigned int)nSize, nSampleRate);
+    } while (0);
+
+    if (pFile)
+    {
+        fclose(pFile);
+    }
+    delete [] pBuffer;
+    return pRet;
+}
+
+} // end of namespace CocosDenshion
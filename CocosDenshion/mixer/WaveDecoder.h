@@ -0,0 +1,29 @@
+#ifndef _WAVE_DECODER_H_
+#define _WAVE_DECODER_H_
+
+#include "AudioMixer.h"
+
+namespace CocosDenshion {
+
+/**
+@class WaveDecoder
+@brief Decodes PCM .wav data into the format AudioMixer plays
+*/
+class WaveDecoder
+{
+public:
+    /**
+    @brief Decode 8 or 16 bit, mono or stereo PCM wave data, resampled to nSampleRate
+    @return The sound, or NULL if the data is not a PCM wave
+    */
+    static tPcmSound* decode(const unsigned char* pData, unsigned int nSize, unsigned int nSampleRate);
+
+    /**
+    @brief Read a .wav file and decode it
+    */
+    static tPcmSound* decodeFile(const char* pszFilePath, unsigned int nSampleRate);
+};
+
+} // end of namespace CocosDenshion
+
+#endif
@@ -0,0 +1,123 @@
+/*
+Measures how fast AudioMixer mixes, with no audio device.
+
+Every run starts the mixer on a NullAudioOutput, plays looping voices and lets
+the audio thread mix as fast as it can for a while. The throughput is printed
+as frames per second and as a multiple of real time.
+
+    make && ./MixerBenchmark [seconds per run]
+*/
+
+#include "../AudioMixer.h"
+#include "../AudioOutput.h"
+#include "../AudioThread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <sys/time.h>
+
+using namespace CocosDenshion;
+
+static const unsigned int kSampleRate = 44100;
+
+static double _Now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+// one second of a stereo tone, freed with freePcmSound
+static tPcmSound* _CreateTone(float fFrequency)
+{
+    tPcmSound* pSound = new tPcmSound;
+    pSound->nFrames   = kSampleRate;
+    pSound->pSamples  = new short[kSampleRate * 2];
+
+    for (unsigned int i = 0; i < kSampleRate; ++i)
+    {
+        short nValue = (short)(sin(6.2831853 * fFrequency * i / kSampleRate) * 16000.0);
+        pSound->pSamples[i * 2]     = nValue;
+        pSound->pSamples[i * 2 + 1] = nValue;
+    }
+    return pSound;
+}
+
+static bool _Run(tPcmSound** pSounds, unsigned int nSounds, unsigned int nVoices, float fSeconds)
+{
+    AudioMixer mixer;
+    NullAudioOutput* pOutput = new NullAudioOutput();
+
+    // the mixer owns the output from here
+    if (! mixer.start(kSampleRate, nVoices, pOutput))
+    {
+        printf("the mixer could not be started\n");
+        return false;
+    }
+
+    for (unsigned int i = 0; i < nVoices; ++i)
+    {
+        float fPan = (nVoices > 1) ? (2.0f * i / (nVoices - 1) - 1.0f) : 0.0f;
+        mixer.play(pSounds[i % nSounds], 0.5f, fPan, 0, true);
+    }
+
+    // let the audio thread pick the voices up before measuring
+    while (mixer.getActiveVoices() < nVoices)
+    {
+        sleepAudioThread(1);
+    }
+
+    unsigned long nStartFrames = pOutput->getFramesWritten();
+    double fStart = _Now();
+    sleepAudioThread((unsigned int)(fSeconds * 1000));
+    unsigned long nFrames = pOutput->getFramesWritten() - nStartFrames;
+    double fElapsed = _Now() - fStart;
+
+    mixer.stop();
+
+    double fFramesPerSecond = nFrames / fElapsed;
+    printf("%3u voices: %12.0f frames/s  %8.1fx real time\n",
+        nVoices, fFramesPerSecond, fFramesPerSecond / kSampleRate);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    float fSeconds = (argc > 1) ? (float)atof(argv[1]) : 1.0f;
+    if (fSeconds <= 0.0f)
+    {
+        fSeconds = 1.0f;
+    }
+
+#if defined(__SSE2__)
+    printf("kernel: SSE2\n");
+#elif defined(__ARM_NEON__)
+    printf("kernel: NEON\n");
+#else
+    printf("kernel: scalar\n");
+#endif
+
+    tPcmSound* pSounds[4];
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        pSounds[i] = _CreateTone(220.0f * (i + 1));
+    }
+
+    static const unsigned int s_nVoices[] = { 1, 4, 8, 16, 32, 64 };
+    int nRet = 0;
+    for (unsigned int i = 0; i < sizeof(s_nVoices) / sizeof(s_nVoices[0]); ++i)
+    {
+        if (! _Run(pSounds, 4, s_nVoices[i], fSeconds))
+        {
+            nRet = 1;
+            break;
+        }
+    }
+
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        freePcmSound(pSounds[i]);
+    }
+    return nRet;
+}
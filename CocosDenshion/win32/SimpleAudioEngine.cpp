@@ -1,9 +1,13 @@
 #include "SimpleAudioEngine.h"
 
 #include <map>
+#include <string>
 #include <cstdlib>
 
 #include "MciPlayer.h"
+#include "AudioMixer.h"
+#include "WaveDecoder.h"
+#include "WaveOutAudioOutput.h"
 
 using namespace std;
 
@@ -12,6 +16,23 @@ namespace CocosDenshion {
 typedef map<unsigned int, MciPlayer> EffectList;
 typedef pair<unsigned int, MciPlayer> Effect;
 
+// effects the mixer can decode are kept as PCM, the others fall back to MciPlayer
+typedef map<unsigned int, tPcmSound*> PcmEffectList;
+
+static const unsigned int kMixerSampleRate = 44100;
+
+// the ids of the effects played by the mixer have the high bit set, _Hash() never does
+static const unsigned int kMixerVoiceTag = 0x80000000;
+
+// switching tracks fades the old one out while the new one fades in
+static const float kMusicCrossfadeSeconds = 0.5f;
+
+// .wav music is streamed by the mixer, the other formats are played by MciPlayer
+static MusicStream*     s_pPreloadedMusic = NULL;
+static unsigned int     s_uPreloadedMusicID = 0;
+static string           s_strStreamedMusic;
+static bool             s_bStreamedMusicLoop = false;
+
 static char     s_szRootPath[MAX_PATH];
 static DWORD    s_dwRootLen;
 static char     s_szFullPath[MAX_PATH];
@@ -33,6 +54,52 @@ static MciPlayer& sharedMusic()
     return s_Music;
 }
 
+static PcmEffectList& sharedPcmList()
+{
+    static PcmEffectList s_PcmList;
+    return s_PcmList;
+}
+
+static bool s_bMixerStarted = false;
+static bool s_bMixerFailed  = false;
+
+static AudioMixer* sharedMixer()
+{
+    static AudioMixer s_Mixer;
+
+    if (! s_bMixerStarted && ! s_bMixerFailed)
+    {
+        s_bMixerStarted = s_Mixer.start(kMixerSampleRate, AudioMixer::kDefaultVoices, new WaveOutAudioOutput());
+        s_bMixerFailed  = ! s_bMixerStarted;
+    }
+
+    return (s_bMixerStarted) ? &s_Mixer : NULL;
+}
+
+static MusicStream* _OpenMusicStream(const char* pszFilePath, bool bLoop)
+{
+    if (s_pPreloadedMusic && s_uPreloadedMusicID == _Hash(pszFilePath))
+    {
+        MusicStream* pRet = s_pPreloadedMusic;
+        s_pPreloadedMusic = NULL;
+
+        // a short track may already be decoded to its end, or past its loop point
+        if (pRet->isLoop() == bLoop)
+        {
+            return pRet;
+        }
+        delete pRet;
+    }
+
+    FileStreamSource* pSource = FileStreamSource::openFile(_FullPath(pszFilePath));
+    MusicStream* pRet = MusicStream::create(pSource, kMixerSampleRate, bLoop);
+    if (! pRet)
+    {
+        delete pSource;
+    }
+    return pRet;
+}
+
 SimpleAudioEngine::SimpleAudioEngine()
 {
 }
@@ -51,6 +118,23 @@ void SimpleAudioEngine::end()
 {
     sharedMusic().Close();
     sharedList().clear();
+
+    delete s_pPreloadedMusic;
+    s_pPreloadedMusic = NULL;
+    s_strStreamedMusic.clear();
+
+    if (s_bMixerStarted)
+    {
+        sharedMixer()->stop();
+        s_bMixerStarted = false;
+    }
+
+    PcmEffectList::iterator it;
+    for (it = sharedPcmList().begin(); it != sharedPcmList().end(); ++it)
+    {
+        freePcmSound(it->second);
+    }
+    sharedPcmList().clear();
     return;
 }
 
@@ -69,12 +153,42 @@ void SimpleAudioEngine::playBackgroundMusic(const char* pszFilePath, bool bLoop)
         return;
     }
 
+    MusicStream* pStream = (sharedMixer()) ? _OpenMusicStream(pszFilePath, bLoop) : NULL;
+    if (pStream)
+    {
+        sharedMusic().Close();
+
+        float fFade = (sharedMixer()->isMusicPlaying()) ? kMusicCrossfadeSeconds : 0.0f;
+        sharedMixer()->playMusic(pStream, fFade);
+        s_strStreamedMusic   = pszFilePath;
+        s_bStreamedMusicLoop = bLoop;
+        return;
+    }
+
+    if (s_bMixerStarted)
+    {
+        sharedMixer()->stopMusic();
+    }
+    s_strStreamedMusic.clear();
+
     sharedMusic().Open(_FullPath(pszFilePath), _Hash(pszFilePath));
     sharedMusic().Play((bLoop) ? -1 : 1);
 }
 
 void SimpleAudioEngine::stopBackgroundMusic(bool bReleaseData)
 {
+    if (s_bMixerStarted)
+    {
+        sharedMixer()->stopMusic();
+    }
+
+    if (bReleaseData)
+    {
+        delete s_pPreloadedMusic;
+        s_pPreloadedMusic = NULL;
+        s_strStreamedMusic.clear();
+    }
+
     if (bReleaseData)
     {
         sharedMusic().Close();
@@ -87,16 +201,35 @@ void SimpleAudioEngine::stopBackgroundMusic(bool bReleaseData)
 
 void SimpleAudioEngine::pauseBackgroundMusic()
 {
+    if (s_bMixerStarted)
+    {
+        sharedMixer()->pauseMusic();
+    }
     sharedMusic().Pause();
 }
 
 void SimpleAudioEngine::resumeBackgroundMusic()
 {
+    if (s_bMixerStarted)
+    {
+        sharedMixer()->resumeMusic();
+    }
     sharedMusic().Resume();
 }
 
 void SimpleAudioEngine::rewindBackgroundMusic()
 {
+    if (s_bMixerStarted && ! s_strStreamedMusic.empty())
+    {
+        // restart on a new stream, the old one is cut
+        MusicStream* pStream = _OpenMusicStream(s_strStreamedMusic.c_str(), s_bStreamedMusicLoop);
+        if (pStream)
+        {
+            sharedMixer()->playMusic(pStream);
+        }
+        return;
+    }
+
     sharedMusic().Rewind();
 }
 
@@ -107,6 +240,10 @@ bool SimpleAudioEngine::willPlayBackgroundMusic()
 
 bool SimpleAudioEngine::isBackgroundMusicPlaying()
 {
+    if (s_bMixerStarted && sharedMixer()->isMusicPlaying())
+    {
+        return true;
+    }
     return sharedMusic().IsPlaying();
 }
 
@@ -120,6 +257,13 @@ unsigned int SimpleAudioEngine::playEffect(const char* pszFilePath)
 
     preloadEffect(pszFilePath);
 
+    PcmEffectList::iterator it = sharedPcmList().find(nRet);
+    if (it != sharedPcmList().end())
+    {
+        unsigned int nVoiceId = sharedMixer()->play(it->second);
+        return (nVoiceId) ? (nVoiceId | kMixerVoiceTag) : 0;
+    }
+
     EffectList::iterator p = sharedList().find(nRet);
     if (p != sharedList().end())
     {
@@ -131,6 +275,15 @@ unsigned int SimpleAudioEngine::playEffect(const char* pszFilePath)
 
 void SimpleAudioEngine::stopEffect(unsigned int nSoundId)
 {
+    if (nSoundId & kMixerVoiceTag)
+    {
+        if (s_bMixerStarted)
+        {
+            sharedMixer()->stopVoice(nSoundId & ~kMixerVoiceTag);
+        }
+        return;
+    }
+
     EffectList::iterator p = sharedList().find(nSoundId);
     if (p != sharedList().end())
     {
@@ -148,6 +301,17 @@ void SimpleAudioEngine::preloadEffect(const char* pszFilePath)
         nRet = _Hash(pszFilePath);
 
         BREAK_IF(sharedList().end() != sharedList().find(nRet));
+        BREAK_IF(sharedPcmList().end() != sharedPcmList().find(nRet));
+
+        if (sharedMixer())
+        {
+            tPcmSound* pSound = WaveDecoder::decodeFile(_FullPath(pszFilePath), kMixerSampleRate);
+            if (pSound)
+            {
+                sharedPcmList()[nRet] = pSound;
+                break;
+            }
+        }
 
         sharedList().insert(Effect(nRet, MciPlayer()));
         MciPlayer& player = sharedList()[nRet];
@@ -162,13 +326,31 @@ void SimpleAudioEngine::preloadEffect(const char* pszFilePath)
 
 void SimpleAudioEngine::preloadBackgroundMusic(const char* pszFilePath)
 {
+    if (! pszFilePath || ! sharedMixer())
+    {
+        return;
+    }
 
+    // only the header and the first chunks are decoded, whatever the length of the music.
+    // Background music usually loops, playing it once reopens the stream
+    delete s_pPreloadedMusic;
+    s_pPreloadedMusic   = NULL;
+    s_pPreloadedMusic   = _OpenMusicStream(pszFilePath, true);
+    s_uPreloadedMusicID = _Hash(pszFilePath);
 }
 
 void SimpleAudioEngine::unloadEffect(const char* pszFilePath)
 {
     unsigned int nID = _Hash(pszFilePath);
     sharedList().erase(nID);
+
+    PcmEffectList::iterator it = sharedPcmList().find(nID);
+    if (it != sharedPcmList().end())
+    {
+        // freed by the audio thread once no voice plays it
+        sharedMixer()->unloadSound(it->second);
+        sharedPcmList().erase(it);
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -177,20 +359,28 @@ void SimpleAudioEngine::unloadEffect(const char* pszFilePath)
 
 float SimpleAudioEngine::getBackgroundMusicVolume()
 {
-    return 1.0;
+    return (s_bMixerStarted) ? sharedMixer()->getMusicVolume() : 1.0f;
 }
 
 void SimpleAudioEngine::setBackgroundMusicVolume(float volume)
 {
+    if (sharedMixer())
+    {
+        sharedMixer()->setMusicVolume(volume);
+    }
 }
 
 float SimpleAudioEngine::getEffectsVolume()
 {
-    return 1.0;
+    return (s_bMixerStarted) ? sharedMixer()->getMasterVolume() : 1.0f;
 }
 
 void SimpleAudioEngine::setEffectsVolume(float volume)
 {
+    if (sharedMixer())
+    {
+        sharedMixer()->setMasterVolume(volume);
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -236,7 +426,7 @@ unsigned int _Hash(const char *key)
         hash *= 16777619;
         hash ^= (unsigned int) (unsigned char) toupper(*key);
     }
-    return (hash);
+    return (hash & ~kMixerVoiceTag);
 }
 
 } // end of namespace CocosDenshion
@@ -0,0 +1,113 @@
+#include "WaveOutAudioOutput.h"
+
+#include <string.h>
+
+namespace CocosDenshion {
+
+WaveOutAudioOutput::WaveOutAudioOutput()
+: m_hWaveOut(NULL)
+, m_hEvent(NULL)
+, m_nNext(0)
+{
+    memset(m_Headers, 0, sizeof(m_Headers));
+    memset(m_pBuffers, 0, sizeof(m_pBuffers));
+}
+
+WaveOutAudioOutput::~WaveOutAudioOutput()
+{
+    close();
+}
+
+bool WaveOutAudioOutput::open(unsigned int nSampleRate)
+{
+    close();
+
+    WAVEFORMATEX format;
+    memset(&format, 0, sizeof(format));
+    format.wFormatTag       = WAVE_FORMAT_PCM;
+    format.nChannels        = 2;
+    format.nSamplesPerSec   = nSampleRate;
+    format.wBitsPerSample   = 16;
+    format.nBlockAlign      = 4;
+    format.nAvgBytesPerSec  = nSampleRate * 4;
+
+    m_hEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (! m_hEvent)
+    {
+        return false;
+    }
+
+    if (MMSYSERR_NOERROR != waveOutOpen(&m_hWaveOut, WAVE_MAPPER, &format, (DWORD_PTR)m_hEvent, 0, CALLBACK_EVENT))
+    {
+        m_hWaveOut = NULL;
+        close();
+        return false;
+    }
+
+    for (int i = 0; i < kBufferCount; ++i)
+    {
+        m_pBuffers[i] = new short[kBufferFrames * 2];
+        m_Headers[i].lpData         = (LPSTR)m_pBuffers[i];
+        m_Headers[i].dwBufferLength = kBufferFrames * 4;
+        m_Headers[i].dwFlags        = 0;
+        waveOutPrepareHeader(m_hWaveOut, &m_Headers[i], sizeof(WAVEHDR));
+
+        // mark it free
+        m_Headers[i].dwFlags |= WHDR_DONE;
+    }
+    m_nNext = 0;
+    return true;
+}
+
+void WaveOutAudioOutput::close()
+{
+    if (m_hWaveOut)
+    {
+        waveOutReset(m_hWaveOut);
+        for (int i = 0; i < kBufferCount; ++i)
+        {
+            waveOutUnprepareHeader(m_hWaveOut, &m_Headers[i], sizeof(WAVEHDR));
+        }
+        waveOutClose(m_hWaveOut);
+        m_hWaveOut = NULL;
+    }
+
+    for (int i = 0; i < kBufferCount; ++i)
+    {
+        delete [] m_pBuffers[i];
+        m_pBuffers[i] = NULL;
+    }
+    memset(m_Headers, 0, sizeof(m_Headers));
+
+    if (m_hEvent)
+    {
+        CloseHandle(m_hEvent);
+        m_hEvent = NULL;
+    }
+}
+
+void WaveOutAudioOutput::write(const short* pSamples, unsigned int nFrames)
+{
+    while (m_hWaveOut && nFrames)
+    {
+        WAVEHDR& header = m_Headers[m_nNext];
+
+        // the buffers are played in order, wait for the oldest one to come back
+        while (! (header.dwFlags & WHDR_DONE))
+        {
+            WaitForSingleObject(m_hEvent, INFINITE);
+        }
+
+        unsigned int nCount = (nFrames > kBufferFrames) ? (unsigned int)kBufferFrames : nFrames;
+        memcpy(m_pBuffers[m_nNext], pSamples, nCount * 4);
+        header.dwBufferLength = nCount * 4;
+        header.dwFlags &= ~WHDR_DONE;
+        waveOutWrite(m_hWaveOut, &header, sizeof(WAVEHDR));
+
+        m_nNext  = (m_nNext + 1) % kBufferCount;
+        pSamples += nCount * 2;
+        nFrames  -= nCount;
+    }
+}
+
+} // end of namespace CocosDenshion
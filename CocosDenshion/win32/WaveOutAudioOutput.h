@@ -0,0 +1,41 @@
+#ifndef _WAVE_OUT_AUDIO_OUTPUT_H_
+#define _WAVE_OUT_AUDIO_OUTPUT_H_
+
+#include <windows.h>
+#include <mmsystem.h>
+
+#include "AudioOutput.h"
+
+namespace CocosDenshion {
+
+/**
+@class WaveOutAudioOutput
+@brief Plays the mixed samples through the waveOut device, a few buffers ahead
+*/
+class WaveOutAudioOutput : public AudioOutput
+{
+public:
+    WaveOutAudioOutput();
+    virtual ~WaveOutAudioOutput();
+
+    virtual bool open(unsigned int nSampleRate);
+    virtual void close();
+    virtual void write(const short* pSamples, unsigned int nFrames);
+
+private:
+    enum
+    {
+        kBufferCount    = 4,
+        kBufferFrames   = 512,
+    };
+
+    HWAVEOUT    m_hWaveOut;
+    HANDLE      m_hEvent;
+    WAVEHDR     m_Headers[kBufferCount];
+    short*      m_pBuffers[kBufferCount];
+    int         m_nNext;
+};
+
+} // end of namespace CocosDenshion
+
+#endif
@@ -26,6 +26,7 @@ src/cpHashSet.c \
 src/cpPolyShape.c \
 src/cpShape.c \
 src/cpSpace.c \
+src/cpSpaceComponent.c \
 src/cpSpaceHash.c \
 src/cpVect.c
 
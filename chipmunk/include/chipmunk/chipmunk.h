@@ -22,6 +22,8 @@
 #ifndef CHIPMUNK_HEADER
 #define CHIPMUNK_HEADER
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
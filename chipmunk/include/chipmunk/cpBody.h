@@ -20,11 +20,29 @@
  */
 
 struct cpBody;
+struct cpShape;
+struct cpSpace;
+
 typedef void (*cpBodyVelocityFunc)(struct cpBody *body, cpVect gravity, cpFloat damping, cpFloat dt);
 typedef void (*cpBodyPositionFunc)(struct cpBody *body, cpFloat dt);
 
 extern cpBodyVelocityFunc cpBodyUpdateVelocityDefault;
 extern cpBodyPositionFunc cpBodyUpdatePositionDefault;
+
+// Used internally to track the contact graph islands (components) for sleeping.
+typedef struct cpComponentNode {
+	// Union-find parent while the space builds islands. NULL otherwise.
+	struct cpBody *parent;
+	// Next body in the same island. The island root is the head of the list.
+	struct cpBody *next;
+	// Root body of the sleeping island this body belongs to. NULL while awake.
+	struct cpBody *root;
+	// Union-find rank.
+	int rank;
+	
+	// How long the body has been moving slower than the space's idle threshold.
+	cpFloat idleTime;
+} cpComponentNode;
  
 typedef struct cpBody{
 	// *** Integration Functions.ntoehu
@@ -72,7 +90,14 @@ typedef struct cpBody{
 	cpVect v_bias;
 	cpFloat w_bias;
 	
-//	int active;
+	// Space the body was added to. NULL for rogue and static bodies.
+	struct cpSpace *space;
+	
+	// Singly linked list of shapes added to a space with cpSpaceAddShape().
+	struct cpShape *shapesList;
+	
+	// Island bookkeeping for sleeping.
+	cpComponentNode node;
 } cpBody;
 
 // Basic allocation/destruction functions
@@ -132,10 +157,44 @@ cpBodyWorld2Local(cpBody *body, cpVect v)
 	return cpvunrotate(cpvsub(v, body->p), body->rot);
 }
 
+// Rogue bodies are not added to a space. Static bodies are rogue bodies that are not moving.
+static inline int
+cpBodyIsRogue(cpBody *body)
+{
+	return (body->space == NULL);
+}
+
+static inline int
+cpBodyIsSleeping(cpBody *body)
+{
+	return (body->node.root != NULL);
+}
+
+// Wake up a sleeping body and every other body in its island.
+// Call this after changing the position or velocity of a sleeping body by hand.
+void cpBodyActivate(cpBody *body);
+
+// Force a body to fall asleep immediately, alone in its own island.
+// It will wake up as soon as an active body touches it.
+// Cannot be called from a collision callback.
+void cpBodySleep(cpBody *body);
+
+static inline cpFloat
+cpBodyKineticEnergy(cpBody *body)
+{
+	// Need to do some fudging to avoid NaNs
+	cpFloat vsq = cpvdot(body->v, body->v);
+	cpFloat wsq = body->w*body->w;
+	return (vsq ? vsq*body->m : 0.0f) + (wsq ? wsq*body->i : 0.0f);
+}
+
 // Apply an impulse (in world coordinates) to the body at a point relative to the center of gravity (also in world coordinates).
+// Wakes the body up if it was sleeping.
 static inline void
 cpBodyApplyImpulse(cpBody *body, cpVect j, cpVect r)
 {
+	if(cpBodyIsSleeping(body)) cpBodyActivate(body);
+	
 	body->v = cpvadd(body->v, cpvmult(j, body->m_inv));
 	body->w += body->i_inv*cpvcross(r, j);
 }
@@ -151,10 +210,9 @@ cpBodyApplyBiasImpulse(cpBody *body, cpVect j, cpVect r)
 // Zero the forces on a body.
 void cpBodyResetForces(cpBody *body);
 // Apply a force (in world coordinates) to a body at a point relative to the center of gravity (also in world coordinates).
+// Wakes the body up if it was sleeping.
 void cpBodyApplyForce(cpBody *body, cpVect f, cpVect r);
 
 // Apply a damped spring force between two bodies.
 // Warning: Large damping values can be unstable. Use a cpDampedSpring constraint for this instead.
 void cpApplyDampedSpring(cpBody *a, cpBody *b, cpVect anchr1, cpVect anchr2, cpFloat rlen, cpFloat k, cpFloat dmp, cpFloat dt);
-
-//int cpBodyMarkLowEnergy(cpBody *body, cpFloat dvsq, int max);
@@ -92,6 +92,9 @@ typedef struct cpShape{
 	
 	// Unique id used as the hash value.
 	cpHashValue hashid;
+	
+	// Next shape in the body's shape list.
+	struct cpShape *next;
 } cpShape;
 
 // Low level shape initialization func.
@@ -64,6 +64,14 @@ typedef struct cpSpace{
 	// Default damping to supply when integrating rigid body motions.
 	cpFloat damping;
 	
+	// Speed threshold for a body to be considered idle.
+	// The default value of 0 means to let the space guess a good threshold based on gravity.
+	cpFloat idleSpeedThreshold;
+	
+	// Time a group of bodies must remain idle in order to fall asleep.
+	// The default value of INFINITY disables the sleeping algorithm.
+	cpFloat sleepTimeThreshold;
+	
 	// *** Internally Used Fields
 	
 	// When the space is locked, you should not add or remove objects;
@@ -76,9 +84,12 @@ typedef struct cpSpace{
 	cpSpaceHash *staticShapes;
 	cpSpaceHash *activeShapes;
 	
-	// List of bodies in the system.
+	// List of awake bodies in the system.
 	cpArray *bodies;
 	
+	// Root bodies of the sleeping islands. Their shapes are kept in the static hash.
+	cpArray *sleepingComponents;
+	
 	// List of active arbiters for the impulse solver.
 	cpArray *arbiters, *pooledArbiters;
 	
@@ -96,6 +107,9 @@ typedef struct cpSpace{
 	// List of constraints in the system.
 	cpArray *constraints;
 	
+	// Constraints that are solved this step. (not attached to sleeping bodies)
+	cpArray *activeConstraints;
+	
 	// Set of collisionpair functions.
 	cpHashSet *collFuncSet;
 	// Default collision handler.
@@ -167,10 +181,15 @@ typedef void (*cpSpaceBBQueryFunc)(cpShape *shape, void *data);
 void cpSpaceBBQuery(cpSpace *space, cpBB bb, cpLayers layers, cpGroup group, cpSpaceBBQueryFunc func, void *data);
 
 
-// Iterator function for iterating the bodies in a space.
+// Iterator function for iterating the bodies in a space. (awake and sleeping)
 typedef void (*cpSpaceBodyIterator)(cpBody *body, void *data);
 void cpSpaceEachBody(cpSpace *space, cpSpaceBodyIterator func, void *data);
 
+// Sleeping functions, used internally by cpSpaceStep(). (cpSpaceComponent.c)
+void cpSpaceProcessComponents(cpSpace *space, cpFloat dt);
+void cpSpaceActivateBody(cpSpace *space, cpBody *body);
+void cpSpaceCollideShape(cpSpace *space, cpShape *shape);
+
 // Spatial hash management functions.
 void cpSpaceResizeStaticHash(cpSpace *space, cpFloat dim, int count);
 void cpSpaceResizeActiveHash(cpSpace *space, cpFloat dim, int count);
@@ -56,7 +56,15 @@ cpBodyInit(cpBody *body, cpFloat m, cpFloat i)
 	body->data = NULL;
 	body->v_limit = (cpFloat)INFINITY;
 	body->w_limit = (cpFloat)INFINITY;
-//	body->active = 1;
+	
+	body->space = NULL;
+	body->shapesList = NULL;
+	
+	body->node.parent = NULL;
+	body->node.next = NULL;
+	body->node.root = NULL;
+	body->node.rank = 0;
+	body->node.idleTime = 0.0f;
 
 	return body;
 }
@@ -135,6 +143,8 @@ cpBodyResetForces(cpBody *body)
 void
 cpBodyApplyForce(cpBody *body, cpVect force, cpVect r)
 {
+	if(cpBodyIsSleeping(body)) cpBodyActivate(body);
+	
 	body->f = cpvadd(body->f, force);
 	body->t += cpvcross(r, force);
 }
@@ -167,22 +177,3 @@ cpApplyDampedSpring(cpBody *a, cpBody *b, cpVect anchr1, cpVect anchr2, cpFloat
 	cpBodyApplyForce(b, cpvneg(f), r2);
 }
 
-//int
-//cpBodyMarkLowEnergy(cpBody *body, cpFloat dvsq, int max)
-//{
-//	cpFloat ke = body->m*cpvdot(body->v, body->v);
-//	cpFloat re = body->i*body->w*body->w;
-//	
-//	if(ke + re > body->m*dvsq)
-//		body->active = 1;
-//	else if(body->active)
-//		body->active = (body->active + 1)%(max + 1);
-//	else {
-//		body->v = cpvzero;
-//		body->v_bias = cpvzero;
-//		body->w = 0.0f;
-//		body->w_bias = 0.0f;
-//	}
-//	
-//	return body->active;
-//}
@@ -160,11 +160,13 @@ cpSpaceInit(cpSpace *space)
 {
 	space->iterations = DEFAULT_ITERATIONS;
 	space->elasticIterations = DEFAULT_ELASTIC_ITERATIONS;
-//	space->sleepTicks = 300;
 	
 	space->gravity = cpvzero;
 	space->damping = 1.0f;
 	
+	space->idleSpeedThreshold = 0.0f;
+	space->sleepTimeThreshold = (cpFloat)INFINITY;
+	
 	space->locked = 0;
 	space->stamp = 0;
 
@@ -174,6 +176,7 @@ cpSpaceInit(cpSpace *space)
 	space->allocatedBuffers = cpArrayNew(0);
 	
 	space->bodies = cpArrayNew(0);
+	space->sleepingComponents = cpArrayNew(0);
 	space->arbiters = cpArrayNew(0);
 	space->pooledArbiters = cpArrayNew(0);
 	
@@ -185,6 +188,7 @@ cpSpaceInit(cpSpace *space)
 	space->contactSet = cpHashSetNew(0, (cpHashSetEqlFunc)contactSetEql, (cpHashSetTransFunc)contactSetTrans);
 	
 	space->constraints = cpArrayNew(0);
+	space->activeConstraints = cpArrayNew(0);
 	
 	space->defaultHandler = defaultHandler;
 	space->collFuncSet = cpHashSetNew(0, (cpHashSetEqlFunc)collFuncSetEql, (cpHashSetTransFunc)collFuncSetTrans);
@@ -208,8 +212,10 @@ cpSpaceDestroy(cpSpace *space)
 	cpSpaceHashFree(space->activeShapes);
 	
 	cpArrayFree(space->bodies);
+	cpArrayFree(space->sleepingComponents);
 	
 	cpArrayFree(space->constraints);
+	cpArrayFree(space->activeConstraints);
 	
 	cpHashSetFree(space->contactSet);
 	
@@ -246,7 +252,7 @@ cpSpaceFreeChildren(cpSpace *space)
 {
 	cpSpaceHashEach(space->staticShapes, (cpSpaceHashIterator)&shapeFreeWrap, NULL);
 	cpSpaceHashEach(space->activeShapes, (cpSpaceHashIterator)&shapeFreeWrap, NULL);
-	cpArrayEach(space->bodies,           (cpArrayIter)&bodyFreeWrap,          NULL);
+	cpSpaceEachBody(space,               (cpSpaceBodyIterator)&bodyFreeWrap,  NULL);
 	cpArrayEach(space->constraints,      (cpArrayIter)&constraintFreeWrap,    NULL);
 }
 
@@ -322,6 +328,12 @@ cpSpaceAddShape(cpSpace *space, cpShape *shape)
 		"Cannot add the same shape more than once.");
 	cpAssertSpaceUnlocked(space);
 	
+	cpBody *body = shape->body;
+	if(cpBodyIsSleeping(body)) cpSpaceActivateBody(space, body);
+	
+	shape->next = body->shapesList;
+	body->shapesList = shape;
+	
 	cpSpaceHashInsert(space->activeShapes, shape, shape->hashid, shape->bb);
 	return shape;
 }
@@ -343,10 +355,11 @@ cpSpaceAddStaticShape(cpSpace *space, cpShape *shape)
 cpBody *
 cpSpaceAddBody(cpSpace *space, cpBody *body)
 {
-	cpAssert(!cpArrayContains(space->bodies, body), "Cannot add the same body more than once.");
+	cpAssert(!body->space, "Cannot add the same body more than once.");
 //	cpAssertSpaceUnlocked(space); This should be safe as long as it's not from an integration callback
 	
 	cpArrayPush(space->bodies, body);
+	body->space = space;
 	
 	return body;
 }
@@ -359,6 +372,10 @@ cpSpaceAddConstraint(cpSpace *space, cpConstraint *constraint)
 	
 	cpArrayPush(space->constraints, constraint);
 	
+	// The bodies now belong to the same island.
+	cpBodyActivate(constraint->a);
+	cpBodyActivate(constraint->b);
+	
 	return constraint;
 }
 
@@ -372,6 +389,10 @@ static int
 contactSetFilterRemovedShape(cpArbiter *arb, removalContext *context)
 {
 	if(context->shape == arb->private_a || context->shape == arb->private_b){
+		// Wake up anything that was resting on the removed shape.
+		cpSpaceActivateBody(context->space, arb->private_a->body);
+		cpSpaceActivateBody(context->space, arb->private_b->body);
+		
 		arb->handler->separate(arb, context->space, arb->handler->data);
 		cpArrayPush(context->space->pooledArbiters, arb);
 		return 0;
@@ -383,10 +404,22 @@ contactSetFilterRemovedShape(cpArbiter *arb, removalContext *context)
 void
 cpSpaceRemoveShape(cpSpace *space, cpShape *shape)
 {
+	cpBody *body = shape->body;
+	if(cpBodyIsSleeping(body)) cpSpaceActivateBody(space, body);
+	
 	cpAssertWarn(cpHashSetFind(space->activeShapes->handleSet, shape->hashid, shape),
 		"Cannot remove a shape that was never added to the space. (Removed twice maybe?)");
 	cpAssertSpaceUnlocked(space);
 	
+	// Unlink the shape from the body's shape list.
+	for(cpShape **prev_ptr = &body->shapesList; *prev_ptr; prev_ptr = &(*prev_ptr)->next){
+		if(*prev_ptr == shape){
+			*prev_ptr = shape->next;
+			break;
+		}
+	}
+	shape->next = NULL;
+	
 	removalContext context = {space, shape};
 	cpHashSetFilter(space->contactSet, (cpHashSetFilterFunc)contactSetFilterRemovedShape, &context);
 	cpSpaceHashRemove(space->activeShapes, shape, shape->hashid);
@@ -407,11 +440,14 @@ cpSpaceRemoveStaticShape(cpSpace *space, cpShape *shape)
 void
 cpSpaceRemoveBody(cpSpace *space, cpBody *body)
 {
-	cpAssertWarn(cpArrayContains(space->bodies, body),
+	cpAssertWarn(body->space == space,
 		"Cannot remove a body that was never added to the space. (Removed twice maybe?)");
 	cpAssertSpaceUnlocked(space);
 	
+	if(cpBodyIsSleeping(body)) cpSpaceActivateBody(space, body);
+	
 	cpArrayDeleteObj(space->bodies, body);
+	body->space = NULL;
 }
 
 void
@@ -422,6 +458,10 @@ cpSpaceRemoveConstraint(cpSpace *space, cpConstraint *constraint)
 //	cpAssertSpaceUnlocked(space); Should be safe as long as its not from a constraint callback.
 	
 	cpArrayDeleteObj(space->constraints, constraint);
+	
+	// Nothing may hold the bodies up anymore.
+	cpBodyActivate(constraint->a);
+	cpBodyActivate(constraint->b);
 }
 
 #pragma mark Post Step Functions
@@ -496,6 +536,18 @@ cpSpaceEachBody(cpSpace *space, cpSpaceBodyIterator func, void *data)
 	
 	for(int i=0; i<bodies->num; i++)
 		func((cpBody *)bodies->arr[i], data);
+	
+	cpArray *components = space->sleepingComponents;
+	for(int i=0; i<components->num; i++){
+		cpBody *body = (cpBody *)components->arr[i];
+		
+		while(body){
+			// Grab the next body first in case func() frees the current one.
+			cpBody *next = body->node.next;
+			func(body, data);
+			body = next;
+		}
+	}
 }
 
 #pragma mark Segment Query Functions
@@ -764,10 +816,46 @@ active2staticIter(cpShape *shape, cpSpace *space)
 	cpSpaceHashQuery(space->staticShapes, shape, shape->bb, (cpSpaceHashQueryFunc)queryFunc, space);
 }
 
+// Query func for the shapes of an island woken in the middle of a step.
+// Skips the pairs that were already collided during this step.
+static void
+wokenQueryFunc(cpShape *a, cpShape *b, cpSpace *space)
+{
+	cpShape *shape_pair[] = {a, b};
+	cpArbiter *arb = (cpArbiter *)cpHashSetFind(space->contactSet, CP_HASH_PAIR((size_t)a, (size_t)b), shape_pair);
+	if(arb && arb->stamp == space->stamp) return;
+	
+	queryFunc(a, b, space);
+}
+
+// Collide a shape that was moved to the active hash after the collision pass of the step.
+// The cached arbiters of its pairs are updated and added to space->arbiters again.
+void
+cpSpaceCollideShape(cpSpace *space, cpShape *shape)
+{
+	cpSpaceHashQuery(space->activeShapes, shape, shape->bb, (cpSpaceHashQueryFunc)wokenQueryFunc, space);
+	cpSpaceHashQuery(space->staticShapes, shape, shape->bb, (cpSpaceHashQueryFunc)wokenQueryFunc, space);
+}
+
 // Hashset filter func to throw away old arbiters.
 static int
 contactSetFilter(cpArbiter *arb, cpSpace *space)
 {
+	cpBody *a = arb->private_a->body, *b = arb->private_b->body;
+	
+	// Preserve arbiters of sleeping bodies, they are still touching.
+	// Their contacts point into recycled contact buffers so they must be dropped.
+	if(
+		(cpBodyIsSleeping(a) || cpBodyIsSleeping(b)) &&
+		(cpBodyIsRogue(a) || cpBodyIsSleeping(a)) &&
+		(cpBodyIsRogue(b) || cpBodyIsSleeping(b))
+	){
+		arb->stamp = space->stamp;
+		arb->contacts = NULL;
+		arb->numContacts = 0;
+		return 1;
+	}
+	
 	int ticks = space->stamp - arb->stamp;
 	
 	// was used last frame, but not this one
@@ -825,6 +913,12 @@ cpSpaceStep(cpSpace *space, cpFloat dt)
 	cpSpaceHashEach(space->activeShapes, (cpSpaceHashIterator)active2staticIter, space);
 	cpSpaceHashQueryRehash(space->activeShapes, (cpSpaceHashQueryFunc)queryFunc, space);
 	
+	// Wake up or put islands to sleep. Rebuilds the body, arbiter and constraint lists.
+	if(space->sleepTimeThreshold != INFINITY){
+		cpSpaceProcessComponents(space, dt);
+		constraints = space->activeConstraints;
+	}
+	
 	// Clear out old cached arbiters and dispatch untouch functions
 	cpHashSetFilter(space->contactSet, (cpHashSetFilterFunc)contactSetFilter, space);
 
@@ -889,11 +983,6 @@ cpSpaceStep(cpSpace *space, cpFloat dt)
 	// Use filter as an easy way to clear out the queue as it runs
 	cpHashSetFilter(space->postStepCallbacks, (cpHashSetFilterFunc)postStepCallbackSetFilter, space);
 	
-//	cpFloat dvsq = cpvdot(space->gravity, space->gravity);
-//	dvsq *= dt*dt * space->damping*space->damping;
-//	for(int i=0; i<bodies->num; i++)
-//		cpBodyMarkLowEnergy(bodies->arr[i], dvsq, space->sleepTicks);
-	
 	// Increment the stamp.
 	space->stamp++;
 }
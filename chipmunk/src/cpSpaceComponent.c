@@ -0,0 +1,291 @@
+/* Copyright (c) 2007 Scott Lembcke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "chipmunk.h"
+
+// Bodies touching each other through arbiters or constraints form islands (components).
+// Once every body in an island has been idle for longer than space->sleepTimeThreshold,
+// the island is put to sleep: its bodies are dropped from space->bodies and its shapes are
+// moved from the active hash into the static hash. Sleeping bodies are not integrated,
+// rehashed or solved, but active shapes still collide against them, which wakes them up.
+
+#pragma mark Union-Find Helpers
+
+static cpBody *
+componentNodeRoot(cpBody *body)
+{
+	cpBody *parent = body->node.parent;
+
+	if(parent){
+		// path compression
+		return (body->node.parent = componentNodeRoot(parent));
+	} else {
+		return body;
+	}
+}
+
+static void
+componentNodeMerge(cpBody *a_root, cpBody *b_root)
+{
+	if(a_root == b_root) return;
+
+	if(a_root->node.rank < b_root->node.rank){
+		a_root->node.parent = b_root;
+	} else if(a_root->node.rank > b_root->node.rank){
+		b_root->node.parent = a_root;
+	} else {
+		b_root->node.parent = a_root;
+		a_root->node.rank++;
+	}
+}
+
+#pragma mark Activation Functions
+
+static void
+cpSpaceActivateComponent(cpSpace *space, cpBody *root)
+{
+	cpArrayDeleteObj(space->sleepingComponents, root);
+
+	cpBody *body = root;
+	while(body){
+		cpBody *next = body->node.next;
+
+		body->node.parent = NULL;
+		body->node.next = NULL;
+		body->node.root = NULL;
+		body->node.rank = 0;
+		body->node.idleTime = 0.0f;
+
+		cpArrayPush(space->bodies, body);
+
+		for(cpShape *shape = body->shapesList; shape; shape = shape->next){
+			cpSpaceHashRemove(space->staticShapes, shape, shape->hashid);
+			cpSpaceHashInsert(space->activeShapes, shape, shape->hashid, shape->bb);
+		}
+
+		// Woken during a step, after the collision pass. Without their arbiters
+		// the bodies would fall through each other for this step.
+		if(space->locked){
+			for(cpShape *shape = body->shapesList; shape; shape = shape->next){
+				cpSpaceCollideShape(space, shape);
+			}
+		}
+
+		body = next;
+	}
+}
+
+static void
+cpSpaceDeactivateComponent(cpSpace *space, cpBody *root)
+{
+	for(cpBody *body = root; body; body = body->node.next){
+		body->node.parent = NULL;
+		body->node.root = root;
+
+		for(cpShape *shape = body->shapesList; shape; shape = shape->next){
+			cpSpaceHashRemove(space->activeShapes, shape, shape->hashid);
+			cpSpaceHashInsert(space->staticShapes, shape, shape->hashid, shape->bb);
+		}
+	}
+
+	cpArrayPush(space->sleepingComponents, root);
+}
+
+void
+cpSpaceActivateBody(cpSpace *space, cpBody *body)
+{
+	if(cpBodyIsSleeping(body)) cpSpaceActivateComponent(space, body->node.root);
+}
+
+// Post step callback used to wake bodies from inside a collision callback.
+static void
+activateBodyPostStep(cpSpace *space, cpBody *body, void *unused)
+{
+	cpSpaceActivateBody(space, body);
+}
+
+void
+cpBodyActivate(cpBody *body)
+{
+	if(!cpBodyIsSleeping(body)) return;
+
+	cpSpace *space = body->space;
+	if(space->locked){
+		// The spatial hashes can't be modified in the middle of a step.
+		cpSpaceAddPostStepCallback(space, (cpPostStepFunc)activateBodyPostStep, body->node.root, NULL);
+	} else {
+		cpSpaceActivateBody(space, body);
+	}
+}
+
+void
+cpBodySleep(cpBody *body)
+{
+	cpSpace *space = body->space;
+	cpAssert(space, "Cannot put a rogue body to sleep.");
+	cpAssert(!space->locked, "Bodies cannot be put to sleep from a collision callback.");
+
+	if(cpBodyIsSleeping(body)) return;
+
+	cpArrayDeleteObj(space->bodies, body);
+
+	body->node.next = NULL;
+	body->node.rank = 0;
+	cpSpaceDeactivateComponent(space, body);
+}
+
+#pragma mark Island Processing
+
+// Join the islands of two bodies connected by an arbiter or constraint.
+static void
+mergeBodies(cpSpace *space, cpBody *a, cpBody *b)
+{
+	if(cpBodyIsRogue(a)){
+		cpBody *temp = a;
+		a = b;
+		b = temp;
+	}
+
+	// Rogue bodies don't belong to any island.
+	// A static one doesn't hold anything up, but one being moved by hand keeps its island awake.
+	if(cpBodyIsRogue(b)){
+		if(cpBodyIsRogue(a)) return;
+
+		if(cpvdot(b->v, b->v) != 0.0f || b->w != 0.0f){
+			cpSpaceActivateBody(space, a);
+			a->node.idleTime = 0.0f;
+		}
+
+		return;
+	}
+
+	// Both bodies in the same sleeping island, leave them alone.
+	if(cpBodyIsSleeping(a) && a->node.root == b->node.root) return;
+
+	// An awake body touched a sleeping one, or two sleeping islands were connected.
+	cpSpaceActivateBody(space, a);
+	cpSpaceActivateBody(space, b);
+
+	componentNodeMerge(componentNodeRoot(a), componentNodeRoot(b));
+}
+
+static int
+componentActive(cpBody *root, cpFloat threshold)
+{
+	for(cpBody *body = root; body; body = body->node.next){
+		if(body->node.idleTime < threshold) return 1;
+	}
+
+	return 0;
+}
+
+void
+cpSpaceProcessComponents(cpSpace *space, cpFloat dt)
+{
+	cpArray *bodies = space->bodies;
+	cpArray *arbiters = space->arbiters;
+	cpArray *constraints = space->constraints;
+
+	cpFloat dv = space->idleSpeedThreshold;
+	cpFloat dvsq = (dv ? dv*dv : cpvdot(space->gravity, space->gravity)*dt*dt);
+
+	// Update the idle timers.
+	for(int i=0; i<bodies->num; i++){
+		cpBody *body = (cpBody *)bodies->arr[i];
+
+		cpFloat thresh = (dvsq ? body->m*dvsq : 0.0f);
+		body->node.idleTime = (cpBodyKineticEnergy(body) > thresh ? 0.0f : body->node.idleTime + dt);
+	}
+
+	// Build the islands from the graph edges.
+	// Sleeping islands woken up here are appended to the body list and their arbiters
+	// to the arbiter list, so the constraints go first and the arbiter loop sees them all.
+	for(int i=0; i<constraints->num; i++){
+		cpConstraint *constraint = (cpConstraint *)constraints->arr[i];
+		mergeBodies(space, constraint->a, constraint->b);
+	}
+
+	for(int i=0; i<arbiters->num; i++){
+		cpArbiter *arb = (cpArbiter *)arbiters->arr[i];
+		mergeBodies(space, arb->private_a->body, arb->private_b->body);
+	}
+
+	// Link every body into its island's list. The root is the head.
+	for(int i=0; i<bodies->num; i++){
+		cpBody *body = (cpBody *)bodies->arr[i];
+		cpBody *root = componentNodeRoot(body);
+
+		if(root != body){
+			body->node.next = root->node.next;
+			root->node.next = body;
+		}
+	}
+
+	// Put the idle islands to sleep.
+	cpFloat threshold = space->sleepTimeThreshold;
+	for(int i=0; i<bodies->num; i++){
+		cpBody *body = (cpBody *)bodies->arr[i];
+
+		// Only the roots of islands that are not already asleep.
+		if(!body->node.parent && !cpBodyIsSleeping(body) && !componentActive(body, threshold)){
+			cpSpaceDeactivateComponent(space, body);
+		}
+	}
+
+	// Compact the body list and reset the nodes of the bodies that stay awake.
+	int num = 0;
+	for(int i=0; i<bodies->num; i++){
+		cpBody *body = (cpBody *)bodies->arr[i];
+
+		if(!cpBodyIsSleeping(body)){
+			body->node.parent = NULL;
+			body->node.next = NULL;
+			body->node.rank = 0;
+
+			bodies->arr[num++] = body;
+		}
+	}
+	bodies->num = num;
+
+	// Don't solve arbiters and constraints of sleeping bodies.
+	num = 0;
+	for(int i=0; i<arbiters->num; i++){
+		cpArbiter *arb = (cpArbiter *)arbiters->arr[i];
+
+		if(!cpBodyIsSleeping(arb->private_a->body) && !cpBodyIsSleeping(arb->private_b->body)){
+			arbiters->arr[num++] = arb;
+		}
+	}
+	arbiters->num = num;
+
+	cpArray *activeConstraints = space->activeConstraints;
+	activeConstraints->num = 0;
+	for(int i=0; i<constraints->num; i++){
+		cpConstraint *constraint = (cpConstraint *)constraints->arr[i];
+
+		if(!cpBodyIsSleeping(constraint->a) && !cpBodyIsSleeping(constraint->b)){
+			cpArrayPush(activeConstraints, constraint);
+		}
+	}
+}
@@ -21,6 +21,7 @@ actions/CCActionPageTurn3D.cpp \
 actions/CCActionProgressTimer.cpp \
 actions/CCActionTiledGrid.cpp \
 base_nodes/CCAtlasNode.cpp \
+cocoa/CCXInternedString.cpp \
 cocoa/CGAffineTransform.cpp \
 cocoa/CGGeometry.cpp \
 cocoa/NSAutoreleasePool.cpp \
@@ -37,6 +38,7 @@ keypad_dispatcher/CCKeypadDelegate.cpp \
 keypad_dispatcher/CCKeypadDispatcher.cpp \
 label_nodes/CCLabelAtlas.cpp \
 label_nodes/CCLabelBMFont.cpp \
+label_nodes/CCGlyphCache.cpp \
 label_nodes/CCLabelTTF.cpp \
 layers_scenes_transitions_nodes/CCScene.cpp \
 layers_scenes_transitions_nodes/CCTransitionPageTurn.cpp \
@@ -49,6 +51,9 @@ misc_nodes/CCRibbon.cpp \
 particle_nodes/CCParticleExamples.cpp \
 particle_nodes/CCParticleSystem.cpp \
 particle_nodes/CCParticleSystemQuad.cpp \
+particle_nodes/CCParticlePool.cpp \
+particle_nodes/CCParticleTemplateCache.cpp \
+particle_nodes/CCParticleBatchNode.cpp \
 platform/CCDirector_mobile.cpp \
 platform/CCGrid_mobile.cpp \
 platform/CCLayer_mobile.cpp \
@@ -56,6 +61,7 @@ platform/CCMenu_mobile.cpp \
 platform/CCNode_mobile.cpp \
 platform/CCParticleSystemPoint_mobile.cpp \
 platform/CCTransition_mobile.cpp \
+platform/CCXThread.cpp \
 platform/android/CCNS_android.cpp \
 platform/android/CCTime.cpp \
 platform/android/CCXApplication_android.cpp \
@@ -81,6 +87,9 @@ support/base64.cpp \
 support/ccUtils.cpp \
 support/file_support/FileUtils.cpp \
 support/image_support/TGAlib.cpp \
+support/image_support/ImageEncoder.cpp \
+support/image_support/ETC1Decoder.cpp \
+support/data_support/CCPlistParser.cpp \
 support/opengl_support/glu.cpp \
 support/zip_support/ZipUtils.cpp \
 support/zip_support/ioapi.cpp \
@@ -88,6 +97,7 @@ support/zip_support/unzip.cpp \
 textures/CCTexture2D.cpp \
 textures/CCTextureAtlas.cpp \
 textures/CCTextureCache.cpp \
+textures/CCResourcePreloader.cpp \
 tileMap_parallax_nodes/CCParallaxNode.cpp \
 tileMap_parallax_nodes/CCTMXLayer.cpp \
 tileMap_parallax_nodes/CCTMXObjectGroup.cpp \
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "CCGL.h"
 
 #include <string.h>
+#include <stdlib.h>
 #include <cmath>
 #include <GLES/gl.h>
 
@@ -37,123 +38,231 @@ THE SOFTWARE.
 
 namespace   cocos2d {
 
-void ccDrawPoint(CGPoint point)
+// The primitives are kept in grow-only buffers, one per kind of primitive, so drawing
+// them doesn't allocate once the buffers are big enough.
+typedef struct _ccPrimitiveBuffer
 {
-	ccVertex2F p = {point.x * CC_CONTENT_SCALE_FACTOR(), point.y * CC_CONTENT_SCALE_FACTOR() };
-	// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
-	// Needed states: GL_VERTEX_ARRAY, 
-	// Unneeded states: GL_TEXTURE_2D, GL_TEXTURE_COORD_ARRAY, GL_COLOR_ARRAY	
-	glDisable(GL_TEXTURE_2D);
-	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	glDisableClientState(GL_COLOR_ARRAY);
-	
-	glVertexPointer(2, GL_FLOAT, 0, &p);	
-	glDrawArrays(GL_POINTS, 0, 1);
+	ccV2F_C4B		*vertices;
+	unsigned int	count;
+	unsigned int	capacity;
+} ccPrimitiveBuffer;
 
-	// restore default state
-	glEnableClientState(GL_COLOR_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-	glEnable(GL_TEXTURE_2D);	
+static ccPrimitiveBuffer s_tTriangles = { NULL, 0, 0 };
+static ccPrimitiveBuffer s_tLines = { NULL, 0, 0 };
+static ccPrimitiveBuffer s_tPoints = { NULL, 0, 0 };
+
+// scratch memory for the curves, before they are split in lines
+static ccVertex2F *s_pScratch = NULL;
+static unsigned int s_uScratchCapacity = 0;
+
+static unsigned int s_uBatchDepth = 0;
+static ccColor4B s_tDrawColor = { 255, 255, 255, 255 };
+static GLfloat s_fLineWidth = 1.0f;
+static GLfloat s_fPointSize = 1.0f;
+
+static ccV2F_C4B* reserveVertices(ccPrimitiveBuffer *pBuffer, unsigned int uCount)
+{
+	if (pBuffer->count + uCount > pBuffer->capacity)
+	{
+		unsigned int uCapacity = pBuffer->capacity ? pBuffer->capacity : 64;
+		while (uCapacity < pBuffer->count + uCount)
+		{
+			uCapacity *= 2;
+		}
+
+		ccV2F_C4B *pVertices = (ccV2F_C4B*)realloc(pBuffer->vertices, uCapacity * sizeof(ccV2F_C4B));
+		if (! pVertices)
+		{
+			return NULL;
+		}
+
+		pBuffer->vertices = pVertices;
+		pBuffer->capacity = uCapacity;
+	}
+
+	ccV2F_C4B *pRet = pBuffer->vertices + pBuffer->count;
+	pBuffer->count += uCount;
+	return pRet;
 }
 
-void ccDrawPoints(const CGPoint *points, unsigned int numberOfPoints)
+static ccVertex2F* scratchVertices(unsigned int uCount)
+{
+	if (uCount > s_uScratchCapacity)
+	{
+		ccVertex2F *pVertices = (ccVertex2F*)realloc(s_pScratch, uCount * sizeof(ccVertex2F));
+		if (! pVertices)
+		{
+			return NULL;
+		}
+
+		s_pScratch = pVertices;
+		s_uScratchCapacity = uCount;
+	}
+
+	return s_pScratch;
+}
+
+static inline void setVertex(ccV2F_C4B *pVertex, float x, float y)
+{
+	pVertex->vertices.x = x;
+	pVertex->vertices.y = y;
+	pVertex->colors = s_tDrawColor;
+}
+
+static void drawBuffer(ccPrimitiveBuffer *pBuffer, GLenum mode, bool bColorArray)
 {
+	if (pBuffer->count == 0)
+	{
+		return;
+	}
+
+	glVertexPointer(2, GL_FLOAT, sizeof(ccV2F_C4B), &pBuffer->vertices[0].vertices);
+	if (bColorArray)
+	{
+		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(ccV2F_C4B), &pBuffer->vertices[0].colors);
+	}
+
+	glDrawArrays(mode, 0, pBuffer->count);
+	pBuffer->count = 0;
+}
+
+// Batched primitives carry their own color, the immediate ones use the current glColor
+static void flushPrimitives(bool bColorArray)
+{
+	if (s_tTriangles.count == 0 && s_tLines.count == 0 && s_tPoints.count == 0)
+	{
+		return;
+	}
+
 	// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
-	// Needed states: GL_VERTEX_ARRAY, 
-	// Unneeded states: GL_TEXTURE_2D, GL_TEXTURE_COORD_ARRAY, GL_COLOR_ARRAY	
+	// Needed states: GL_VERTEX_ARRAY, GL_COLOR_ARRAY when batching
+	// Unneeded states: GL_TEXTURE_2D, GL_TEXTURE_COORD_ARRAY, GL_COLOR_ARRAY otherwise
 	glDisable(GL_TEXTURE_2D);
 	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	glDisableClientState(GL_COLOR_ARRAY);
+	if (! bColorArray)
+	{
+		glDisableClientState(GL_COLOR_ARRAY);
+	}
 
-	ccVertex2F *newPoints = new ccVertex2F[numberOfPoints];
+	drawBuffer(&s_tTriangles, GL_TRIANGLES, bColorArray);
+	drawBuffer(&s_tLines, GL_LINES, bColorArray);
+	drawBuffer(&s_tPoints, GL_POINTS, bColorArray);
 
-	// iPhone and 32-bit machines optimization
-	if( sizeof(CGPoint) == sizeof(ccVertex2F) ) {
+	// restore default state
+	if (! bColorArray)
+	{
+		glEnableClientState(GL_COLOR_ARRAY);
+	}
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glEnable(GL_TEXTURE_2D);
+}
 
-		// points ?
-		if( CC_CONTENT_SCALE_FACTOR() != 1 ) 
-		{
-			for( unsigned int i= 0; i < numberOfPoints; i++)
-			{
-				newPoints[i].x = points[i].x * CC_CONTENT_SCALE_FACTOR();
-				newPoints[i].y = points[i].y * CC_CONTENT_SCALE_FACTOR();
-			}
+// draws right away unless a batch is open
+static inline void primitivesAdded(void)
+{
+	if (s_uBatchDepth == 0)
+	{
+		flushPrimitives(false);
+	}
+}
 
-			glVertexPointer(2, GL_FLOAT, 0, newPoints);
+static void addLineStrip(const ccVertex2F *pVertices, unsigned int uCount, bool bClose)
+{
+	if (uCount < 2)
+	{
+		return;
+	}
 
-		} else
-			glVertexPointer(2, GL_FLOAT, 0, points);
+	unsigned int uSegments = bClose ? uCount : uCount - 1;
+	ccV2F_C4B *pLines = reserveVertices(&s_tLines, uSegments * 2);
+	if (! pLines)
+	{
+		return;
+	}
 
-		glDrawArrays(GL_POINTS, 0, numberOfPoints);
+	for (unsigned int i = 0; i < uSegments; ++i)
+	{
+		const ccVertex2F& from = pVertices[i];
+		const ccVertex2F& to = pVertices[(i + 1) % uCount];
+		setVertex(pLines++, from.x, from.y);
+		setVertex(pLines++, to.x, to.y);
+	}
+}
 
-	} else {
+void ccDrawPoint(CGPoint point)
+{
+	ccV2F_C4B *pPoint = reserveVertices(&s_tPoints, 1);
+	if (pPoint)
+	{
+		setVertex(pPoint, point.x * CC_CONTENT_SCALE_FACTOR(), point.y * CC_CONTENT_SCALE_FACTOR());
+	}
+
+	primitivesAdded();
+}
 
-		// Mac on 64-bit
-		for( unsigned int i = 0; i < numberOfPoints; i++)
+void ccDrawPoints(const CGPoint *points, unsigned int numberOfPoints)
+{
+	ccV2F_C4B *pPoints = reserveVertices(&s_tPoints, numberOfPoints);
+	if (pPoints)
+	{
+		for (unsigned int i = 0; i < numberOfPoints; ++i)
 		{
-			newPoints[i].x = points[i].x;
-			newPoints[i].y = points[i].y;
+			setVertex(pPoints + i, points[i].x * CC_CONTENT_SCALE_FACTOR(), points[i].y * CC_CONTENT_SCALE_FACTOR());
 		}
-
-		glVertexPointer(2, GL_FLOAT, 0, newPoints);
-		glDrawArrays(GL_POINTS, 0, numberOfPoints);
 	}
 
-	delete[] newPoints;
-	
-	// restore default state
-	glEnableClientState(GL_COLOR_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-	glEnable(GL_TEXTURE_2D);	
+	primitivesAdded();
 }
 
 void ccDrawLine(CGPoint origin, CGPoint destination)
 {
-	CGPoint vertices[2];
-	
-	vertices[0] = origin;
-	vertices[1] = destination;
+	ccV2F_C4B *pLine = reserveVertices(&s_tLines, 2);
+	if (pLine)
+	{
+		setVertex(pLine, origin.x, origin.y);
+		setVertex(pLine + 1, destination.x, destination.y);
+	}
 
-	// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
-	// Needed states: GL_VERTEX_ARRAY, 
-	// Unneeded states: GL_TEXTURE_2D, GL_TEXTURE_COORD_ARRAY, GL_COLOR_ARRAY	
-	glDisable(GL_TEXTURE_2D);
-	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	glDisableClientState(GL_COLOR_ARRAY);
-	
-	glVertexPointer(2, GL_FLOAT, 0, vertices);	
-	glDrawArrays(GL_LINES, 0, 2);
-	
-	// restore default state
-	glEnableClientState(GL_COLOR_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-	glEnable(GL_TEXTURE_2D);	
+	primitivesAdded();
 }
 
 
 void ccDrawPoly(const CGPoint *poli, int points, bool closePolygon)
 {
-	// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
-	// Needed states: GL_VERTEX_ARRAY, 
-	// Unneeded states: GL_TEXTURE_2D, GL_TEXTURE_COORD_ARRAY, GL_COLOR_ARRAY	
-	glDisable(GL_TEXTURE_2D);
-	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	glDisableClientState(GL_COLOR_ARRAY);
-	
-	glVertexPointer(2, GL_FLOAT, 0, poli);
-	if (closePolygon)
+	ccVertex2F *pVertices = scratchVertices(points);
+	if (pVertices)
 	{
-		glDrawArrays(GL_LINE_LOOP, 0, points);
+		for (int i = 0; i < points; ++i)
+		{
+			pVertices[i] = vertex2(poli[i].x, poli[i].y);
+		}
+
+		addLineStrip(pVertices, points, closePolygon);
 	}
-	else 
+
+	primitivesAdded();
+}
+
+void ccDrawSolidPoly(const CGPoint *poli, int numberOfPoints)
+{
+	if (numberOfPoints < 3)
 	{
-		glDrawArrays(GL_LINE_STRIP, 0, points);
+		return;
 	}
-	
-	// restore default state
-	glEnableClientState(GL_COLOR_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-	glEnable(GL_TEXTURE_2D);	
+
+	// the triangle fan is split in triangles so that it can be batched
+	ccV2F_C4B *pTriangles = reserveVertices(&s_tTriangles, (numberOfPoints - 2) * 3);
+	if (pTriangles)
+	{
+		for (int i = 1; i < numberOfPoints - 1; ++i)
+		{
+			setVertex(pTriangles++, poli[0].x, poli[0].y);
+			setVertex(pTriangles++, poli[i].x, poli[i].y);
+			setVertex(pTriangles++, poli[i + 1].x, poli[i + 1].y);
+		}
+	}
+
+	primitivesAdded();
 }
 
 void ccDrawCircle(CGPoint center, float r, float a, int segs, bool drawLineToCenter)
@@ -166,103 +275,124 @@ void ccDrawCircle(CGPoint center, float r, float a, int segs, bool drawLineToCen
 
 	const float coef = 2.0f * (float) (M_PI) /segs;
 
-	float *vertices = new float[2*(segs+2)]; //	float *vertices = (float *)malloc( sizeof(float)*2*(segs+2));
+	ccVertex2F *vertices = scratchVertices(segs + 2);
 	if( ! vertices )
 	{
 		return;
 	}
 	
-	memset( vertices,0, sizeof(float)*2*(segs+2));
-	
 	for(int i=0;i<=segs;i++)
 	{
 		float rads = i*coef;
 		float j = r * cosf(rads + a) + center.x;
 		float k = r * sinf(rads + a) + center.y;
 		
-		vertices[i*2] = j;
-		vertices[i*2+1] =k;
+		vertices[i].x = j;
+		vertices[i].y = k;
 	}
-	vertices[(segs+1)*2] = center.x;
-	vertices[(segs+1)*2+1] = center.y;
+	vertices[segs+1].x = center.x;
+	vertices[segs+1].y = center.y;
 	
-	// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
-	// Needed states: GL_VERTEX_ARRAY, 
-	// Unneeded states: GL_TEXTURE_2D, GL_TEXTURE_COORD_ARRAY, GL_COLOR_ARRAY	
-	glDisable(GL_TEXTURE_2D);
-	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	glDisableClientState(GL_COLOR_ARRAY);
-	
-	glVertexPointer(2, GL_FLOAT, 0, vertices);	
-	glDrawArrays(GL_LINE_STRIP, 0, segs+additionalSegment);
-	
-	// restore default state
-	glEnableClientState(GL_COLOR_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-	glEnable(GL_TEXTURE_2D);	
+	addLineStrip(vertices, segs+additionalSegment, false);
 
-	delete[] vertices; //	free(vertices);
+	primitivesAdded();
 }
 
 void ccDrawQuadBezier(CGPoint origin, CGPoint control, CGPoint destination, int segments)
 {
-	CGPoint *vertices = new CGPoint[segments + 1];
+	ccVertex2F *vertices = scratchVertices(segments + 1);
+	if( ! vertices )
+	{
+		return;
+	}
 	
 	float t = 0.0f;
 	for(int i = 0; i < segments; i++)
 	{
-		float x = powf(1 - t, 2) * origin.x + 2.0f * (1 - t) * t * control.x + t * t * destination.x;
-		float y = powf(1 - t, 2) * origin.y + 2.0f * (1 - t) * t * control.y + t * t * destination.y;
-		vertices[i] = CGPointMake(x, y);
+		vertices[i].x = powf(1 - t, 2) * origin.x + 2.0f * (1 - t) * t * control.x + t * t * destination.x;
+		vertices[i].y = powf(1 - t, 2) * origin.y + 2.0f * (1 - t) * t * control.y + t * t * destination.y;
 		t += 1.0f / segments;
 	}
-	vertices[segments] = destination;
-	
-	// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
-	// Needed states: GL_VERTEX_ARRAY, 
-	// Unneeded states: GL_TEXTURE_2D, GL_TEXTURE_COORD_ARRAY, GL_COLOR_ARRAY	
-	glDisable(GL_TEXTURE_2D);
-	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	glDisableClientState(GL_COLOR_ARRAY);
-	
-	glVertexPointer(2, GL_FLOAT, 0, vertices);	
-	glDrawArrays(GL_LINE_STRIP, 0, segments + 1);
-	delete[] vertices;
+	vertices[segments].x = destination.x;
+	vertices[segments].y = destination.y;
 	
-	// restore default state
-	glEnableClientState(GL_COLOR_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-	glEnable(GL_TEXTURE_2D);	
+	addLineStrip(vertices, segments + 1, false);
+
+	primitivesAdded();
 }
 
 void ccDrawCubicBezier(CGPoint origin, CGPoint control1, CGPoint control2, CGPoint destination, int segments)
 {
-	CGPoint *vertices = new CGPoint[segments + 1];
+	ccVertex2F *vertices = scratchVertices(segments + 1);
+	if( ! vertices )
+	{
+		return;
+	}
 	
 	float t = 0;
 	for(int i = 0; i < segments; ++i)
 	{
-		float x = powf(1 - t, 3) * origin.x + 3.0f * powf(1 - t, 2) * t * control1.x + 3.0f * (1 - t) * t * t * control2.x + t * t * t * destination.x;
-		float y = powf(1 - t, 3) * origin.y + 3.0f * powf(1 - t, 2) * t * control1.y + 3.0f * (1 - t) * t * t * control2.y + t * t * t * destination.y;
-		vertices[i] = CGPointMake(x, y);
+		vertices[i].x = powf(1 - t, 3) * origin.x + 3.0f * powf(1 - t, 2) * t * control1.x + 3.0f * (1 - t) * t * t * control2.x + t * t * t * destination.x;
+		vertices[i].y = powf(1 - t, 3) * origin.y + 3.0f * powf(1 - t, 2) * t * control1.y + 3.0f * (1 - t) * t * t * control2.y + t * t * t * destination.y;
 		t += 1.0f / segments;
 	}
-	vertices[segments] = destination;
-	
-	// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
-	// Needed states: GL_VERTEX_ARRAY, 
-	// Unneeded states: GL_TEXTURE_2D, GL_TEXTURE_COORD_ARRAY, GL_COLOR_ARRAY	
-	glDisable(GL_TEXTURE_2D);
-	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	glDisableClientState(GL_COLOR_ARRAY);
+	vertices[segments].x = destination.x;
+	vertices[segments].y = destination.y;
 	
-	glVertexPointer(2, GL_FLOAT, 0, vertices);	
-	glDrawArrays(GL_LINE_STRIP, 0, segments + 1);
-	delete[] vertices;
-	
-	// restore default state
-	glEnableClientState(GL_COLOR_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-	glEnable(GL_TEXTURE_2D);	
+	addLineStrip(vertices, segments + 1, false);
+
+	primitivesAdded();
+}
+
+void ccDrawColor4B(GLubyte r, GLubyte g, GLubyte b, GLubyte a)
+{
+	s_tDrawColor.r = r;
+	s_tDrawColor.g = g;
+	s_tDrawColor.b = b;
+	s_tDrawColor.a = a;
+
+	glColor4ub(r, g, b, a);
+}
+
+void ccDrawBeginBatch(void)
+{
+	++s_uBatchDepth;
+}
+
+void ccDrawEndBatch(void)
+{
+	NSAssert(s_uBatchDepth > 0, "ccDrawEndBatch without ccDrawBeginBatch");
+
+	if (s_uBatchDepth > 0 && --s_uBatchDepth == 0)
+	{
+		flushPrimitives(true);
+	}
+}
+
+void ccDrawFlush(void)
+{
+	flushPrimitives(s_uBatchDepth > 0);
+}
+
+void ccDrawLineWidth(GLfloat width)
+{
+	if (width != s_fLineWidth && s_tLines.count > 0)
+	{
+		ccDrawFlush();
+	}
+
+	s_fLineWidth = width;
+	glLineWidth(width);
+}
+
+void ccDrawPointSize(GLfloat size)
+{
+	if (size != s_fPointSize && s_tPoints.count > 0)
+	{
+		ccDrawFlush();
+	}
+
+	s_fPointSize = size;
+	glPointSize(size);
 }
 }//namespace   cocos2d 
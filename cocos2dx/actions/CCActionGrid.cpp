@@ -24,6 +24,7 @@ THE SOFTWARE.
 #include "CCActionGrid.h"
 #include "CCDirector.h"
 #include "effects/CCGrid.h"
+#include "platform/CCXThread.h"
 
 namespace cocos2d
 {
@@ -153,6 +154,50 @@ namespace cocos2d
 		return g->setVertex(pos, vertex);
 	}
 
+	ccVertex3F* CCGrid3DAction::vertices(void)
+	{
+		CCGrid3D *g = (CCGrid3D*)m_pTarget->getGrid();
+		return g->getVertices();
+	}
+
+	ccVertex3F* CCGrid3DAction::originalVertices(void)
+	{
+		CCGrid3D *g = (CCGrid3D*)m_pTarget->getGrid();
+		return g->getOriginalVertices();
+	}
+
+	// below this number of vertices, the effects are computed on the calling thread
+	#define kCCGridParallelMinVertices 1024
+
+	typedef struct
+	{
+		CCGrid3DAction *action;
+		ccTime time;
+		ccVertex3F *vertices;
+		const ccVertex3F *original;
+	} tGrid3DColumnsJob;
+
+	static void updateGrid3DColumns(void *pData, unsigned int uBegin, unsigned int uEnd)
+	{
+		tGrid3DColumnsJob *pJob = (tGrid3DColumnsJob*)pData;
+		pJob->action->updateColumns(pJob->time, pJob->vertices, pJob->original, (int)uBegin, (int)uEnd);
+	}
+
+	void CCGrid3DAction::updateAllColumns(cocos2d::ccTime time)
+	{
+		tGrid3DColumnsJob job = { this, time, vertices(), originalVertices() };
+		unsigned int uColumns = m_sGridSize.x + 1;
+
+		if (uColumns * (m_sGridSize.y + 1) >= kCCGridParallelMinVertices)
+		{
+			ccxParallelFor(updateGrid3DColumns, &job, uColumns);
+		}
+		else
+		{
+			updateGrid3DColumns(&job, 0, uColumns);
+		}
+	}
+
 	// implementation of TiledGrid3DAction
 
 	CCGridBase* CCTiledGrid3DAction::getGrid(void)
@@ -178,6 +223,47 @@ namespace cocos2d
 		return g->setTile(pos, coords);
 	}
 
+	ccQuad3* CCTiledGrid3DAction::tiles(void)
+	{
+		CCTiledGrid3D *g = (CCTiledGrid3D*)m_pTarget->getGrid();
+		return g->getTiles();
+	}
+
+	ccQuad3* CCTiledGrid3DAction::originalTiles(void)
+	{
+		CCTiledGrid3D *g = (CCTiledGrid3D*)m_pTarget->getGrid();
+		return g->getOriginalTiles();
+	}
+
+	typedef struct
+	{
+		CCTiledGrid3DAction *action;
+		ccTime time;
+		ccQuad3 *tiles;
+		const ccQuad3 *original;
+	} tTiledGrid3DColumnsJob;
+
+	static void updateTiledGrid3DColumns(void *pData, unsigned int uBegin, unsigned int uEnd)
+	{
+		tTiledGrid3DColumnsJob *pJob = (tTiledGrid3DColumnsJob*)pData;
+		pJob->action->updateColumns(pJob->time, pJob->tiles, pJob->original, (int)uBegin, (int)uEnd);
+	}
+
+	void CCTiledGrid3DAction::updateAllColumns(cocos2d::ccTime time)
+	{
+		tTiledGrid3DColumnsJob job = { this, time, tiles(), originalTiles() };
+		unsigned int uColumns = m_sGridSize.x;
+
+		if (uColumns * m_sGridSize.y * 4 >= kCCGridParallelMinVertices)
+		{
+			ccxParallelFor(updateTiledGrid3DColumns, &job, uColumns);
+		}
+		else
+		{
+			updateTiledGrid3DColumns(&job, 0, uColumns);
+		}
+	}
+
 	// implementation CCAccelDeccelAmplitude
 
 	CCAccelDeccelAmplitude* CCAccelDeccelAmplitude::actionWithAction(cocos2d::CCAction *pAction, cocos2d::ccTime duration)
@@ -23,6 +23,7 @@ THE SOFTWARE.
 ****************************************************************************/
 #include "CCActionGrid3D.h"
 #include "CGPointExtension.h"
+#include "support/ccUtils.h"
 
 #include <stdlib.h>
 
@@ -89,16 +90,21 @@ namespace cocos2d
 
 	void CCWaves3D::update(cocos2d::ccTime time)
 	{
-		int i, j;
+		updateAllColumns(time);
+	}
+
+	void CCWaves3D::updateColumns(cocos2d::ccTime time, cocos2d::ccVertex3F *pVertices, const cocos2d::ccVertex3F *pOriginal, int nBegin, int nEnd)
+	{
+		int nRows = m_sGridSize.y + 1;
+		float fPhase = (CGFloat)M_PI * time * m_nWaves * 2;
+		float fAmplitude = m_fAmplitude * m_fAmplitudeRate;
 
-		for (i = 0; i < m_sGridSize.x + 1; ++i)
+		// the columns are contiguous
+		for (int i = nBegin * nRows; i < nEnd * nRows; ++i)
 		{
-			for (j = 0; j < m_sGridSize.y + 1; ++j)
-			{
-				ccVertex3F v = originalVertex(ccg(i ,j));
-				v.z += (sinf((CGFloat)M_PI * time * m_nWaves * 2 + (v.y+v.x) * .01f) * m_fAmplitude * m_fAmplitudeRate);
-				setVertex(ccg(i, j), v);
-			}
+			ccVertex3F v = pOriginal[i];
+			v.z += ccFastSin(fPhase + (v.y + v.x) * .01f) * fAmplitude;
+			pVertices[i] = v;
 		}
 	}
 
@@ -412,41 +418,40 @@ namespace cocos2d
 	{
 		if (m_bDirty)
 		{
-			int i, j;
-			
-			for (i = 0; i < m_sGridSize.x + 1; ++i)
+			updateAllColumns(time);
+			m_bDirty = false;
+		}
+	}
+
+	void CCLens3D::updateColumns(cocos2d::ccTime time, cocos2d::ccVertex3F *pVertices, const cocos2d::ccVertex3F *pOriginal, int nBegin, int nEnd)
+	{
+		int nRows = m_sGridSize.y + 1;
+
+		for (int i = nBegin * nRows; i < nEnd * nRows; ++i)
+		{
+			ccVertex3F v = pOriginal[i];
+			CGPoint vect = ccpSub(m_positionInPixels, ccp(v.x, v.y));
+			CGFloat r = ccpLength(vect);
+
+			if (r < m_fRadius)
 			{
-				for (j = 0; j < m_sGridSize.y + 1; ++j)
+				CGFloat pre_log = (m_fRadius - r) / m_fRadius;
+				if ( pre_log == 0 ) 
 				{
-					ccVertex3F v = originalVertex(ccg(i, j));
-					CGPoint vect = ccpSub(m_positionInPixels, ccp(v.x, v.y));
-					CGFloat r = ccpLength(vect);
-					
-					if (r < m_fRadius)
-					{
-						r = m_fRadius - r;
-						CGFloat pre_log = r / m_fRadius;
-						if ( pre_log == 0 ) 
-						{
-							pre_log = 0.001f;
-						}
+					pre_log = 0.001f;
+				}
 
-						float l = logf(pre_log) * m_fLensEffect;
-						float new_r = expf( l ) * m_fRadius;
-						
-						if (ccpLength(vect) > 0)
-						{
-							vect = ccpNormalize(vect);
-							CGPoint new_vect = ccpMult(vect, new_r);
-							v.z += ccpLength(new_vect) * m_fLensEffect;
-						}
-					}
-					
-					setVertex(ccg(i, j), v);
+				float l = logf(pre_log) * m_fLensEffect;
+				float new_r = expf( l ) * m_fRadius;
+
+				// the length of the normalized vector scaled by new_r
+				if (r > 0)
+				{
+					v.z += new_r * m_fLensEffect;
 				}
 			}
-			
-			m_bDirty = false;
+
+			pVertices[i] = v;
 		}
 	}
 
@@ -519,25 +524,31 @@ namespace cocos2d
 
 	void CCRipple3D::update(cocos2d::ccTime time)
 	{
-		int i, j;
-	
-		for (i = 0; i < (m_sGridSize.x+1); ++i)
+		updateAllColumns(time);
+	}
+
+	void CCRipple3D::updateColumns(cocos2d::ccTime time, cocos2d::ccVertex3F *pVertices, const cocos2d::ccVertex3F *pOriginal, int nBegin, int nEnd)
+	{
+		int nRows = m_sGridSize.y + 1;
+		float fPhase = time * (CGFloat)M_PI * m_nWaves * 2;
+		float fAmplitude = m_fAmplitude * m_fAmplitudeRate;
+		CGPoint c = m_positionInPixels;
+
+		for (int i = nBegin * nRows; i < nEnd * nRows; ++i)
 		{
-			for (j = 0; j < (m_sGridSize.y+1); ++j)
+			ccVertex3F v = pOriginal[i];
+			float dx = c.x - v.x;
+			float dy = c.y - v.y;
+			CGFloat r = sqrtf(dx * dx + dy * dy);
+
+			if (r < m_fRadius)
 			{
-				ccVertex3F v = originalVertex(ccg(i, j));
-				CGPoint vect = ccpSub(m_positionInPixels, ccp(v.x,v.y));
-				CGFloat r = ccpLength(vect);
-				
-				if (r < m_fRadius)
-				{
-					r = m_fRadius - r;
-					CGFloat rate = powf(r / m_fRadius, 2);
-					v.z += (sinf( time*(CGFloat)M_PI * m_nWaves * 2 + r * 0.1f) * m_fAmplitude * m_fAmplitudeRate * rate);
-				}
-				
-				setVertex(ccg(i, j), v);
+				r = m_fRadius - r;
+				CGFloat rate = (r / m_fRadius) * (r / m_fRadius);
+				v.z += ccFastSin(fPhase + r * 0.1f) * fAmplitude * rate;
 			}
+
+			pVertices[i] = v;
 		}
 	}
 
@@ -600,22 +611,22 @@ namespace cocos2d
 
 	void CCShaky3D::update(cocos2d::ccTime time)
 	{
-		int i, j;
-	
-		for (i = 0; i < (m_sGridSize.x+1); ++i)
+		// rand() is not reentrant, this one stays on the calling thread
+		ccVertex3F *pVertices = vertices();
+		ccVertex3F *pOriginal = originalVertices();
+		int nCount = (m_sGridSize.x + 1) * (m_sGridSize.y + 1);
+
+		for (int i = 0; i < nCount; ++i)
 		{
-			for (j = 0; j < (m_sGridSize.y+1); ++j)
+			ccVertex3F v = pOriginal[i];
+			v.x += (rand() % (m_nRandrange*2)) - m_nRandrange;
+			v.y += (rand() % (m_nRandrange*2)) - m_nRandrange;
+			if (m_bShakeZ)
 			{
-				ccVertex3F v = originalVertex(ccg(i ,j));
-				v.x += (rand() % (m_nRandrange*2)) - m_nRandrange;
-				v.y += (rand() % (m_nRandrange*2)) - m_nRandrange;
-				if (m_bShakeZ)
-				{
-					v.z += (rand() % (m_nRandrange*2)) - m_nRandrange;
-				}
-				
-				setVertex(ccg(i, j), v);
+				v.z += (rand() % (m_nRandrange*2)) - m_nRandrange;
 			}
+
+			pVertices[i] = v;
 		}
 	}
 
@@ -679,16 +690,27 @@ namespace cocos2d
 
 	void CCLiquid::update(cocos2d::ccTime time)
 	{
-		int i, j;
+		updateAllColumns(time);
+	}
+
+	void CCLiquid::updateColumns(cocos2d::ccTime time, cocos2d::ccVertex3F *pVertices, const cocos2d::ccVertex3F *pOriginal, int nBegin, int nEnd)
+	{
+		int nRows = m_sGridSize.y + 1;
+		float fPhase = time * (CGFloat)M_PI * m_nWaves * 2;
+		float fAmplitude = m_fAmplitude * m_fAmplitudeRate;
+
+		// the border of the grid doesn't move
+		int nFirst = MAX(nBegin, 1);
+		int nLast = MIN(nEnd, m_sGridSize.x);
 
-		for (i = 1; i < m_sGridSize.x; ++i)
+		for (int i = nFirst; i < nLast; ++i)
 		{
-			for (j = 1; j < m_sGridSize.y; ++j)
+			for (int j = i * nRows + 1; j < (i + 1) * nRows - 1; ++j)
 			{
-				ccVertex3F v = originalVertex(ccg(i, j));
-				v.x = (v.x + (sinf(time * (CGFloat)M_PI * m_nWaves * 2 + v.x * .01f) * m_fAmplitude * m_fAmplitudeRate));
-				v.y = (v.y + (sinf(time * (CGFloat)M_PI * m_nWaves * 2 + v.y * .01f) * m_fAmplitude * m_fAmplitudeRate));
-				setVertex(ccg(i, j), v);
+				ccVertex3F v = pOriginal[j];
+				v.x = (v.x + (ccFastSin(fPhase + v.x * .01f) * fAmplitude));
+				v.y = (v.y + (ccFastSin(fPhase + v.y * .01f) * fAmplitude));
+				pVertices[j] = v;
 			}
 		}
 	}
@@ -755,26 +777,28 @@ namespace cocos2d
 
 	void CCWaves::update(cocos2d::ccTime time)
 	{
-		int i, j;
+		updateAllColumns(time);
+	}
+
+	void CCWaves::updateColumns(cocos2d::ccTime time, cocos2d::ccVertex3F *pVertices, const cocos2d::ccVertex3F *pOriginal, int nBegin, int nEnd)
+	{
+		int nRows = m_sGridSize.y + 1;
+		float fPhase = time * (CGFloat)M_PI * m_nWaves * 2;
+		float fAmplitude = m_fAmplitude * m_fAmplitudeRate;
 
-		for (i = 0; i < m_sGridSize.x + 1; ++i)
+		for (int i = nBegin * nRows; i < nEnd * nRows; ++i)
 		{
-			for (j = 0; j < m_sGridSize.y + 1; ++j)
+			ccVertex3F v = pOriginal[i];
+			ccVertex3F o = v;
+			if (m_bVertical)
 			{
-				ccVertex3F v = originalVertex(ccg(i, j));
-
-				if (m_bVertical)
-				{
-					v.x = (v.x + (sinf(time * (CGFloat)M_PI * m_nWaves * 2 + v.y * .01f) * m_fAmplitude * m_fAmplitudeRate));
-				}
-
-				if (m_bHorizontal)
-				{
-                    v.y = (v.y + (sinf(time * (CGFloat)M_PI * m_nWaves * 2 + v.x * .01f) * m_fAmplitude * m_fAmplitudeRate));
-				}
-
-				setVertex(ccg(i, j), v);
+				v.x = (o.x + (ccFastSin(fPhase + o.y * .01f) * fAmplitude));
 			}
+			if (m_bHorizontal)
+			{
+				v.y = (o.y + (ccFastSin(fPhase + o.x * .01f) * fAmplitude));
+			}
+			pVertices[i] = v;
 		}
 	}
 
@@ -847,30 +871,39 @@ namespace cocos2d
 
 	void CCTwirl::update(cocos2d::ccTime time)
 	{
-		int i, j;
+		updateAllColumns(time);
+	}
+
+	void CCTwirl::updateColumns(cocos2d::ccTime time, cocos2d::ccVertex3F *pVertices, const cocos2d::ccVertex3F *pOriginal, int nBegin, int nEnd)
+	{
+		int nRows = m_sGridSize.y + 1;
 		CGPoint	c = m_positionInPixels;
-		
-		for (i = 0; i < (m_sGridSize.x+1); ++i)
+
+		CGFloat amp = 0.1f * m_fAmplitude * m_fAmplitudeRate;
+		CGFloat twirl = cosf( (CGFloat)M_PI/2.0f + time * (CGFloat)M_PI * m_nTwirls * 2 ) * amp;
+
+		for (int i = nBegin; i < nEnd; ++i)
 		{
-			for (j = 0; j < (m_sGridSize.y+1); ++j)
+			CGFloat ax = i - (m_sGridSize.x/2.0f);
+
+			for (int j = 0; j < nRows; ++j)
 			{
-				ccVertex3F v = originalVertex(ccg(i ,j));
-				
-				CGPoint	avg = ccp(i-(m_sGridSize.x/2.0f), j-(m_sGridSize.y/2.0f));
-				CGFloat r = ccpLength(avg);
-				
-				CGFloat amp = 0.1f * m_fAmplitude * m_fAmplitudeRate;
-				CGFloat a = r * cosf( (CGFloat)M_PI/2.0f + time * (CGFloat)M_PI * m_nTwirls * 2 ) * amp;
-				
+				CGFloat ay = j - (m_sGridSize.y/2.0f);
+				CGFloat a = sqrtf(ax * ax + ay * ay) * twirl;
+
+				// the angle scales distances of hundreds of pixels, the precise sine is kept here
+				CGFloat sina = sinf(a);
+				CGFloat cosa = cosf(a);
+
+				ccVertex3F v = pOriginal[i * nRows + j];
 				CGPoint	d;
-				
-				d.x = sinf(a) * (v.y-c.y) + cosf(a) * (v.x-c.x);
-				d.y = cosf(a) * (v.y-c.y) - sinf(a) * (v.x-c.x);
-				
+
+				d.x = sina * (v.y-c.y) + cosa * (v.x-c.x);
+				d.y = cosa * (v.y-c.y) - sina * (v.x-c.x);
+
 				v.x = c.x + d.x;
 				v.y = c.y + d.y;
-
-				setVertex(ccg(i ,j), v);
+				pVertices[i * nRows + j] = v;
 			}
 		}
 	}
@@ -1834,6 +1834,7 @@ bool CCAnimate::initWithAnimation(cocos2d::CCAnimation *pAnimation, bool bRestor
        m_pAnimation = pAnimation;
 		CCX_SAFE_RETAIN(m_pAnimation);
 		m_pOrigFrame = NULL;
+		m_uFrameIndex = (unsigned int)-1;
 
 		return true;
 	}
@@ -1860,6 +1861,7 @@ bool CCAnimate::initWithDuration(cocos2d::ccTime duration, cocos2d::CCAnimation
 		m_pAnimation = pAnimation;
 		CCX_SAFE_RETAIN(m_pAnimation);
 		m_pOrigFrame = NULL;
+		m_uFrameIndex = (unsigned int)-1;
 
 		return true;
 	}
@@ -1908,6 +1910,8 @@ void CCAnimate::startWithTarget(CCNode *pTarget)
 		m_pOrigFrame = pSprite->displayedFrame();
 		m_pOrigFrame->retain();
 	}
+
+	m_uFrameIndex = (unsigned int)-1;
 }
 
 void CCAnimate::stop(void)
@@ -1932,10 +1936,11 @@ void CCAnimate::update(cocos2d::ccTime time)
 		idx = numberOfFrames - 1;
 	}
 
-	CCSprite *pSprite = (CCSprite*)(m_pTarget);
-	if (! pSprite->isFrameDisplayed(pFrames->getObjectAtIndex(idx)))
+	// only the frame index is compared, the sprite copies the texture coordinates cached by the frame
+	if (idx != m_uFrameIndex)
 	{
-		pSprite->setDisplayFrame(pFrames->getObjectAtIndex(idx));
+		m_uFrameIndex = idx;
+		((CCSprite*)(m_pTarget))->setDisplayFrame(pFrames->getObjectAtIndex(idx));
 	}
 }
 
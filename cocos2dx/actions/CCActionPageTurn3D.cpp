@@ -50,6 +50,11 @@ namespace cocos2d
 	 */
 	void CCPageTurn3D::update(cocos2d::ccTime time)
 	{
+		updateAllColumns(time);
+	}
+
+	void CCPageTurn3D::updateColumns(cocos2d::ccTime time, cocos2d::ccVertex3F *pVertices, const cocos2d::ccVertex3F *pOriginal, int nBegin, int nEnd)
+	{
 		float tt = MAX(0, time - 0.25f);
 		float deltaAy = (tt * tt * 500);
 		float ay = -100 - deltaAy;
@@ -60,12 +65,14 @@ namespace cocos2d
 		float sinTheta = sinf(theta);
 		float cosTheta = cosf(theta);
 		
-		for (int i = 0; i <= m_sGridSize.x; ++i)
+		int nRows = m_sGridSize.y + 1;
+
+		for (int i = nBegin; i < nEnd; ++i)
 		{
-			for (int j = 0; j <= m_sGridSize.y; ++j)
+			for (int j = 0; j < nRows; ++j)
 			{
 				// Get original vertex
-				ccVertex3F p = originalVertex(ccg(i ,j));
+				ccVertex3F p = pOriginal[i * nRows + j];
 				
 				float R = sqrtf((p.x * p.x) + ((p.y - ay) * (p.y - ay)));
 				float r = R * sinTheta;
@@ -100,7 +107,7 @@ namespace cocos2d
 				}
 				
 				// Set new coords
-				setVertex(ccg(i, j), p);
+				pVertices[i * nRows + j] = p;
 				
 			}
 		}
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "ccMacros.h"
 #include "CGPointExtension.h"
 #include "effects/CCGrid.h"
+#include "support/ccUtils.h"
 
 #include <stdlib.h>
 
@@ -795,22 +796,26 @@ namespace cocos2d
 
 	void CCWavesTiles3D::update(cocos2d::ccTime time)
 	{
-		int i, j;
+		updateAllColumns(time);
+	}
 
-		for( i = 0; i < m_sGridSize.x; i++ )
+	void CCWavesTiles3D::updateColumns(cocos2d::ccTime time, cocos2d::ccQuad3 *pTiles, const cocos2d::ccQuad3 *pOriginal, int nBegin, int nEnd)
+	{
+		int nRows = m_sGridSize.y;
+		float fPhase = time * (CGFloat)M_PI * m_nWaves * 2;
+		float fAmplitude = m_fAmplitude * m_fAmplitudeRate;
+
+		// the columns are contiguous
+		for (int i = nBegin * nRows; i < nEnd * nRows; ++i)
 		{
-			for( j = 0; j < m_sGridSize.y; j++ )
-			{
-				ccQuad3 coords = originalTile(ccg(i, j));
+			ccQuad3 coords = pOriginal[i];
 
-				coords.bl.z = (sinf(time * (CGFloat)M_PI  *m_nWaves * 2 + 
-					(coords.bl.y+coords.bl.x) * .01f) * m_fAmplitude * m_fAmplitudeRate );
-				coords.br.z	= coords.bl.z;
-				coords.tl.z = coords.bl.z;
-				coords.tr.z = coords.bl.z;
+			coords.bl.z = ccFastSin(fPhase + (coords.bl.y + coords.bl.x) * .01f) * fAmplitude;
+			coords.br.z	= coords.bl.z;
+			coords.tl.z = coords.bl.z;
+			coords.tr.z = coords.bl.z;
 
-				setTile(ccg(i, j), coords);
-			}
+			pTiles[i] = coords;
 		}
 	}
 
@@ -871,34 +876,30 @@ namespace cocos2d
 	}
 
 	void CCJumpTiles3D::update(cocos2d::ccTime time)
+	{
+		updateAllColumns(time);
+	}
+
+	void CCJumpTiles3D::updateColumns(cocos2d::ccTime time, cocos2d::ccQuad3 *pTiles, const cocos2d::ccQuad3 *pOriginal, int nBegin, int nEnd)
 	{
 		int i, j;
 
 		float sinz =  (sinf((CGFloat)M_PI * time * m_nJumps * 2) * m_fAmplitude * m_fAmplitudeRate );
 		float sinz2 = (sinf((CGFloat)M_PI * (time * m_nJumps * 2 + 1)) * m_fAmplitude * m_fAmplitudeRate );
 
-		for( i = 0; i < m_sGridSize.x; i++ )
+		for( i = nBegin; i < nEnd; i++ )
 		{
 			for( j = 0; j < m_sGridSize.y; j++ )
 			{
-				ccQuad3 coords = originalTile(ccg(i, j));
+				ccQuad3 coords = pOriginal[i * m_sGridSize.y + j];
+				float z = ((i+j) % 2) == 0 ? sinz : sinz2;
 
-				if ( ((i+j) % 2) == 0 )
-				{
-					coords.bl.z += sinz;
-					coords.br.z += sinz;
-					coords.tl.z += sinz;
-					coords.tr.z += sinz;
-				}
-				else
-				{
-					coords.bl.z += sinz2;
-					coords.br.z += sinz2;
-					coords.tl.z += sinz2;
-					coords.tr.z += sinz2;
-				}
+				coords.bl.z += z;
+				coords.br.z += z;
+				coords.tl.z += z;
+				coords.tr.z += z;
 
-				setTile(ccg(i, j), coords);
+				pTiles[i * m_sGridSize.y + j] = coords;
 			}
 		}
 	}
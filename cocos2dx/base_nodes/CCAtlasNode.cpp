@@ -24,6 +24,7 @@ THE SOFTWARE.
 
 #include "CCAtlasNode.h"
 #include "CCTextureAtlas.h"
+#include "CCDirector.h"
 
 namespace   cocos2d {
 
@@ -117,7 +118,17 @@ void CCAtlasNode::draw()
 		glBlendFunc( m_tBlendFunc.src, m_tBlendFunc.dst );
 	}
 
-	m_pTextureAtlas->drawQuads();
+	CGRect visibleRect;
+	if (visibleRectInNodeSpace(&visibleRect))
+	{
+		unsigned int uQuads = m_pTextureAtlas->getTotalQuads();
+		unsigned int uDrawn = m_pTextureAtlas->drawNumberOfQuadsInRect(uQuads, visibleRect);
+		CCDirector::sharedDirector()->addCullingStats(uQuads, uQuads - uDrawn);
+	}
+	else
+	{
+		m_pTextureAtlas->drawQuads();
+	}
 
 	if( newBlend )
 		glBlendFunc(CC_BLEND_SRC, CC_BLEND_DST);
@@ -0,0 +1,126 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCXInternedString.h"
+#include <stdlib.h>
+#include <string.h>
+
+namespace   cocos2d {
+
+// the pool is an open addressing set of the interned strings, it only grows
+typedef struct
+{
+	const char *string;
+	unsigned int hash;
+} tInternedSlot;
+
+static tInternedSlot *s_pInternedSlots = NULL;
+static unsigned int s_uInternedCapacity = 0;
+static unsigned int s_uInternedCount = 0;
+
+static void insertInternedSlot(tInternedSlot *pSlots, unsigned int uCapacity, const char *pszString, unsigned int uHash)
+{
+	unsigned int uMask = uCapacity - 1;
+	unsigned int i = uHash & uMask;
+
+	while (pSlots[i].string)
+	{
+		i = (i + 1) & uMask;
+	}
+
+	pSlots[i].string = pszString;
+	pSlots[i].hash = uHash;
+}
+
+static void growInternedPool(void)
+{
+	unsigned int uCapacity = s_uInternedCapacity ? s_uInternedCapacity * 2 : 256;
+	tInternedSlot *pSlots = (tInternedSlot*)calloc(uCapacity, sizeof(tInternedSlot));
+
+	for (unsigned int i = 0; i < s_uInternedCapacity; ++i)
+	{
+		if (s_pInternedSlots[i].string)
+		{
+			insertInternedSlot(pSlots, uCapacity, s_pInternedSlots[i].string, s_pInternedSlots[i].hash);
+		}
+	}
+
+	free(s_pInternedSlots);
+	s_pInternedSlots = pSlots;
+	s_uInternedCapacity = uCapacity;
+}
+
+CCXInternedString::CCXInternedString(const char *pszString)
+: m_pszString(NULL)
+, m_uHash(0)
+{
+	intern(pszString);
+}
+
+CCXInternedString::CCXInternedString(const std::string& str)
+: m_pszString(NULL)
+, m_uHash(0)
+{
+	intern(str.c_str());
+}
+
+void CCXInternedString::intern(const char *pszString)
+{
+	if (! pszString)
+	{
+		return;
+	}
+
+	m_uHash = hashString(pszString);
+
+	if (s_uInternedCapacity > 0)
+	{
+		unsigned int uMask = s_uInternedCapacity - 1;
+		for (unsigned int i = m_uHash & uMask; s_pInternedSlots[i].string; i = (i + 1) & uMask)
+		{
+			if (s_pInternedSlots[i].hash == m_uHash && strcmp(s_pInternedSlots[i].string, pszString) == 0)
+			{
+				m_pszString = s_pInternedSlots[i].string;
+				return;
+			}
+		}
+	}
+
+	// keep the pool at most half full
+	if ((s_uInternedCount + 1) * 2 > s_uInternedCapacity)
+	{
+		growInternedPool();
+	}
+
+	size_t uLength = strlen(pszString);
+	char *pszCopy = (char*)malloc(uLength + 1);
+	memcpy(pszCopy, pszString, uLength + 1);
+
+	insertInternedSlot(s_pInternedSlots, s_uInternedCapacity, pszCopy, m_uHash);
+	++s_uInternedCount;
+
+	m_pszString = pszCopy;
+}
+
+}//namespace   cocos2d 
@@ -24,7 +24,7 @@ THE SOFTWARE.
 
 
 #include "NSData.h"
-#include "support/file_support/FileData.h"
+#include "CCXFileUtils.h"
 
 #include <stdio.h>
 
@@ -34,11 +34,22 @@ namespace   cocos2d {
 NSData::NSData(void)
 {
 	m_pData = NULL;
+	m_nSize = 0;
+	m_bMapped = false;
+	m_pOwner = NULL;
 }
 
 NSData::~NSData(void)
 {
-	if (m_pData)
+	if (m_pOwner)
+	{
+		m_pOwner->release();
+	}
+	else if (m_bMapped)
+	{
+		FileUtils::unmapFileData((unsigned char*)m_pData, m_nSize);
+	}
+	else if (m_pData)
 	{
 		delete[] m_pData;
 	}
@@ -46,20 +57,16 @@ NSData::~NSData(void)
 
 NSData* NSData::dataWithContentsOfFile(const string &strPath)
 {
-    FileData data;
-    unsigned long  nSize = 0;
-    unsigned char* pBuffer = data.getFileData(strPath.c_str(), "rb", &nSize);
-
-    if (! pBuffer)
-    {
-        return NULL;
-    }
+	unsigned long  nSize = 0;
+	unsigned char* pBuffer = CCFileUtils::getFileData(strPath.c_str(), "rb", &nSize);
 
-	NSData *pRet = new NSData();
-    pRet->m_pData = new char[nSize];
-    memcpy(pRet->m_pData, pBuffer, nSize);
+	// the buffer is kept as is, no copy
+	return dataWithBytesNoCopy(pBuffer, nSize);
+}
 
-	return pRet;
+NSData* NSData::dataWithContentsOfMappedFile(const string &strPath)
+{
+	return CCFileUtils::getFileDataView(strPath.c_str());
 }
 
 void* NSData::bytes(void)
@@ -67,9 +74,65 @@ void* NSData::bytes(void)
 	return m_pData;
 }
 
-//@todo implement
+unsigned long NSData::getSize(void)
+{
+	return m_nSize;
+}
+
+NSData* NSData::subdataWithRange(unsigned long uLocation, unsigned long uLength)
+{
+	if (uLocation > m_nSize || uLength > m_nSize - uLocation)
+	{
+		return NULL;
+	}
+
+	NSData *pRet = new NSData();
+	pRet->m_pData = m_pData + uLocation;
+	pRet->m_nSize = uLength;
+	// the views of a view share the bytes of the first owner
+	pRet->m_pOwner = m_pOwner ? m_pOwner : this;
+	pRet->m_pOwner->retain();
+
+	return pRet;
+}
+
 NSData* NSData::dataWithBytes(unsigned char *pBytes, int size)
 {
-	return NULL;
+	if (! pBytes || size <= 0)
+	{
+		return NULL;
+	}
+
+	NSData *pRet = new NSData();
+	pRet->m_pData = new char[size];
+	memcpy(pRet->m_pData, pBytes, size);
+	pRet->m_nSize = size;
+
+	return pRet;
+}
+
+NSData* NSData::dataWithBytesNoCopy(unsigned char *pBytes, unsigned long size)
+{
+	if (! pBytes)
+	{
+		return NULL;
+	}
+
+	NSData *pRet = new NSData();
+	pRet->m_pData = (char*)pBytes;
+	pRet->m_nSize = size;
+
+	return pRet;
+}
+
+NSData* NSData::dataWithMappedBytes(unsigned char *pBytes, unsigned long size)
+{
+	NSData *pRet = dataWithBytesNoCopy(pBytes, size);
+	if (pRet)
+	{
+		pRet->m_bMapped = true;
+	}
+
+	return pRet;
 }
 }//namespace   cocos2d 
@@ -105,6 +105,16 @@ namespace cocos2d
 		/** sets a new vertex at a given position */
 		void setVertex(ccGridSize pos, ccVertex3F vertex);
 
+		/** returns the (gridSize.x+1) * (gridSize.y+1) vertices of the grid.
+		The vertex at (x, y) is at index x * (gridSize.y+1) + y, so each column is contiguous.
+		@since v0.99.5
+		*/
+		inline ccVertex3F* getVertices(void) { return (ccVertex3F*)m_pVertices; }
+		/** returns the original (non-transformed) vertices, with the same layout as getVertices
+		@since v0.99.5
+		*/
+		inline ccVertex3F* getOriginalVertices(void) { return (ccVertex3F*)m_pOriginalVertices; }
+
 		virtual void blit(void);
 		virtual void reuse(void);
 		virtual void calculateVertexPoints(void);
@@ -136,6 +146,16 @@ namespace cocos2d
 		/** sets a new tile */
 		void setTile(ccGridSize pos, ccQuad3 coords);
 
+		/** returns the gridSize.x * gridSize.y tiles of the grid.
+		The tile at (x, y) is at index x * gridSize.y + y, so each column is contiguous.
+		@since v0.99.5
+		*/
+		inline ccQuad3* getTiles(void) { return (ccQuad3*)m_pVertices; }
+		/** returns the original (untransformed) tiles, with the same layout as getTiles
+		@since v0.99.5
+		*/
+		inline ccQuad3* getOriginalTiles(void) { return (ccQuad3*)m_pOriginalVertices; }
+
 		virtual void blit(void);
 		virtual void reuse(void);
 		virtual void calculateVertexPoints(void);
@@ -68,6 +68,26 @@ namespace cocos2d
 		/** sets a new vertex to a certain position of the grid */
 		void setVertex(ccGridSize pos, ccVertex3F vertex);
 
+		/** returns the vertices of the grid, see CCGrid3D::getVertices
+		@since v0.99.5
+		*/
+		ccVertex3F* vertices(void);
+		/** returns the non-transformed vertices of the grid, see CCGrid3D::getOriginalVertices
+		@since v0.99.5
+		*/
+		ccVertex3F* originalVertices(void);
+
+		/** computes the columns [nBegin, nEnd) of the grid from the original vertices.
+		It is called by updateAllColumns from several threads: it may only write to the vertices of its columns.
+		@since v0.99.5
+		*/
+		virtual void updateColumns(ccTime time, ccVertex3F *pVertices, const ccVertex3F *pOriginal, int nBegin, int nEnd) {}
+		/** calls updateColumns on every column of the grid.
+		Big grids are split between the worker threads of ccxParallelFor.
+		@since v0.99.5
+		*/
+		void updateAllColumns(ccTime time);
+
 	public:
 		/** creates the action with size and duration */
         static CCGrid3DAction* actionWithSize(ccGridSize gridSize, ccTime duration);
@@ -84,6 +104,26 @@ namespace cocos2d
 		/** sets a new tile to a certain position of the grid */
 		void setTile(ccGridSize pos, ccQuad3 coords);
 
+		/** returns the tiles of the grid, see CCTiledGrid3D::getTiles
+		@since v0.99.5
+		*/
+		ccQuad3* tiles(void);
+		/** returns the non-transformed tiles of the grid, see CCTiledGrid3D::getOriginalTiles
+		@since v0.99.5
+		*/
+		ccQuad3* originalTiles(void);
+
+		/** computes the tile columns [nBegin, nEnd) of the grid from the original tiles.
+		It is called by updateAllColumns from several threads: it may only write to the tiles of its columns.
+		@since v0.99.5
+		*/
+		virtual void updateColumns(ccTime time, ccQuad3 *pTiles, const ccQuad3 *pOriginal, int nBegin, int nEnd) {}
+		/** calls updateColumns on every tile column of the grid.
+		Big grids are split between the worker threads of ccxParallelFor.
+		@since v0.99.5
+		*/
+		void updateAllColumns(ccTime time);
+
 		/** returns the grid */
 		virtual CCGridBase* getGrid(void);
 
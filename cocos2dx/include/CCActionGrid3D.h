@@ -45,6 +45,7 @@ namespace cocos2d
 
 		virtual NSObject* copyWithZone(NSZone* pZone);
 		virtual void update(ccTime time);
+		virtual void updateColumns(ccTime time, ccVertex3F *pVertices, const ccVertex3F *pOriginal, int nBegin, int nEnd);
 
 	public:
 		/** create the action */
@@ -99,6 +100,7 @@ namespace cocos2d
 		bool initWithPosition(CGPoint pos, float r, ccGridSize gridSize, ccTime duration);
 		virtual NSObject* copyWithZone(NSZone* pZone);
 		virtual void update(ccTime time);
+		virtual void updateColumns(ccTime time, ccVertex3F *pVertices, const ccVertex3F *pOriginal, int nBegin, int nEnd);
 
 	public:
 		/** creates the action with center position, radius, a grid size and duration */
@@ -136,6 +138,7 @@ namespace cocos2d
 			ccGridSize gridSize, ccTime duration);
 		virtual NSObject* copyWithZone(NSZone* pZone);
 		virtual void update(ccTime time);
+		virtual void updateColumns(ccTime time, ccVertex3F *pVertices, const ccVertex3F *pOriginal, int nBegin, int nEnd);
 
 	public:
 		/** creates the action with radius, number of waves, amplitude, a grid size and duration */
@@ -185,6 +188,7 @@ namespace cocos2d
 		bool initWithWaves(int wav, float amp, ccGridSize gridSize, ccTime duration);
 		virtual NSObject* copyWithZone(NSZone* pZone);
 		virtual void update(ccTime time);
+		virtual void updateColumns(ccTime time, ccVertex3F *pVertices, const ccVertex3F *pOriginal, int nBegin, int nEnd);
 
 	public:
 		/** creates the action with amplitude, a grid and duration */
@@ -211,6 +215,7 @@ namespace cocos2d
 			ccTime duration);
 		virtual NSObject* copyWithZone(NSZone* pZone);
 		virtual void update(ccTime time);
+		virtual void updateColumns(ccTime time, ccVertex3F *pVertices, const ccVertex3F *pOriginal, int nBegin, int nEnd);
 
 	public:
 		/** initializes the action with amplitude, horizontal sin, vertical sin, a grid and duration */
@@ -244,6 +249,7 @@ namespace cocos2d
 			ccTime duration);
 		virtual NSObject* copyWithZone(NSZone* pZone);
 		virtual void update(ccTime time);
+		virtual void updateColumns(ccTime time, ccVertex3F *pVertices, const ccVertex3F *pOriginal, int nBegin, int nEnd);
 
 	public:
 		/** creates the action with center position, number of twirls, amplitude, a grid size and duration */
@@ -629,6 +629,8 @@ protected:
 	CCAnimation *m_pAnimation;
 	CCSpriteFrame *m_pOrigFrame;
     bool m_bRestoreOriginalFrame;
+	// index of the frame that was set last, (unsigned int)-1 before the first update
+	unsigned int m_uFrameIndex;
 };
 
 }
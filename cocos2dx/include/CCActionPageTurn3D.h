@@ -41,6 +41,7 @@ namespace cocos2d
 	{
 	public:
 		virtual void update(ccTime time);
+		virtual void updateColumns(ccTime time, ccVertex3F *pVertices, const ccVertex3F *pOriginal, int nBegin, int nEnd);
 
 	public:
 		/** create the action */
@@ -203,6 +203,7 @@ namespace cocos2d
 
 		virtual NSObject* copyWithZone(NSZone* pZone);
 		virtual void update(ccTime time);
+		virtual void updateColumns(ccTime time, ccQuad3 *pTiles, const ccQuad3 *pOriginal, int nBegin, int nEnd);
 
 	public:
 		/** creates the action with a number of waves, the waves amplitude, the grid size and the duration */
@@ -232,6 +233,7 @@ namespace cocos2d
 		bool initWithJumps(int j, float amp, ccGridSize gridSize, ccTime duration);
 		virtual NSObject* copyWithZone(NSZone* pZone);
 		virtual void update(ccTime time);
+		virtual void updateColumns(ccTime time, ccQuad3 *pTiles, const ccQuad3 *pOriginal, int nBegin, int nEnd);
 
 	public:
 		/** creates the action with the number of jumps, the sin amplitude, the grid size and the duration */
@@ -28,11 +28,13 @@ THE SOFTWARE.
 #include "NSMutableArray.h"
 #include "CGGeometry.h"
 #include "CCXCocos2dDefine.h"
+#include "selector_protocol.h"
 #include <string>
 
 namespace   cocos2d {
 	class CCSpriteFrame;
     class CCTexture2D;
+	class CCSprite;
 	/** A CCAnimation object is used to perform animations on the CCSprite objects.
 
 	The CCAnimation object contains CCSpriteFrame objects, and a possible delay between the frames.
@@ -155,6 +157,59 @@ namespace   cocos2d {
 		/** Creates a CCAnimation with a name, delay and an array of CCSpriteFrames. */
 		static CCAnimation* animationWithName(const char *pszName, float fDelay, NSArray<CCSpriteFrame*> *pFrames);
 	};
+
+	/** A CCAnimationGroup plays a CCAnimation in loop on many sprites with a single clock.
+
+	The frame index is computed once per tick for the whole group, and the sprites only get a new
+	display frame when it changes. It is cheaper than running one CCAnimate per sprite when a crowd
+	plays the same animation in sync.
+
+	While it is running, the group is scheduled on the CCScheduler, which retains it.
+	@since v0.99.5
+	*/
+	class CCX_DLL CCAnimationGroup : public NSObject, public SelectorProtocol
+	{
+	public:
+		CCAnimationGroup(void);
+		~CCAnimationGroup(void);
+
+		/** get the animation played by the group */
+		inline CCAnimation* getAnimation(void) { return m_pAnimation; }
+		/** get the index of the frame being displayed */
+		inline unsigned int getFrameIndex(void) { return m_uFrameIndex; }
+		/** whether or not the group is scheduled */
+		inline bool isRunning(void) { return m_bIsRunning; }
+
+		/** Initializes the group with an animation, the animation is retained */
+		bool initWithAnimation(CCAnimation *pAnimation);
+
+		/** adds a sprite to the group, it displays the current frame right away. The sprite is retained */
+		void addSprite(CCSprite *pSprite);
+		/** removes a sprite from the group, it keeps the frame it was displaying */
+		void removeSprite(CCSprite *pSprite);
+		/** removes all the sprites from the group */
+		void removeAllSprites(void);
+
+		/** starts the clock of the group */
+		void start(void);
+		/** stops the clock of the group, the sprites keep their frame */
+		void stop(void);
+
+		virtual void update(ccTime dt);
+		virtual void selectorProtocolRetain(void);
+		virtual void selectorProtocolRelease(void);
+
+	public:
+		/** Creates a group with an animation */
+		static CCAnimationGroup* groupWithAnimation(CCAnimation *pAnimation);
+
+	protected:
+		CCAnimation *m_pAnimation;
+		NSMutableArray<CCSprite*> *m_pSprites;
+		ccTime m_fElapsed;
+		unsigned int m_uFrameIndex;
+		bool m_bIsRunning;
+	};
 } // end of name sapce cocos2d
 
 #endif // __CC_ANIMATION_H__
@@ -67,10 +67,17 @@ namespace cocos2d
 		*/
 		CCAnimation* animationByName(const char* name);
 
+		/** Returns a CCAnimation that was previously added.
+		The name is already hashed and is compared by pointer, keep it in the code that
+		looks the animation up every frame.
+		*/
+		CCAnimation* animationByName(const CCXInternedString& name);
+
 		bool init(void);
 
 	private:
-		NSMutableDictionary<std::string, CCAnimation*> *m_pAnimations;
+		// the names are interned by addAnimation
+		NSMutableDictionary<CCXInternedString, CCAnimation*> *m_pAnimations;
 		static CCAnimationCache *s_pSharedAnimationCache;
 	};
 }
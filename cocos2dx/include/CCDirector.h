@@ -178,6 +178,17 @@ typedef enum {
 	CCDeviceOrientationLandscapeRight = kCCDeviceOrientationLandscapeRight,
 } ccDeviceOrientation;
 
+/** @typedef ccCullingStats
+ Viewport culling counters of one frame.
+ @since v0.99.5
+ */
+typedef struct _ccCullingStats {
+	/// sprites and quads that were tested against the visible rect
+	unsigned int tested;
+	/// sprites and quads that were outside of it and were not drawn
+	unsigned int culled;
+} ccCullingStats;
+
 class CCLabelTTF;
 class CCScene;
 class CCXEGLView;
@@ -227,6 +238,69 @@ public:
 	/** Display the FPS on the bottom-left corner */
 	inline void setDisplayFPS(bool bDisplayFPS) { m_bDisplayFPS = bDisplayFPS; }
 
+	/** Whether or not sprites, batched quads and atlas nodes outside of the visible rect are skipped when drawing.
+	 @since v0.99.5
+	 */
+	inline bool isCullingEnabled(void) { return m_bCullingEnabled; }
+	/** Enables viewport culling. It is disabled by default.
+	 Don't enable it if nodes are drawn with a custom viewport or projection, except inside a CCRenderTexture.
+	 @since v0.99.5
+	 */
+	inline void setCullingEnabled(bool bCullingEnabled) { m_bCullingEnabled = bCullingEnabled; }
+
+	/** Stops culling until the matching resumeCulling, while nodes are drawn somewhere else than the window,
+	 eg: CCRenderTexture does it between begin and end. The calls can be nested.
+	 @since v0.99.5
+	 */
+	inline void suspendCulling(void) { ++m_uCullingSuspended; }
+	inline void resumeCulling(void) { --m_uCullingSuspended; }
+	/** Whether the nodes drawn now are culled: culling is enabled and not suspended.
+	 @since v0.99.5
+	 */
+	inline bool isCullingActive(void) { return m_bCullingEnabled && m_uCullingSuspended == 0; }
+
+	/** Culling counters of the last drawn frame
+	 @since v0.99.5
+	 */
+	inline const ccCullingStats& getCullingStats(void) { return m_tCullingStats; }
+	/** Adds to the culling counters of the frame being drawn. Called by the nodes that do the culling.
+	 @since v0.99.5
+	 */
+	inline void addCullingStats(unsigned int uTested, unsigned int uCulled)
+	{
+		m_tFrameCullingStats.tested += uTested;
+		m_tFrameCullingStats.culled += uCulled;
+	}
+
+	/** Fixed simulation step, in seconds. When it is greater than 0 the scheduler is ticked with
+	 a constant delta time, as many times per drawn frame as the elapsed time allows, and the
+	 remainder is carried to the next frame. Default: 0, the scheduler gets the real delta time.
+	 @since v0.99.5
+	 */
+	inline ccTime getFixedTimeStep(void) { return m_fFixedTimeStep; }
+	void setFixedTimeStep(ccTime fFixedTimeStep);
+
+	/** Maximum number of fixed steps run for a single frame. The time that doesn't fit is dropped,
+	 so a slow frame can't make the next ones slower. Default: 5
+	 @since v0.99.5
+	 */
+	inline unsigned int getMaxFixedStepsPerFrame(void) { return m_uMaxFixedSteps; }
+	inline void setMaxFixedStepsPerFrame(unsigned int uMaxSteps) { m_uMaxFixedSteps = (uMaxSteps > 0 ? uMaxSteps : 1); }
+
+	/** How far, from 0 to 1, the drawn frame is between the last fixed step and the next one.
+	 Nodes driven by the fixed steps can interpolate their previous and current state with it.
+	 It is 1 when no fixed time step is set.
+	 @since v0.99.5
+	 */
+	inline ccTime getInterpolationAlpha(void) { return m_fInterpolationAlpha; }
+
+	/** Average and variance of the frame time, in seconds, measured over the last
+	 CC_DIRECTOR_FPS_INTERVAL seconds
+	 @since v0.99.5
+	 */
+	inline ccTime getFrameTimeAverage(void) { return m_fFrameTimeAverage; }
+	inline ccTime getFrameTimeVariance(void) { return m_fFrameTimeVariance; }
+
 	/** Get the CCXEGLView, where everything is rendered */
 	inline CC_GLVIEW* getOpenGLView(void) { return m_pobOpenGLView; }
 	void setOpenGLView(CC_GLVIEW *pobOpenGLView);
@@ -269,6 +343,12 @@ public:
 	*/
 	CGSize getDisplaySizeInPixels(void);
 
+	/** returns the rect of the window that is visible, in points.
+	It is the rect used by the viewport culling.
+	@since v0.99.5
+	*/
+	CGRect getVisibleRect(void);
+
 	/** changes the projection size */
 	void reshapeProjection(CGSize newWindowSize);
 
@@ -473,7 +553,10 @@ protected:
 	void showFPS(void) {}
 #endif // CC_DIRECTOR_FAST_FPS
 
-/** calculates delta time since last time it was called */	void calculateDeltaTime();protected:
+/** calculates delta time since last time it was called */	void calculateDeltaTime();
+	/** ticks the scheduler with the delta time of the frame, or with the fixed time steps */
+	void tickScheduler(void);
+protected:
 	/* The CCXEGLView, where everything is rendered */
     CC_GLVIEW	*m_pobOpenGLView;
 
@@ -485,6 +568,13 @@ protected:
 	
 	bool m_bDisplayFPS;
 	int  m_nFrames;
+
+	/* viewport culling */
+	bool m_bCullingEnabled;
+	unsigned int m_uCullingSuspended;
+	ccCullingStats m_tCullingStats;
+	ccCullingStats m_tFrameCullingStats;
+
 	ccTime m_fAccumDt;
 	ccTime m_fFrameRate;
 #if	CC_DIRECTOR_FAST_FPS
@@ -515,6 +605,19 @@ protected:
 
 	/* whether or not the next delta time will be zero */
 	bool m_bNextDeltaTimeZero;
+
+	/* fixed time step mode */
+	ccTime m_fFixedTimeStep;
+	ccTime m_fFixedTimeAccum;
+	ccTime m_fInterpolationAlpha;
+	unsigned int m_uMaxFixedSteps;
+
+	/* frame time statistics */
+	ccTime m_fFrameTimeSum;
+	ccTime m_fFrameTimeSquaredSum;
+	unsigned int m_uFrameTimeSamples;
+	ccTime m_fFrameTimeAverage;
+	ccTime m_fFrameTimeVariance;
 	
 	/* projection used */
 	ccDirectorProjection m_eProjection;
@@ -35,14 +35,19 @@ THE SOFTWARE.
  - ccDrawCircle
  - ccDrawQuadBezier
  - ccDrawCubicBezier
+ - ccDrawSolidPoly
  
  You can change the color, width and other property by calling the
  glColor4ub(), glLineWitdh(), glPointSize().
  
- @warning These functions draws the Line, Point, Polygon, immediately. They aren't batched. If you are going to make a game that depends on these primitives, I suggest creating a batch.
+ Outside of a batch these functions draw the Line, Point, Polygon immediately.
+ Between ccDrawBeginBatch() and ccDrawEndBatch() they are only accumulated, with the
+ color set by ccDrawColor4B(), and everything is drawn with one glDrawArrays per
+ kind of primitive: first the filled polygons, then the lines, then the points.
  */
 
 #include "CGGeometry.h"	// for CGPoint
+#include "ccTypes.h"
 namespace   cocos2d {
 
 /** draws a point given x and y coordinate measured in points */
@@ -73,6 +78,44 @@ void CCX_DLL ccDrawQuadBezier(CGPoint origin, CGPoint control, CGPoint destinati
  @since v0.8
  */
 void CCX_DLL ccDrawCubicBezier(CGPoint origin, CGPoint control1, CGPoint control2, CGPoint destination, int segments);
+
+/** draws a filled convex polygon given a pointer to CGPoint coordiantes and the number of vertices measured in points.
+ @since v0.99.5
+ */
+void CCX_DLL ccDrawSolidPoly( const CGPoint *poli, int numberOfPoints );
+
+/** sets the color of the following primitives.
+ It is used as the per vertex color of batched primitives, and as glColor4ub() otherwise.
+ @since v0.99.5
+ */
+void CCX_DLL ccDrawColor4B( GLubyte r, GLubyte g, GLubyte b, GLubyte a );
+
+/** starts accumulating the primitives instead of drawing them.
+ The batch is drawn with the transform and the line width that are current when it is flushed,
+ so begin and end it in the same draw(). Batches can be nested, only the outer one is flushed.
+ @since v0.99.5
+ */
+void CCX_DLL ccDrawBeginBatch(void);
+
+/** draws the accumulated primitives and stops batching
+ @since v0.99.5
+ */
+void CCX_DLL ccDrawEndBatch(void);
+
+/** draws the accumulated primitives now, the batch goes on
+ @since v0.99.5
+ */
+void CCX_DLL ccDrawFlush(void);
+
+/** sets the line width, flushing the batched primitives drawn with the previous width
+ @since v0.99.5
+ */
+void CCX_DLL ccDrawLineWidth( GLfloat width );
+
+/** sets the point size, flushing the batched primitives drawn with the previous size
+ @since v0.99.5
+ */
+void CCX_DLL ccDrawPointSize( GLfloat size );
 }//namespace   cocos2d 
 
 #endif // __CCDRAWING_PRIMITIVES__
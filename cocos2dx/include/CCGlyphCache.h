@@ -0,0 +1,128 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CCGLYPH_CACHE_H__
+#define __CCGLYPH_CACHE_H__
+
+#include <map>
+#include <string>
+#include "NSObject.h"
+#include "NSMutableArray.h"
+#include "NSMutableDictionary.h"
+#include "CGGeometry.h"
+
+namespace cocos2d {
+
+class CCTexture2D;
+
+/** a glyph of a CCGlyphFont
+@since v0.99.5
+*/
+typedef struct _ccGlyph
+{
+	//! the page holding the glyph, NULL for a glyph without pixels such as a space
+	CCTexture2D		*texture;
+	//! the glyph in its page, in pixels
+	CGRect			rect;
+	//! how far the pen moves after the glyph, in pixels
+	float			advance;
+} ccGlyph;
+
+/**
+@brief The glyphs of a TrueType font at one size.
+
+Each glyph is rasterized once with the platform CCXBitmapDC, the first time it is asked for,
+and packed in A8 texture pages shared by all the labels using the font.
+The glyphs are white, their color comes from the label.
+@since v0.99.5
+*/
+class CCX_DLL CCGlyphFont : public NSObject
+{
+public:
+	CCGlyphFont(void);
+	virtual ~CCGlyphFont(void);
+
+	/** initializes the font with a font name and a font size in pixels */
+	bool initWithFontName(const char *fontName, float fontSize);
+
+	/** returns the glyph of a unicode character, rasterizing it if needed.
+	Returns NULL if the glyph can't be cached, for example if it doesn't fit in a page.
+	*/
+	const ccGlyph* glyphForCharacter(unsigned int uCharacter);
+
+	/** the height of the tallest glyph rasterized so far, in pixels */
+	inline float getLineHeight(void) { return m_fLineHeight; }
+	/** the number of texture pages used by the font */
+	inline unsigned int getPageCount(void) { return m_pPages->count(); }
+
+	/** returns the unicode character at the start of an UTF-8 string and moves past it */
+	static unsigned int nextCharacter(const char **ppszText);
+
+protected:
+	bool rasterizeGlyph(unsigned int uCharacter, ccGlyph *pGlyph);
+	CCTexture2D* reserveRect(unsigned int uWidth, unsigned int uHeight, CGPoint *pOrigin);
+
+protected:
+	std::string m_sFontName;
+	float m_fFontSize;
+	float m_fLineHeight;
+
+	std::map<unsigned int, ccGlyph> m_tGlyphs;
+	NSMutableArray<CCTexture2D*> *m_pPages;
+
+	// shelf packing in the last page
+	unsigned int m_uPageSize;
+	unsigned int m_uPenX;
+	unsigned int m_uPenY;
+	unsigned int m_uShelfHeight;
+};
+
+/**
+@brief Singleton that keeps a CCGlyphFont per font name and size.
+@since v0.99.5
+*/
+class CCX_DLL CCGlyphCache : public NSObject
+{
+public:
+	CCGlyphCache(void);
+	virtual ~CCGlyphCache(void);
+
+	/** returns the shared instance of the cache */
+	static CCGlyphCache* sharedGlyphCache(void);
+
+	/** purges the cache. It releases the fonts and their pages, labels still using them keep them alive */
+	static void purgeSharedGlyphCache(void);
+
+	/** returns the glyphs of a font at a size in pixels, creating them if needed */
+	CCGlyphFont* fontWithName(const char *fontName, float fontSize);
+
+	/** removes all the fonts from the cache */
+	void removeAllFonts(void);
+
+protected:
+	NSMutableDictionary<std::string, CCGlyphFont*> *m_pFonts;
+};
+
+}//namespace cocos2d
+
+#endif //__CCGLYPH_CACHE_H__
@@ -28,19 +28,30 @@ THE SOFTWARE.
 
 namespace cocos2d{
 
+	class CCGlyphFont;
+
 	/** @brief CCLabelTTF is a subclass of CCTextureNode that knows how to render text labels
 	*
 	* All features from CCTextureNode are valid in CCLabelTTF
 	*
-	* CCLabelTTF objects are slow. Consider using CCLabelAtlas or CCBitmapFontAtlas instead.
+	* Single line labels without dimensions are laid out with glyphs from the shared CCGlyphCache,
+	* so changing their string only updates vertices. The other labels render the whole string
+	* in a texture, which is slow. Consider using CCLabelAtlas or CCBitmapFontAtlas instead.
 	*/
 	class CCX_DLL CCLabelTTF : public CCSprite, public CCLabelProtocol
 	{
 	public:
 		CCLabelTTF()
 			:m_sFontName("")
+			,m_pGlyphFont(NULL)
+			,m_pGlyphQuads(NULL)
+			,m_pGlyphPages(NULL)
+			,m_pGlyphIndices(NULL)
+			,m_uGlyphCount(0)
+			,m_uGlyphCapacity(0)
+			,m_bUsesGlyphCache(false)
 		{}
-		virtual ~CCLabelTTF(){ m_sFontName.clear(); }
+		virtual ~CCLabelTTF();
 		char * description();
 		/** creates a CCLabelTTF from a fontname, alignment, dimension and font size */
 		static CCLabelTTF * labelWithString(const char *label, CGSize dimensions, UITextAlignment alignment, const char *fontName, float fontSize);
@@ -52,11 +63,19 @@ namespace cocos2d{
 		bool initWithString(const char *label, const char *fontName, float fontSize);
 
 		/** changes the string to render
-		* @warning Changing the string is as expensive as creating a new CCLabelTTF. To obtain better performance use CCLabelAtlas
+		* @warning Unless the label uses the glyph cache, changing the string is as expensive as creating a new CCLabelTTF. To obtain better performance use CCLabelAtlas
 		*/
 		virtual void setString(const char *label);
 		virtual const char* getString(void);
 
+		virtual void draw(void);
+
+		/** whether the labels that can be laid out from the glyph cache use it. Default is true
+		@since v0.99.5
+		*/
+		static void setIsGlyphCacheEnabled(bool bEnabled);
+		static bool isGlyphCacheEnabled(void);
+
 		virtual CCLabelProtocol* convertToLabelProtocol() { return (CCLabelProtocol*)this; }
 	protected:
 		CGSize m_tDimensions;
@@ -64,6 +83,17 @@ namespace cocos2d{
 		std::string m_sFontName;
 		float m_fFontSize;
 		std::string m_sString;
+
+		bool updateGlyphQuads(const char *label);
+
+		// glyph cache layout
+		CCGlyphFont *m_pGlyphFont;
+		ccV3F_C4B_T2F_Quad *m_pGlyphQuads;
+		CCTexture2D **m_pGlyphPages;
+		GLushort *m_pGlyphIndices;
+		unsigned int m_uGlyphCount;
+		unsigned int m_uGlyphCapacity;
+		bool m_bUsesGlyphCache;
 	};
 
 } //namespace cocos2d
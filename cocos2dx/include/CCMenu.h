@@ -92,6 +92,11 @@ namespace cocos2d{
 		virtual void ccTouchCancelled(CCTouch *touch, UIEvent* event);
 		virtual void ccTouchMoved(CCTouch* touch, UIEvent* event);
 
+		/** the union of the rects of the visible items, in world space
+		@since v0.99.5
+		*/
+		virtual bool getTouchHitRect(CGRect *pRect);
+
         /**
         @brief For PC event handle functions
         @since v0.99.5
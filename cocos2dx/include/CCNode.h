@@ -43,6 +43,7 @@ namespace   cocos2d {
 	class CCAction;
 	class CCRGBAProtocol;
 	class CCLabelProtocol;
+	struct _tagHashElement;
 
 	enum {
 		kCCNodeTagInvalid = -1,
@@ -215,6 +216,20 @@ namespace   cocos2d {
 		bool m_bIsTransformGLDirty;
 #endif
 
+		// children were appended or reordered out of z order, sort them before the next visit
+		bool m_bIsReorderChildDirty;
+		bool m_bIsChildTagIndexEnabled;
+
+		// order in which the node was added to (or reordered in) its parent, breaks z ties
+		unsigned int m_uOrderOfArrival;
+
+		// tag -> child index, only used when the tag index is enabled
+		struct _tagHashElement *m_pChildrenByTag;
+
+		//! removes a child without checking that it belongs to this node.
+		//! Removing the last child is O(1).
+		void detachChild(CCNode *child, bool doCleanup);
+
 	private:
 
 		//! lazy allocs
@@ -226,7 +241,13 @@ namespace   cocos2d {
 		//! used internally to alter the zOrder variable. DON'T call this method manually
 		void setZOrder(int z);
 
-		void detachChild(CCNode *child, bool doCleanup);
+		//! tag index helpers
+		void addChildToTagIndex(CCNode *child);
+		void removeChildFromTagIndex(CCNode *child);
+		void removeAllChildrenFromTagIndex(void);
+
+		//! children sort predicate: z order, then order of arrival
+		static bool isChildOrderLess(CCNode *pFirst, CCNode *pSecond);
 
 		typedef void (CCNode::*callbackFunc)(void);
 
@@ -247,6 +268,12 @@ namespace   cocos2d {
 		*/
 		static CCNode * node(void);
 
+		/** a counter bumped whenever the transform, the parent or the visibility of any node changes.
+		Caches of world space data compare it to the value they were built with to know when to refresh.
+		@since v0.99.5
+		*/
+		static unsigned int getTransformGeneration(void);
+
 		//scene managment
 
 		/** callback that is called every time the CCNode enters the 'stage'.
@@ -322,6 +349,22 @@ namespace   cocos2d {
 		*/
 		virtual void reorderChild(CCNode * child, int zOrder);
 
+		/** Sorts the children by z order if any of them was added or reordered since the last sort.
+		addChild and reorderChild only mark the node dirty, the children are sorted once before
+		they are visited or returned by getChildren. Children with the same z order keep the order
+		in which they were added or reordered.
+		Subclasses that walk m_pChildren in order call it first.
+		@since v0.99.5
+		*/
+		virtual void sortAllChildren(void);
+
+		/** Whether getChildByTag uses a hash index of the children's tags instead of a linear search.
+		Useful for nodes with many tagged children. Default is false.
+		@since v0.99.5
+		*/
+		void setIsChildTagIndexEnabled(bool bEnabled);
+		bool getIsChildTagIndexEnabled(void);
+
 		/** Stops all running actions and schedulers
 		@since v0.8
 		*/
@@ -498,6 +541,25 @@ namespace   cocos2d {
 		*/
 		CGAffineTransform worldToNodeTransform(void);
 
+		/** Computes the same matrix as nodeToWorldTransform, in Pixels, but returns false when
+		the node or one of its ancestors has a vertexZ, a modified camera or an active grid,
+		because then the position on the screen can't be obtained from the affine transforms.
+		@since v0.99.5
+		*/
+		bool nodeToScreenTransform(CGAffineTransform *pTransform);
+
+		/** Returns true if the rect, in local Pixels, is known to be completely outside of
+		CCDirector::getVisibleRect. It always returns false when culling is disabled or suspended in the director.
+		@since v0.99.5
+		*/
+		bool isRectCulled(const CGRect& rectInPixels);
+
+		/** Gets the visible rect of the director in local Pixels, as an axis aligned box.
+		Returns false when culling is disabled or suspended, or when nodeToScreenTransform fails.
+		@since v0.99.5
+		*/
+		bool visibleRectInNodeSpace(CGRect *pRectInPixels);
+
 		/** Converts a Point to node (local) space coordinates. The result is in Points.
 		@since v0.7.1
 		*/
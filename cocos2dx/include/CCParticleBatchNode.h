@@ -0,0 +1,103 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CC_PARTICLE_BATCH_NODE_H__
+#define __CC_PARTICLE_BATCH_NODE_H__
+
+#include "CCNode.h"
+#include "ccTypes.h"
+#include "platform/CCGL.h"
+
+namespace cocos2d {
+
+class CCParticleSystemQuad;
+
+/** @brief CCParticleBatchNode draws the particles of its CCParticleSystemQuad children
+with as few OpenGL calls as possible.
+
+Every frame the quads of the children are transformed into the coordinates of the batch node
+and copied into one shared buffer. Consecutive children, in z order, that use the same texture
+and blend function are drawn with a single glDrawElements call, so the draw order of the children
+is the same as without the batch node.
+
+Any CCParticleSystemQuad can be added as is. The children that can't be batched are visited
+normally between the batched draws: other nodes, and systems that have children of their own,
+an active grid, a moved camera or a vertexZ.
+
+@since v0.99.5
+*/
+class CCX_DLL CCParticleBatchNode : public CCNode
+{
+public:
+	CCParticleBatchNode(void);
+	virtual ~CCParticleBatchNode(void);
+
+	/** creates a batch node with room for 500 particles.
+	The buffer grows when the children have more living particles.
+	*/
+	static CCParticleBatchNode* batchNode(void);
+
+	/** creates a batch node with room for uCapacity particles */
+	static CCParticleBatchNode* batchNodeWithCapacity(unsigned int uCapacity);
+
+	/** initializes a batch node with room for uCapacity particles */
+	bool initWithCapacity(unsigned int uCapacity);
+
+	/** number of draw calls issued for the batched children by the last visit */
+	inline unsigned int getDrawCount(void) { return m_uDrawCount; }
+
+	virtual void addChild(CCNode * child);
+	virtual void addChild(CCNode * child, int zOrder);
+	virtual void addChild(CCNode * child, int zOrder, int tag);
+	virtual void removeChild(CCNode* child, bool cleanup);
+	virtual void removeAllChildrenWithCleanup(bool cleanup);
+	virtual void visit(void);
+
+protected:
+	// returns the child as a system whose quads can be copied, NULL if it must be visited
+	CCParticleSystemQuad* batchedSystem(CCNode *pChild);
+	// grows the shared buffers, keeping their content
+	bool ensureCapacity(unsigned int uQuads);
+	// draws the quads from m_uRunStart to m_uQuadCount
+	void drawRun(void);
+
+protected:
+	ccV2F_C4F_T2F_Quad	*m_pQuads;
+	GLushort			*m_pIndices;
+	unsigned int		m_uCapacity;
+	unsigned int		m_uIndexedQuads;	// quads covered by m_pIndices
+#if CC_USES_VBO
+	GLuint				m_uQuadsID;
+#endif
+
+	// state of the visit
+	unsigned int		m_uQuadCount;
+	unsigned int		m_uRunStart;
+	GLuint				m_uRunTexture;
+	ccBlendFunc			m_tRunBlendFunc;
+	unsigned int		m_uDrawCount;
+};
+
+}// namespace cocos2d
+
+#endif //__CC_PARTICLE_BATCH_NODE_H__
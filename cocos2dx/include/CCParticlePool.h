@@ -0,0 +1,105 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CC_PARTICLE_POOL_H__
+#define __CC_PARTICLE_POOL_H__
+
+#include <string>
+#include "NSObject.h"
+#include "NSMutableArray.h"
+#include "NSMutableDictionary.h"
+
+namespace cocos2d {
+
+class CCParticleSystemQuad;
+
+/** @brief Singleton that recycles the CCParticleSystemQuad created from the same plist.
+
+The pool keeps a reference to the systems it creates, up to getCapacity for each plist.
+A system is free again once nothing else retains it and it has no parent, e.g. after it
+removed itself with setIsAutoRemoveOnFinish and was released. The next request for its plist
+resets it with CCParticleSystem::resetWithTemplate, keeping its particles, quads and VBO,
+instead of allocating a new system.
+
+The systems are described by the templates of CCParticleTemplateCache.
+@since v0.99.5
+*/
+class CCX_DLL CCParticlePool : public NSObject
+{
+public:
+	~CCParticlePool(void);
+
+	/** Returns the shared instance of the pool */
+	static CCParticlePool* sharedParticlePool(void);
+
+	/** Purges the pool. The systems in use are not affected. */
+	static void purgeSharedParticlePool(void);
+
+	/** Returns an autoreleased system for a plist file, a recycled one if one is free.
+	@return NULL if the plist can't be loaded
+	*/
+	CCParticleSystemQuad* systemWithFile(const char *pszPlist);
+
+	/** Creates systems for a plist file until uCount of them are pooled, so that the first bursts
+	don't allocate. It also loads the template of the plist.
+	*/
+	void prewarmWithFile(const char *pszPlist, unsigned int uCount);
+
+	/** Most systems pooled for each plist file, 32 by default. The systems created beyond it are not pooled. */
+	inline void setCapacity(unsigned int uCapacity) { m_uCapacity = uCapacity; }
+	inline unsigned int getCapacity(void) { return m_uCapacity; }
+
+	/** Releases the pooled systems that are free */
+	void removeUnusedSystems(void);
+
+	/** Releases all the pooled systems. The systems in use are not affected. */
+	void removeAllSystems(void);
+
+	/** Number of requests served with a recycled system */
+	inline unsigned int getHitCount(void) { return m_uHitCount; }
+	/** Number of requests that created a system */
+	inline unsigned int getMissCount(void) { return m_uMissCount; }
+	/** Most pooled systems in use at the same time, for one plist file */
+	inline unsigned int getPeakCount(void) { return m_uPeakCount; }
+	/** Sets the statistics back to 0 */
+	void resetStatistics(void);
+
+private:
+	CCParticlePool(void);
+
+	// a pooled system is free when the pool holds its only reference
+	static bool isFree(CCParticleSystemQuad *pSystem);
+	// the pooled systems of a plist, created empty the first time
+	NSMutableArray<CCParticleSystemQuad*>* systemsForPath(const std::string &sPath);
+
+protected:
+	NSDictionary<std::string, NSMutableArray<CCParticleSystemQuad*>*> *m_pSystems;
+	unsigned int m_uCapacity;
+	unsigned int m_uHitCount;
+	unsigned int m_uMissCount;
+	unsigned int m_uPeakCount;
+};
+
+}// namespace cocos2d
+
+#endif //__CC_PARTICLE_POOL_H__
@@ -118,9 +118,57 @@ typedef struct sCCParticle {
 
 }tCCParticle;
 
+/**
+Plain description of an emitter, with the values of a Particle Designer plist.
+Systems created from a CCParticleTemplate copy it instead of parsing the plist again.
+@since v0.99.5
+*/
+typedef struct sCCParticleTemplate {
+	int			maxParticles;
+	float		duration;
+	float		angle;
+	float		angleVar;
+	ccBlendFunc	blendFunc;
+	ccColor4F	startColor;
+	ccColor4F	startColorVar;
+	ccColor4F	endColor;
+	ccColor4F	endColorVar;
+	float		startSize;
+	float		startSizeVar;
+	float		endSize;
+	float		endSizeVar;
+	CGPoint		position;
+	CGPoint		posVar;
+	float		life;
+	float		lifeVar;
+	int			emitterMode;
+
+	//! Mode A: gravity, speed, radial accel, tangential accel
+	struct {
+		CGPoint		gravity;
+		float		speed;
+		float		speedVar;
+		float		radialAccel;
+		float		radialAccelVar;
+		float		tangentialAccel;
+		float		tangentialAccelVar;
+	} modeA;
+
+	//! Mode B: radius mode
+	struct {
+		float		startRadius;
+		float		startRadiusVar;
+		float		endRadius;
+		float		endRadiusVar;
+		float		rotatePerSecond;
+		float		rotatePerSecondVar;
+	} modeB;
+}tCCParticleTemplate;
+
 //typedef void (*CC_UPDATE_PARTICLE_IMP)(id, SEL, tCCParticle*, CGPoint);
 
 class CCTexture2D;
+class CCParticleTemplate;
 
 /** @brief Particle System base class.
 Attributes of a Particle System:
@@ -356,6 +404,18 @@ public:
 	*/
 	bool initWithDictionary(NSDictionary<std::string, NSObject*> *dictionary);
 
+	/** initializes a CCParticleSystem by copying a parsed template and using its texture.
+	@since v0.99.5
+	*/
+	bool initWithTemplate(CCParticleTemplate *pTemplate);
+
+	/** puts a finished system back in the state initWithTemplate leaves it in, keeping its buffers.
+	Fails if the template doesn't have as many particles as the system.
+	Used by CCParticlePool to recycle systems.
+	@since v0.99.5
+	*/
+	virtual bool resetWithTemplate(CCParticleTemplate *pTemplate);
+
 	//! Initializes a system with a fixed number of particles
 	virtual bool initWithTotalParticles(int numberOfParticles);
 	//! Add a particle to the emitter
@@ -375,19 +435,10 @@ public:
 	virtual void postStep();
 
 	virtual void update(ccTime dt);
+
 private:
-	/** Private method, return the string found by key in dict.
-	@return "" if not found; return the string if found.
-	*/
-	inline const char * valueForKey(const char *key, NSDictionary<std::string, NSObject*> *dict)
-	{
-		if (dict)
-		{
-			NSString *pString = (NSString*)dict->objectForKey(std::string(key));
-			return pString ? pString->m_sString.c_str() : "";
-		}
-		return "";
-	}
+	// copies the description and the texture of a template
+	void applyTemplate(CCParticleTemplate *pTemplate);
 };
 
 }// namespace cocos2d
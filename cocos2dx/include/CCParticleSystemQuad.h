@@ -29,6 +29,7 @@ THE SOFTWARE.
 namespace cocos2d {
 
 class CCSpriteFrame;
+class CCParticleBatchNode;
 
 /** @brief CCParticleSystemQuad is a subclass of CCParticleSystem
 
@@ -52,10 +53,12 @@ protected:
 #if CC_USES_VBO
 	GLuint				m_uQuadsID;	// VBO id
 #endif
+	CCParticleBatchNode	*m_pBatchNode;	// weak ref, the batch node drawing the quads
 public:
 	CCParticleSystemQuad()
 		:m_pQuads(NULL)
 		,m_pIndices(NULL)
+		,m_pBatchNode(NULL)
 	{}
 	virtual ~CCParticleSystemQuad();
 	/** initialices the indices for the vertices*/
@@ -74,9 +77,22 @@ public:
 	@since v0.99.4
 	*/
 	void setTextureWithRect(CCTexture2D *texture, CGRect rect);
+
+	/** The CCParticleBatchNode that draws the system, NULL when it draws itself.
+	It is set by the batch node when the system is added to it.
+	@since v0.99.5
+	*/
+	inline CCParticleBatchNode* getBatchNode(void) { return m_pBatchNode; }
+	inline void setBatchNode(CCParticleBatchNode *pBatchNode) { m_pBatchNode = pBatchNode; }
+
+	/** The quads written by the last update, one for each living particle, in the coordinates of the system.
+	@since v0.99.5
+	*/
+	inline ccV2F_C4F_T2F_Quad* getQuads(void) { return m_pQuads; }
 	// super methods
 	virtual bool initWithTotalParticles(int numberOfParticles);
 	virtual void setTexture(CCTexture2D* var);
+	virtual bool resetWithTemplate(CCParticleTemplate *pTemplate);
 	virtual void updateQuadWithParticle(tCCParticle* particle, CGPoint newPosition);
 	virtual void postStep();
 	virtual void draw();
@@ -0,0 +1,99 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CC_PARTICLE_TEMPLATE_CACHE_H__
+#define __CC_PARTICLE_TEMPLATE_CACHE_H__
+
+#include <string>
+#include "CCParticleSystem.h"
+#include "NSObject.h"
+#include "NSMutableDictionary.h"
+
+namespace cocos2d {
+
+class CCTexture2D;
+
+/** @brief A parsed emitter: its description and its loaded texture.
+@since v0.99.5
+*/
+class CCX_DLL CCParticleTemplate : public NSObject
+{
+public:
+	CCParticleTemplate(void);
+	virtual ~CCParticleTemplate(void);
+
+	/** reads the description of a Particle Designer dictionary and loads its texture,
+	from textureFileName relative to pszPlistPath or from the embedded textureImageData.
+	*/
+	bool initWithDictionary(NSDictionary<std::string, NSObject*> *pDictionary, const char *pszPlistPath);
+
+	inline const tCCParticleTemplate& getDescription(void) { return m_tDescription; }
+	inline CCTexture2D* getTexture(void) { return m_pTexture; }
+
+protected:
+	tCCParticleTemplate m_tDescription;
+	CCTexture2D *m_pTexture;
+};
+
+/** @brief Singleton that keeps the parsed emitter plists, keyed by their full path.
+
+CCParticleSystem::initWithFile reads a plist once and creates the next systems by copying
+its template, so spawning an effect doesn't parse the plist or decode its texture again.
+Call addTemplateWithFile while loading a scene to prewarm the effects it uses.
+@since v0.99.5
+*/
+class CCX_DLL CCParticleTemplateCache : public NSObject
+{
+public:
+	~CCParticleTemplateCache(void);
+
+	/** Returns the shared instance of the cache */
+	static CCParticleTemplateCache* sharedParticleTemplateCache(void);
+
+	/** Purges the cache. It releases the templates, their textures and the retained instance. */
+	static void purgeSharedParticleTemplateCache(void);
+
+	/** Returns the template of a plist file, reading the file and loading its texture the first time.
+	@return NULL if the file can't be read or its texture can't be loaded
+	*/
+	CCParticleTemplate* addTemplateWithFile(const char *pszPlist);
+
+	/** Returns the template of a plist file if it was already added, NULL otherwise */
+	CCParticleTemplate* templateForFile(const char *pszPlist);
+
+	/** Removes the template of a plist file. The systems created from it are not affected. */
+	void removeTemplateForFile(const char *pszPlist);
+
+	/** Removes all the templates. Call it if you receive the "Memory Warning". */
+	void removeAllTemplates(void);
+
+private:
+	CCParticleTemplateCache(void);
+
+protected:
+	NSDictionary<std::string, CCParticleTemplate*> *m_pTemplates;
+};
+
+}// namespace cocos2d
+
+#endif //__CC_PARTICLE_TEMPLATE_CACHE_H__
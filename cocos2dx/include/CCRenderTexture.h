@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "NSData.h"
 #include "CCNode.h"
 #include "CCSprite.h"
+#include "selector_protocol.h"
 
 namespace cocos2d {
 
@@ -86,6 +87,31 @@ public:
 
     /* get buffer as UIImage, can only save a render buffer which has a RGBA8888 pixel format */
     NSData *getUIImageAsDataFromBuffer(int format);
+
+    /** saves the texture into a file without stalling the frame. The format can be JPG, PNG or raw data.
+    The pixels are read back a few frames after the next end(), when the GPU has finished drawing them;
+    flipping, encoding and writing the file are done on a worker thread.
+    When it is done, the selector is called on the main thread with this render texture
+    and the encoded NSData, or NULL on failure. The data is released after the call, retain it to keep it.
+    @since v0.99.5
+    */
+    void saveBufferAsync(const char *fileName, int format, SelectorProtocol *pTarget, SEL_CallFuncND selector);
+
+    /** same as saveBufferAsync but only delivers the encoded data, no file is written */
+    void getUIImageAsDataFromBufferAsync(int format, SelectorProtocol *pTarget, SEL_CallFuncND selector);
+
+    /** whether the async captures read back and encode at once, on the main thread.
+    Useful when running headless or when the platform has no worker threads. Default is false */
+    static void setIsSynchronousCapture(bool bSynchronous);
+    static bool getIsSynchronousCapture(void);
+
+    /** how many frames to wait after end() before reading the pixels back. Default is 2 */
+    static void setCaptureFrameDelay(int nFrames);
+
+    /** reads the pixels of the render target back as RGBA8888, top-down unless bFlip is false.
+    @return a buffer allocated with new[], or NULL
+    */
+    unsigned char* readPixels(int *pWidth, int *pHeight, bool bFlip = true);
 protected:
 	GLuint				m_uFBO;
 	GLint				m_nOldFBO;
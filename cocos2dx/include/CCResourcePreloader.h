@@ -0,0 +1,171 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CCRESOURCE_PRELOADER_H__
+#define __CCRESOURCE_PRELOADER_H__
+
+#include <string>
+#include <vector>
+#include "NSObject.h"
+#include "selector_protocol.h"
+
+namespace cocos2d {
+
+class CCResourcePreloader;
+class NSLock;
+struct _ccPreloadItem;
+
+/** Kinds of resources a CCResourcePreloader can load
+@since v0.99.5
+*/
+typedef enum
+{
+	/// image file added to CCTextureCache
+	kCCPreloadTypeTexture,
+	/// sprite frames plist added to CCSpriteFrameCache, with its texture
+	kCCPreloadTypeSpriteFrames,
+	/// .fnt configuration used by CCLabelBMFont, with its texture
+	kCCPreloadTypeBMFont,
+	/// textures of the tilesets of a .tmx map
+	kCCPreloadTypeTMX,
+} ccPreloadType;
+
+/** @brief Receives the progress of a CCResourcePreloader, always on the main thread.
+@since v0.99.5
+*/
+class CCX_DLL CCResourcePreloaderDelegate
+{
+public:
+	virtual ~CCResourcePreloaderDelegate(void) {}
+
+	/** called each time a resource added to the preloader, with its dependencies, is loaded */
+	virtual void preloaderDidLoadResource(CCResourcePreloader *pPreloader, const char *pszFile, unsigned int uLoaded, unsigned int uTotal) {}
+	/** called once all the resources are loaded, or when the preloader is cancelled */
+	virtual void preloaderDidFinish(CCResourcePreloader *pPreloader, bool bCancelled) = 0;
+};
+
+/** @brief Loads the resources of a scene in the background.
+
+The PNG and JPEG files are decoded on worker threads, the textures are created on the
+main thread, up to a time budget per frame, so a loading screen keeps animating.
+The plist, .fnt and .tmx files are parsed on the main thread, then their textures are loaded
+the same way. The resources end in the usual caches: once the preloader finished,
+CCTextureCache::addImage, CCSpriteFrameCache::addSpriteFramesWithFile, CCLabelBMFont and
+CCTMXTiledMap find them there.
+
+The resources with the highest priority are loaded first. The priority of a resource can be raised
+while loading, eg when the player skips ahead to a scene whose resources were added later.
+Platforms without threads (uphone) load everything on the main thread, under the same budget.
+@since v0.99.5
+*/
+class CCX_DLL CCResourcePreloader : public NSObject, public SelectorProtocol
+{
+public:
+	CCResourcePreloader(void);
+	virtual ~CCResourcePreloader(void);
+
+	/** creates an empty preloader */
+	static CCResourcePreloader* preloader(void);
+
+	/** adds a resource to load. The file is the path the game passes to the caches.
+	 Resources already added are ignored, use setPriority to change their priority.
+	 */
+	void addResource(ccPreloadType eType, const char *pszFile, int nPriority = 0);
+	void addTexture(const char *pszFile, int nPriority = 0);
+	void addSpriteFrames(const char *pszPlist, int nPriority = 0);
+	void addBMFont(const char *pszFntFile, int nPriority = 0);
+	void addTMX(const char *pszTmxFile, int nPriority = 0);
+
+	/** adds the resources listed in a manifest file, one per line:
+	 <type> <file> [priority]
+	 where type is texture, plist, fnt or tmx. Empty lines and lines starting with # are skipped.
+	 @return false if the file can't be read
+	 */
+	bool addManifestFile(const char *pszManifest);
+
+	/** changes the priority of a resource added before, and of the textures it depends on */
+	void setPriority(const char *pszFile, int nPriority);
+
+	/** starts loading. The delegate is not retained, it must outlive the preloader or cancel it.
+	 The preloader is retained until it finished.
+	 */
+	void start(CCResourcePreloaderDelegate *pDelegate);
+	/** stops loading. The delegate is told at once, the resources already loaded stay in the caches.
+	 Calling start again resumes with the resources left.
+	 */
+	void cancel(void);
+
+	inline bool isRunning(void) { return m_bRunning; }
+	inline unsigned int getLoadedCount(void) { return m_uLoaded; }
+	inline unsigned int getTotalCount(void) { return m_uTotal; }
+	/** loaded resources / resources, between 0 and 1 */
+	float getProgress(void);
+
+	/** time spent creating textures and parsing files on the main thread per frame, in seconds.
+	 At least one resource is handled per frame. Default: 8 ms
+	 */
+	inline void setFrameBudget(ccTime fBudget) { m_fFrameBudget = fBudget; }
+	inline ccTime getFrameBudget(void) { return m_fFrameBudget; }
+
+	/** maximum number of threads decoding images. 0 decodes them on the main thread. Default: 2 */
+	inline void setMaxThreads(unsigned int uThreads) { m_uMaxThreads = uThreads; }
+	inline unsigned int getMaxThreads(void) { return m_uMaxThreads; }
+
+public:
+	virtual void tick(ccTime dt);
+
+	virtual void selectorProtocolRetain(void);
+	virtual void selectorProtocolRelease(void);
+
+private:
+	struct _ccPreloadItem* addItem(ccPreloadType eType, const std::string& file, int nPriority, struct _ccPreloadItem *pParent);
+	struct _ccPreloadItem* findItem(const char *pszFile);
+	struct _ccPreloadItem* nextDecodeItem(void);
+	struct _ccPreloadItem* nextMainThreadItem(void);
+	void startWorkers(void);
+	void loadItem(struct _ccPreloadItem *pItem);
+	void completeItem(struct _ccPreloadItem *pItem);
+	void finish(bool bCancelled);
+
+	static void workerProc(void *pData);
+
+private:
+	std::vector<struct _ccPreloadItem*> m_items;
+	// guards m_items, the item states and m_uWorkers
+	NSLock *m_pLock;
+	CCResourcePreloaderDelegate *m_pDelegate;
+	bool m_bRunning;
+	bool m_bScheduled;
+	bool m_bCancelled;
+	bool m_bThreadless;
+	unsigned int m_uWorkers;
+	unsigned int m_uMaxThreads;
+	unsigned int m_uLoaded;
+	unsigned int m_uTotal;
+	ccTime m_fFrameBudget;
+};
+
+}//namespace   cocos2d 
+
+#endif // __CCRESOURCE_PRELOADER_H__
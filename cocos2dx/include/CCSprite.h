@@ -302,6 +302,14 @@ public:
 	/** updates the quad according the the rotation, position, scale values. */
 	void updateTransform(void);
 
+	/** updates the quads of the sprite and of its children, from the top of the hierarchy down.
+	Each sprite builds its transform once from the one its parent cached during the same pass,
+	instead of walking up to the batch node like updateTransform does.
+	Only the quads of this subtree are written, so disjoint subtrees can be updated concurrently.
+	@since v0.99.5
+	*/
+	void updateTransformRecursively(void);
+
 	/** tell the sprite to use self-render.
 	 @since v0.99.0
 	 */
@@ -322,7 +330,10 @@ public:
 
 	// Frames
 
-	/** sets a new display frame to the CCSprite. */
+	/** sets a new display frame to the CCSprite.
+	When the frame uses the texture of the sprite, its cached texture coordinates are copied
+	instead of being computed again.
+	*/
 	void setDisplayFrame(CCSpriteFrame *pNewFrame);
 
 	/** returns whether or not a CCSpriteFrame is being displayed */
@@ -358,10 +369,21 @@ public:
 
 protected:
 	void updateTextureCoords(CGRect rect);
+	// copies unflipped texture coordinates (bl, br, tl, tr) to the quad, applying flipX and flipY
+	void setTextureCoords(const ccTex2F *pTexCoords);
+	// places the rect in the untrimmed size and updates the quad vertices or the dirty flag
+	void updateRectVertices(CGPoint trimOffsetInPixels);
 	void updateBlendFunc(void);
 	void initAnimationDictionary(void);
     void getTransformValues(struct transformValues_ *tv); // optimization
 
+	// transform relative to the parent, in pixels
+	CGAffineTransform localTransformInBatch(void);
+	// walks up to the batch node honoring the ccHonorParentTransform of each sprite. false if one of them is invisible
+	bool transformToBatchFromAncestors(CGAffineTransform *pMatrix);
+	// places the quad vertices of the sprite with a transform relative to the batch node
+	void updateQuadVertices(const CGAffineTransform& matrix);
+
 protected:
 	//
 	// Data used when the sprite is rendered using a CCSpriteSheet
@@ -373,6 +395,8 @@ protected:
 	bool					m_bDirty;				// Sprite needs to be updated
 	bool					m_bRecursiveDirty;		// Subchildren needs to be updated
 	bool					m_bHasChildren;			// optimization to check if it contain children
+	bool					m_bIsVisibleInBatch;	// visible and all its ancestors are, as of the last update
+	CGAffineTransform		m_tTransformToBatch;	// transform relative to the batch node, as of the last update
 
 	//
 	// Data used when the sprite is self-rendered
@@ -141,6 +141,25 @@ namespace cocos2d
 		unsigned int highestAtlasIndexInChild(CCSprite *sprite);
 		unsigned int lowestAtlasIndexInChild(CCSprite *sprite);
 		unsigned int atlasIndexForChild(CCSprite *sprite, int z);
+
+		/** Whether the sprites can be drawn in any order.
+		While all the children have the same z order and no children of their own, an unordered batch node
+		appends new sprites to the end of the atlas and fills the slot of a removed sprite with the last one,
+		so adding and removing a sprite is O(1). Removing a sprite changes the draw order of the last one.
+		Adding a child with another z order or adding a child to a sprite switches back to the ordered mode
+		until the batch node is empty again. Default is false.
+		@since v0.99.5
+		*/
+		void setIsUnordered(bool bUnordered);
+		bool getIsUnordered(void);
+
+		/** Number of sprites from which draw updates the transforms on the worker threads started with
+		ccxSetWorkerThreadCount, each thread taking a range of children with their subtrees.
+		0 (the default) always updates them on the calling thread.
+		@since v0.99.5
+		*/
+		static void setParallelTransformThreshold(unsigned int uSprites);
+		static unsigned int getParallelTransformThreshold(void);
 		
 		// CCTextureProtocol
 	    virtual CCTexture2D* getTexture(void);
@@ -176,12 +195,20 @@ namespace cocos2d
 	private:
 		void updateBlendFunc();
 
+		// sorts the sprites of an unordered batch node and leaves the unordered mode
+		void rebuildOrderedAtlas(void);
+
 	protected:
 		CCTextureAtlas *m_pobTextureAtlas;
 		ccBlendFunc m_blendFunc;
 
 		// all descendants: chlidren, gran children, etc...
 		NSArray<CCSprite*>* m_pobDescendants;
+
+		// unordered mode requested / in use. While in use, the children, the descendants and
+		// the quads of the atlas are in the same order and the atlas index of a child is its index
+		bool m_bIsUnordered;
+		bool m_bIsUnorderedActive;
 	};
 }
 
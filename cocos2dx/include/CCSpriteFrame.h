@@ -52,10 +52,18 @@ public:
 	// attributes
 
 	inline CGRect getRectInPixels(void) { return m_obRectInPixels; }
-	inline void setRectInPixels(CGRect rectInPixels) { m_obRectInPixels = rectInPixels; }
+	inline void setRectInPixels(CGRect rectInPixels)
+	{
+		m_obRectInPixels = rectInPixels;
+		m_bIsQuadDirty = true;
+	}
 
 	inline bool isRotated(void) { return m_bRotated; }
-	inline void setRotated(bool bRotated) { m_bRotated = bRotated; }
+	inline void setRotated(bool bRotated)
+	{
+		m_bRotated = bRotated;
+		m_bIsQuadDirty = true;
+	}
 
 	/** get rect of the frame */
 	inline CGRect getRect(void) { return m_obRect; }
@@ -70,7 +78,11 @@ public:
 	/** get original size of the trimmed image */
 	inline CGSize getOriginalSizeInPixels(void) { return m_obOriginalSizeInPixels; }
 	/** set original size of the trimmed image */
-	inline void setOriginalSizeInPixels(CGSize sizeInPixels) { m_obOriginalSizeInPixels = sizeInPixels; }
+	inline void setOriginalSizeInPixels(CGSize sizeInPixels)
+	{
+		m_obOriginalSizeInPixels = sizeInPixels;
+		m_bIsQuadDirty = true;
+	}
 
 	/** get texture of the frame */
 	inline CCTexture2D* getTexture(void) { return m_pobTexture; }
@@ -80,8 +92,21 @@ public:
 		CCX_SAFE_RETAIN(pobTexture);
 		CCX_SAFE_RELEASE(m_pobTexture);
 		m_pobTexture = pobTexture;
+		m_bIsQuadDirty = true;
 	}
 
+	/** get the texture coordinates of the frame in its texture, in the order bl, br, tl, tr.
+	They are computed once like CCSprite does, rotation included and without flip.
+	@since v0.99.5
+	*/
+	const ccTex2F* getTexCoords(void);
+
+	/** get the offset of the trimmed rect from the bottom left corner of the original size, in pixels.
+	It doesn't include the offset of the frame.
+	@since v0.99.5
+	*/
+	CGPoint getTrimOffsetInPixels(void);
+
 public:
 	~CCSpriteFrame(void);
 	virtual NSObject* copyWithZone(NSZone *pZone);
@@ -113,6 +138,14 @@ protected:
 	CGPoint m_obOffsetInPixels;
 	CGSize m_obOriginalSizeInPixels;
 	CCTexture2D *m_pobTexture;
+
+	// cached for CCSprite::setDisplayFrame
+	bool m_bIsQuadDirty;
+	ccTex2F m_tTexCoords[4];
+	CGPoint m_obTrimOffsetInPixels;
+
+private:
+	void updateQuad(void);
 };
 
 }//namespace   cocos2d 
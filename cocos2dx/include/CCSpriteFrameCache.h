@@ -67,6 +67,13 @@ public:
 	/** Adds multiple Sprite Frames from a plist file. The texture will be associated with the created sprite frames. */
 	void addSpriteFramesWithFile(const char *pszPlist, CCTexture2D *pobTexture);
 
+	/** Returns the path of the texture used by the sprite frames of a plist file: the textureFileName
+	 of its metadata, relative to the plist, or the plist path with a .png suffix.
+	 @param pszPlistPath the full path of the plist file
+	 @since v0.99.5
+	 */
+	std::string texturePathForDictionary(NSDictionary<std::string, NSObject*> *pobDictionary, const char *pszPlistPath);
+
 	/** Adds an sprite frame with a given name.
 	 If the name already exists, then the contents of the old name will be replaced with the new one.
 	 */
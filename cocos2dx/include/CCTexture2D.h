@@ -122,6 +122,12 @@ public:
 	/** Intializes with a texture2d with data */
 	bool initWithData(const void* data, CCTexture2DPixelFormat pixelFormat, unsigned int pixelsWide, unsigned int pixelsHigh, CGSize contentSize);
 
+	/** replaces the pixels of a region of the texture.
+	The data has the pixel format of the texture and its rows are tightly packed.
+	@since v0.99.5
+	*/
+	void updateWithData(const void *data, unsigned int x, unsigned int y, unsigned int pixelsWide, unsigned int pixelsHigh);
+
 	/**
 	Drawing extensions to make it easy to draw basic quads using a CCTexture2D object.
 	These functions require GL_TEXTURE_2D and both GL_VERTEX_ARRAY and GL_TEXTURE_COORD_ARRAY client states to be enabled.
@@ -147,6 +153,27 @@ public:
 	/** Initializes a texture from a string with font name and font size */
 	bool initWithString(const char *text, const char *fontName, float fontSize);
 
+	/**
+	Extensions to make it easy to create a CCTexture2D object from the data of a PVR (v2) file, eg: an inflated .pvr.ccz.
+	Only the uncompressed pixel formats are supported: RGBA8888, RGBA4444, RGBA5551, RGB565, RGB888 and A8.
+	The first level is used, the mipmaps are skipped.
+	@since v0.99.5
+	*/
+	bool initWithPVRData(const unsigned char *data, unsigned int dataLength);
+
+	/**
+	Extensions to make it easy to create a CCTexture2D object from the data of a KTX file holding an ETC1 texture,
+	with all of its mipmaps. On the GPUs without GL_OES_compressed_ETC1_RGB8_texture the levels are decoded
+	to RGB565 on the CPU.
+	@since v0.99.5
+	*/
+	bool initWithKTXData(const unsigned char *data, unsigned int dataLength);
+
+	/** treats (or not) the PVR images as if they have alpha premultiplied. Default: false
+	@since v0.99.5
+	*/
+	static void PVRImagesHavePremultipliedAlpha(bool haveAlphaPremultiplied);
+
 	/** returns the content size of the texture in points */
 	CGSize getContentSize(void);
 
@@ -49,6 +49,7 @@ class CCX_DLL CCTextureAtlas : public NSObject
 {
 protected:
 	GLushort			*m_pIndices;
+	GLushort			*m_pCulledIndices;
 #if CC_USES_VBO
 	GLuint				m_pBuffersVBO[2]; //0: vertex  1: indices
 #endif // CC_USES_VBO
@@ -140,11 +141,20 @@ public:
 	*/
 	void drawNumberOfQuads(unsigned int n);
 
+	/** draws the quads, among the first n ones, whose vertices intersect a rect.
+	* The rect is in the same coordinates as the vertices of the quads.
+	* The visible quads are drawn with a single call, using a compacted copy of their indices.
+	* It returns the number of quads that were drawn.
+	@since v0.99.5
+	*/
+	unsigned int drawNumberOfQuadsInRect(unsigned int n, const CGRect& rect);
+
 	/** draws all the Atlas's Quads
 	*/
 	void drawQuads();
 private:
 	void initIndices();
+	void drawElements(unsigned int n, GLushort *pIndices, unsigned int uIndexCount);
 };
 }//namespace   cocos2d 
 
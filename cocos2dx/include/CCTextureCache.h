@@ -71,6 +71,8 @@ public:
 	*  object and it will return it. It will use the filename as a key.
 	* Otherwise it will return a reference of a previosly loaded image.
 	* Supported image extensions: .png, .bmp, .tiff, .jpeg, .pvr, .gif
+	* and, since v0.99.5, the CCZ compressed .png.ccz and .pvr.ccz (uncompressed pixel formats only)
+	* and the ETC1 .ktx
 	*/
 	CCTexture2D* addImage(const char* fileimage);
 
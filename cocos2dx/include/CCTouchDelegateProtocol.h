@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "NSObject.h"
 #include "ccxCommon.h"
+#include "CGGeometry.h"
 
 namespace   cocos2d {
 
@@ -64,6 +65,14 @@ public:
  	virtual void ccTouchesMoved(NSSet *pTouches, UIEvent *pEvent) {}
  	virtual void ccTouchesEnded(NSSet *pTouches, UIEvent *pEvent) {}
  	virtual void ccTouchesCancelled(NSSet *pTouches, UIEvent *pEvent) {}
+
+	/** Returns in pRect the rect, in world space, outside of which the delegate never claims a touch.
+	 The targeted delegates that return true are kept in the spatial index of CCTouchDispatcher and
+	 only get ccTouchBegan for touches inside the rect. The rect is asked again when a node transform
+	 changes, see CCNode::getTransformGeneration(). Default: false, the delegate gets every touch.
+	 @since v0.99.5
+	 */
+	virtual bool getTouchHitRect(CGRect *pRect) { return false; }
 };
 /**
  @brief
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "CCTouchDelegateProtocol.h"
 #include "NSObject.h"
 #include "NSMutableArray.h"
+#include <vector>
 namespace   cocos2d {
 
 typedef enum
@@ -132,6 +133,13 @@ public:
 	virtual void touchesEnded(NSSet* touches, UIEvent* pEvent);
 	virtual void touchesCancelled(NSSet* touches, UIEvent* pEvent);
 
+	/** Whether or not ccTouchBegan is only sent to the targeted delegates whose
+	 CCTouchDelegate::getTouchHitRect() contains the touch. Default: true
+	 @since v0.99.5
+	 */
+	bool isHitTestIndexEnabled(void);
+	void setIsHitTestIndexEnabled(bool bEnabled);
+
 public:
 	/** singleton of the CCTouchDispatcher */
 	static CCTouchDispatcher* sharedDispatcher();
@@ -140,6 +148,8 @@ protected:
 	void forceRemoveDelegate(CCTouchDelegate *pDelegate);
 	void forceAddHandler(CCTouchHandler *pHandler, NSMutableArray<CCTouchHandler*> *pArray);
 	void forceRemoveAllDelegates(void);
+	void rebuildHitTestIndex(void);
+	void findHitTestCandidates(const CGPoint& point);
 
 protected:
  	NSMutableArray<CCTouchHandler*> *m_pTargetedHandlers;
@@ -155,6 +165,20 @@ protected:
 
 	// 4, 1 for each type of event
 	struct ccTouchHandlerHelperData m_sHandlerHelperData[ccTouchMax];
+
+	// spatial index of the targeted handlers, built from the hit rects of their delegates.
+	// The grid covers the window, each cell lists the handlers (by index, in priority order)
+	// whose rect overlaps it: m_tCellEntries[m_tCellStarts[c] .. m_tCellStarts[c + 1]).
+	bool m_bHitTestIndexEnabled;
+	bool m_bHitTestIndexDirty;
+	unsigned int m_uHitTestGeneration;
+	int m_nHitTestCols;
+	int m_nHitTestRows;
+	std::vector<CGRect> m_tHitRects;
+	std::vector<unsigned int> m_tUnindexed;
+	std::vector<unsigned int> m_tCellStarts;
+	std::vector<unsigned int> m_tCellEntries;
+	std::vector<unsigned int> m_tCandidates;
 };
 }//namespace   cocos2d 
 
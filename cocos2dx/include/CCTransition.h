@@ -36,6 +36,7 @@ namespace   cocos2d {
 
 class CCActionInterval;
 class CCNode;
+class CCRenderTexture;
 
 /** @brief CCTransitionEaseScene can ease the actions of the scene protocol.
 @since v0.8.2
@@ -62,6 +63,18 @@ typedef enum {
 	kOrientationDownOver = 1,
 } tOrientation;
 
+/** How a transition draws the scenes
+@since v0.99.5
+*/
+typedef enum {
+	/// both scenes are drawn every frame
+	kCCTransitionSnapshotNone,
+	/// the outgoing scene is drawn once into a texture, the incoming scene keeps being drawn every frame
+	kCCTransitionSnapshotOutScene,
+	/// both scenes are drawn once into textures, the incoming scene is frozen until the transition ends
+	kCCTransitionSnapshotBothScenes,
+} ccTransitionSnapshotMode;
+
 /** @brief Base class for CCTransition scenes
 */
 class CCX_DLL CCTransitionScene : public CCScene
@@ -73,6 +86,9 @@ protected:
 	ccTime	m_fDuration;
 	bool	m_bIsInSceneOnTop;
 	bool	m_bIsSendCleanupToScene;
+	ccTransitionSnapshotMode m_eSnapshotMode;
+	CCRenderTexture *m_pOutSnapshot;
+	CCRenderTexture *m_pInSnapshot;
 
 public:
 
@@ -95,10 +111,29 @@ public:
 	/** used by some transitions to hide the outter scene */
 	void hideOutShowIn(void);
 
+	/** Sets how the scenes are drawn. The snapshots are taken when the transition starts,
+	 so the mode must be set before the transition is run.
+	 The transitions still move, scale, rotate and apply grid effects to the scenes,
+	 they are applied to the snapshot instead of the scene contents.
+	 CCTransitionCrossFade and CCTransitionRadialCCW render the scenes to textures themselves and ignore it.
+	 @since v0.99.5
+	 */
+	inline void setSnapshotMode(ccTransitionSnapshotMode eMode) { m_eSnapshotMode = eMode; }
+	inline ccTransitionSnapshotMode getSnapshotMode(void) { return m_eSnapshotMode; }
+
+	/** Sets the snapshot mode of the transitions created afterwards. Default: kCCTransitionSnapshotNone
+	 @since v0.99.5
+	 */
+	static void setDefaultSnapshotMode(ccTransitionSnapshotMode eMode);
+	static ccTransitionSnapshotMode getDefaultSnapshotMode(void);
+
 protected:
 	virtual void sceneOrder();
 private:
 	void setNewScene(ccTime dt);
+	void takeSnapshots(void);
+	void releaseSnapshots(void);
+	void visitScene(CCScene *pScene, CCRenderTexture *pSnapshot);
 
 };
 
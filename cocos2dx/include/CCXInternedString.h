@@ -0,0 +1,78 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CCX_INTERNED_STRING_H__
+#define __CCX_INTERNED_STRING_H__
+
+#include <string>
+#include "ccxCommon.h"
+
+namespace   cocos2d {
+
+/**
+@brief A string interned in a global pool, with its hash computed once.
+
+Two CCXInternedString made from equal strings point to the same characters, so they
+are compared by pointer. NSMutableDictionary lookups with an interned key don't hash
+the string again and don't allocate.
+Interned strings are never freed: use them for names that are looked up often,
+such as the names of textures, sprite frames or animations.
+The pool is not thread safe, strings must be interned on the main thread.
+@since v0.99.5
+*/
+class CCX_DLL CCXInternedString
+{
+public:
+	CCXInternedString(void) : m_pszString(NULL), m_uHash(0) {}
+	explicit CCXInternedString(const char *pszString);
+	explicit CCXInternedString(const std::string& str);
+
+	/** the interned characters, NULL for a default constructed string */
+	inline const char* c_str(void) const { return m_pszString; }
+	/** the hash of the string, the same as hashString(c_str()) */
+	inline unsigned int hash(void) const { return m_uHash; }
+
+	inline bool operator==(const CCXInternedString& other) const { return m_pszString == other.m_pszString; }
+	inline bool operator!=(const CCXInternedString& other) const { return m_pszString != other.m_pszString; }
+
+	/** the hash function used by the pool and by NSMutableDictionary (FNV-1a) */
+	static inline unsigned int hashString(const char *pszString)
+	{
+		unsigned int uHash = 2166136261u;
+		for (const unsigned char *p = (const unsigned char*)pszString; *p; ++p)
+		{
+			uHash = (uHash ^ *p) * 16777619u;
+		}
+		return uHash;
+	}
+
+private:
+	void intern(const char *pszString);
+
+	const char *m_pszString;
+	unsigned int m_uHash;
+};
+
+}//namespace   cocos2d 
+
+#endif //__CCX_INTERNED_STRING_H__
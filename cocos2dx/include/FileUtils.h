@@ -27,6 +27,8 @@ THE SOFTWARE.
 
 namespace cocos2d {
 
+class NSData;
+
 class FileUtils
 {
 public:
@@ -49,6 +51,36 @@ public:
     */
     static unsigned char* getFileDataFromZip(const char* pszZipFilePath, const char* pszFileName, unsigned long * pSize);
 
+    /**
+    @brief Get resource file data without copying it in the heap
+    The file is mapped in memory when the platform supports it, otherwise it is read.
+    @param[in]  pszFileName The resource file name which contain the path
+    @return the data, to release once used, or NULL if the file can't be read
+    @warning The bytes are read only.
+    @since v0.99.5
+    */
+    static NSData* getFileDataView(const char* pszFileName);
+
+    /**
+    @brief Get resource file data from zip file without copying it in the heap
+    The zip file is mapped in memory and an entry stored uncompressed is served from the mapping.
+    A compressed entry is inflated in the heap as by getFileDataFromZip.
+    @return the data, to release once used, or NULL if the file can't be read
+    @warning The bytes are read only.
+    @since v0.99.5
+    */
+    static NSData* getFileDataViewFromZip(const char* pszZipFilePath, const char* pszFileName);
+
+    /**
+    @brief Maps a whole file in memory, read only
+    @param[out] pSize the size of the file
+    @return the mapped bytes, or NULL if the file can't be mapped (missing, empty or no mapping on this platform)
+    @warning Release the mapping with unmapFileData.
+    @since v0.99.5
+    */
+    static unsigned char* mapFileData(const char* pszFileName, unsigned long * pSize);
+    static void unmapFileData(unsigned char* pData, unsigned long uSize);
+
     /** removes the HD suffix from a path
     @returns const char * without the HD suffix
     @since v0.99.5
@@ -37,13 +37,39 @@ public:
 	~NSData(void);
 	
 	void* bytes(void);
+	/// the length of the data in bytes
+	unsigned long getSize(void);
+
+	/** Returns a NSData sharing uLength bytes of the receiver from uLocation, without copying them.
+	The receiver is retained until the returned data is released.
+	@since v0.99.5
+	*/
+	NSData* subdataWithRange(unsigned long uLocation, unsigned long uLength);
 
 public:
 	static NSData* dataWithBytes(unsigned char *pBytes, int size);
+	/** Takes the ownership of a buffer allocated with new[], like the one returned by CCFileUtils::getFileData
+	@since v0.99.5
+	*/
+	static NSData* dataWithBytesNoCopy(unsigned char *pBytes, unsigned long size);
+	/** Takes the ownership of a file mapping made by FileUtils::mapFileData
+	@since v0.99.5
+	*/
+	static NSData* dataWithMappedBytes(unsigned char *pBytes, unsigned long size);
 	static NSData* dataWithContentsOfFile(const std::string &strPath);
+	/** Maps the file in memory instead of reading it, see CCFileUtils::getFileDataView.
+	The bytes are read only.
+	@since v0.99.5
+	*/
+	static NSData* dataWithContentsOfMappedFile(const std::string &strPath);
 
 private:
 	char *m_pData;
+	unsigned long m_nSize;
+	// m_pData is unmapped instead of deleted
+	bool m_bMapped;
+	// m_pData belongs to this data
+	NSData *m_pOwner;
 };
 }//namespace   cocos2d 
 
@@ -43,8 +43,9 @@ public:
 
 public:
 	NSMutableArray(unsigned int uSize = 0)
+		: m_uNullCount(0)
 	{
-		m_array.resize(uSize);
+		m_array.reserve(uSize);
 	}
 
 	~NSMutableArray(void)
@@ -54,6 +55,12 @@ public:
 
 	unsigned int count(void)
 	{
+		// the array only holds NULLs if replaceObjectAtIndex stored one
+		if (m_uNullCount == 0)
+		{
+			return (unsigned int)m_array.size();
+		}
+
 		unsigned int uCount = 0;
 		NSMutableArrayIterator it;
 		for (it = m_array.begin(); it != m_array.end(); ++it)
@@ -149,8 +156,8 @@ public:
 		// add the refrence
 		pObject->retain();
 
-		// if the vector is empty, push back
-		if (m_array.empty())
+		// if there is no empty slot, push back
+		if (m_uNullCount == 0)
 		{
 			m_array.push_back(pObject);
 			return;
@@ -164,6 +171,7 @@ public:
 			if (*it == NULL)
 			{
 				m_array[count] = pObject;
+				--m_uNullCount;
 				return;
 			}
             
@@ -201,10 +209,10 @@ public:
 		// add the refrence of the object
 		pObject->retain();
 
-		// resize the capacity if the index out of it
-		if (uIndex >= m_array.capacity())
+		// an index out of the array appends the object
+		if (uIndex > m_array.size())
 		{
-			m_array.resize(uIndex + 4);
+			uIndex = (unsigned int)m_array.size();
 		}
 
 		// insert the object
@@ -266,13 +274,14 @@ public:
 			return;
 		}
 
-		if (bDeleteObject)
+		T pObject = m_array.at(uIndex);
+		if (! pObject)
 		{
-			T pObject = m_array.at(uIndex);
-			if (pObject)
-			{
-				pObject->release();
-			}
+			--m_uNullCount;
+		}
+		else if (bDeleteObject)
+		{
+			pObject->release();
 		}
 		
 		m_array.erase(m_array.begin() + uIndex);
@@ -293,6 +302,7 @@ public:
 		}		
 
 		m_array.clear();
+		m_uNullCount = 0;
 	}
 
 	void replaceObjectAtIndex(unsigned int uIndex, T pObject, bool bDeleteObject = true)
@@ -302,6 +312,15 @@ public:
 			m_array[uIndex]->release();
 		}
 
+		if (! m_array[uIndex] && pObject)
+		{
+			--m_uNullCount;
+		}
+		else if (m_array[uIndex] && ! pObject)
+		{
+			++m_uNullCount;
+		}
+
 		m_array[uIndex] = pObject;
 
 		// add the ref
@@ -336,6 +355,7 @@ public:
 		NSMutableArray* pArray = new NSMutableArray();
 
 		pArray->m_array.assign(m_array.begin(), m_array.end());
+		pArray->m_uNullCount = m_uNullCount;
 
 		if(pArray->count() > 0)
 		{
@@ -384,6 +404,8 @@ public:
 
 private:
 	std::vector<T> m_array;
+	// number of NULL slots in m_array
+	unsigned int m_uNullCount;
 };
 
 #define NSArray NSMutableArray
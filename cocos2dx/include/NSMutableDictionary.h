@@ -24,56 +24,125 @@ THE SOFTWARE.
 #ifndef __NSMUTABLE_DICTIONARY_H__
 #define __NSMUTABLE_DICTIONARY_H__
 
-#include <map>
 #include <vector>
 #include <string>
+#include <string.h>
 #include "NSObject.h"
 #include "NSMutableArray.h"
+#include "CCXInternedString.h"
 
 using namespace std;
 namespace   cocos2d {
 class NSString;
 
+/** hash and compare the keys of NSMutableDictionary, the default works with integer keys */
+template<class _T>
+struct NSDictionaryKeyTraits
+{
+	static unsigned int hash(const _T& key)
+	{
+		// the table masks the low bits, mix the high bits of the key into them
+		unsigned int uHash = (unsigned int)key;
+		uHash ^= uHash >> 16;
+		uHash *= 0x85ebca6bu;
+		uHash ^= uHash >> 13;
+		uHash *= 0xc2b2ae35u;
+		uHash ^= uHash >> 16;
+		return uHash;
+	}
+	template<class _K>
+	static bool equal(const _T& key, const _K& other) { return key == other; }
+};
+
+/** string keys can also be looked up with a const char* without allocating */
+template<>
+struct NSDictionaryKeyTraits<std::string>
+{
+	static unsigned int hash(const std::string& key) { return CCXInternedString::hashString(key.c_str()); }
+	static unsigned int hash(const char *key) { return CCXInternedString::hashString(key); }
+	static bool equal(const std::string& key, const std::string& other) { return key == other; }
+	static bool equal(const std::string& key, const char *other) { return strcmp(key.c_str(), other) == 0; }
+};
+
+/** interned keys are hashed once and compared by pointer, a const char* lookup doesn't intern the string */
+template<>
+struct NSDictionaryKeyTraits<CCXInternedString>
+{
+	static unsigned int hash(const CCXInternedString& key) { return key.hash(); }
+	static unsigned int hash(const char *key) { return CCXInternedString::hashString(key); }
+	static bool equal(const CCXInternedString& key, const CCXInternedString& other) { return key == other; }
+	static bool equal(const CCXInternedString& key, const char *other) { return strcmp(key.c_str(), other) == 0; }
+};
+
+/**
+@brief A hash table of retained objects.
+
+The entries are kept in an open addressing table with linear probing, so a lookup
+is one hash of the key and a few comparisons, without any allocation.
+Removing an object while iterating with begin()/next() is safe, adding one may grow
+the table and restart the iteration order.
+@warning The iteration order is the order of the table, not the order of the keys.
+*/
 template<class _T, class _ValueT = NSObject*>
 class NSMutableDictionary : public NSObject
 {
-public:
-	typedef std::map<_T, _ValueT>	NSObjectMap;
-	typedef typename NSObjectMap::iterator	NSObjectMapIter;
-
 protected:
-	typedef pair<_T, _ValueT> Int_Pair;
-	NSObjectMap		m_Map;
+	typedef NSDictionaryKeyTraits<_T> KeyTraits;
+
+	enum
+	{
+		kSlotEmpty = 0,
+		kSlotUsed,
+		kSlotDeleted,
+	};
+
+	struct tSlot
+	{
+		_T				key;
+		_ValueT			value;
+		unsigned int	hash;
+		unsigned char	state;
+	};
+
+	tSlot			*m_pSlots;
+	unsigned int	m_uCapacity;
+	unsigned int	m_uCount;
+	unsigned int	m_uDeleted;
 	bool			m_bBegin;
-	NSObjectMapIter m_MapIter;
+	unsigned int	m_uIterIndex;
 
 public:
 	NSMutableDictionary(void)
+		: m_pSlots(NULL)
+		, m_uCapacity(0)
+		, m_uCount(0)
+		, m_uDeleted(0)
+		, m_bBegin(false)
+		, m_uIterIndex(0)
 	{
-		m_bBegin = false;
 	}
 
 	~NSMutableDictionary(void)
 	{
 		removeAllObjects();
+		delete[] m_pSlots;
 	}
 
 	/// return the number of items
 	unsigned int count()
 	{
-		return m_Map.size();
+		return m_uCount;
 	}
 
 	/// return all the keys
 	std::vector<std::string> allKeys()
 	{
 		std::vector<std::string> tRet;
-		if (m_Map.size() > 0)
+		for (unsigned int i = 0; i < m_uCapacity; ++i)
 		{
-			NSObjectMapIter it;
-			for( it = m_Map.begin(); it != m_Map.end(); ++it)
+			if (m_pSlots[i].state == kSlotUsed)
 			{
-				tRet.push_back(it->first);
+				tRet.push_back(m_pSlots[i].key);
 			}
 		}
 		return tRet;
@@ -83,70 +152,96 @@ public:
 	std::vector<std::string> allKeysForObject(_ValueT object)
 	{
 		std::vector<std::string> tRet;
-		if (m_Map.size() > 0)
+		for (unsigned int i = 0; i < m_uCapacity; ++i)
 		{
-			NSObjectMapIter it;
-			for( it= m_Map.begin(); it != m_Map.end(); ++it)
+			if (m_pSlots[i].state == kSlotUsed && m_pSlots[i].value == object)
 			{
-				if (it->second == object)
-				{
-					tRet.push_back(it->first);
-				}
+				tRet.push_back(m_pSlots[i].key);
 			}
 		}
 		return tRet;
 	}
 
-	_ValueT objectForKey(_T key)			///< 
+	_ValueT objectForKey(const _T& key)			///< 
 	{
-		NSObjectMapIter it;
-
-		it = m_Map.find(key);
+		return objectForHashedKey(key, KeyTraits::hash(key));
+	}
 
-		if(it == m_Map.end()) //no match case
+	/** look up a string key without building a std::string
+	@since v0.99.5
+	*/
+	_ValueT objectForKey(const char *key)
+	{
+		if (! key)
+		{
 			return NULL;
+		}
 
-		return it->second;
+		return objectForHashedKey(key, KeyTraits::hash(key));
 	}
 
-
-	bool setObject(_ValueT pObject, _T key)
+	bool setObject(_ValueT pObject, const _T& key)
 	{
-		pair<NSObjectMapIter, bool > pr;
+		unsigned int uHash = KeyTraits::hash(key);
 
-		pr = m_Map.insert( Int_Pair(key, pObject) );
+		if (findSlot(key, uHash) >= 0)
+		{
+			return false;
+		}
 
-		if(pr.second == true)
+		// keep at least a quarter of the slots empty so that probing stays short
+		if ((m_uCount + m_uDeleted + 1) * 4 > m_uCapacity * 3)
 		{
-			pObject->retain(); 
-			return true;
+			unsigned int uCapacity = m_uCapacity ? m_uCapacity : 16;
+			while ((m_uCount + 1) * 2 > uCapacity)
+			{
+				uCapacity *= 2;
+			}
+			rehash(uCapacity);
 		}
 
-		return false;
-	}
+		unsigned int uMask = m_uCapacity - 1;
+		unsigned int i = uHash & uMask;
+		while (m_pSlots[i].state == kSlotUsed)
+		{
+			i = (i + 1) & uMask;
+		}
 
-	void removeObjectForKey(_T key)
-	{
-		NSObjectMapIter it;
+		if (m_pSlots[i].state == kSlotDeleted)
+		{
+			--m_uDeleted;
+		}
 
-		it = m_Map.find(key);
+		m_pSlots[i].key = key;
+		m_pSlots[i].value = pObject;
+		m_pSlots[i].hash = uHash;
+		m_pSlots[i].state = kSlotUsed;
+		++m_uCount;
 
-		if(it == m_Map.end()) //no match case
-			return;
+		pObject->retain();
+		return true;
+	}
+
+	void removeObjectForKey(const _T& key)
+	{
+		removeSlot(findSlot(key, KeyTraits::hash(key)));
+	}
 
-		if(it->second )
+	/** @since v0.99.5 */
+	void removeObjectForKey(const char *key)
+	{
+		if (key)
 		{
-			it->second->release() ; 
-			m_Map.erase(it);
+			removeSlot(findSlot(key, KeyTraits::hash(key)));
 		}
 	}
 
 	bool begin()
 	{
-		if(m_Map.size() == 0)
+		if(m_uCount == 0)
 			return false;
 
-		m_MapIter = m_Map.begin();
+		m_uIterIndex = 0;
 		m_bBegin = true;
 
 		return true;
@@ -157,28 +252,25 @@ public:
 		if(!m_bBegin)
 			return NULL;
 
-		_ValueT pObject = m_MapIter->second;
+		while (m_uIterIndex < m_uCapacity && m_pSlots[m_uIterIndex].state != kSlotUsed)
+		{
+			++m_uIterIndex;
+		}
 
-		if(m_MapIter == m_Map.end())
+		if (m_uIterIndex == m_uCapacity)
 		{
 			m_bBegin = false;
+			return NULL;
 		}
-		else
-		{
-			if(key)
-			{
-				*key = m_MapIter->first;
-			}
 
-			m_MapIter++;
+		tSlot& slot = m_pSlots[m_uIterIndex++];
 
-			if(m_MapIter == m_Map.end())
-			{
-				m_bBegin = false;
-			}
+		if(key)
+		{
+			*key = slot.key;
 		}
 
-		return pObject;
+		return slot.value;
 	}
 
 	void end()
@@ -188,18 +280,21 @@ public:
 
 	void removeAllObjects()
 	{
-		if (m_Map.size() > 0)
+		for (unsigned int i = 0; i < m_uCapacity; ++i)
 		{
-			NSObjectMapIter it;
-			for( it = m_Map.begin(); it != m_Map.end(); ++it)
+			if (m_pSlots[i].state == kSlotUsed && m_pSlots[i].value)
 			{
-				if (it->second)
-				{
-					it->second->release();
-				}
+				m_pSlots[i].value->release();
 			}
+
+			m_pSlots[i].key = _T();
+			m_pSlots[i].value = NULL;
+			m_pSlots[i].state = kSlotEmpty;
 		}
-		m_Map.clear();
+
+		m_uCount = 0;
+		m_uDeleted = 0;
+		m_bBegin = false;
 	}
 
 	static NSMutableDictionary<_T, _ValueT>* dictionaryWithDictionary(NSMutableDictionary<_T, _ValueT>* srcDict)
@@ -220,6 +315,93 @@ public:
 
 		return pNewDict;
 	}
+
+protected:
+	template<class _K>
+	int findSlot(const _K& key, unsigned int uHash)
+	{
+		if (m_uCount == 0)
+		{
+			return -1;
+		}
+
+		unsigned int uMask = m_uCapacity - 1;
+		for (unsigned int i = uHash & uMask; m_pSlots[i].state != kSlotEmpty; i = (i + 1) & uMask)
+		{
+			if (m_pSlots[i].state == kSlotUsed && m_pSlots[i].hash == uHash && KeyTraits::equal(m_pSlots[i].key, key))
+			{
+				return (int)i;
+			}
+		}
+
+		return -1;
+	}
+
+	template<class _K>
+	_ValueT objectForHashedKey(const _K& key, unsigned int uHash)
+	{
+		int nSlot = findSlot(key, uHash);
+
+		if (nSlot < 0) //no match case
+			return NULL;
+
+		return m_pSlots[nSlot].value;
+	}
+
+	/** the slot is only marked as deleted, so that an iteration in progress is not disturbed */
+	void removeSlot(int nSlot)
+	{
+		if (nSlot < 0 || ! m_pSlots[nSlot].value)
+		{
+			return;
+		}
+
+		tSlot& slot = m_pSlots[nSlot];
+		slot.value->release();
+		slot.key = _T();
+		slot.value = NULL;
+		slot.state = kSlotDeleted;
+
+		--m_uCount;
+		++m_uDeleted;
+	}
+
+	/** move the entries to a table of uCapacity slots, a power of two, dropping the deleted ones */
+	void rehash(unsigned int uCapacity)
+	{
+		tSlot *pOldSlots = m_pSlots;
+		unsigned int uOldCapacity = m_uCapacity;
+
+		m_pSlots = new tSlot[uCapacity];
+		m_uCapacity = uCapacity;
+		m_uDeleted = 0;
+
+		for (unsigned int i = 0; i < uCapacity; ++i)
+		{
+			m_pSlots[i].value = NULL;
+			m_pSlots[i].hash = 0;
+			m_pSlots[i].state = kSlotEmpty;
+		}
+
+		unsigned int uMask = uCapacity - 1;
+		for (unsigned int i = 0; i < uOldCapacity; ++i)
+		{
+			if (pOldSlots[i].state != kSlotUsed)
+			{
+				continue;
+			}
+
+			unsigned int j = pOldSlots[i].hash & uMask;
+			while (m_pSlots[j].state == kSlotUsed)
+			{
+				j = (j + 1) & uMask;
+			}
+
+			m_pSlots[j] = pOldSlots[i];
+		}
+
+		delete[] pOldSlots;
+	}
 };
 
 #define NSDictionary	NSMutableDictionary
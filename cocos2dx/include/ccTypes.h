@@ -221,6 +221,15 @@ typedef struct _ccV2F_C4F_T2F
 	ccTex2F			texCoords;
 } ccV2F_C4F_T2F;
 
+//! a Point with a vertex point and a color 4B
+typedef struct _ccV2F_C4B
+{
+	//! vertices (2F)
+	ccVertex2F		vertices;
+	//! colors (4B)
+	ccColor4B		colors;
+} ccV2F_C4B;
+
 //! a Point with a vertex point, a tex coord point and a color 4B
 typedef struct _ccV3F_C4B_T2F
 {
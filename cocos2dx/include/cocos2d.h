@@ -44,17 +44,22 @@ THE SOFTWARE.
 #include "CCActionInterval.h"
 #include "CCActionEase.h"
 #include "CCLabelTTF.h"
+#include "CCGlyphCache.h"
 #include "CCLayer.h"
 #include "CCMenu.h"
 #include "CCMenuItem.h"
 #include "CCParticleSystem.h"
 #include "CCParticleSystemPoint.h"
 #include "CCParticleSystemQuad.h"
+#include "CCParticleBatchNode.h"
+#include "CCParticleTemplateCache.h"
+#include "CCParticlePool.h"
 #include "CCParticleExamples.h"
 #include "CCScene.h"
 #include "CCSprite.h"
 #include "CCSpriteFrameCache.h"
 #include "CCTextureCache.h"
+#include "CCResourcePreloader.h"
 #include "CCTransition.h"
 #include "CCTextureAtlas.h"
 #include "CCLabelAtlas.h"
@@ -0,0 +1,336 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCGlyphCache.h"
+#include "CCTexture2D.h"
+#include "ccMacros.h"
+#include "platform/platform.h"
+#include "CCXUIImage.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace cocos2d {
+
+// space left around each glyph, so that linear filtering doesn't pick up the neighbours
+#define kCCGlyphPadding 1
+
+static unsigned int encodeCharacter(unsigned int uCharacter, char *pszText)
+{
+	unsigned int uLength = 0;
+
+	if (uCharacter < 0x80)
+	{
+		pszText[uLength++] = (char)uCharacter;
+	}
+	else if (uCharacter < 0x800)
+	{
+		pszText[uLength++] = (char)(0xc0 | (uCharacter >> 6));
+		pszText[uLength++] = (char)(0x80 | (uCharacter & 0x3f));
+	}
+	else if (uCharacter < 0x10000)
+	{
+		pszText[uLength++] = (char)(0xe0 | (uCharacter >> 12));
+		pszText[uLength++] = (char)(0x80 | ((uCharacter >> 6) & 0x3f));
+		pszText[uLength++] = (char)(0x80 | (uCharacter & 0x3f));
+	}
+	else
+	{
+		pszText[uLength++] = (char)(0xf0 | (uCharacter >> 18));
+		pszText[uLength++] = (char)(0x80 | ((uCharacter >> 12) & 0x3f));
+		pszText[uLength++] = (char)(0x80 | ((uCharacter >> 6) & 0x3f));
+		pszText[uLength++] = (char)(0x80 | (uCharacter & 0x3f));
+	}
+
+	pszText[uLength] = 0;
+	return uLength;
+}
+
+//
+// CCGlyphFont
+//
+
+CCGlyphFont::CCGlyphFont(void)
+: m_fFontSize(0)
+, m_fLineHeight(0)
+, m_pPages(NULL)
+, m_uPageSize(0)
+, m_uPenX(0)
+, m_uPenY(0)
+, m_uShelfHeight(0)
+{
+}
+
+CCGlyphFont::~CCGlyphFont(void)
+{
+	CCX_SAFE_RELEASE(m_pPages);
+}
+
+bool CCGlyphFont::initWithFontName(const char *fontName, float fontSize)
+{
+	m_sFontName = fontName ? fontName : "";
+	m_fFontSize = fontSize;
+	m_pPages = new NSMutableArray<CCTexture2D*>();
+
+	// a page holds a few lines of glyphs, the smaller the font the smaller the page
+	m_uPageSize = 256;
+	while (m_uPageSize < 1024 && m_uPageSize < fontSize * 8)
+	{
+		m_uPageSize *= 2;
+	}
+
+	return true;
+}
+
+unsigned int CCGlyphFont::nextCharacter(const char **ppszText)
+{
+	const unsigned char *p = (const unsigned char*)*ppszText;
+	unsigned int uCharacter = *p++;
+	int nFollowing = 0;
+
+	if (uCharacter >= 0xf0)
+	{
+		uCharacter &= 0x07;
+		nFollowing = 3;
+	}
+	else if (uCharacter >= 0xe0)
+	{
+		uCharacter &= 0x0f;
+		nFollowing = 2;
+	}
+	else if (uCharacter >= 0xc0)
+	{
+		uCharacter &= 0x1f;
+		nFollowing = 1;
+	}
+
+	// stop at a truncated sequence rather than reading past the terminator
+	for (; nFollowing > 0 && (*p & 0xc0) == 0x80; --nFollowing)
+	{
+		uCharacter = (uCharacter << 6) | (*p++ & 0x3f);
+	}
+
+	*ppszText = (const char*)p;
+	return uCharacter;
+}
+
+const ccGlyph* CCGlyphFont::glyphForCharacter(unsigned int uCharacter)
+{
+	std::map<unsigned int, ccGlyph>::iterator it = m_tGlyphs.find(uCharacter);
+	if (it == m_tGlyphs.end())
+	{
+		ccGlyph glyph;
+		if (! rasterizeGlyph(uCharacter, &glyph))
+		{
+			return NULL;
+		}
+
+		it = m_tGlyphs.insert(std::pair<unsigned int, ccGlyph>(uCharacter, glyph)).first;
+	}
+
+	return &it->second;
+}
+
+bool CCGlyphFont::rasterizeGlyph(unsigned int uCharacter, ccGlyph *pGlyph)
+{
+	char szText[8];
+	encodeCharacter(uCharacter, szText);
+
+	CCXBitmapDC *pBitmapDC = new CCXBitmapDC(szText, CGSizeZero, UITextAlignmentLeft, m_sFontName.c_str(), m_fFontSize);
+	UIImage *pImage = new UIImage(pBitmapDC);
+
+	bool bRet = false;
+	unsigned char *pCoverage = NULL;
+
+	do 
+	{
+		unsigned int uWidth = pImage->width();
+		unsigned int uHeight = pImage->height();
+		unsigned char *pData = pImage->getData();
+
+		pGlyph->texture = NULL;
+		pGlyph->rect = CGRectZero;
+		pGlyph->advance = (float)uWidth;
+
+		if (m_fLineHeight < uHeight)
+		{
+			m_fLineHeight = (float)uHeight;
+		}
+
+		// nothing to draw, the glyph only moves the pen
+		if (uWidth == 0 || uHeight == 0 || ! pData)
+		{
+			bRet = true;
+			break;
+		}
+
+		CCX_BREAK_IF(pImage->CGImageGetBitsPerComponent() != 8);
+
+		// The platforms disagree on premultiplication, and some only fill the color.
+		// The text is white, so the coverage is the alpha of the premultiplied color.
+		bool bPremultiplied = pImage->isPremultipliedAlpha();
+		pCoverage = new unsigned char[uWidth * uHeight];
+		for (unsigned int i = 0; i < uWidth * uHeight; ++i)
+		{
+			const unsigned char *pPixel = pData + i * 4;
+			unsigned int uAlpha = pPixel[3];
+
+			if (! bPremultiplied)
+			{
+				unsigned int uColor = MAX(pPixel[0], MAX(pPixel[1], pPixel[2]));
+				uAlpha = uAlpha * uColor / 255;
+			}
+
+			pCoverage[i] = (unsigned char)uAlpha;
+		}
+
+		CGPoint origin;
+		CCTexture2D *pPage = reserveRect(uWidth, uHeight, &origin);
+		CCX_BREAK_IF(! pPage);
+
+		pPage->updateWithData(pCoverage, (unsigned int)origin.x, (unsigned int)origin.y, uWidth, uHeight);
+
+		pGlyph->texture = pPage;
+		pGlyph->rect = CGRectMake(origin.x, origin.y, (float)uWidth, (float)uHeight);
+		bRet = true;
+	} while (0);
+
+	CCX_SAFE_DELETE_ARRAY(pCoverage);
+	delete pImage;
+	delete pBitmapDC;
+
+	return bRet;
+}
+
+CCTexture2D* CCGlyphFont::reserveRect(unsigned int uWidth, unsigned int uHeight, CGPoint *pOrigin)
+{
+	if (uWidth + kCCGlyphPadding > m_uPageSize || uHeight + kCCGlyphPadding > m_uPageSize)
+	{
+		CCLOG("cocos2d: CCGlyphFont: glyph of %ux%u doesn't fit in a page", uWidth, uHeight);
+		return NULL;
+	}
+
+	// next shelf
+	if (m_uPenX + uWidth + kCCGlyphPadding > m_uPageSize)
+	{
+		m_uPenX = 0;
+		m_uPenY += m_uShelfHeight;
+		m_uShelfHeight = 0;
+	}
+
+	// next page
+	if (m_pPages->count() == 0 || m_uPenY + uHeight + kCCGlyphPadding > m_uPageSize)
+	{
+		void *pZero = calloc(m_uPageSize * m_uPageSize, 1);
+		if (! pZero)
+		{
+			return NULL;
+		}
+
+		CCTexture2D *pPage = new CCTexture2D();
+		pPage->initWithData(pZero, kCCTexture2DPixelFormat_A8, m_uPageSize, m_uPageSize, CGSizeMake((float)m_uPageSize, (float)m_uPageSize));
+		free(pZero);
+
+		m_pPages->addObject(pPage);
+		pPage->release();
+
+		m_uPenX = 0;
+		m_uPenY = 0;
+		m_uShelfHeight = 0;
+	}
+
+	pOrigin->x = (float)m_uPenX;
+	pOrigin->y = (float)m_uPenY;
+
+	m_uPenX += uWidth + kCCGlyphPadding;
+	if (m_uShelfHeight < uHeight + kCCGlyphPadding)
+	{
+		m_uShelfHeight = uHeight + kCCGlyphPadding;
+	}
+
+	return m_pPages->getLastObject();
+}
+
+//
+// CCGlyphCache
+//
+
+static CCGlyphCache *g_sharedGlyphCache = NULL;
+
+CCGlyphCache* CCGlyphCache::sharedGlyphCache(void)
+{
+	if (! g_sharedGlyphCache)
+	{
+		g_sharedGlyphCache = new CCGlyphCache();
+	}
+
+	return g_sharedGlyphCache;
+}
+
+void CCGlyphCache::purgeSharedGlyphCache(void)
+{
+	CCX_SAFE_RELEASE_NULL(g_sharedGlyphCache);
+}
+
+CCGlyphCache::CCGlyphCache(void)
+{
+	NSAssert(g_sharedGlyphCache == NULL, "Attempted to allocate a second instance of a singleton.");
+
+	m_pFonts = new NSMutableDictionary<std::string, CCGlyphFont*>();
+}
+
+CCGlyphCache::~CCGlyphCache(void)
+{
+	CCX_SAFE_RELEASE(m_pFonts);
+}
+
+CCGlyphFont* CCGlyphCache::fontWithName(const char *fontName, float fontSize)
+{
+	char szSize[32];
+	sprintf(szSize, "@%.2f", fontSize);
+	std::string key = std::string(fontName ? fontName : "") + szSize;
+
+	CCGlyphFont *pFont = m_pFonts->objectForKey(key);
+	if (! pFont)
+	{
+		pFont = new CCGlyphFont();
+		if (! pFont->initWithFontName(fontName, fontSize))
+		{
+			delete pFont;
+			return NULL;
+		}
+
+		m_pFonts->setObject(pFont, key);
+		pFont->release();
+	}
+
+	return pFont;
+}
+
+void CCGlyphCache::removeAllFonts(void)
+{
+	m_pFonts->removeAllObjects();
+}
+
+}//namespace cocos2d
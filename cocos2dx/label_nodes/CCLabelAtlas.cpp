@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "CGPointExtension.h"
 #include "CCDrawingPrimitives.h"
 #include "ccConfig.h"
+#include "CCDirector.h"
 
 namespace cocos2d{
 
@@ -156,7 +157,17 @@ namespace cocos2d{
 			glBlendFunc( m_tBlendFunc.src, m_tBlendFunc.dst );
 		}
 
-		m_pTextureAtlas->drawNumberOfQuads(m_sString.length());
+		CGRect visibleRect;
+		if (visibleRectInNodeSpace(&visibleRect))
+		{
+			unsigned int uQuads = m_sString.length();
+			unsigned int uDrawn = m_pTextureAtlas->drawNumberOfQuadsInRect(uQuads, visibleRect);
+			CCDirector::sharedDirector()->addCullingStats(uQuads, uQuads - uDrawn);
+		}
+		else
+		{
+			m_pTextureAtlas->drawNumberOfQuads(m_sString.length());
+		}
 
 		if( newBlend )
 			glBlendFunc(CC_BLEND_SRC, CC_BLEND_DST);
@@ -22,11 +22,34 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "CCLabelTTF.h"
+#include "CCGlyphCache.h"
+#include "CCDirector.h"
 
 namespace cocos2d{
+	static bool s_bGlyphCacheEnabled = true;
+
 	//
 	//CCLabelTTF
 	//
+	CCLabelTTF::~CCLabelTTF()
+	{
+		m_sFontName.clear();
+		CCX_SAFE_RELEASE(m_pGlyphFont);
+		CCX_SAFE_FREE(m_pGlyphQuads);
+		CCX_SAFE_FREE(m_pGlyphPages);
+		CCX_SAFE_FREE(m_pGlyphIndices);
+	}
+
+	void CCLabelTTF::setIsGlyphCacheEnabled(bool bEnabled)
+	{
+		s_bGlyphCacheEnabled = bEnabled;
+	}
+
+	bool CCLabelTTF::isGlyphCacheEnabled(void)
+	{
+		return s_bGlyphCacheEnabled;
+	}
+
 	CCLabelTTF * CCLabelTTF::labelWithString(const char *label, CGSize dimensions, UITextAlignment alignment, const char *fontName, float fontSize)
 	{
 		CCLabelTTF *pRet = new CCLabelTTF();
@@ -85,6 +108,15 @@ namespace cocos2d{
         }
 
 		m_sString = string(label);
+
+		m_bUsesGlyphCache = s_bGlyphCacheEnabled
+			&& CGSize::CGSizeEqualToSize(m_tDimensions, CGSizeZero)
+			&& ! m_bUsesBatchNode
+			&& updateGlyphQuads(label);
+		if (m_bUsesGlyphCache)
+		{
+			return;
+		}
         
 		CCTexture2D *texture;
 		if( CGSize::CGSizeEqualToSize( m_tDimensions, CGSizeZero ) )
@@ -105,6 +137,218 @@ namespace cocos2d{
 		this->setTextureRect(rect);
 	}
 
+	bool CCLabelTTF::updateGlyphQuads(const char *label)
+	{
+		// the platforms break lines themselves
+		if (strchr(label, '\n'))
+		{
+			return false;
+		}
+
+		if (! m_pGlyphFont)
+		{
+			m_pGlyphFont = CCGlyphCache::sharedGlyphCache()->fontWithName(m_sFontName.c_str(), m_fFontSize);
+			CCX_SAFE_RETAIN(m_pGlyphFont);
+			if (! m_pGlyphFont)
+			{
+				return false;
+			}
+		}
+
+		// there are never more characters than bytes, and the indices are GLushort
+		unsigned int uLength = strlen(label);
+		if (uLength > 65536 / 4)
+		{
+			return false;
+		}
+
+		if (uLength > m_uGlyphCapacity)
+		{
+			ccV3F_C4B_T2F_Quad *pQuads = (ccV3F_C4B_T2F_Quad*)realloc(m_pGlyphQuads, uLength * sizeof(ccV3F_C4B_T2F_Quad));
+			if (pQuads)
+			{
+				m_pGlyphQuads = pQuads;
+			}
+			CCTexture2D **pPages = (CCTexture2D**)realloc(m_pGlyphPages, uLength * sizeof(CCTexture2D*));
+			if (pPages)
+			{
+				m_pGlyphPages = pPages;
+			}
+			GLushort *pIndices = (GLushort*)realloc(m_pGlyphIndices, uLength * 6 * sizeof(GLushort));
+			if (pIndices)
+			{
+				m_pGlyphIndices = pIndices;
+			}
+
+			if (! pQuads || ! pPages || ! pIndices)
+			{
+				return false;
+			}
+
+			for (unsigned int i = m_uGlyphCapacity; i < uLength; ++i)
+			{
+				m_pGlyphIndices[i * 6 + 0] = (GLushort)(i * 4 + 0);
+				m_pGlyphIndices[i * 6 + 1] = (GLushort)(i * 4 + 1);
+				m_pGlyphIndices[i * 6 + 2] = (GLushort)(i * 4 + 2);
+				m_pGlyphIndices[i * 6 + 3] = (GLushort)(i * 4 + 3);
+				m_pGlyphIndices[i * 6 + 4] = (GLushort)(i * 4 + 2);
+				m_pGlyphIndices[i * 6 + 5] = (GLushort)(i * 4 + 1);
+			}
+
+			m_uGlyphCapacity = uLength;
+		}
+
+		// the glyphs are laid out in pixels, like the vertices of a sprite
+		ccColor4B white = { 255, 255, 255, 255 };
+		float fPenX = 0;
+		unsigned int uCount = 0;
+		const char *p = label;
+
+		while (*p)
+		{
+			const ccGlyph *pGlyph = m_pGlyphFont->glyphForCharacter(CCGlyphFont::nextCharacter(&p));
+			if (! pGlyph)
+			{
+				return false;
+			}
+
+			if (pGlyph->texture)
+			{
+				float fPageSize = (float)pGlyph->texture->getPixelsWide();
+				float left = pGlyph->rect.origin.x / fPageSize;
+				float right = (pGlyph->rect.origin.x + pGlyph->rect.size.width) / fPageSize;
+				float top = pGlyph->rect.origin.y / fPageSize;
+				float bottom = (pGlyph->rect.origin.y + pGlyph->rect.size.height) / fPageSize;
+
+				float x1 = fPenX;
+				float x2 = fPenX + pGlyph->rect.size.width;
+				float y2 = pGlyph->rect.size.height;
+
+				ccV3F_C4B_T2F_Quad& quad = m_pGlyphQuads[uCount];
+				quad.bl.vertices = vertex3(x1, 0, 0);
+				quad.br.vertices = vertex3(x2, 0, 0);
+				quad.tl.vertices = vertex3(x1, y2, 0);
+				quad.tr.vertices = vertex3(x2, y2, 0);
+				quad.bl.texCoords = tex2(left, bottom);
+				quad.br.texCoords = tex2(right, bottom);
+				quad.tl.texCoords = tex2(left, top);
+				quad.tr.texCoords = tex2(right, top);
+				quad.bl.colors = quad.br.colors = quad.tl.colors = quad.tr.colors = white;
+
+				m_pGlyphPages[uCount] = pGlyph->texture;
+				++uCount;
+			}
+
+			fPenX += pGlyph->advance;
+		}
+
+		m_uGlyphCount = uCount;
+
+		// group the glyphs by page, keeping their order within a page, so that draw binds each page once.
+		// The glyphs of a line don't overlap, the order of the pages doesn't show
+		for (unsigned int i = 0; i < uCount; )
+		{
+			CCTexture2D *pPage = m_pGlyphPages[i];
+			unsigned int uEnd = i + 1;
+
+			for (unsigned int j = uEnd; j < uCount; ++j)
+			{
+				if (m_pGlyphPages[j] != pPage)
+				{
+					continue;
+				}
+
+				if (j != uEnd)
+				{
+					ccV3F_C4B_T2F_Quad quad = m_pGlyphQuads[j];
+					memmove(m_pGlyphQuads + uEnd + 1, m_pGlyphQuads + uEnd, (j - uEnd) * sizeof(ccV3F_C4B_T2F_Quad));
+					memmove(m_pGlyphPages + uEnd + 1, m_pGlyphPages + uEnd, (j - uEnd) * sizeof(CCTexture2D*));
+					m_pGlyphQuads[uEnd] = quad;
+					m_pGlyphPages[uEnd] = pPage;
+				}
+				++uEnd;
+			}
+
+			i = uEnd;
+		}
+
+		// the pages have no premultiplied alpha, this sets the blending for them
+		if (uCount > 0)
+		{
+			this->setTexture(m_pGlyphPages[0]);
+		}
+
+		this->setContentSizeInPixels(CGSizeMake(fPenX, m_pGlyphFont->getLineHeight()));
+		return true;
+	}
+
+	void CCLabelTTF::draw(void)
+	{
+		if (! m_bUsesGlyphCache)
+		{
+			CCSprite::draw();
+			return;
+		}
+
+		if (m_uGlyphCount == 0)
+		{
+			return;
+		}
+
+		if (CCDirector::sharedDirector()->isCullingActive())
+		{
+			bool bCulled = isRectCulled(CGRectMake(0, 0, m_tContentSizeInPixels.width, m_tContentSizeInPixels.height));
+			CCDirector::sharedDirector()->addCullingStats(1, bCulled ? 1 : 0);
+
+			if (bCulled)
+			{
+				return;
+			}
+		}
+
+		// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
+		// Needed states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_TEXTURE_COORD_ARRAY
+		// Unneeded states: GL_COLOR_ARRAY
+		// The A8 pages take their color from glColor, so color changes don't touch the quads
+		glDisableClientState(GL_COLOR_ARRAY);
+		glColor4ub(m_sColor.r, m_sColor.g, m_sColor.b, m_nOpacity);
+
+		bool newBlend = m_sBlendFunc.src != CC_BLEND_SRC || m_sBlendFunc.dst != CC_BLEND_DST;
+		if (newBlend)
+		{
+			glBlendFunc(m_sBlendFunc.src, m_sBlendFunc.dst);
+		}
+
+		glVertexPointer(3, GL_FLOAT, sizeof(ccV3F_C4B_T2F), &m_pGlyphQuads[0].tl.vertices);
+		glTexCoordPointer(2, GL_FLOAT, sizeof(ccV3F_C4B_T2F), &m_pGlyphQuads[0].tl.texCoords);
+
+		// one draw call per page, the glyphs are grouped by page
+		unsigned int uStart = 0;
+		while (uStart < m_uGlyphCount)
+		{
+			CCTexture2D *pPage = m_pGlyphPages[uStart];
+			unsigned int uEnd = uStart + 1;
+			while (uEnd < m_uGlyphCount && m_pGlyphPages[uEnd] == pPage)
+			{
+				++uEnd;
+			}
+
+			glBindTexture(GL_TEXTURE_2D, pPage->getName());
+			glDrawElements(GL_TRIANGLES, (uEnd - uStart) * 6, GL_UNSIGNED_SHORT, m_pGlyphIndices + uStart * 6);
+
+			uStart = uEnd;
+		}
+
+		if (newBlend)
+		{
+			glBlendFunc(CC_BLEND_SRC, CC_BLEND_DST);
+		}
+
+		// restore default GL state
+		glColor4ub(255, 255, 255, 255);
+		glEnableClientState(GL_COLOR_ARRAY);
+	}
+
 	const char* CCLabelTTF::getString(void)
 	{
 		return m_sString.c_str();
@@ -54,6 +54,8 @@ CCProgressTimerType CCTransitionRadialCCW::radialType()
 
 void CCTransitionRadialCCW::onEnter()
 {
+	// the outScene is rendered to a texture below
+	m_eSnapshotMode = kCCTransitionSnapshotNone;
 	CCTransitionScene::onEnter();
 	// create a transparent color layer
 	// in which we are going to add our rendertextures
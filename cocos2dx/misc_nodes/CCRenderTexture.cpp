@@ -27,11 +27,229 @@ THE SOFTWARE.
 #include "platform/platform.h"
 #include "CCXUIImage.h"
 #include "support/ccUtils.h"
+#include "support/image_support/ImageEncoder.h"
+#include "platform/CCXThread.h"
+#include "CCScheduler.h"
 
 #include <GLES/glext.h>
+#include <vector>
+#include <string>
 
 namespace cocos2d { 
 
+// async captures
+
+typedef enum
+{
+	kCaptureStateWaiting,	// waiting for the GPU to finish drawing the render target
+	kCaptureStateEncoding,	// pixels read back, a worker thread flips and encodes them
+	kCaptureStateDone,		// result ready to be delivered on the main thread
+} tCaptureState;
+
+typedef struct _ccCaptureRequest
+{
+	CCRenderTexture		*renderTexture;
+	std::string			fileName;
+	int					format;
+	SelectorProtocol	*target;
+	SEL_CallFuncND		selector;
+	int					framesLeft;
+	tCaptureState		state;
+
+	unsigned char		*pixels;
+	int					width;
+	int					height;
+	unsigned char		*result;
+	unsigned long		resultLength;
+	bool				succeeded;
+} ccCaptureRequest;
+
+static bool s_bSynchronousCapture = false;
+static int s_nCaptureFrameDelay = 2;
+
+// reads the bound render target back, bottom-up rows
+static unsigned char* readFramebufferPixels(int nWidth, int nHeight)
+{
+	unsigned char *pPixels = new unsigned char[nWidth * nHeight * 4];
+	if (pPixels)
+	{
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, nWidth, nHeight, GL_RGBA, GL_UNSIGNED_BYTE, pPixels);
+	}
+	return pPixels;
+}
+
+// runs on the worker thread when there is one, touches nothing but the request
+static void encodeCaptureRequest(ccCaptureRequest *pRequest)
+{
+	ccImageFlipRows(pRequest->pixels, pRequest->width, pRequest->height, 4);
+
+	bool bRet = ccImageEncodeRGBA(pRequest->pixels, pRequest->width, pRequest->height, pRequest->format,
+		&pRequest->result, &pRequest->resultLength);
+	if (bRet && ! pRequest->fileName.empty())
+	{
+		bRet = ccImageWriteFile(pRequest->fileName.c_str(), pRequest->result, pRequest->resultLength);
+	}
+
+	delete [] pRequest->pixels;
+	pRequest->pixels = NULL;
+	pRequest->succeeded = bRet;
+}
+
+class CCRenderTextureCaptureQueue : public SelectorProtocol
+{
+public:
+	static CCRenderTextureCaptureQueue* sharedQueue(void)
+	{
+		static CCRenderTextureCaptureQueue s_queue;
+		return &s_queue;
+	}
+
+	void addRequest(ccCaptureRequest *pRequest)
+	{
+		m_requests.push_back(pRequest);
+
+		if (s_bSynchronousCapture)
+		{
+			// headless, no frame to wait for
+			flush(pRequest);
+			return;
+		}
+
+		if (! m_bScheduled)
+		{
+			CCScheduler::sharedScheduler()->scheduleSelector(schedule_selector(CCRenderTextureCaptureQueue::tick), this, 0, false);
+			m_bScheduled = true;
+		}
+	}
+
+	bool hasRequests(void)
+	{
+		return ! m_requests.empty();
+	}
+
+	virtual void tick(ccTime dt)
+	{
+		// iterate over a copy, the callbacks may add requests
+		std::vector<ccCaptureRequest*> requests = m_requests;
+		for (unsigned int i = 0; i < requests.size(); ++i)
+		{
+			ccCaptureRequest *pRequest = requests[i];
+
+			// the worker thread writes the state once it is done encoding
+			m_lock.lock();
+			tCaptureState eState = pRequest->state;
+			m_lock.unlock();
+
+			if (eState == kCaptureStateWaiting)
+			{
+				if (--pRequest->framesLeft <= 0)
+				{
+					readBack(pRequest);
+				}
+			}
+			else if (eState == kCaptureStateDone)
+			{
+				deliver(pRequest);
+			}
+		}
+
+		if (m_requests.empty() && m_bScheduled)
+		{
+			CCScheduler::sharedScheduler()->unscheduleSelector(schedule_selector(CCRenderTextureCaptureQueue::tick), this);
+			m_bScheduled = false;
+		}
+	}
+
+private:
+	CCRenderTextureCaptureQueue(void) : m_bScheduled(false) {}
+
+	static void workerProc(void *pData)
+	{
+		ccCaptureRequest *pRequest = (ccCaptureRequest*)pData;
+		encodeCaptureRequest(pRequest);
+
+		CCRenderTextureCaptureQueue *pQueue = sharedQueue();
+		pQueue->m_lock.lock();
+		pRequest->state = kCaptureStateDone;
+		pQueue->m_lock.unlock();
+	}
+
+	void readBack(ccCaptureRequest *pRequest)
+	{
+		pRequest->pixels = pRequest->renderTexture->readPixels(&pRequest->width, &pRequest->height, false);
+		pRequest->state = kCaptureStateEncoding;
+
+		if (! pRequest->pixels)
+		{
+			pRequest->state = kCaptureStateDone;
+			return;
+		}
+
+		if (! ccxStartThread(workerProc, pRequest))
+		{
+			// no worker thread, encode on the main thread and deliver on the next tick
+			encodeCaptureRequest(pRequest);
+			pRequest->state = kCaptureStateDone;
+		}
+	}
+
+	// reads back, encodes and delivers at once
+	void flush(ccCaptureRequest *pRequest)
+	{
+		pRequest->pixels = pRequest->renderTexture->readPixels(&pRequest->width, &pRequest->height, false);
+		if (pRequest->pixels)
+		{
+			encodeCaptureRequest(pRequest);
+		}
+		pRequest->state = kCaptureStateDone;
+		deliver(pRequest);
+	}
+
+	void deliver(ccCaptureRequest *pRequest)
+	{
+		std::vector<ccCaptureRequest*>::iterator it;
+		for (it = m_requests.begin(); it != m_requests.end(); ++it)
+		{
+			if (*it == pRequest)
+			{
+				m_requests.erase(it);
+				break;
+			}
+		}
+
+		NSData *pData = NULL;
+		if (pRequest->succeeded)
+		{
+			pData = NSData::dataWithBytes(pRequest->result, (int)pRequest->resultLength);
+		}
+
+		if (pRequest->target && pRequest->selector)
+		{
+			(pRequest->target->*pRequest->selector)(pRequest->renderTexture, pData);
+		}
+
+		if (pData)
+		{
+			pData->release();
+		}
+
+		if (pRequest->target)
+		{
+			pRequest->target->selectorProtocolRelease();
+		}
+		pRequest->renderTexture->release();
+
+		delete [] pRequest->result;
+		delete pRequest;
+	}
+
+private:
+	std::vector<ccCaptureRequest*> m_requests;
+	NSLock m_lock;
+	bool m_bScheduled;
+};
+
 // implementation CCRenderTexture
 CCRenderTexture::CCRenderTexture()
 : m_pSprite(NULL)
@@ -147,6 +365,9 @@ void CCRenderTexture::begin()
 {
     saveGLstate();
 
+	// the nodes are drawn into the texture, not the window
+	CCDirector::sharedDirector()->suspendCulling();
+
 	CC_DISABLE_DEFAULT_GL_STATES();
 	// Save the current matrix
 	glPushMatrix();
@@ -172,6 +393,9 @@ void CCRenderTexture::beginWithClear(float r, float g, float b, float a)
 {
     this->saveGLstate();
 
+    // the nodes are drawn into the texture, not the window
+    CCDirector::sharedDirector()->suspendCulling();
+
     CC_DISABLE_DEFAULT_GL_STATES();
     // Save the current matrix
     glPushMatrix();
@@ -198,12 +422,21 @@ void CCRenderTexture::beginWithClear(float r, float g, float b, float a)
 
 void CCRenderTexture::end()
 {
+	CCRenderTextureCaptureQueue *pQueue = CCRenderTextureCaptureQueue::sharedQueue();
+	if (pQueue->hasRequests())
+	{
+		// kick off the drawing now, the pixels are read back once the GPU is done with them
+		glFlush();
+	}
+
 	ccglBindFramebuffer(CC_GL_FRAMEBUFFER, m_nOldFBO);
 	// Restore the original matrix and viewport
 	glPopMatrix();
 	CGSize size = CCDirector::sharedDirector()->getDisplaySizeInPixels();
 	glViewport(0, 0, (GLsizei)size.width, (GLsizei)size.height);
     this->restoreGLstate();
+
+	CCDirector::sharedDirector()->resumeCulling();
 }
 
 void CCRenderTexture::clear(float r, float g, float b, float a)
@@ -232,106 +465,128 @@ bool CCRenderTexture::saveBuffer(const char *name)
 bool CCRenderTexture::saveBuffer(const char *fileName, int format)
 {
 	bool bRet = false;
-//@ todo CCRenderTexture::saveBuffer
-// 	UIImage *myImage = this->getUIImageFromBuffer(format);
-//     NSArray *paths					= NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES);
-//     NSString *documentsDirectory	= [paths objectAtIndex:0];
-//     NSString *fullPath				= [documentsDirectory stringByAppendingPathComponent:fileName];
-
-//     NSData * data = this->getUIImageAsDataFromBuffer(format);
-// 	if (data)
-// 	{
-//         bRet = data->writeToFile(path, true);
-// 		delete data;
-//         bRet = true;
-// 	}
+	unsigned char *pData = NULL;
+	unsigned long nLen = 0;
+	unsigned char *pPixels = NULL;
+
+	do 
+	{
+		CCX_BREAK_IF(! fileName);
+
+		int tx = 0;
+		int ty = 0;
+		CCX_BREAK_IF(! (pPixels = this->readPixels(&tx, &ty)));
+		CCX_BREAK_IF(! ccImageEncodeRGBA(pPixels, tx, ty, format, &pData, &nLen));
+
+		bRet = ccImageWriteFile(fileName, pData, nLen);
+	} while (0);
+
+	CCX_SAFE_DELETE_ARRAY(pPixels);
+	CCX_SAFE_DELETE_ARRAY(pData);
 	return bRet;
 }
 
 NSData * CCRenderTexture::getUIImageAsDataFromBuffer(int format)
 {
-    NSData *  pData     = NULL;
-//@ todo CCRenderTexture::getUIImageAsDataFromBuffer
-
-// #include "Availability.h"
-// #include "UIKit.h"
-
-//     GLubyte * pBuffer   = NULL;
-//     GLubyte * pPixels   = NULL;
-//     do 
-//     {
-//         CCX_BREAK_IF(! m_pTexture);
-// 
-//         NSAssert(m_ePixelFormat == kCCTexture2DPixelFormat_RGBA8888, "only RGBA8888 can be saved as image");
-// 
-//         CGSize s = m_pTexture->getContentSizeInPixels();
-//         int tx = s.width;
-//         int ty = s.height;
-// 
-//         int bitsPerComponent = 8;
-//         int bitsPerPixel = 32;
-// 
-//         int bytesPerRow = (bitsPerPixel / 8) * tx;
-//         int myDataLength = bytesPerRow * ty;
-// 
-//         CCX_BREAK_IF(! (pBuffer = new GLubyte[tx * ty * 4]));
-//         CCX_BREAK_IF(! (pPixels = new GLubyte[tx * ty * 4]));
-// 
-//         this->begin();
-//         glReadPixels(0,0,tx,ty,GL_RGBA,GL_UNSIGNED_BYTE, pBuffer);
-//         this->end();
-// 
-//         int x,y;
-// 
-//         for(y = 0; y <ty; y++) {
-//             for(x = 0; x <tx * 4; x++) {
-//                 pPixels[((ty - 1 - y) * tx * 4 + x)] = pBuffer[(y * 4 * tx + x)];
-//             }
-//         }
-// 
-//         if (format == kCCImageFormatRawData)
-//         {
-//             pData = NSData::dataWithBytesNoCopy(pPixels, myDataLength);
-//             break;
-//         }
-
-        //@ todo impliment save to jpg or png
-        /*
-        CGImageCreate(size_t width, size_t height,
-        size_t bitsPerComponent, size_t bitsPerPixel, size_t bytesPerRow,
-        CGColorSpaceRef space, CGBitmapInfo bitmapInfo, CGDataProviderRef provider,
-        const CGFloat decode[], bool shouldInterpolate,
-        CGColorRenderingIntent intent)
-        */
-        // make data provider with data.
-//         CGBitmapInfo bitmapInfo = kCGImageAlphaPremultipliedLast | kCGBitmapByteOrderDefault;
-//         CGDataProviderRef provider		= CGDataProviderCreateWithData(NULL, pixels, myDataLength, NULL);
-//         CGColorSpaceRef colorSpaceRef	= CGColorSpaceCreateDeviceRGB();
-//         CGImageRef iref					= CGImageCreate(tx, ty,
-//             bitsPerComponent, bitsPerPixel, bytesPerRow,
-//             colorSpaceRef, bitmapInfo, provider,
-//             NULL, false,
-//             kCGRenderingIntentDefault);
-// 
-//         UIImage* image					= [[UIImage alloc] initWithCGImage:iref];
-// 
-//         CGImageRelease(iref);	
-//         CGColorSpaceRelease(colorSpaceRef);
-//         CGDataProviderRelease(provider);
-// 
-// 
-// 
-//         if (format == kCCImageFormatPNG)
-//             data = UIImagePNGRepresentation(image);
-//         else
-//             data = UIImageJPEGRepresentation(image, 1.0f);
-// 
-//         [image release];
-//     } while (0);
-//     
-//     CCX_SAFE_DELETE_ARRAY(pBuffer);
-//     CCX_SAFE_DELETE_ARRAY(pPixels);
-	return pData;
+	NSData *pRet = NULL;
+	unsigned char *pData = NULL;
+	unsigned long nLen = 0;
+	unsigned char *pPixels = NULL;
+
+	do 
+	{
+		int tx = 0;
+		int ty = 0;
+		CCX_BREAK_IF(! (pPixels = this->readPixels(&tx, &ty)));
+		CCX_BREAK_IF(! ccImageEncodeRGBA(pPixels, tx, ty, format, &pData, &nLen));
+
+		pRet = NSData::dataWithBytes(pData, (int)nLen);
+		if (pRet)
+		{
+			pRet->autorelease();
+		}
+	} while (0);
+
+	CCX_SAFE_DELETE_ARRAY(pPixels);
+	CCX_SAFE_DELETE_ARRAY(pData);
+	return pRet;
+}
+
+unsigned char* CCRenderTexture::readPixels(int *pWidth, int *pHeight, bool bFlip)
+{
+	if (! m_pTexture || ! pWidth || ! pHeight)
+	{
+		return NULL;
+	}
+
+	NSAssert(m_ePixelFormat == kCCTexture2DPixelFormat_RGBA8888, "only RGBA8888 can be saved as image");
+
+	CGSize s = m_pTexture->getContentSizeInPixels();
+	int tx = (int)s.width;
+	int ty = (int)s.height;
+
+	// only bind the frame buffer, the projection does not matter for glReadPixels
+	GLint nOldFBO = 0;
+	glGetIntegerv(CC_GL_FRAMEBUFFER_BINDING, &nOldFBO);
+	ccglBindFramebuffer(CC_GL_FRAMEBUFFER, m_uFBO);
+	unsigned char *pPixels = readFramebufferPixels(tx, ty);
+	ccglBindFramebuffer(CC_GL_FRAMEBUFFER, nOldFBO);
+
+	if (pPixels && bFlip)
+	{
+		ccImageFlipRows(pPixels, tx, ty, 4);
+	}
+
+	*pWidth = tx;
+	*pHeight = ty;
+	return pPixels;
+}
+
+void CCRenderTexture::saveBufferAsync(const char *fileName, int format, SelectorProtocol *pTarget, SEL_CallFuncND selector)
+{
+	ccCaptureRequest *pRequest = new ccCaptureRequest;
+	pRequest->renderTexture = this;
+	pRequest->fileName = fileName ? fileName : "";
+	pRequest->format = format;
+	pRequest->target = pTarget;
+	pRequest->selector = selector;
+	pRequest->framesLeft = s_nCaptureFrameDelay;
+	pRequest->state = kCaptureStateWaiting;
+	pRequest->pixels = NULL;
+	pRequest->width = 0;
+	pRequest->height = 0;
+	pRequest->result = NULL;
+	pRequest->resultLength = 0;
+	pRequest->succeeded = false;
+
+	// keep both alive until the result is delivered
+	this->retain();
+	if (pTarget)
+	{
+		pTarget->selectorProtocolRetain();
+	}
+
+	CCRenderTextureCaptureQueue::sharedQueue()->addRequest(pRequest);
+}
+
+void CCRenderTexture::getUIImageAsDataFromBufferAsync(int format, SelectorProtocol *pTarget, SEL_CallFuncND selector)
+{
+	this->saveBufferAsync(NULL, format, pTarget, selector);
+}
+
+void CCRenderTexture::setIsSynchronousCapture(bool bSynchronous)
+{
+	s_bSynchronousCapture = bSynchronous;
+}
+
+bool CCRenderTexture::getIsSynchronousCapture(void)
+{
+	return s_bSynchronousCapture;
+}
+
+void CCRenderTexture::setCaptureFrameDelay(int nFrames)
+{
+	s_nCaptureFrameDelay = nFrames > 0 ? nFrames : 1;
 }
 
 } // namespace cocos2d
@@ -0,0 +1,382 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCParticleBatchNode.h"
+#include "CCParticleSystemQuad.h"
+#include "effects/CCGrid.h"
+#include "CCCamera.h"
+#include "CCTexture2D.h"
+#include "CGAffineTransform.h"
+
+namespace cocos2d {
+
+// GLushort indices address 65536 vertices, so a draw call takes at most 16384 quads
+#define kCCParticleBatchMaxQuadsPerDraw		16384
+
+#define kCCParticleBatchDefaultCapacity		500
+
+CCParticleBatchNode::CCParticleBatchNode(void)
+: m_pQuads(NULL)
+, m_pIndices(NULL)
+, m_uCapacity(0)
+, m_uIndexedQuads(0)
+#if CC_USES_VBO
+, m_uQuadsID(0)
+#endif
+, m_uQuadCount(0)
+, m_uRunStart(0)
+, m_uRunTexture(0)
+, m_uDrawCount(0)
+{
+	m_tRunBlendFunc.src = CC_BLEND_SRC;
+	m_tRunBlendFunc.dst = CC_BLEND_DST;
+}
+
+CCParticleBatchNode::~CCParticleBatchNode(void)
+{
+	// the children may outlive the batch node
+	if (m_pChildren)
+	{
+		NSMutableArray<CCNode*>::NSMutableArrayIterator it;
+		for (it = m_pChildren->begin(); it != m_pChildren->end(); ++it)
+		{
+			CCParticleSystemQuad *pSystem = dynamic_cast<CCParticleSystemQuad*>(*it);
+			if (pSystem)
+			{
+				pSystem->setBatchNode(NULL);
+			}
+		}
+	}
+
+	CCX_SAFE_FREE(m_pQuads);
+	CCX_SAFE_FREE(m_pIndices);
+#if CC_USES_VBO
+	if (m_uQuadsID)
+	{
+		glDeleteBuffers(1, &m_uQuadsID);
+	}
+#endif
+}
+
+CCParticleBatchNode* CCParticleBatchNode::batchNode(void)
+{
+	return batchNodeWithCapacity(kCCParticleBatchDefaultCapacity);
+}
+
+CCParticleBatchNode* CCParticleBatchNode::batchNodeWithCapacity(unsigned int uCapacity)
+{
+	CCParticleBatchNode *pRet = new CCParticleBatchNode();
+	if (pRet && pRet->initWithCapacity(uCapacity))
+	{
+		pRet->autorelease();
+		return pRet;
+	}
+	CCX_SAFE_DELETE(pRet);
+	return NULL;
+}
+
+bool CCParticleBatchNode::initWithCapacity(unsigned int uCapacity)
+{
+#if CC_USES_VBO
+	glGenBuffers(1, &m_uQuadsID);
+#endif
+	return ensureCapacity(uCapacity ? uCapacity : 1);
+}
+
+bool CCParticleBatchNode::ensureCapacity(unsigned int uQuads)
+{
+	if (uQuads > m_uCapacity)
+	{
+		// grow by a third to keep the reallocations rare while the systems warm up
+		unsigned int uCapacity = MAX(uQuads, m_uCapacity + m_uCapacity / 3);
+		ccV2F_C4F_T2F_Quad *pQuads = (ccV2F_C4F_T2F_Quad*)realloc(m_pQuads, uCapacity * sizeof(m_pQuads[0]));
+		if (! pQuads)
+		{
+			CCLOG("cocos2d: CCParticleBatchNode: not enough memory");
+			return false;
+		}
+		m_pQuads = pQuads;
+		m_uCapacity = uCapacity;
+	}
+
+	// the runs are drawn from the start of the index buffer
+	unsigned int uIndexed = MIN(m_uCapacity, (unsigned int)kCCParticleBatchMaxQuadsPerDraw);
+	if (uIndexed > m_uIndexedQuads)
+	{
+		GLushort *pIndices = (GLushort*)realloc(m_pIndices, uIndexed * 6 * sizeof(m_pIndices[0]));
+		if (! pIndices)
+		{
+			CCLOG("cocos2d: CCParticleBatchNode: not enough memory");
+			return false;
+		}
+		m_pIndices = pIndices;
+
+		for (unsigned int i = m_uIndexedQuads; i < uIndexed; ++i)
+		{
+			const unsigned int i6 = i*6;
+			const unsigned int i4 = i*4;
+			m_pIndices[i6+0] = (GLushort) i4+0;
+			m_pIndices[i6+1] = (GLushort) i4+1;
+			m_pIndices[i6+2] = (GLushort) i4+2;
+
+			m_pIndices[i6+5] = (GLushort) i4+1;
+			m_pIndices[i6+4] = (GLushort) i4+2;
+			m_pIndices[i6+3] = (GLushort) i4+3;
+		}
+		m_uIndexedQuads = uIndexed;
+	}
+
+	return true;
+}
+
+// composition
+
+void CCParticleBatchNode::addChild(CCNode *child)
+{
+	CCNode::addChild(child);
+}
+
+void CCParticleBatchNode::addChild(CCNode *child, int zOrder)
+{
+	CCNode::addChild(child, zOrder);
+}
+
+void CCParticleBatchNode::addChild(CCNode *child, int zOrder, int tag)
+{
+	CCNode::addChild(child, zOrder, tag);
+
+	CCParticleSystemQuad *pSystem = dynamic_cast<CCParticleSystemQuad*>(child);
+	if (pSystem)
+	{
+		pSystem->setBatchNode(this);
+	}
+}
+
+void CCParticleBatchNode::removeChild(CCNode* child, bool cleanup)
+{
+	if (! child || ! m_pChildren || ! m_pChildren->containsObject(child))
+	{
+		return;
+	}
+
+	CCParticleSystemQuad *pSystem = dynamic_cast<CCParticleSystemQuad*>(child);
+	if (pSystem)
+	{
+		pSystem->setBatchNode(NULL);
+	}
+
+	CCNode::removeChild(child, cleanup);
+}
+
+void CCParticleBatchNode::removeAllChildrenWithCleanup(bool cleanup)
+{
+	if (m_pChildren)
+	{
+		NSMutableArray<CCNode*>::NSMutableArrayIterator it;
+		for (it = m_pChildren->begin(); it != m_pChildren->end(); ++it)
+		{
+			CCParticleSystemQuad *pSystem = dynamic_cast<CCParticleSystemQuad*>(*it);
+			if (pSystem)
+			{
+				pSystem->setBatchNode(NULL);
+			}
+		}
+	}
+
+	CCNode::removeAllChildrenWithCleanup(cleanup);
+}
+
+// draw
+
+CCParticleSystemQuad* CCParticleBatchNode::batchedSystem(CCNode *pChild)
+{
+	CCParticleSystemQuad *pSystem = dynamic_cast<CCParticleSystemQuad*>(pChild);
+	if (! pSystem || ! pSystem->getTexture())
+	{
+		return NULL;
+	}
+
+	// these need the GL transform of the system
+	if ((pSystem->getChildren() && pSystem->getChildren()->count() > 0)
+		|| (pSystem->getGrid() && pSystem->getGrid()->isActive())
+		|| pSystem->getCamera()->getDirty()
+		|| pSystem->getVertexZ() != 0)
+	{
+		return NULL;
+	}
+
+	return pSystem;
+}
+
+void CCParticleBatchNode::drawRun(void)
+{
+	unsigned int uCount = m_uQuadCount - m_uRunStart;
+	if (! uCount)
+	{
+		return;
+	}
+
+	// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
+	// Needed states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
+	// Unneeded states: -
+	glBindTexture(GL_TEXTURE_2D, m_uRunTexture);
+
+#define kQuadSize sizeof(m_pQuads[0].bl)
+
+#if CC_USES_VBO
+	glBindBuffer(GL_ARRAY_BUFFER, m_uQuadsID);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(m_pQuads[0]) * uCount, m_pQuads + m_uRunStart, GL_DYNAMIC_DRAW);
+
+	glVertexPointer(2, GL_FLOAT, kQuadSize, (GLvoid*) offsetof(ccV2F_C4F_T2F, vertices));
+	glColorPointer(4, GL_FLOAT, kQuadSize, (GLvoid*) offsetof(ccV2F_C4F_T2F, colors));
+	glTexCoordPointer(2, GL_FLOAT, kQuadSize, (GLvoid*) offsetof(ccV2F_C4F_T2F, texCoords));
+#else
+	char *pStart = (char*)(m_pQuads + m_uRunStart);
+
+	glVertexPointer(2, GL_FLOAT, kQuadSize, (GLvoid*) (pStart + offsetof(ccV2F_C4F_T2F, vertices)));
+	glColorPointer(4, GL_FLOAT, kQuadSize, (GLvoid*) (pStart + offsetof(ccV2F_C4F_T2F, colors)));
+	glTexCoordPointer(2, GL_FLOAT, kQuadSize, (GLvoid*) (pStart + offsetof(ccV2F_C4F_T2F, texCoords)));
+#endif // ! CC_USES_VBO
+
+	bool newBlend = (m_tRunBlendFunc.src != CC_BLEND_SRC || m_tRunBlendFunc.dst != CC_BLEND_DST);
+	if (newBlend)
+	{
+		glBlendFunc(m_tRunBlendFunc.src, m_tRunBlendFunc.dst);
+	}
+
+	glDrawElements(GL_TRIANGLES, uCount * 6, GL_UNSIGNED_SHORT, m_pIndices);
+
+	// restore blend state
+	if (newBlend)
+	{
+		glBlendFunc(CC_BLEND_SRC, CC_BLEND_DST);
+	}
+
+#if CC_USES_VBO
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+#endif
+
+	++m_uDrawCount;
+	m_uRunStart = m_uQuadCount;
+}
+
+void CCParticleBatchNode::visit(void)
+{
+	// quick return if not visible
+	if (! m_bIsVisible)
+	{
+		return;
+	}
+
+	glPushMatrix();
+
+	if (m_pGrid && m_pGrid->isActive())
+	{
+		m_pGrid->beforeDraw();
+		transformAncestors();
+	}
+
+	transform();
+	sortAllChildren();
+
+	m_uQuadCount = 0;
+	m_uRunStart = 0;
+	m_uDrawCount = 0;
+
+	if (m_pChildren)
+	{
+		NSMutableArray<CCNode*>::NSMutableArrayIterator it;
+		for (it = m_pChildren->begin(); it != m_pChildren->end(); ++it)
+		{
+			CCNode *pChild = *it;
+			if (! pChild || ! pChild->getIsVisible())
+			{
+				continue;
+			}
+
+			CCParticleSystemQuad *pSystem = batchedSystem(pChild);
+			if (! pSystem)
+			{
+				drawRun();
+				pChild->visit();
+				continue;
+			}
+
+			unsigned int uCount = (unsigned int)pSystem->getParticleCount();
+			if (! uCount)
+			{
+				continue;
+			}
+
+			GLuint uTexture = pSystem->getTexture()->getName();
+			ccBlendFunc tBlendFunc = pSystem->getBlendFunc();
+			unsigned int uRunLength = m_uQuadCount - m_uRunStart;
+			if (uRunLength && (uTexture != m_uRunTexture
+				|| tBlendFunc.src != m_tRunBlendFunc.src || tBlendFunc.dst != m_tRunBlendFunc.dst
+				|| uRunLength + uCount > kCCParticleBatchMaxQuadsPerDraw))
+			{
+				drawRun();
+			}
+			m_uRunTexture = uTexture;
+			m_tRunBlendFunc = tBlendFunc;
+
+			uCount = MIN(uCount, (unsigned int)kCCParticleBatchMaxQuadsPerDraw);
+			if (! ensureCapacity(m_uQuadCount + uCount))
+			{
+				break;
+			}
+
+			// move the quads from the system's coordinates into the batch node's ones
+			CGAffineTransform t = pSystem->nodeToParentTransform();
+			const ccV2F_C4F_T2F_Quad *pSrc = pSystem->getQuads();
+			ccV2F_C4F_T2F_Quad *pDst = m_pQuads + m_uQuadCount;
+			for (unsigned int i = 0; i < uCount; ++i)
+			{
+				const ccV2F_C4F_T2F *pSrcVertex = &pSrc[i].bl;
+				ccV2F_C4F_T2F *pDstVertex = &pDst[i].bl;
+				for (int v = 0; v < 4; ++v)
+				{
+					GLfloat x = pSrcVertex[v].vertices.x;
+					GLfloat y = pSrcVertex[v].vertices.y;
+					pDstVertex[v].vertices.x = t.a * x + t.c * y + t.tx;
+					pDstVertex[v].vertices.y = t.b * x + t.d * y + t.ty;
+					pDstVertex[v].colors = pSrcVertex[v].colors;
+					pDstVertex[v].texCoords = pSrcVertex[v].texCoords;
+				}
+			}
+			m_uQuadCount += uCount;
+		}
+	}
+
+	drawRun();
+
+	if (m_pGrid && m_pGrid->isActive())
+	{
+		m_pGrid->afterDraw(this);
+	}
+
+	glPopMatrix();
+}
+
+}// namespace cocos2d
@@ -0,0 +1,210 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCParticlePool.h"
+#include "CCParticleSystemQuad.h"
+#include "CCParticleTemplateCache.h"
+#include "CCXFileUtils.h"
+#include "ccMacros.h"
+
+namespace cocos2d {
+
+#define kCCParticlePoolDefaultCapacity	32
+
+static CCParticlePool *pSharedParticlePool = NULL;
+
+CCParticlePool* CCParticlePool::sharedParticlePool(void)
+{
+	if (! pSharedParticlePool)
+	{
+		pSharedParticlePool = new CCParticlePool();
+	}
+
+	return pSharedParticlePool;
+}
+
+void CCParticlePool::purgeSharedParticlePool(void)
+{
+	CCX_SAFE_RELEASE_NULL(pSharedParticlePool);
+}
+
+CCParticlePool::CCParticlePool(void)
+: m_uCapacity(kCCParticlePoolDefaultCapacity)
+, m_uHitCount(0)
+, m_uMissCount(0)
+, m_uPeakCount(0)
+{
+	m_pSystems = new NSDictionary<std::string, NSMutableArray<CCParticleSystemQuad*>*>();
+}
+
+CCParticlePool::~CCParticlePool(void)
+{
+	CCX_SAFE_RELEASE(m_pSystems);
+}
+
+bool CCParticlePool::isFree(CCParticleSystemQuad *pSystem)
+{
+	return pSystem->retainCount() == 1 && ! pSystem->getParent();
+}
+
+NSMutableArray<CCParticleSystemQuad*>* CCParticlePool::systemsForPath(const std::string &sPath)
+{
+	NSMutableArray<CCParticleSystemQuad*> *pSystems = m_pSystems->objectForKey(sPath);
+	if (! pSystems)
+	{
+		pSystems = new NSMutableArray<CCParticleSystemQuad*>();
+		m_pSystems->setObject(pSystems, sPath);
+		pSystems->release();
+	}
+	return pSystems;
+}
+
+CCParticleSystemQuad* CCParticlePool::systemWithFile(const char *pszPlist)
+{
+	std::string sPath = CCFileUtils::fullPathFromRelativePath(pszPlist);
+	CCParticleTemplate *pTemplate = CCParticleTemplateCache::sharedParticleTemplateCache()->addTemplateWithFile(sPath.c_str());
+	if (! pTemplate)
+	{
+		return NULL;
+	}
+
+	NSMutableArray<CCParticleSystemQuad*> *pSystems = systemsForPath(sPath);
+
+	// look for a free system, counting the ones in use
+	CCParticleSystemQuad *pRet = NULL;
+	unsigned int uInUse = 1;
+	for (unsigned int i = 0; i < pSystems->count(); ++i)
+	{
+		CCParticleSystemQuad *pSystem = pSystems->getObjectAtIndex(i);
+		if (! pRet && isFree(pSystem))
+		{
+			if (pSystem->resetWithTemplate(pTemplate))
+			{
+				pRet = pSystem;
+				continue;
+			}
+
+			// the plist changed since the system was created
+			pSystems->removeObjectAtIndex(i--);
+			continue;
+		}
+
+		if (! isFree(pSystem))
+		{
+			++uInUse;
+		}
+	}
+
+	if (pRet)
+	{
+		++m_uHitCount;
+		pRet->retain();
+	}
+	else
+	{
+		++m_uMissCount;
+		pRet = new CCParticleSystemQuad();
+		if (! pRet->initWithTemplate(pTemplate))
+		{
+			CCX_SAFE_DELETE(pRet);
+			return NULL;
+		}
+
+		if (pSystems->count() < m_uCapacity)
+		{
+			pSystems->addObject(pRet);
+		}
+	}
+
+	m_uPeakCount = MAX(m_uPeakCount, uInUse);
+
+	pRet->autorelease();
+	return pRet;
+}
+
+void CCParticlePool::prewarmWithFile(const char *pszPlist, unsigned int uCount)
+{
+	std::string sPath = CCFileUtils::fullPathFromRelativePath(pszPlist);
+	CCParticleTemplate *pTemplate = CCParticleTemplateCache::sharedParticleTemplateCache()->addTemplateWithFile(sPath.c_str());
+	if (! pTemplate)
+	{
+		return;
+	}
+
+	NSMutableArray<CCParticleSystemQuad*> *pSystems = systemsForPath(sPath);
+
+	uCount = MIN(uCount, m_uCapacity);
+	while (pSystems->count() < uCount)
+	{
+		CCParticleSystemQuad *pSystem = new CCParticleSystemQuad();
+		if (! pSystem->initWithTemplate(pTemplate))
+		{
+			CCX_SAFE_DELETE(pSystem);
+			return;
+		}
+
+		// initWithTotalParticles schedules the update, a pooled system waits unscheduled
+		pSystem->unscheduleUpdate();
+		pSystems->addObject(pSystem);
+		pSystem->release();
+	}
+}
+
+void CCParticlePool::removeUnusedSystems(void)
+{
+	std::string sKey;
+	NSMutableArray<CCParticleSystemQuad*> *pSystems = NULL;
+
+	m_pSystems->begin();
+	while ((pSystems = m_pSystems->next(&sKey)))
+	{
+		for (unsigned int i = pSystems->count(); i > 0; --i)
+		{
+			if (isFree(pSystems->getObjectAtIndex(i - 1)))
+			{
+				pSystems->removeObjectAtIndex(i - 1);
+			}
+		}
+
+		if (pSystems->count() == 0)
+		{
+			m_pSystems->removeObjectForKey(sKey);
+		}
+	}
+	m_pSystems->end();
+}
+
+void CCParticlePool::removeAllSystems(void)
+{
+	m_pSystems->removeAllObjects();
+}
+
+void CCParticlePool::resetStatistics(void)
+{
+	m_uHitCount = 0;
+	m_uMissCount = 0;
+	m_uPeakCount = 0;
+}
+
+}// namespace cocos2d
@@ -24,12 +24,10 @@ THE SOFTWARE.
 #include "CCParticleSystem.h"
 #include "ccTypes.h"
 #include "CCTextureCache.h"
-#include "support/base64.h"
 #include "CGPointExtension.h"
 #include "CCXFileUtils.h"
-#include "CCXUIImage.h"
 #include "platform/platform.h"
-#include "support/zip_support/ZipUtils.h"
+#include "CCParticleTemplateCache.h"
 
 // opengl
 #include "platform/CCGL.h"
@@ -122,170 +120,122 @@ CCParticleSystem * CCParticleSystem::particleWithFile(const char *plistFile)
 bool CCParticleSystem::initWithFile(const char *plistFile)
 {
 	m_sPlistFile = CCFileUtils::fullPathFromRelativePath(plistFile);
-	NSDictionary<std::string, NSObject*> *dict = CCFileUtils::dictionaryWithContentsOfFile(m_sPlistFile.c_str());
+	CCParticleTemplate *pTemplate = CCParticleTemplateCache::sharedParticleTemplateCache()->addTemplateWithFile(m_sPlistFile.c_str());
 
-	NSAssert( dict != NULL, "Particles: file not found");
-	return this->initWithDictionary(dict);
+	NSAssert( pTemplate != NULL, "Particles: file not found");
+	return pTemplate && this->initWithTemplate(pTemplate);
 }
 
 bool CCParticleSystem::initWithDictionary(NSDictionary<std::string, NSObject*> *dictionary)
 {
-	bool bRet = false;
-	unsigned char *buffer = NULL;
-	unsigned char *deflated = NULL;
-	UIImage *image = NULL;
-	do 
+	CCParticleTemplate *pTemplate = new CCParticleTemplate();
+	bool bRet = pTemplate->initWithDictionary(dictionary, m_sPlistFile.c_str())
+		&& this->initWithTemplate(pTemplate);
+	pTemplate->release();
+	return bRet;
+}
+
+bool CCParticleSystem::initWithTemplate(CCParticleTemplate *pTemplate)
+{
+	const tCCParticleTemplate &d = pTemplate->getDescription();
+
+	// self, not super
+	if(! this->initWithTotalParticles(d.maxParticles))
 	{
-		int maxParticles = atoi(valueForKey("maxParticles", dictionary));
-		// self, not super
-		if(this->initWithTotalParticles(maxParticles))
-		{
-			// angle
-			m_fAngle = (float)atof(valueForKey("angle", dictionary));
-			m_fAngleVar = (float)atof(valueForKey("angleVariance", dictionary));
+		return false;
+	}
 
-			// duration
-			m_fDuration = (float)atof(valueForKey("duration", dictionary));
+	applyTemplate(pTemplate);
+	return true;
+}
 
-			// blend function 
-			m_tBlendFunc.src = atoi(valueForKey("blendFuncSource", dictionary));
-			m_tBlendFunc.dst = atoi(valueForKey("blendFuncDestination", dictionary));
+bool CCParticleSystem::resetWithTemplate(CCParticleTemplate *pTemplate)
+{
+	// the buffers are only kept when they have the right size
+	if (! m_pParticles || pTemplate->getDescription().maxParticles != m_nTotalParticles)
+	{
+		return false;
+	}
 
-			// color
-			m_tStartColor.r = (float)atof(valueForKey("startColorRed", dictionary));
-			m_tStartColor.g = (float)atof(valueForKey("startColorGreen", dictionary));
-			m_tStartColor.b = (float)atof(valueForKey("startColorBlue", dictionary));
-			m_tStartColor.a = (float)atof(valueForKey("startColorAlpha", dictionary));
-
-			m_tStartColorVar.r = (float)atof(valueForKey("startColorVarianceRed", dictionary));
-			m_tStartColorVar.g = (float)atof(valueForKey("startColorVarianceGreen", dictionary));
-			m_tStartColorVar.b = (float)atof(valueForKey("startColorVarianceBlue", dictionary));
-			m_tStartColorVar.a = (float)atof(valueForKey("startColorVarianceAlpha", dictionary));
-
-			m_tEndColor.r = (float)atof(valueForKey("finishColorRed", dictionary));
-			m_tEndColor.g = (float)atof(valueForKey("finishColorGreen", dictionary));
-			m_tEndColor.b = (float)atof(valueForKey("finishColorBlue", dictionary));
-			m_tEndColor.a = (float)atof(valueForKey("finishColorAlpha", dictionary));
-
-			m_tEndColorVar.r = (float)atof(valueForKey("finishColorVarianceRed", dictionary));
-			m_tEndColorVar.g = (float)atof(valueForKey("finishColorVarianceGreen", dictionary));
-			m_tEndColorVar.b = (float)atof(valueForKey("finishColorVarianceBlue", dictionary));
-			m_tEndColorVar.a = (float)atof(valueForKey("finishColorVarianceAlpha", dictionary));
-
-			// particle size
-			m_fStartSize = (float)atof(valueForKey("startParticleSize", dictionary));
-			m_fStartSizeVar = (float)atof(valueForKey("startParticleSizeVariance", dictionary));
-			m_fEndSize = (float)atof(valueForKey("finishParticleSize", dictionary));
-			m_fEndSizeVar = (float)atof(valueForKey("finishParticleSizeVariance", dictionary));
-
-			// position
-			m_tPosition.x = (float)atof(valueForKey("sourcePositionx", dictionary));
-			m_tPosition.y = (float)atof(valueForKey("sourcePositiony", dictionary));
-			m_tPosVar.x = (float)atof(valueForKey("sourcePositionVariancex", dictionary));
-			m_tPosVar.y = (float)atof(valueForKey("sourcePositionVariancey", dictionary));
-
-			m_nEmitterMode = atoi(valueForKey("emitterType", dictionary));
-
-			// Mode A: Gravity + tangential accel + radial accel
-			if( m_nEmitterMode == kCCParticleModeGravity ) 
-			{
-				// gravity
-				modeA.gravity.x = (float)atof(valueForKey("gravityx", dictionary));
-				modeA.gravity.y = (float)atof(valueForKey("gravityy", dictionary));
+	// what initWithTotalParticles sets, without the allocation
+	m_nParticleCount = 0;
+	m_nParticleIdx = 0;
+	m_fElapsed = 0;
+	m_fEmitCounter = 0;
+	m_bIsActive = true;
+	m_ePositionType = kCCPositionTypeFree;
+	m_bIsAutoRemoveOnFinish = false;
 
-				// speed
-				modeA.speed = (float)atof(valueForKey("speed", dictionary));
-				modeA.speedVar = (float)atof(valueForKey("speedVariance", dictionary));
+	// node state a fired system may have changed. A new system has its
+	// pixel position at zero, applyTemplate only sets the position in points.
+	setPosition(CGPointZero);
+	setRotation(0);
+	setScale(1);
+	setVertexZ(0);
+	setIsVisible(true);
+	setTag(kCCNodeTagInvalid);
 
-                const char * pszTmp = NULL;
-				// radial acceleration
-                pszTmp = valueForKey("radialAcceleration", dictionary);
-                modeA.radialAccel = (pszTmp) ? (float)atof(pszTmp) : 0;
+	applyTemplate(pTemplate);
 
-                pszTmp = valueForKey("radialAccelVariance", dictionary);
-				modeA.radialAccelVar = (pszTmp) ? (float)atof(pszTmp) : 0;
+	// udpate after action in run!
+	this->unscheduleUpdate();
+	this->scheduleUpdateWithPriority(1);
 
-				// tangential acceleration
-                pszTmp = valueForKey("tangentialAcceleration", dictionary);
-				modeA.tangentialAccel = (pszTmp) ? (float)atof(pszTmp) : 0;
+	return true;
+}
 
-                pszTmp = valueForKey("tangentialAccelVariance", dictionary);
-				modeA.tangentialAccelVar = (pszTmp) ? (float)atof(pszTmp) : 0;
-			}
+void CCParticleSystem::applyTemplate(CCParticleTemplate *pTemplate)
+{
+	const tCCParticleTemplate &d = pTemplate->getDescription();
 
-			// or Mode B: radius movement
-			else if( m_nEmitterMode == kCCParticleModeRadius ) 
-			{
-				modeB.startRadius = (float)atof(valueForKey("maxRadius", dictionary));
-				modeB.startRadiusVar = (float)atof(valueForKey("maxRadiusVariance", dictionary));
-				modeB.endRadius = (float)atof(valueForKey("minRadius", dictionary));
-				modeB.endRadiusVar = 0;
-				modeB.rotatePerSecond = (float)atof(valueForKey("rotatePerSecond", dictionary));
-				modeB.rotatePerSecondVar = (float)atof(valueForKey("rotatePerSecondVariance", dictionary));
-
-			} else {
-				NSAssert( false, "Invalid emitterType in config file");
-				CCX_BREAK_IF(true);
-			}
+	m_fAngle = d.angle;
+	m_fAngleVar = d.angleVar;
+	m_fDuration = d.duration;
+	m_tBlendFunc = d.blendFunc;
 
-			// life span
-			m_fLife = (float)atof(valueForKey("particleLifespan", dictionary));
-			m_fLifeVar = (float)atof(valueForKey("particleLifespanVariance", dictionary));
-
-			// emission Rate
-			m_fEmissionRate = m_nTotalParticles / m_fLife;
-
-			// texture		
-			// Try to get the texture from the cache
-			char *textureName = (char *)valueForKey("textureFileName", dictionary);
-            std::string fullpath = CCFileUtils::fullPathFromRelativeFile(textureName, m_sPlistFile.c_str());
-
-            if (strlen(textureName) > 0)
-            {
-                // set not pop-up message box when load image failed
-                bool bNotify = UIImage::getIsPopupNotify();
-                UIImage::setIsPopupNotify(false);
-                this->m_pTexture = CCTextureCache::sharedTextureCache()->addImage(fullpath.c_str());
-
-                // reset the value of UIImage notify
-                UIImage::setIsPopupNotify(bNotify);
-            }
-
-			// if it fails, try to get it from the base64-gzipped data			
-            char *textureData = NULL;
-			if ( ! m_pTexture && 
-                (textureData = (char *)valueForKey("textureImageData", dictionary)))
-			{
-				int dataLen = strlen(textureData);
-				if(dataLen != 0)
-				{
-					int decodeLen = base64Decode((unsigned char*)textureData, dataLen, &buffer);
-					NSAssert( buffer != NULL, "CCParticleSystem: error decoding textureImageData");
-					CCX_BREAK_IF(!buffer);
-
-						int deflatedLen = ZipUtils::ccInflateMemory(buffer, decodeLen, &deflated);
-						NSAssert( deflated != NULL, "CCParticleSystem: error ungzipping textureImageData");
-						CCX_BREAK_IF(!deflated);
-						
-						image = new UIImage();
-						bool isOK = image->initWithData(deflated, deflatedLen);
-						NSAssert(isOK, "CCParticleSystem: error init image with Data");
-						CCX_BREAK_IF(!isOK);
-						
-						m_pTexture = CCTextureCache::sharedTextureCache()->addUIImage(image, fullpath.c_str());
-				}
-			}
-			NSAssert( this->m_pTexture != NULL, "CCParticleSystem: error loading the texture");
-			
-			CCX_BREAK_IF(!m_pTexture);
-			this->m_pTexture->retain();
-			bRet = true;
-		}
-	} while (0);
-	CCX_SAFE_DELETE_ARRAY(buffer);
-    CCX_SAFE_DELETE_ARRAY(deflated);
-	CCX_SAFE_DELETE(image);
-	return bRet;
+	m_tStartColor = d.startColor;
+	m_tStartColorVar = d.startColorVar;
+	m_tEndColor = d.endColor;
+	m_tEndColorVar = d.endColorVar;
+
+	m_fStartSize = d.startSize;
+	m_fStartSizeVar = d.startSizeVar;
+	m_fEndSize = d.endSize;
+	m_fEndSizeVar = d.endSizeVar;
+
+	m_tPosition = d.position;
+	m_tPosVar = d.posVar;
+
+	m_nEmitterMode = d.emitterMode;
+
+	// Mode A: Gravity + tangential accel + radial accel
+	modeA.gravity = d.modeA.gravity;
+	modeA.speed = d.modeA.speed;
+	modeA.speedVar = d.modeA.speedVar;
+	modeA.radialAccel = d.modeA.radialAccel;
+	modeA.radialAccelVar = d.modeA.radialAccelVar;
+	modeA.tangentialAccel = d.modeA.tangentialAccel;
+	modeA.tangentialAccelVar = d.modeA.tangentialAccelVar;
+
+	// Mode B: radius movement
+	modeB.startRadius = d.modeB.startRadius;
+	modeB.startRadiusVar = d.modeB.startRadiusVar;
+	modeB.endRadius = d.modeB.endRadius;
+	modeB.endRadiusVar = d.modeB.endRadiusVar;
+	modeB.rotatePerSecond = d.modeB.rotatePerSecond;
+	modeB.rotatePerSecondVar = d.modeB.rotatePerSecondVar;
+
+	// life span
+	m_fLife = d.life;
+	m_fLifeVar = d.lifeVar;
+
+	// emission Rate
+	m_fEmissionRate = m_nTotalParticles / m_fLife;
+
+	// texture
+	CCX_SAFE_RETAIN(pTemplate->getTexture());
+	CCX_SAFE_RELEASE(m_pTexture);
+	m_pTexture = pTemplate->getTexture();
 }
 bool CCParticleSystem::initWithTotalParticles(int numberOfParticles)
 {
@@ -153,6 +153,19 @@ void CCParticleSystemQuad::setTexture(CCTexture2D* var)
         (float)(var->getPixelsWide() / CC_CONTENT_SCALE_FACTOR()), 
         (float)(var->getPixelsHigh() / CC_CONTENT_SCALE_FACTOR())));
 }
+bool CCParticleSystemQuad::resetWithTemplate(CCParticleTemplate *pTemplate)
+{
+	if (! CCParticleSystem::resetWithTemplate(pTemplate))
+	{
+		return false;
+	}
+
+	// a new system maps the whole texture, setTextureWithRect or setDisplayFrame may have changed it
+	this->initTexCoordsWithRect(CGRectMake(0, 0, 
+		(float)(m_pTexture->getPixelsWide() / CC_CONTENT_SCALE_FACTOR()), 
+		(float)(m_pTexture->getPixelsHigh() / CC_CONTENT_SCALE_FACTOR())));
+	return true;
+}
 void CCParticleSystemQuad::setDisplayFrame(CCSpriteFrame *spriteFrame)
 {
 	NSAssert( CGPoint::CGPointEqualToPoint( spriteFrame->getOffsetInPixels() , CGPointZero ), "QuadParticle only supports SpriteFrames with no offsets");
@@ -247,6 +260,13 @@ void CCParticleSystemQuad::updateQuadWithParticle(tCCParticle* particle, CGPoint
 void CCParticleSystemQuad::postStep()
 {
 #if CC_USES_VBO
+	// a batch node copies the quads into its own buffer,
+	// draw() uploads them when the batch node visits the system instead
+	if (m_pBatchNode)
+	{
+		return;
+	}
+
 	glBindBuffer(GL_ARRAY_BUFFER, m_uQuadsID);
 	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(m_pQuads[0])*m_nParticleCount, m_pQuads);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -268,6 +288,11 @@ void CCParticleSystemQuad::draw()
 
 #if CC_ENABLE_CACHE_TEXTTURE_DATA
     glBufferData(GL_ARRAY_BUFFER, sizeof(m_pQuads[0])*m_nTotalParticles, m_pQuads, GL_DYNAMIC_DRAW);	
+#else
+	if (m_pBatchNode)
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(m_pQuads[0])*m_nParticleCount, m_pQuads);
+	}
 #endif
 
 	glVertexPointer(2,GL_FLOAT, kQuadSize, 0);
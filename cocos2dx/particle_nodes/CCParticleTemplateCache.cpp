@@ -0,0 +1,278 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCParticleTemplateCache.h"
+#include "CCTextureCache.h"
+#include "CCXFileUtils.h"
+#include "CCXUIImage.h"
+#include "NSString.h"
+#include "support/base64.h"
+#include "support/zip_support/ZipUtils.h"
+
+namespace cocos2d {
+
+// return the string found by key in dict, "" if not found
+static inline const char* valueForKey(const char *key, NSDictionary<std::string, NSObject*> *dict)
+{
+	NSString *pString = (NSString*)dict->objectForKey(key);
+	return pString ? pString->m_sString.c_str() : "";
+}
+
+// CCParticleTemplate
+
+CCParticleTemplate::CCParticleTemplate(void)
+: m_tDescription()
+, m_pTexture(NULL)
+{
+}
+
+CCParticleTemplate::~CCParticleTemplate(void)
+{
+	CCX_SAFE_RELEASE(m_pTexture);
+}
+
+bool CCParticleTemplate::initWithDictionary(NSDictionary<std::string, NSObject*> *dictionary, const char *pszPlistPath)
+{
+	bool bRet = false;
+	unsigned char *buffer = NULL;
+	unsigned char *deflated = NULL;
+	UIImage *image = NULL;
+	tCCParticleTemplate &d = m_tDescription;
+	do 
+	{
+		CCX_BREAK_IF(! dictionary);
+
+		d.maxParticles = atoi(valueForKey("maxParticles", dictionary));
+
+		// angle
+		d.angle = (float)atof(valueForKey("angle", dictionary));
+		d.angleVar = (float)atof(valueForKey("angleVariance", dictionary));
+
+		// duration
+		d.duration = (float)atof(valueForKey("duration", dictionary));
+
+		// blend function 
+		d.blendFunc.src = atoi(valueForKey("blendFuncSource", dictionary));
+		d.blendFunc.dst = atoi(valueForKey("blendFuncDestination", dictionary));
+
+		// color
+		d.startColor.r = (float)atof(valueForKey("startColorRed", dictionary));
+		d.startColor.g = (float)atof(valueForKey("startColorGreen", dictionary));
+		d.startColor.b = (float)atof(valueForKey("startColorBlue", dictionary));
+		d.startColor.a = (float)atof(valueForKey("startColorAlpha", dictionary));
+
+		d.startColorVar.r = (float)atof(valueForKey("startColorVarianceRed", dictionary));
+		d.startColorVar.g = (float)atof(valueForKey("startColorVarianceGreen", dictionary));
+		d.startColorVar.b = (float)atof(valueForKey("startColorVarianceBlue", dictionary));
+		d.startColorVar.a = (float)atof(valueForKey("startColorVarianceAlpha", dictionary));
+
+		d.endColor.r = (float)atof(valueForKey("finishColorRed", dictionary));
+		d.endColor.g = (float)atof(valueForKey("finishColorGreen", dictionary));
+		d.endColor.b = (float)atof(valueForKey("finishColorBlue", dictionary));
+		d.endColor.a = (float)atof(valueForKey("finishColorAlpha", dictionary));
+
+		d.endColorVar.r = (float)atof(valueForKey("finishColorVarianceRed", dictionary));
+		d.endColorVar.g = (float)atof(valueForKey("finishColorVarianceGreen", dictionary));
+		d.endColorVar.b = (float)atof(valueForKey("finishColorVarianceBlue", dictionary));
+		d.endColorVar.a = (float)atof(valueForKey("finishColorVarianceAlpha", dictionary));
+
+		// particle size
+		d.startSize = (float)atof(valueForKey("startParticleSize", dictionary));
+		d.startSizeVar = (float)atof(valueForKey("startParticleSizeVariance", dictionary));
+		d.endSize = (float)atof(valueForKey("finishParticleSize", dictionary));
+		d.endSizeVar = (float)atof(valueForKey("finishParticleSizeVariance", dictionary));
+
+		// position
+		d.position.x = (float)atof(valueForKey("sourcePositionx", dictionary));
+		d.position.y = (float)atof(valueForKey("sourcePositiony", dictionary));
+		d.posVar.x = (float)atof(valueForKey("sourcePositionVariancex", dictionary));
+		d.posVar.y = (float)atof(valueForKey("sourcePositionVariancey", dictionary));
+
+		d.emitterMode = atoi(valueForKey("emitterType", dictionary));
+
+		// Mode A: Gravity + tangential accel + radial accel
+		if( d.emitterMode == kCCParticleModeGravity ) 
+		{
+			// gravity
+			d.modeA.gravity.x = (float)atof(valueForKey("gravityx", dictionary));
+			d.modeA.gravity.y = (float)atof(valueForKey("gravityy", dictionary));
+
+			// speed
+			d.modeA.speed = (float)atof(valueForKey("speed", dictionary));
+			d.modeA.speedVar = (float)atof(valueForKey("speedVariance", dictionary));
+
+			// radial acceleration
+			d.modeA.radialAccel = (float)atof(valueForKey("radialAcceleration", dictionary));
+			d.modeA.radialAccelVar = (float)atof(valueForKey("radialAccelVariance", dictionary));
+
+			// tangential acceleration
+			d.modeA.tangentialAccel = (float)atof(valueForKey("tangentialAcceleration", dictionary));
+			d.modeA.tangentialAccelVar = (float)atof(valueForKey("tangentialAccelVariance", dictionary));
+		}
+
+		// or Mode B: radius movement
+		else if( d.emitterMode == kCCParticleModeRadius ) 
+		{
+			d.modeB.startRadius = (float)atof(valueForKey("maxRadius", dictionary));
+			d.modeB.startRadiusVar = (float)atof(valueForKey("maxRadiusVariance", dictionary));
+			d.modeB.endRadius = (float)atof(valueForKey("minRadius", dictionary));
+			d.modeB.endRadiusVar = 0;
+			d.modeB.rotatePerSecond = (float)atof(valueForKey("rotatePerSecond", dictionary));
+			d.modeB.rotatePerSecondVar = (float)atof(valueForKey("rotatePerSecondVariance", dictionary));
+
+		} else {
+			NSAssert( false, "Invalid emitterType in config file");
+			CCX_BREAK_IF(true);
+		}
+
+		// life span
+		d.life = (float)atof(valueForKey("particleLifespan", dictionary));
+		d.lifeVar = (float)atof(valueForKey("particleLifespanVariance", dictionary));
+
+		// texture		
+		// Try to get the texture from the cache
+		const char *textureName = valueForKey("textureFileName", dictionary);
+		std::string fullpath = CCFileUtils::fullPathFromRelativeFile(textureName, pszPlistPath);
+
+		if (strlen(textureName) > 0)
+		{
+			// set not pop-up message box when load image failed
+			bool bNotify = UIImage::getIsPopupNotify();
+			UIImage::setIsPopupNotify(false);
+			m_pTexture = CCTextureCache::sharedTextureCache()->addImage(fullpath.c_str());
+
+			// reset the value of UIImage notify
+			UIImage::setIsPopupNotify(bNotify);
+		}
+
+		// if it fails, try to get it from the base64-gzipped data			
+		const char *textureData = NULL;
+		if ( ! m_pTexture && 
+			(textureData = valueForKey("textureImageData", dictionary)))
+		{
+			int dataLen = strlen(textureData);
+			if(dataLen != 0)
+			{
+				int decodeLen = base64Decode((unsigned char*)textureData, dataLen, &buffer);
+				NSAssert( buffer != NULL, "CCParticleSystem: error decoding textureImageData");
+				CCX_BREAK_IF(!buffer);
+
+				int deflatedLen = ZipUtils::ccInflateMemory(buffer, decodeLen, &deflated);
+				NSAssert( deflated != NULL, "CCParticleSystem: error ungzipping textureImageData");
+				CCX_BREAK_IF(!deflated);
+
+				image = new UIImage();
+				bool isOK = image->initWithData(deflated, deflatedLen);
+				NSAssert(isOK, "CCParticleSystem: error init image with Data");
+				CCX_BREAK_IF(!isOK);
+
+				m_pTexture = CCTextureCache::sharedTextureCache()->addUIImage(image, fullpath.c_str());
+			}
+		}
+		NSAssert( m_pTexture != NULL, "CCParticleSystem: error loading the texture");
+
+		CCX_BREAK_IF(!m_pTexture);
+		m_pTexture->retain();
+		bRet = true;
+	} while (0);
+	CCX_SAFE_DELETE_ARRAY(buffer);
+	CCX_SAFE_DELETE_ARRAY(deflated);
+	CCX_SAFE_DELETE(image);
+	return bRet;
+}
+
+// CCParticleTemplateCache
+
+static CCParticleTemplateCache *pSharedParticleTemplateCache = NULL;
+
+CCParticleTemplateCache* CCParticleTemplateCache::sharedParticleTemplateCache(void)
+{
+	if (! pSharedParticleTemplateCache)
+	{
+		pSharedParticleTemplateCache = new CCParticleTemplateCache();
+	}
+
+	return pSharedParticleTemplateCache;
+}
+
+void CCParticleTemplateCache::purgeSharedParticleTemplateCache(void)
+{
+	CCX_SAFE_RELEASE_NULL(pSharedParticleTemplateCache);
+}
+
+CCParticleTemplateCache::CCParticleTemplateCache(void)
+{
+	m_pTemplates = new NSDictionary<std::string, CCParticleTemplate*>();
+}
+
+CCParticleTemplateCache::~CCParticleTemplateCache(void)
+{
+	CCX_SAFE_RELEASE(m_pTemplates);
+}
+
+CCParticleTemplate* CCParticleTemplateCache::addTemplateWithFile(const char *pszPlist)
+{
+	std::string sPath = CCFileUtils::fullPathFromRelativePath(pszPlist);
+
+	CCParticleTemplate *pTemplate = m_pTemplates->objectForKey(sPath);
+	if (pTemplate)
+	{
+		return pTemplate;
+	}
+
+	NSDictionary<std::string, NSObject*> *pDict = CCFileUtils::dictionaryWithContentsOfFile(sPath.c_str());
+	if (! pDict)
+	{
+		CCLOG("cocos2d: CCParticleTemplateCache: can't read %s", sPath.c_str());
+		return NULL;
+	}
+
+	pTemplate = new CCParticleTemplate();
+	if (! pTemplate->initWithDictionary(pDict, sPath.c_str()))
+	{
+		pTemplate->release();
+		return NULL;
+	}
+
+	m_pTemplates->setObject(pTemplate, sPath);
+	pTemplate->release();
+	return pTemplate;
+}
+
+CCParticleTemplate* CCParticleTemplateCache::templateForFile(const char *pszPlist)
+{
+	return m_pTemplates->objectForKey(CCFileUtils::fullPathFromRelativePath(pszPlist));
+}
+
+void CCParticleTemplateCache::removeTemplateForFile(const char *pszPlist)
+{
+	m_pTemplates->removeObjectForKey(CCFileUtils::fullPathFromRelativePath(pszPlist));
+}
+
+void CCParticleTemplateCache::removeAllTemplates(void)
+{
+	m_pTemplates->removeAllObjects();
+}
+
+}// namespace cocos2d
@@ -40,12 +40,15 @@ THE SOFTWARE.
 #include "platform/platform.h"
 #include "CCXApplication.h"
 #include "CCLabelBMFont.h"
+#include "CCGlyphCache.h"
 #include "CCActionManager.h"
 #include "CCLabelTTF.h"
 #include "CCConfiguration.h"
 #include "CCKeypadDispatcher.h"
 #include "CCGL.h"
 #include "CCAnimationCache.h"
+#include "CCParticleTemplateCache.h"
+#include "CCParticlePool.h"
 #include "NSEvent.h"
 
 #if CC_ENABLE_PROFILERS
@@ -53,6 +56,7 @@ THE SOFTWARE.
 #endif // CC_ENABLE_PROFILERS
 
 #include <string>
+#include <math.h>
 
 using namespace std;
 using namespace cocos2d;
@@ -104,6 +108,21 @@ bool CCDirector::init(void)
 	m_pszFPS = new char[10];
 	m_pLastUpdate = new struct cc_timeval();
 
+	// frame pacing
+	m_fFixedTimeStep = 0;
+	m_fFixedTimeAccum = 0;
+	m_fInterpolationAlpha = 1;
+	m_uMaxFixedSteps = 5;
+	m_fFrameTimeSum = m_fFrameTimeSquaredSum = 0;
+	m_uFrameTimeSamples = 0;
+	m_fFrameTimeAverage = m_fFrameTimeVariance = 0;
+
+	// culling
+	m_bCullingEnabled = false;
+	m_uCullingSuspended = 0;
+	memset(&m_tCullingStats, 0, sizeof(m_tCullingStats));
+	memset(&m_tFrameCullingStats, 0, sizeof(m_tFrameCullingStats));
+
 	// paused ?
 	m_bPaused = false;
 	
@@ -184,7 +203,7 @@ void CCDirector::drawScene(void)
 	//tick before glClear: issue #533
 	if (! m_bPaused)
 	{
-		CCScheduler::sharedScheduler()->tick(m_fDeltaTime);
+		tickScheduler();
 	}
 
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -203,6 +222,8 @@ void CCDirector::drawScene(void)
 	// By default enable VertexArray, ColorArray, TextureCoordArray and Texture2D
 	CC_ENABLE_DEFAULT_GL_STATES();
 
+	memset(&m_tFrameCullingStats, 0, sizeof(m_tFrameCullingStats));
+
 	// draw the scene
     if (m_pRunningScene)
     {
@@ -215,6 +236,8 @@ void CCDirector::drawScene(void)
 		m_pNotificationNode->visit();
 	}
 
+	m_tCullingStats = m_tFrameCullingStats;
+
 	if (m_bDisplayFPS)
 	{
 		showFPS();
@@ -259,6 +282,59 @@ void CCDirector::calculateDeltaTime(void)
 	}
 
 	*m_pLastUpdate = now;
+
+	// frame time statistics, the zero deltas after a pause or a scene change are not frames
+	if (m_fDeltaTime > 0)
+	{
+		m_fFrameTimeSum += m_fDeltaTime;
+		m_fFrameTimeSquaredSum += m_fDeltaTime * m_fDeltaTime;
+		++m_uFrameTimeSamples;
+
+		if (m_fFrameTimeSum > CC_DIRECTOR_FPS_INTERVAL)
+		{
+			m_fFrameTimeAverage = m_fFrameTimeSum / m_uFrameTimeSamples;
+			m_fFrameTimeVariance = MAX(0, m_fFrameTimeSquaredSum / m_uFrameTimeSamples - m_fFrameTimeAverage * m_fFrameTimeAverage);
+
+			m_fFrameTimeSum = m_fFrameTimeSquaredSum = 0;
+			m_uFrameTimeSamples = 0;
+		}
+	}
+}
+
+void CCDirector::tickScheduler(void)
+{
+	CCScheduler *pScheduler = CCScheduler::sharedScheduler();
+
+	if (m_fFixedTimeStep <= 0)
+	{
+		pScheduler->tick(m_fDeltaTime);
+		return;
+	}
+
+	m_fFixedTimeAccum += m_fDeltaTime;
+
+	unsigned int uSteps = 0;
+	while (m_fFixedTimeAccum >= m_fFixedTimeStep && uSteps < m_uMaxFixedSteps)
+	{
+		pScheduler->tick(m_fFixedTimeStep);
+		m_fFixedTimeAccum -= m_fFixedTimeStep;
+		++uSteps;
+	}
+
+	// too far behind: drop the steps that didn't fit, keeping the phase
+	if (m_fFixedTimeAccum >= m_fFixedTimeStep)
+	{
+		m_fFixedTimeAccum = fmodf(m_fFixedTimeAccum, m_fFixedTimeStep);
+	}
+
+	m_fInterpolationAlpha = m_fFixedTimeAccum / m_fFixedTimeStep;
+}
+
+void CCDirector::setFixedTimeStep(ccTime fFixedTimeStep)
+{
+	m_fFixedTimeStep = MAX(0, fFixedTimeStep);
+	m_fFixedTimeAccum = 0;
+	m_fInterpolationAlpha = 1;
 }
 
 
@@ -349,6 +425,9 @@ void CCDirector::setProjection(ccDirectorProjection kProjection)
 void CCDirector::purgeCachedData(void)
 {
     CCLabelBMFont::purgeCachedData();
+	CCGlyphCache::purgeSharedGlyphCache();
+	CCParticlePool::purgeSharedParticlePool();
+	CCParticleTemplateCache::purgeSharedParticleTemplateCache();
 	CCTextureCache::purgeSharedTextureCache();
 }
 
@@ -462,6 +541,12 @@ CGSize CCDirector::getWinSize(void)
 	return s;
 }
 
+CGRect CCDirector::getVisibleRect(void)
+{
+	CGSize s = getWinSize();
+	return CGRectMake(0, 0, s.width, s.height);
+}
+
 CGSize CCDirector::getWinSizeInPixels()
 {
 	CGSize s = getWinSize();
@@ -573,10 +658,13 @@ void CCDirector::purgeDirector()
 
 	// purge bitmap cache
 	CCLabelBMFont::purgeCachedData();
+	CCGlyphCache::purgeSharedGlyphCache();
 
 	// purge all managers
 	CCAnimationCache::purgeSharedAnimationCache();
  	CCSpriteFrameCache::purgeSharedSpriteFrameCache();
+	CCParticlePool::purgeSharedParticlePool();
+	CCParticleTemplateCache::purgeSharedParticleTemplateCache();
 	CCActionManager::sharedManager()->purgeSharedManager();
 	CCScheduler::purgeSharedScheduler();
 	CCTextureCache::purgeSharedTextureCache();
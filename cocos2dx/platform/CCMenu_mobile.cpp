@@ -245,6 +245,9 @@ namespace cocos2d{
 
 	void CCMenu::alignItemsVerticallyWithPadding(float padding)
 	{
+		// the items are laid out and hit-tested in z order
+		sortAllChildren();
+
 		float height = -padding;
 		if (m_pChildren && m_pChildren->count() > 0)
 		{
@@ -284,6 +287,7 @@ namespace cocos2d{
 
 	void CCMenu::alignItemsHorizontallyWithPadding(float padding)
 	{
+		sortAllChildren();
 
 		float width = -padding;
 		if (m_pChildren && m_pChildren->count() > 0)
@@ -329,6 +333,8 @@ namespace cocos2d{
 
 	void CCMenu::alignItemsInColumns(unsigned int columns, va_list args)
 	{
+		sortAllChildren();
+
 		vector<unsigned int> rows;
 		while (columns)
 		{
@@ -437,6 +443,8 @@ namespace cocos2d{
 
 	void CCMenu::alignItemsInRows(unsigned int rows, va_list args)
 	{
+		sortAllChildren();
+
 		vector<unsigned int> columns;
 		while (rows)
 		{
@@ -600,8 +608,64 @@ namespace cocos2d{
 		return m_tColor;
 	}
 
+	bool CCMenu::getTouchHitRect(CGRect *pRect)
+	{
+		float minX = 0, minY = 0, maxX = 0, maxY = 0;
+		bool bEmpty = true;
+
+		// a hidden menu ignores the touches, and showing it again refreshes the index
+		if (m_bIsVisible && m_pChildren && m_pChildren->count() > 0)
+		{
+			NSMutableArray<CCNode*>::NSMutableArrayIterator it;
+			for (it = m_pChildren->begin(); it != m_pChildren->end(); ++it)
+			{
+				if (! *it)
+				{
+					break;
+				}
+
+				// the same items and the same conversion as itemForTouch(), disabled items are
+				// kept since enabling one doesn't refresh the index
+				if (! (*it)->getIsVisible())
+				{
+					continue;
+				}
+
+				CGRect r = ((CCMenuItem*)(*it))->rect();
+				CGPoint corners[4] = {
+					(*it)->convertToWorldSpace(CGPointZero),
+					(*it)->convertToWorldSpace(ccp(r.size.width, 0)),
+					(*it)->convertToWorldSpace(ccp(0, r.size.height)),
+					(*it)->convertToWorldSpace(ccp(r.size.width, r.size.height)),
+				};
+
+				for (int i = 0; i < 4; ++i)
+				{
+					if (bEmpty)
+					{
+						minX = maxX = corners[i].x;
+						minY = maxY = corners[i].y;
+						bEmpty = false;
+					}
+					else
+					{
+						minX = MIN(minX, corners[i].x);
+						maxX = MAX(maxX, corners[i].x);
+						minY = MIN(minY, corners[i].y);
+						maxY = MAX(maxY, corners[i].y);
+					}
+				}
+			}
+		}
+
+		*pRect = CGRectMake(minX, minY, maxX - minX, maxY - minY);
+		return true;
+	}
+
 	CCMenuItem* CCMenu::itemForTouch(cocos2d::CCTouch *touch)
 	{
+		sortAllChildren();
+
 		CGPoint touchLocation = touch->locationInView(touch->view());
 		touchLocation = CCDirector::sharedDirector()->convertToGL(touchLocation);
 
@@ -31,6 +31,9 @@ THE SOFTWARE.
 #include "CCScheduler.h"
 #include "CCTouch.h"
 #include "CCActionManager.h"
+#include "support/data_support/uthash.h"
+
+#include <algorithm>
 
 #if CC_COCOSNODE_RENDER_SUBPIXEL
 #define RENDER_IN_SUBPIXEL
@@ -40,36 +43,59 @@ THE SOFTWARE.
 
 namespace   cocos2d {
 
+static unsigned int s_uTransformGeneration = 0;
+
+unsigned int CCNode::getTransformGeneration(void)
+{
+	return s_uTransformGeneration;
+}
+
+typedef struct _tagHashElement
+{
+	int				tag;
+	// valid only when count is 1, NULL means it has to be looked up again
+	CCNode			*child;
+	unsigned int	count;
+	UT_hash_handle	hh;
+} tTagHashElement;
+
+// incremented every time a child is added or reordered
+static unsigned int s_uGlobalOrderOfArrival = 0;
+
 CCNode::CCNode(void)
-:m_bIsRunning(false)
+:m_nZOrder(0)
+,m_fVertexZ(0.0f)
 ,m_fRotation(0.0f)
 ,m_fScaleX(1.0f)
 ,m_fScaleY(1.0f)
 ,m_tPosition(CGPointZero)
 ,m_tPositionInPixels(CGPointZero)
-,m_tAnchorPointInPixels(CGPointZero)
+// children (lazy allocs)
+,m_pChildren(NULL)
+// lazy alloc
+,m_pCamera(NULL)
+,m_pGrid(NULL)
+,m_bIsVisible(true)
 ,m_tAnchorPoint(CGPointZero)
+,m_tAnchorPointInPixels(CGPointZero)
 ,m_tContentSize(CGSizeZero)
 ,m_tContentSizeInPixels(CGSizeZero)
+,m_bIsRunning(false)
+,m_pParent(NULL)
 // "whole screen" objects. like Scenes and Layers, should set isRelativeAnchorPoint to false
 ,m_bIsRelativeAnchorPoint(true)
+,m_nTag(kCCNodeTagInvalid)
+// userData is always inited as nil
+,m_pUserData(NULL)
 ,m_bIsTransformDirty(true)
 ,m_bIsInverseDirty(true)
 #ifdef CC_NODE_TRANSFORM_USING_AFFINE_MATRIX
 ,m_bIsTransformGLDirty(true)
 #endif
-,m_fVertexZ(0.0f)
-,m_pGrid(NULL)
-,m_bIsVisible(true)
-,m_nTag(kCCNodeTagInvalid)
-,m_nZOrder(0)
-// lazy alloc
-,m_pCamera(NULL)
-// children (lazy allocs)
-,m_pChildren(NULL)
-// userData is always inited as nil
-,m_pUserData(NULL)
-,m_pParent(NULL)
+,m_bIsReorderChildDirty(false)
+,m_bIsChildTagIndexEnabled(false)
+,m_uOrderOfArrival(0)
+,m_pChildrenByTag(NULL)
 {
     // nothing
 }
@@ -96,6 +122,7 @@ CCNode::~CCNode()
 	}
 
 	// children
+	removeAllChildrenFromTagIndex();
 	CCX_SAFE_RELEASE(m_pChildren);
 
 }
@@ -156,6 +183,7 @@ void CCNode::setRotation(float newRotation)
 {
 	m_fRotation = newRotation;
 	m_bIsTransformDirty = m_bIsInverseDirty = true;
+	++s_uTransformGeneration;
 #ifdef CC_NODE_TRANSFORM_USING_AFFINE_MATRIX
 	m_bIsTransformGLDirty = true;
 #endif
@@ -174,6 +202,7 @@ void CCNode::setScale(float scale)
 {
 	m_fScaleX = m_fScaleY = scale;
 	m_bIsTransformDirty = m_bIsInverseDirty = true;
+	++s_uTransformGeneration;
 #ifdef CC_NODE_TRANSFORM_USING_AFFINE_MATRIX
 	m_bIsTransformGLDirty = true;
 #endif
@@ -190,6 +219,7 @@ void CCNode::setScaleX(float newScaleX)
 {
 	m_fScaleX = newScaleX;
 	m_bIsTransformDirty = m_bIsInverseDirty = true;
+	++s_uTransformGeneration;
 #ifdef CC_NODE_TRANSFORM_USING_AFFINE_MATRIX
 	m_bIsTransformGLDirty = true;
 #endif
@@ -206,6 +236,7 @@ void CCNode::setScaleY(float newScaleY)
 {
 	m_fScaleY = newScaleY;
 	m_bIsTransformDirty = m_bIsInverseDirty = true;
+	++s_uTransformGeneration;
 #ifdef CC_NODE_TRANSFORM_USING_AFFINE_MATRIX
 	m_bIsTransformGLDirty = true;
 #endif
@@ -231,6 +262,7 @@ void CCNode::setPosition(CGPoint newPosition)
 	}
 
 	m_bIsTransformDirty = m_bIsInverseDirty = true;
+	++s_uTransformGeneration;
 #ifdef CC_NODE_TRANSFORM_USING_AFFINE_MATRIX
 	m_bIsTransformGLDirty = true;
 #endif
@@ -250,6 +282,7 @@ void CCNode::setPositionInPixels(CGPoint newPosition)
 	}
 
 	m_bIsTransformDirty = m_bIsInverseDirty = true;
+	++s_uTransformGeneration;
 
 #if CC_NODE_TRANSFORM_USING_AFFINE_MATRIX
 	m_bIsTransformGLDirty = true;
@@ -264,6 +297,7 @@ CGPoint CCNode::getPositionInPixels()
 /// children getter
 NSMutableArray<CCNode*> * CCNode::getChildren()
 {
+	sortAllChildren();
 	return m_pChildren;
 }
 
@@ -304,6 +338,7 @@ bool CCNode::getIsVisible()
 void CCNode::setIsVisible(bool var)
 {
 	m_bIsVisible = var;
+	++s_uTransformGeneration;
 }
 
 
@@ -320,6 +355,7 @@ void CCNode::setAnchorPoint(CGPoint point)
 		m_tAnchorPoint = point;
 		m_tAnchorPointInPixels = ccp( m_tContentSizeInPixels.width * m_tAnchorPoint.x, m_tContentSizeInPixels.height * m_tAnchorPoint.y );
 		m_bIsTransformDirty = m_bIsInverseDirty = true;
+		++s_uTransformGeneration;
 #ifdef CC_NODE_TRANSFORM_USING_AFFINE_MATRIX
 		m_bIsTransformGLDirty = true;
 #endif
@@ -355,6 +391,7 @@ void CCNode::setContentSize(CGSize size)
 
 		m_tAnchorPointInPixels = ccp( m_tContentSizeInPixels.width * m_tAnchorPoint.x, m_tContentSizeInPixels.height * m_tAnchorPoint.y );
 		m_bIsTransformDirty = m_bIsInverseDirty = true;
+		++s_uTransformGeneration;
 #ifdef CC_NODE_TRANSFORM_USING_AFFINE_MATRIX
 		m_bIsTransformGLDirty = true;
 #endif
@@ -378,6 +415,7 @@ void CCNode::setContentSizeInPixels(CGSize size)
 
 		m_tAnchorPointInPixels = ccp(m_tContentSizeInPixels.width * m_tAnchorPoint.x, m_tContentSizeInPixels.height * m_tAnchorPoint.y);
 		m_bIsTransformDirty = m_bIsInverseDirty = true;
+		++s_uTransformGeneration;
 
 #if CC_NODE_TRANSFORM_USING_AFFINE_MATRIX
 		m_bIsTransformGLDirty = true;
@@ -407,6 +445,7 @@ CCNode * CCNode::getParent()
 void CCNode::setParent(CCNode * var)
 {
 	m_pParent = var;
+	++s_uTransformGeneration;
 }
 
 /// isRelativeAnchorPoint getter
@@ -419,6 +458,7 @@ void CCNode::setIsRelativeAnchorPoint(bool newValue)
 {
 	m_bIsRelativeAnchorPoint = newValue;
 	m_bIsTransformDirty = m_bIsInverseDirty = true;
+	++s_uTransformGeneration;
 #ifdef CC_NODE_TRANSFORM_USING_AFFINE_MATRIX
 	m_bIsTransformGLDirty = true;
 #endif
@@ -433,7 +473,16 @@ int CCNode::getTag()
 /// tag setter
 void CCNode::setTag(int var)
 {
-	m_nTag = var;
+	if (m_pParent && m_pParent->m_bIsChildTagIndexEnabled)
+	{
+		m_pParent->removeChildFromTagIndex(this);
+		m_nTag = var;
+		m_pParent->addChildToTagIndex(this);
+	}
+	else
+	{
+		m_nTag = var;
+	}
 }
 
 /// userData getter
@@ -498,6 +547,27 @@ CCNode* CCNode::getChildByTag(int aTag)
 {
 	NSAssert( aTag != kCCNodeTagInvalid, "Invalid tag");
 
+	if (m_bIsChildTagIndexEnabled)
+	{
+		tTagHashElement *pElement = NULL;
+		HASH_FIND_INT(m_pChildrenByTag, &aTag, pElement);
+		if (! pElement)
+		{
+			return NULL;
+		}
+
+		if (pElement->child)
+		{
+			return pElement->child;
+		}
+
+		// the tag is shared by several children (or the cached one was removed),
+		// return the first one in z order like the linear search does
+	}
+
+	// the first match depends on the order of the children
+	sortAllChildren();
+
 	if(m_pChildren && m_pChildren->count() > 0)
 	{
 		CCNode* pNode;
@@ -530,6 +600,11 @@ void CCNode::addChild(CCNode *child, int zOrder, int tag)
 
 	child->m_nTag = tag;
 
+	if (m_bIsChildTagIndexEnabled)
+	{
+		addChildToTagIndex(child);
+	}
+
 	child->setParent(this);
 
 	if( m_bIsRunning )
@@ -620,8 +695,10 @@ void CCNode::removeAllChildrenWithCleanup(bool cleanup)
 		}
 		
 		m_pChildren->removeAllObjects();
+		m_bIsReorderChildDirty = false;
 	}
-	
+
+	removeAllChildrenFromTagIndex();
 }
 
 void CCNode::detachChild(CCNode *child, bool doCleanup)
@@ -641,51 +718,180 @@ void CCNode::detachChild(CCNode *child, bool doCleanup)
 		child->cleanup();
 	}
 
+	if (m_bIsChildTagIndexEnabled)
+	{
+		removeChildFromTagIndex(child);
+	}
+
 	// set parent nil at the end
 	child->setParent(NULL);
 
-	m_pChildren->removeObject(child);
+	if (m_pChildren->getLastObject() == child)
+	{
+		m_pChildren->removeLastObject();
+	}
+	else
+	{
+		m_pChildren->removeObject(child);
+	}
 }
 
 
-// helper used by reorderChild & add
+// helper used by add
+// the child is always appended, the array is sorted lazily by sortAllChildren
 void CCNode::insertChild(CCNode* child, int z)
 {
-    unsigned int index = 0;
+    // while the array is sorted its last object has the highest z order
     CCNode* a = m_pChildren->getLastObject();
-    if (!a || a->getZOrder() <= z)
+    if (a && a->getZOrder() > z)
     {
-        m_pChildren->addObject(child);
+        m_bIsReorderChildDirty = true;
     }
-    else
-    {
-        CCNode* pNode;
-        NSMutableArray<CCNode*>::NSMutableArrayIterator it;
-        for( it = m_pChildren->begin(); it != m_pChildren->end(); it++)
-        {
-            pNode = (*it);
 
-            if ( pNode && pNode->m_nZOrder > z ) 
-            {
-                m_pChildren->insertObjectAtIndex(child, index);
-                break;
-            }
-            index++;
-        }
-    }
+    m_pChildren->addObject(child);
 
     child->setZOrder(z);
+    child->m_uOrderOfArrival = s_uGlobalOrderOfArrival++;
 }
 
 void CCNode::reorderChild(CCNode *child, int zOrder)
 {
 	NSAssert( child != NULL, "Child must be non-nil");
 
-	child->retain();
-	m_pChildren->removeObject(child);
+	// a reordered child goes behind its new brothers of the same z order, as if it was added again
+	m_bIsReorderChildDirty = true;
+	child->setZOrder(zOrder);
+	child->m_uOrderOfArrival = s_uGlobalOrderOfArrival++;
+}
 
-	insertChild(child, zOrder);
-	child->release();
+void CCNode::sortAllChildren()
+{
+	if (! m_bIsReorderChildDirty)
+	{
+		return;
+	}
+
+	m_bIsReorderChildDirty = false;
+
+	unsigned int uCount = m_pChildren ? m_pChildren->count() : 0;
+	if (uCount > 1)
+	{
+		// the array may be padded with NULLs after the last child, leave them out.
+		// the order of arrival is unique, so the result is the same as a stable sort
+		std::sort(m_pChildren->begin(), m_pChildren->begin() + uCount, CCNode::isChildOrderLess);
+	}
+}
+
+bool CCNode::isChildOrderLess(CCNode *pFirst, CCNode *pSecond)
+{
+	if (pFirst->m_nZOrder != pSecond->m_nZOrder)
+	{
+		return pFirst->m_nZOrder < pSecond->m_nZOrder;
+	}
+
+	return pFirst->m_uOrderOfArrival < pSecond->m_uOrderOfArrival;
+}
+
+void CCNode::setIsChildTagIndexEnabled(bool bEnabled)
+{
+	if (bEnabled == m_bIsChildTagIndexEnabled)
+	{
+		return;
+	}
+
+	removeAllChildrenFromTagIndex();
+	m_bIsChildTagIndexEnabled = bEnabled;
+
+	if (bEnabled && m_pChildren && m_pChildren->count() > 0)
+	{
+		NSMutableArray<CCNode*>::NSMutableArrayIterator it;
+		for (it = m_pChildren->begin(); it != m_pChildren->end(); ++it)
+		{
+			if (*it)
+			{
+				addChildToTagIndex(*it);
+			}
+		}
+	}
+}
+
+bool CCNode::getIsChildTagIndexEnabled()
+{
+	return m_bIsChildTagIndexEnabled;
+}
+
+void CCNode::addChildToTagIndex(CCNode *child)
+{
+	int nTag = child->m_nTag;
+	if (nTag == kCCNodeTagInvalid)
+	{
+		return;
+	}
+
+	tTagHashElement *pElement = NULL;
+	HASH_FIND_INT(m_pChildrenByTag, &nTag, pElement);
+	if (! pElement)
+	{
+		pElement = (tTagHashElement*)calloc(sizeof(*pElement), 1);
+		pElement->tag = nTag;
+		pElement->child = child;
+		pElement->count = 1;
+		HASH_ADD_INT(m_pChildrenByTag, tag, pElement);
+	}
+	else
+	{
+		// several children share the tag, getChildByTag has to search them in order
+		pElement->child = NULL;
+		pElement->count++;
+	}
+}
+
+void CCNode::removeChildFromTagIndex(CCNode *child)
+{
+	int nTag = child->m_nTag;
+	if (nTag == kCCNodeTagInvalid)
+	{
+		return;
+	}
+
+	tTagHashElement *pElement = NULL;
+	HASH_FIND_INT(m_pChildrenByTag, &nTag, pElement);
+	if (! pElement)
+	{
+		return;
+	}
+
+	if (--pElement->count == 0)
+	{
+		HASH_DEL(m_pChildrenByTag, pElement);
+		free(pElement);
+	}
+	else if (pElement->count == 1)
+	{
+		// cache the remaining child again
+		pElement->child = NULL;
+
+		NSMutableArray<CCNode*>::NSMutableArrayIterator it;
+		for (it = m_pChildren->begin(); it != m_pChildren->end(); ++it)
+		{
+			if (*it && *it != child && (*it)->m_nTag == nTag)
+			{
+				pElement->child = *it;
+				break;
+			}
+		}
+	}
+}
+
+void CCNode::removeAllChildrenFromTagIndex()
+{
+	tTagHashElement *pElement;
+	while (m_pChildrenByTag)
+	{
+		pElement = m_pChildrenByTag;
+		HASH_DEL(m_pChildrenByTag, pElement);
+		free(pElement);
+	}
 }
 
  void CCNode::draw()
@@ -716,6 +922,8 @@ void CCNode::visit()
     CCNode* pNode;
     NSMutableArray<CCNode*>::NSMutableArrayIterator it;
 
+	sortAllChildren();
+
 	if(m_pChildren && m_pChildren->count() > 0)
 	{
 		// draw children zOrder < 0
@@ -842,6 +1050,8 @@ void CCNode::transform()
 
 void CCNode::onEnter()
 {
+	// the children register their touch handlers here, in z order
+	sortAllChildren();
 	arrayMakeObjectsPerformSelector(m_pChildren, &CCNode::onEnter);
 
 	this->resumeSchedulerAndActions();
@@ -851,6 +1061,7 @@ void CCNode::onEnter()
 
 void CCNode::onEnterTransitionDidFinish()
 {
+	sortAllChildren();
 	arrayMakeObjectsPerformSelector(m_pChildren, &CCNode::onEnterTransitionDidFinish);
 }
 
@@ -860,6 +1071,7 @@ void CCNode::onExit()
 
 	m_bIsRunning = false;
 
+	sortAllChildren();
 	arrayMakeObjectsPerformSelector(m_pChildren, &CCNode::onExit);
 }
 CCAction * CCNode::runAction(CCAction* action)
@@ -1012,6 +1224,59 @@ CGAffineTransform CCNode::worldToNodeTransform(void)
 	return CGAffineTransformInvert(this->nodeToWorldTransform());
 }
 
+bool CCNode::nodeToScreenTransform(CGAffineTransform *pTransform)
+{
+	CGAffineTransform t = CGAffineTransformIdentity;
+
+	for (CCNode *p = this; p != NULL; p = p->getParent())
+	{
+		if (p->m_fVertexZ
+			|| (p->m_pCamera && p->m_pCamera->getDirty())
+			|| (p->m_pGrid && p->m_pGrid->isActive()))
+		{
+			return false;
+		}
+
+		t = CGAffineTransformConcat(t, p->nodeToParentTransform());
+	}
+
+	*pTransform = t;
+	return true;
+}
+
+bool CCNode::isRectCulled(const CGRect& rectInPixels)
+{
+	CCDirector *pDirector = CCDirector::sharedDirector();
+	CGAffineTransform t;
+
+	if (! pDirector->isCullingActive() || ! nodeToScreenTransform(&t))
+	{
+		return false;
+	}
+
+	CGRect visibleRect = pDirector->getVisibleRect();
+	visibleRect = CC_RECT_POINTS_TO_PIXELS(visibleRect);
+
+	return ! CGRect::CGRectIntersectsRect(visibleRect, CGRectApplyAffineTransform(rectInPixels, t));
+}
+
+bool CCNode::visibleRectInNodeSpace(CGRect *pRectInPixels)
+{
+	CCDirector *pDirector = CCDirector::sharedDirector();
+	CGAffineTransform t;
+
+	if (! pDirector->isCullingActive() || ! nodeToScreenTransform(&t))
+	{
+		return false;
+	}
+
+	CGRect visibleRect = pDirector->getVisibleRect();
+	visibleRect = CC_RECT_POINTS_TO_PIXELS(visibleRect);
+
+	*pRectInPixels = CGRectApplyAffineTransform(visibleRect, CGAffineTransformInvert(t));
+	return true;
+}
+
 CGPoint CCNode::convertToNodeSpace(CGPoint worldPoint)
 {
 	CGPoint ret;
@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "CCActionGrid.h"
 #include "CCRenderTexture.h"
 #include "CCActionTiledGrid.h"
+#include "effects/CCGrid.h"
 namespace   cocos2d {
 
 enum {
@@ -53,16 +54,53 @@ enum {
 }
 
 
+static ccTransitionSnapshotMode s_eDefaultSnapshotMode = kCCTransitionSnapshotNone;
+
+// draws the scene once into a window sized render texture, centered like the scene
+static CCRenderTexture* snapshotScene(CCScene *pScene)
+{
+	CGSize size = CCDirector::sharedDirector()->getWinSize();
+	CCRenderTexture *pSnapshot = CCRenderTexture::renderTextureWithWidthAndHeight((int)size.width, (int)size.height);
+	if (! pSnapshot)
+	{
+		return NULL;
+	}
+
+	pSnapshot->getSprite()->setAnchorPoint(ccp(0.5f, 0.5f));
+	pSnapshot->setPosition(ccp(size.width/2, size.height/2));
+	pSnapshot->setAnchorPoint(ccp(0.5f, 0.5f));
+
+	pSnapshot->beginWithClear(0, 0, 0, 0);
+	pScene->visit();
+	pSnapshot->end();
+
+	pSnapshot->retain();
+	return pSnapshot;
+}
 
 CCTransitionScene::CCTransitionScene()
+: m_eSnapshotMode(s_eDefaultSnapshotMode)
+, m_pOutSnapshot(NULL)
+, m_pInSnapshot(NULL)
 {
 }
 CCTransitionScene::~CCTransitionScene()
 {
+	releaseSnapshots();
 	m_pInScene->release();
 	m_pOutScene->release();
 }
 
+void CCTransitionScene::setDefaultSnapshotMode(ccTransitionSnapshotMode eMode)
+{
+	s_eDefaultSnapshotMode = eMode;
+}
+
+ccTransitionSnapshotMode CCTransitionScene::getDefaultSnapshotMode(void)
+{
+	return s_eDefaultSnapshotMode;
+}
+
 CCTransitionScene * CCTransitionScene::transitionWithDuration(ccTime t, CCScene *scene)
 {
 	CCTransitionScene * pScene = new CCTransitionScene();
@@ -112,14 +150,71 @@ void CCTransitionScene::sceneOrder()
 void CCTransitionScene::draw()
 {
 	if( m_bIsInSceneOnTop ) {
-		m_pOutScene->visit();
-		m_pInScene->visit();
+		visitScene(m_pOutScene, m_pOutSnapshot);
+		visitScene(m_pInScene, m_pInSnapshot);
 	} else {
-		m_pInScene->visit();
-		m_pOutScene->visit();
+		visitScene(m_pInScene, m_pInSnapshot);
+		visitScene(m_pOutScene, m_pOutSnapshot);
 	}
 }
 
+void CCTransitionScene::visitScene(CCScene *pScene, CCRenderTexture *pSnapshot)
+{
+	if (! pSnapshot)
+	{
+		pScene->visit();
+		return;
+	}
+
+	// same as CCNode::visit, with the snapshot drawn instead of the children
+	if (! pScene->getIsVisible())
+	{
+		return;
+	}
+
+	glPushMatrix();
+
+	CCGridBase *pGrid = pScene->getGrid();
+	bool bGrid = (pGrid && pGrid->isActive());
+	if (bGrid)
+	{
+		pGrid->beforeDraw();
+		pScene->transformAncestors();
+	}
+
+	pScene->transform();
+	pSnapshot->visit();
+
+	if (bGrid)
+	{
+		pGrid->afterDraw(pScene);
+	}
+
+	glPopMatrix();
+}
+
+void CCTransitionScene::takeSnapshots()
+{
+	releaseSnapshots();
+
+	// the scenes are not moved by the transition yet
+	if (m_eSnapshotMode != kCCTransitionSnapshotNone)
+	{
+		m_pOutSnapshot = snapshotScene(m_pOutScene);
+	}
+
+	if (m_eSnapshotMode == kCCTransitionSnapshotBothScenes)
+	{
+		m_pInSnapshot = snapshotScene(m_pInScene);
+	}
+}
+
+void CCTransitionScene::releaseSnapshots()
+{
+	CCX_SAFE_RELEASE_NULL(m_pOutSnapshot);
+	CCX_SAFE_RELEASE_NULL(m_pInSnapshot);
+}
+
 void CCTransitionScene::finish()
 {
 	// clean up 	
@@ -169,6 +264,8 @@ void CCTransitionScene::onEnter()
 	CCScene::onEnter();
 	m_pInScene->onEnter();
 	// outScene should not receive the onEnter callback
+
+	takeSnapshots();
 }
 
 // custom onExit
@@ -177,6 +274,8 @@ void CCTransitionScene::onExit()
 	CCScene::onExit();
 	m_pOutScene->onExit();
 
+	releaseSnapshots();
+
 	// inScene should not receive the onExit callback
 	// only the onEnterTransitionDidFinish
 	m_pInScene->onEnterTransitionDidFinish();
@@ -1102,6 +1201,8 @@ void CCTransitionCrossFade:: draw()
 
 void CCTransitionCrossFade::onEnter()
 {
+	// the scenes are rendered to textures below
+	m_eSnapshotMode = kCCTransitionSnapshotNone;
 	CCTransitionScene::onEnter();
 
 	// create a transparent color layer
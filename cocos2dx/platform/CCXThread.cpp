@@ -0,0 +1,398 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "CCXThread.h"
+
+#if defined(CCX_PLATFORM_WIN32)
+    #include <windows.h>
+#elif defined(CCX_PLATFORM_ANDROID) || defined(CCX_PLATFORM_IPHONE)
+    #include <pthread.h>
+#endif
+
+#include <stdlib.h>
+
+namespace   cocos2d {
+
+typedef struct
+{
+	CCX_THREAD_FUNC func;
+	void *data;
+} tThreadStartInfo;
+
+#if defined(CCX_PLATFORM_WIN32)
+
+static DWORD WINAPI threadEntry(LPVOID pParam)
+{
+	tThreadStartInfo *pInfo = (tThreadStartInfo*)pParam;
+	pInfo->func(pInfo->data);
+	delete pInfo;
+	return 0;
+}
+
+bool ccxStartThread(CCX_THREAD_FUNC pfnFunc, void *pData)
+{
+	tThreadStartInfo *pInfo = new tThreadStartInfo;
+	pInfo->func = pfnFunc;
+	pInfo->data = pData;
+
+	HANDLE hThread = CreateThread(NULL, 0, threadEntry, pInfo, 0, NULL);
+	if (! hThread)
+	{
+		delete pInfo;
+		return false;
+	}
+
+	CloseHandle(hThread);
+	return true;
+}
+
+#elif defined(CCX_PLATFORM_ANDROID) || defined(CCX_PLATFORM_IPHONE)
+
+static void* threadEntry(void *pParam)
+{
+	tThreadStartInfo *pInfo = (tThreadStartInfo*)pParam;
+	pInfo->func(pInfo->data);
+	delete pInfo;
+	return NULL;
+}
+
+bool ccxStartThread(CCX_THREAD_FUNC pfnFunc, void *pData)
+{
+	tThreadStartInfo *pInfo = new tThreadStartInfo;
+	pInfo->func = pfnFunc;
+	pInfo->data = pData;
+
+	pthread_t thread;
+	if (pthread_create(&thread, NULL, threadEntry, pInfo) != 0)
+	{
+		delete pInfo;
+		return false;
+	}
+
+	pthread_detach(thread);
+	return true;
+}
+
+#else
+
+bool ccxStartThread(CCX_THREAD_FUNC pfnFunc, void *pData)
+{
+	// no thread support
+	return false;
+}
+
+#endif
+
+//
+// worker threads of ccxParallelFor
+//
+
+#define MAX_WORKER_THREADS	8
+
+typedef struct
+{
+	CCX_RANGE_FUNC func;
+	void *data;
+	unsigned int count;
+	unsigned int parts;
+} tRangeJob;
+
+static tRangeJob s_tJob;
+static unsigned int s_uWorkerCount = 0;
+static volatile bool s_bQuitWorkers = false;
+
+static void runJobPart(unsigned int uPart)
+{
+	unsigned int uBegin = (unsigned int)((unsigned long long)s_tJob.count * uPart / s_tJob.parts);
+	unsigned int uEnd = (unsigned int)((unsigned long long)s_tJob.count * (uPart + 1) / s_tJob.parts);
+
+	if (uBegin < uEnd)
+	{
+		s_tJob.func(s_tJob.data, uBegin, uEnd);
+	}
+}
+
+#if defined(CCX_PLATFORM_WIN32)
+
+static HANDLE s_hWorkers[MAX_WORKER_THREADS];
+static HANDLE s_hStartEvents[MAX_WORKER_THREADS];
+static HANDLE s_hDoneEvent = NULL;
+static volatile LONG s_lPendingWorkers = 0;
+
+static DWORD WINAPI workerEntry(LPVOID pParam)
+{
+	unsigned int uIndex = (unsigned int)(size_t)pParam;
+
+	while (true)
+	{
+		WaitForSingleObject(s_hStartEvents[uIndex], INFINITE);
+		if (s_bQuitWorkers)
+		{
+			break;
+		}
+
+		runJobPart(uIndex + 1);
+
+		if (InterlockedDecrement(&s_lPendingWorkers) == 0)
+		{
+			SetEvent(s_hDoneEvent);
+		}
+	}
+
+	return 0;
+}
+
+static void stopWorkers()
+{
+	if (s_uWorkerCount == 0)
+	{
+		return;
+	}
+
+	s_bQuitWorkers = true;
+	for (unsigned int i = 0; i < s_uWorkerCount; ++i)
+	{
+		SetEvent(s_hStartEvents[i]);
+	}
+
+	WaitForMultipleObjects(s_uWorkerCount, s_hWorkers, TRUE, INFINITE);
+
+	for (unsigned int i = 0; i < s_uWorkerCount; ++i)
+	{
+		CloseHandle(s_hWorkers[i]);
+		CloseHandle(s_hStartEvents[i]);
+	}
+
+	s_uWorkerCount = 0;
+	s_bQuitWorkers = false;
+}
+
+static void startWorkers(unsigned int uCount)
+{
+	if (! s_hDoneEvent)
+	{
+		s_hDoneEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+		if (! s_hDoneEvent)
+		{
+			return;
+		}
+	}
+
+	for (unsigned int i = 0; i < uCount; ++i)
+	{
+		s_hStartEvents[i] = CreateEvent(NULL, FALSE, FALSE, NULL);
+		if (! s_hStartEvents[i])
+		{
+			break;
+		}
+
+		s_hWorkers[i] = CreateThread(NULL, 0, workerEntry, (LPVOID)(size_t)i, 0, NULL);
+		if (! s_hWorkers[i])
+		{
+			CloseHandle(s_hStartEvents[i]);
+			break;
+		}
+
+		++s_uWorkerCount;
+	}
+}
+
+static void runJobOnWorkers()
+{
+	s_lPendingWorkers = (LONG)s_uWorkerCount;
+	for (unsigned int i = 0; i < s_uWorkerCount; ++i)
+	{
+		SetEvent(s_hStartEvents[i]);
+	}
+
+	runJobPart(0);
+
+	WaitForSingleObject(s_hDoneEvent, INFINITE);
+}
+
+#elif defined(CCX_PLATFORM_ANDROID) || defined(CCX_PLATFORM_IPHONE)
+
+static pthread_t s_workers[MAX_WORKER_THREADS];
+static pthread_mutex_t s_workerMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_workerStartCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t s_workerDoneCond = PTHREAD_COND_INITIALIZER;
+// bumped for every job, a worker runs a job when the generation differs from the last one it ran
+static unsigned int s_uJobGeneration = 0;
+static unsigned int s_uPendingWorkers = 0;
+
+typedef struct
+{
+	unsigned int index;
+	unsigned int generation;
+} tWorkerStartInfo;
+
+static void* workerEntry(void *pParam)
+{
+	tWorkerStartInfo *pInfo = (tWorkerStartInfo*)pParam;
+	unsigned int uIndex = pInfo->index;
+	unsigned int uGeneration = pInfo->generation;
+	delete pInfo;
+
+	pthread_mutex_lock(&s_workerMutex);
+	while (true)
+	{
+		while (uGeneration == s_uJobGeneration && ! s_bQuitWorkers)
+		{
+			pthread_cond_wait(&s_workerStartCond, &s_workerMutex);
+		}
+
+		if (s_bQuitWorkers)
+		{
+			break;
+		}
+
+		uGeneration = s_uJobGeneration;
+		pthread_mutex_unlock(&s_workerMutex);
+
+		runJobPart(uIndex + 1);
+
+		pthread_mutex_lock(&s_workerMutex);
+		if (--s_uPendingWorkers == 0)
+		{
+			pthread_cond_signal(&s_workerDoneCond);
+		}
+	}
+	pthread_mutex_unlock(&s_workerMutex);
+
+	return NULL;
+}
+
+static void stopWorkers()
+{
+	if (s_uWorkerCount == 0)
+	{
+		return;
+	}
+
+	pthread_mutex_lock(&s_workerMutex);
+	s_bQuitWorkers = true;
+	pthread_cond_broadcast(&s_workerStartCond);
+	pthread_mutex_unlock(&s_workerMutex);
+
+	for (unsigned int i = 0; i < s_uWorkerCount; ++i)
+	{
+		pthread_join(s_workers[i], NULL);
+	}
+
+	s_uWorkerCount = 0;
+	s_bQuitWorkers = false;
+}
+
+static void startWorkers(unsigned int uCount)
+{
+	for (unsigned int i = 0; i < uCount; ++i)
+	{
+		// the worker must not take a job started before it, nor miss one started before it runs
+		tWorkerStartInfo *pInfo = new tWorkerStartInfo;
+		pInfo->index = i;
+		pInfo->generation = s_uJobGeneration;
+
+		if (pthread_create(&s_workers[i], NULL, workerEntry, pInfo) != 0)
+		{
+			delete pInfo;
+			break;
+		}
+
+		++s_uWorkerCount;
+	}
+}
+
+static void runJobOnWorkers()
+{
+	pthread_mutex_lock(&s_workerMutex);
+	s_uPendingWorkers = s_uWorkerCount;
+	++s_uJobGeneration;
+	pthread_cond_broadcast(&s_workerStartCond);
+	pthread_mutex_unlock(&s_workerMutex);
+
+	runJobPart(0);
+
+	pthread_mutex_lock(&s_workerMutex);
+	while (s_uPendingWorkers > 0)
+	{
+		pthread_cond_wait(&s_workerDoneCond, &s_workerMutex);
+	}
+	pthread_mutex_unlock(&s_workerMutex);
+}
+
+#else
+
+static void stopWorkers()
+{
+}
+
+static void startWorkers(unsigned int uCount)
+{
+	// no thread support
+}
+
+static void runJobOnWorkers()
+{
+	runJobPart(0);
+}
+
+#endif
+
+unsigned int ccxSetWorkerThreadCount(unsigned int uCount)
+{
+	stopWorkers();
+
+	if (uCount > MAX_WORKER_THREADS)
+	{
+		uCount = MAX_WORKER_THREADS;
+	}
+
+	startWorkers(uCount);
+	return s_uWorkerCount;
+}
+
+unsigned int ccxGetWorkerThreadCount(void)
+{
+	return s_uWorkerCount;
+}
+
+void ccxParallelFor(CCX_RANGE_FUNC pfnFunc, void *pData, unsigned int uCount)
+{
+	if (s_uWorkerCount == 0 || uCount < 2)
+	{
+		if (uCount > 0)
+		{
+			pfnFunc(pData, 0, uCount);
+		}
+		return;
+	}
+
+	s_tJob.func = pfnFunc;
+	s_tJob.data = pData;
+	s_tJob.count = uCount;
+	s_tJob.parts = s_uWorkerCount + 1;
+
+	runJobOnWorkers();
+}
+
+}//namespace   cocos2d 
@@ -0,0 +1,64 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __PLATFORM_CCXTHREAD_H__
+#define __PLATFORM_CCXTHREAD_H__
+
+#include "config_platform.h"
+
+namespace   cocos2d {
+
+typedef void (*CCX_THREAD_FUNC)(void *pData);
+
+/**
+@brief Runs pfnFunc(pData) on a detached worker thread.
+The function must not touch the cocos2d objects or call OpenGL, hand the results
+back to the main thread under a NSLock instead.
+@return false if the thread could not be started or the platform has no threads (uphone),
+the caller should then do the work itself.
+*/
+bool ccxStartThread(CCX_THREAD_FUNC pfnFunc, void *pData);
+
+typedef void (*CCX_RANGE_FUNC)(void *pData, unsigned int uBegin, unsigned int uEnd);
+
+/**
+@brief Starts the worker threads used by ccxParallelFor, stopping the previous ones.
+0 (the default) stops them all. At most 8 workers are started.
+Must be called from the thread that calls ccxParallelFor, never while it is running.
+@return the number of worker threads running, always 0 on uphone.
+*/
+unsigned int ccxSetWorkerThreadCount(unsigned int uCount);
+unsigned int ccxGetWorkerThreadCount(void);
+
+/**
+@brief Splits [0, uCount) in one range per worker thread plus one for the calling thread
+and calls pfnFunc(pData, uBegin, uEnd) on each range concurrently. Returns when all the ranges are done.
+Without worker threads the whole range is handled by the calling thread.
+The ranges must not write to shared data. Not reentrant: pfnFunc can't call ccxParallelFor.
+*/
+void ccxParallelFor(CCX_RANGE_FUNC pfnFunc, void *pData, unsigned int uCount);
+
+}//namespace   cocos2d 
+
+#endif // __PLATFORM_CCXTHREAD_H__
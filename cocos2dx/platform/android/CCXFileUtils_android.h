@@ -72,6 +72,12 @@ public:
     @warning If you get the file data succeed,you must delete it after used.
     */
     static unsigned char* getFileData(const char* pszFileName, const char* pszMode, unsigned long * pSize);
+
+    /**
+    @brief Get resource file data without copying it in the heap, see FileUtils::getFileDataView
+    @since v0.99.5
+    */
+    static NSData* getFileDataView(const char* pszFileName);
 	
 	static const char* getResourcePath(void);
 	
@@ -25,6 +25,7 @@ THE SOFTWARE.
 #ifndef __PLATFORM_UPHONE_PLATFORM_NSLOCK_H__
 #define __PLATFORM_UPHONE_PLATFORM_NSLOCK_H__
 
+#include <pthread.h>
 namespace   cocos2d {
 
 class NSLock
@@ -35,6 +36,9 @@ public:
 
 	void lock(void);
 	void unlock(void);
+
+private:
+	pthread_mutex_t m_mutex;
 };
 }//namespace   cocos2d 
 
@@ -243,24 +243,37 @@ static bool static_initWithData(void * pBuffer, int length, tImageInfo *pImagein
 	return ret;
 }
 
-static bool static_initWithFile(const char* path, tImageInfo *pImageinfo)
+// Decodes with the CoreGraphics data providers instead of UIKit, so CCResourcePreloader
+// can call it from its worker threads. Those have no autorelease pool of their own.
+static bool static_initWithFile(const char* path, bool bPNG, tImageInfo *pImageinfo)
 {
-	CGImageRef				CGImage;	
-	UIImage					*jpg;
-	UIImage					*png;
+	NSAutoreleasePool		*pool = [[NSAutoreleasePool alloc] init];
+	CGDataProviderRef		provider;
+	CGImageRef				CGImage = NULL;
 	bool                    ret;
 	
-	// convert jpg to png before loading the texture
-
-	NSString *fullPath = [NSString stringWithUTF8String:path];
-	jpg = [[UIImage alloc] initWithContentsOfFile: fullPath];
-	png = [[UIImage alloc] initWithData:UIImagePNGRepresentation(jpg)];
-	CGImage = png.CGImage;	
+	provider = CGDataProviderCreateWithFilename(path);
+	if (provider)
+	{
+		// UIKit didn't trust the extension either, try the other format if the first one fails
+		for (int i = 0; i < 2 && ! CGImage; ++i, bPNG = ! bPNG)
+		{
+			if (bPNG)
+			{
+				CGImage = CGImageCreateWithPNGDataProvider(provider, NULL, false, kCGRenderingIntentDefault);
+			}
+			else
+			{
+				CGImage = CGImageCreateWithJPEGDataProvider(provider, NULL, false, kCGRenderingIntentDefault);
+			}
+		}
+		CGDataProviderRelease(provider);
+	}
 	
 	ret = static_initWithImage(CGImage, pImageinfo);
 	
-	[png release];
-	[jpg release];
+	CGImageRelease(CGImage);
+	[pool release];
 	
 	return ret;
 }
@@ -323,7 +336,7 @@ bool UIImage::initWithContentsOfFile(const string &strPath, tImageFormat imageTy
 	{
 	case kCCImageFormatPNG:
 	case kCCImageFormatJPG:
-		bRet = static_initWithFile(strPath.c_str(), &m_imageInfo);
+		bRet = static_initWithFile(strPath.c_str(), imageType == kCCImageFormatPNG, &m_imageInfo);
 		break;
 	default:
 		// unsupported image type
@@ -26,20 +26,21 @@ namespace   cocos2d {
 
 NSLock::NSLock(void)
 {
+	pthread_mutex_init(&m_mutex, NULL);
 }
 
 NSLock::~NSLock(void)
 {
-
+	pthread_mutex_destroy(&m_mutex);
 }
 
 void NSLock::lock(void)
 {
-	
+	pthread_mutex_lock(&m_mutex);
 }
 
 void NSLock::unlock(void)
 {
-	
+	pthread_mutex_unlock(&m_mutex);
 }
 }//namespace   cocos2d 
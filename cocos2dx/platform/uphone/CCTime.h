@@ -24,6 +24,9 @@ THE SOFTWARE.
 
 #ifndef __PLATFORM_UPHONE_CCTIME_H__
 #define __PLATFORM_UPHONE_CCTIME_H__
+
+#include "ccxCommon.h"
+
 namespace   cocos2d {
 
 struct cc_timeval
@@ -32,7 +35,7 @@ struct cc_timeval
  	long	tv_usec;    // microSeconds
 };
 
-class CCTime 
+class CCX_DLL CCTime 
 {
 public:
 	static int gettimeofdayCocos2d(struct cc_timeval *tp, void *tzp);
@@ -23,180 +23,18 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include <string>
-#include <stack>
-#include <libxml/parser.h>
-#include <libxml/tree.h>
-#include <libxml/xmlmemory.h>
 #include <TG3.h>
 #include "NSString.h"
+#include "support/data_support/CCPlistParser.h"
+#include "NSData.h"
 #include "CCXFileUtils_uphone.h"
 #include "CCXCocos2dDefine.h"
 #include "CCXApplication.h"
 
-#include "support/file_support/FileData.h"
 #include "support/zip_support/unzip.h"
 
 namespace cocos2d {
 
-void plist_startElement(void *ctx, const xmlChar *name, const xmlChar **atts);
-void plist_endElement(void *ctx, const xmlChar *name);
-void plist_characters(void *ctx, const xmlChar *ch, int len);
-
-typedef enum 
-{
-	SAX_NONE = 0,
-	SAX_KEY,
-	SAX_DICT,
-	SAX_INT,
-	SAX_REAL,
-	SAX_STRING
-}CCSAXState;
-
-class CCDictMaker
-{
-public:
-	NSDictionary<std::string, NSObject*> *m_pRootDict;
-	NSDictionary<std::string, NSObject*> *m_pCurDict;
-	std::stack<NSDictionary<std::string, NSObject*>*> m_tDictStack;
-	std::string m_sCurKey;///< parsed key
-	CCSAXState m_tState;
-public:
-	CCDictMaker()
-	{
-		m_pRootDict = NULL;
-		m_pCurDict = NULL;
-		m_tState = SAX_NONE;
-	}
-	~CCDictMaker()
-	{
-	}
-	NSDictionary<std::string, NSObject*> *dictionaryWithContentsOfFile(const char *pFileName)
-	{
-        FileData data;
-        unsigned long size = 0;
-        char *pBuffer = (char *) data.getFileData(pFileName, "r", &size);
-
-        if (!pBuffer)
-        {
-            return NULL;
-        }
-
-		/*
-		* this initialize the library and check potential ABI mismatches
-		* between the version it was compiled for and the actual shared
-		* library used.
-		*/
-		LIBXML_TEST_VERSION
-		xmlSAXHandler saxHandler;
-		memset( &saxHandler, 0, sizeof(saxHandler) );
-		// Using xmlSAXVersion( &saxHandler, 2 ) generate crash as it sets plenty of other pointers...
-		saxHandler.initialized = XML_SAX2_MAGIC;  // so we do this to force parsing as SAX2.
- 		saxHandler.startElement = &plist_startElement;
- 		saxHandler.endElement = &plist_endElement;
- 		saxHandler.characters = &plist_characters;
-
-		int result = xmlSAXUserParseMemory( &saxHandler, this, pBuffer, size );
-		if ( result != 0 )
-		{
-			return NULL;
-		}
-		/*
-		* Cleanup function for the XML library.
-		*/
-		xmlCleanupParser();
-		/*
-		* this is to debug memory for regression tests
-		*/
-		xmlMemoryDump();
-
-		return m_pRootDict;
-	}
-};
-void plist_startElement(void *ctx, const xmlChar *name, const xmlChar **atts)
-{
-	CCDictMaker *pMaker = (CCDictMaker*)(ctx);
-	std::string sName((char*)name);
-	if( sName == "dict" )
-	{
-		NSDictionary<std::string, NSObject*> *pNewDict = new NSDictionary<std::string, NSObject*>();
-		if(! pMaker->m_pRootDict)
-		{
-			pMaker->m_pRootDict = pNewDict;
-			pNewDict->autorelease();
-		}
-		else
-		{
-			NSAssert(pMaker->m_pCurDict && !pMaker->m_sCurKey.empty(), "");
-			pMaker->m_pCurDict->setObject(pNewDict, pMaker->m_sCurKey);
-			pNewDict->release();
-			pMaker->m_sCurKey.clear();
-		}
-		pMaker->m_pCurDict = pNewDict;
-		pMaker->m_tDictStack.push(pMaker->m_pCurDict);
-		pMaker->m_tState = SAX_DICT;
-	}
-	else if(sName == "key")
-	{
-		pMaker->m_tState = SAX_KEY;
-	}
-	else if(sName == "integer")
-	{
-		pMaker->m_tState = SAX_INT;
-	}
-	else if(sName == "real")
-	{
-		pMaker->m_tState = SAX_REAL;
-	}
-	else if(sName == "string")
-	{
-		pMaker->m_tState = SAX_STRING;
-	}
-	else
-	{
-		pMaker->m_tState = SAX_NONE;
-	}
-}
-void plist_endElement(void *ctx, const xmlChar *name)
-{
-	CCDictMaker * pMaker = (CCDictMaker*)(ctx);
-	std::string sName((char*)name);
-	if( sName == "dict" )
-	{
-		pMaker->m_tDictStack.pop();
-		if ( !pMaker->m_tDictStack.empty() )
-		{
-			pMaker->m_pCurDict = (NSDictionary<std::string, NSObject*>*)(pMaker->m_tDictStack.top());
-		}
-	}
-	pMaker->m_tState = SAX_NONE;
-}
-void plist_characters(void *ctx, const xmlChar *ch, int len)
-{
- 	CCDictMaker * pMaker = (CCDictMaker*)(ctx);
-	if (pMaker->m_tState == SAX_NONE)
-	{
-		return;
-	}
- 	NSString *pText = new NSString();
-	pText->m_sString = std::string((char*)ch,0,len);
-
- 	switch(pMaker->m_tState)
- 	{
- 	case SAX_KEY:
- 		pMaker->m_sCurKey = pText->m_sString;
- 		break;
- 	case SAX_INT:
- 	case SAX_REAL:
- 	case SAX_STRING:
- 		{
- 			NSAssert(!pMaker->m_sCurKey.empty(), "not found key : <integet/real>");
- 			pMaker->m_pCurDict->setObject(pText, pMaker->m_sCurKey);
- 			break;
- 		}
- 	}
-	pText->release();
-}
-
 // record the resource path
 static char s_pszResourcePath[EOS_FILE_MAX_PATH] = {0};
 static char s_pszZipFilePath[EOS_FILE_MAX_PATH]  = {0};
@@ -354,8 +192,7 @@ const char *CCFileUtils::fullPathFromRelativeFile(const char *pszFilename, const
 }
 NSDictionary<std::string, NSObject*> *CCFileUtils::dictionaryWithContentsOfFile(const char *pFileName)
 {
-	CCDictMaker tMaker;
-	return tMaker.dictionaryWithContentsOfFile(pFileName);
+	return CCPlistParser::dictionaryWithContentsOfFile(pFileName);
 }
 
 const char* CCFileUtils::getDiffResolutionPath(const char *pszPath)
@@ -472,6 +309,27 @@ unsigned char* CCFileUtils::getFileData(const char* pszFileName, const char* psz
     return pBuffer;
 }
 
+NSData* CCFileUtils::getFileDataView(const char* pszFileName)
+{
+    NSData * pRet = NULL;
+
+    if (strlen(s_pszZipFilePath) != 0)
+    {
+        // if specify the zip file,load from it first
+        pRet = FileUtils::getFileDataViewFromZip(s_pszZipFilePath, pszFileName);
+    }
+
+    if (! pRet)
+    {
+        // uphone can't map files, the data is read as by getFileData
+        unsigned long nSize = 0;
+        unsigned char * pBuffer = getFileData(pszFileName, "rb", &nSize);
+        pRet = NSData::dataWithBytesNoCopy(pBuffer, nSize);
+    }
+
+    return pRet;
+}
+
 int CCFileUtils::ccLoadFileIntoMemory(const char *filename, unsigned char **out)
 {
 	///@todo
@@ -28,7 +28,8 @@ THE SOFTWARE.
 #include "png.h"
 
 #include "CCXBitmapDC.h"
-#include "support/file_support/FileData.h"
+#include "support/image_support/ImageEncoder.h"
+#include "NSData.h"
 
 // in order to compile correct in andLinux, because ssTypes(uphone)
 // and jmorecfg.h all typedef xxx INT32
@@ -127,12 +128,12 @@ bool UIImage::initWithContentsOfFile(const string &strPath, eImageFormat imageTy
 {
 	bool bRet = false;
 
-    // attempt load image from file
-    FileData data;
-    unsigned long nSize  = 0;
-    unsigned char* pBuffer = data.getFileData(strPath.c_str(), "rb", &nSize);
-    if (pBuffer)
+    // attempt load image from file, decoded straight from the file data
+    NSData *pData = CCFileUtils::getFileDataView(strPath.c_str());
+    if (pData)
     {
+        unsigned char* pBuffer = (unsigned char*)pData->bytes();
+        unsigned long nSize = pData->getSize();
         switch (imageType)
         {
         case kCCImageFormatPNG:
@@ -147,6 +148,7 @@ bool UIImage::initWithContentsOfFile(const string &strPath, eImageFormat imageTy
             bRet = false;
             break;
         }
+        pData->release();
     }
 
 	if (!bRet && s_bPopupNotify)
@@ -274,7 +276,8 @@ bool UIImage::loadPngFromStream(unsigned char *data, int nLength)
 
 	// copy data to image info
 	int bytesPerRow = m_imageInfo.width * bytesPerComponent;
-	if(m_imageInfo.hasAlpha)	{
+	if(m_imageInfo.hasAlpha)
+	{
 		unsigned int *tmp = (unsigned int *)m_imageInfo.data;
 		for(unsigned int i = 0; i < m_imageInfo.height; i++)
 		{
@@ -367,8 +370,41 @@ bool UIImage::loadJpgFromStream(unsigned char *data, unsigned long nSize)
 
 bool UIImage::save(const std::string &strFileName, int nFormat)
 {
-	/// @todo uiimage::save
-	return false;
+	bool bRet = false;
+	unsigned char *pRGBA = NULL;
+	unsigned char *pOut = NULL;
+	unsigned long nOutLen = 0;
+
+	do 
+	{
+		CCX_BREAK_IF(! m_imageInfo.data || strFileName.empty());
+
+		int nPixels = m_imageInfo.width * m_imageInfo.height;
+		pRGBA = m_imageInfo.data;
+		if (! m_imageInfo.hasAlpha)
+		{
+			// the encoder only takes RGBA8888
+			pRGBA = new unsigned char[nPixels * 4];
+			CCX_BREAK_IF(! pRGBA);
+			for (int i = 0; i < nPixels; ++i)
+			{
+				pRGBA[i * 4 + 0] = m_imageInfo.data[i * 3 + 0];
+				pRGBA[i * 4 + 1] = m_imageInfo.data[i * 3 + 1];
+				pRGBA[i * 4 + 2] = m_imageInfo.data[i * 3 + 2];
+				pRGBA[i * 4 + 3] = 0xff;
+			}
+		}
+
+		CCX_BREAK_IF(! ccImageEncodeRGBA(pRGBA, m_imageInfo.width, m_imageInfo.height, nFormat, &pOut, &nOutLen));
+		bRet = ccImageWriteFile(strFileName.c_str(), pOut, nOutLen);
+	} while (0);
+
+	if (pRGBA != m_imageInfo.data)
+	{
+		delete [] pRGBA;
+	}
+	delete [] pOut;
+	return bRet;
 }
 bool UIImage::initWithData(unsigned char *pBuffer, int nLength)
 {
@@ -377,8 +413,28 @@ bool UIImage::initWithData(unsigned char *pBuffer, int nLength)
 
 bool UIImage::initWithBuffer(int tx, int ty, unsigned char *pBuffer)
 {
-	/// @todo
-	return false;
+	if (! pBuffer || tx <= 0 || ty <= 0)
+	{
+		return false;
+	}
+
+	// the buffer holds tightly packed RGBA8888 pixels
+	int nLen = tx * ty * 4;
+	unsigned char *pData = new unsigned char[nLen];
+	if (! pData)
+	{
+		return false;
+	}
+	memcpy(pData, pBuffer, nLen);
+
+	delete [] m_imageInfo.data;
+	m_imageInfo.data = pData;
+	m_imageInfo.width = tx;
+	m_imageInfo.height = ty;
+	m_imageInfo.hasAlpha = true;
+	m_imageInfo.isPremultipliedAlpha = false;
+	m_imageInfo.bitsPerComponent = 8;
+	return true;
 }
 
 bool UIImage::initWithBitmap(const TBitmap* pBmp)
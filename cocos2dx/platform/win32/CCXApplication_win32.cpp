@@ -1,4 +1,5 @@
 #include "CCXApplication_win32.h"
+#include <MMSystem.h>
 
 #include "CCDirector.h"
 
@@ -50,20 +51,39 @@ int CCXApplication::Run()
     {
         return 0;
     }
-    
+
+    // 1ms timer resolution, so the wait below wakes up close to the deadline
+    timeBeginPeriod(1);
+
 	while (1)
 	{
 		if (! PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
 		{
             QueryPerformanceCounter(&nNow);
-			if (nNow.QuadPart - nLast.QuadPart >= m_nAnimationInterval.QuadPart)
+            LONGLONG nRemain = nLast.QuadPart + m_nAnimationInterval.QuadPart - nNow.QuadPart;
+			if (nRemain <= 0)
 			{
-                nLast.QuadPart = nNow.QuadPart;
+                // keep the cadence of the frames, unless more than a whole frame was missed
+                nLast.QuadPart += m_nAnimationInterval.QuadPart;
+                if (nNow.QuadPart - nLast.QuadPart > m_nAnimationInterval.QuadPart)
+                {
+                    nLast.QuadPart = nNow.QuadPart;
+                }
 				CCDirector::sharedDirector()->mainLoop();
 			}
 			else
 			{
-				Sleep(0);
+                // sleep until the next frame, or until a message arrives; the last
+                // millisecond is not slept since the wake up time isn't that accurate
+                DWORD dwWait = (DWORD)(nRemain * 1000 / nFreq.QuadPart);
+                if (dwWait > 1)
+                {
+                    MsgWaitForMultipleObjects(0, NULL, FALSE, dwWait - 1, QS_ALLINPUT);
+                }
+                else
+                {
+				    Sleep(0);
+                }
 			}
 			continue;
 		}
@@ -79,6 +99,8 @@ int CCXApplication::Run()
 			DispatchMessage(&msg);
 		}
 	}
+
+    timeEndPeriod(1);
 	return (int) msg.wParam;
 }
 
@@ -26,6 +26,9 @@ THE SOFTWARE.
 #include "CCTexture2D.h"
 #include "ccMacros.h"
 #include "CCSpriteFrame.h"
+#include "CCSprite.h"
+#include "CCScheduler.h"
+#include <math.h>
 
 namespace cocos2d
 {
@@ -163,4 +166,143 @@ namespace cocos2d
 		CCSpriteFrame *pFrame = CCSpriteFrame::frameWithTexture(pobTexture, rect);
 		m_pobFrames->addObject(pFrame);
 	}
+
+	// implementation of CCAnimationGroup
+
+	CCAnimationGroup::CCAnimationGroup(void)
+		: m_pAnimation(NULL)
+		, m_pSprites(NULL)
+		, m_fElapsed(0)
+		, m_uFrameIndex(0)
+		, m_bIsRunning(false)
+	{
+	}
+
+	CCAnimationGroup::~CCAnimationGroup(void)
+	{
+		CCX_SAFE_RELEASE(m_pSprites);
+		CCX_SAFE_RELEASE(m_pAnimation);
+	}
+
+	CCAnimationGroup* CCAnimationGroup::groupWithAnimation(CCAnimation *pAnimation)
+	{
+		CCAnimationGroup *pGroup = new CCAnimationGroup();
+		if (pGroup->initWithAnimation(pAnimation))
+		{
+			pGroup->autorelease();
+			return pGroup;
+		}
+
+		CCX_SAFE_DELETE(pGroup);
+		return NULL;
+	}
+
+	bool CCAnimationGroup::initWithAnimation(CCAnimation *pAnimation)
+	{
+		assert(pAnimation != NULL);
+
+		CCX_SAFE_RETAIN(pAnimation);
+		CCX_SAFE_RELEASE(m_pAnimation);
+		m_pAnimation = pAnimation;
+
+		if (! m_pSprites)
+		{
+			m_pSprites = new NSMutableArray<CCSprite*>();
+		}
+
+		m_fElapsed = 0;
+		m_uFrameIndex = 0;
+
+		return true;
+	}
+
+	void CCAnimationGroup::addSprite(CCSprite *pSprite)
+	{
+		assert(pSprite != NULL);
+
+		m_pSprites->addObject(pSprite);
+
+		NSMutableArray<CCSpriteFrame*> *pFrames = m_pAnimation->getFrames();
+		if (m_uFrameIndex < pFrames->count())
+		{
+			pSprite->setDisplayFrame(pFrames->getObjectAtIndex(m_uFrameIndex));
+		}
+	}
+
+	void CCAnimationGroup::removeSprite(CCSprite *pSprite)
+	{
+		m_pSprites->removeObject(pSprite);
+	}
+
+	void CCAnimationGroup::removeAllSprites(void)
+	{
+		m_pSprites->removeAllObjects();
+	}
+
+	void CCAnimationGroup::start(void)
+	{
+		if (! m_bIsRunning)
+		{
+			m_bIsRunning = true;
+			CCScheduler::sharedScheduler()->scheduleUpdateForTarget(this, 0, false);
+		}
+	}
+
+	void CCAnimationGroup::stop(void)
+	{
+		if (m_bIsRunning)
+		{
+			m_bIsRunning = false;
+			CCScheduler::sharedScheduler()->unscheduleUpdateForTarget(this);
+		}
+	}
+
+	void CCAnimationGroup::update(ccTime dt)
+	{
+		NSMutableArray<CCSpriteFrame*> *pFrames = m_pAnimation->getFrames();
+		unsigned int numberOfFrames = pFrames->count();
+		float fDuration = numberOfFrames * m_pAnimation->getDelay();
+
+		if (numberOfFrames == 0 || fDuration <= 0)
+		{
+			return;
+		}
+
+		// wrap the clock so that it doesn't lose precision
+		m_fElapsed += dt;
+		if (m_fElapsed >= fDuration)
+		{
+			m_fElapsed = fmodf(m_fElapsed, fDuration);
+		}
+
+		unsigned int idx = (unsigned int)(m_fElapsed / m_pAnimation->getDelay());
+		if (idx >= numberOfFrames)
+		{
+			idx = numberOfFrames - 1;
+		}
+
+		if (idx == m_uFrameIndex)
+		{
+			return;
+		}
+
+		m_uFrameIndex = idx;
+
+		CCSpriteFrame *pFrame = pFrames->getObjectAtIndex(idx);
+		NSMutableArray<CCSprite*>::NSMutableArrayIterator iter;
+		for (iter = m_pSprites->begin(); iter != m_pSprites->end(); ++iter)
+		{
+			(*iter)->setDisplayFrame(pFrame);
+		}
+	}
+
+	void CCAnimationGroup::selectorProtocolRetain(void)
+	{
+		retain();
+	}
+
+	void CCAnimationGroup::selectorProtocolRelease(void)
+	{
+		release();
+	}
 }
\ No newline at end of file
@@ -49,7 +49,7 @@ namespace cocos2d
 
 	bool CCAnimationCache::init()
 	{
-		m_pAnimations = new NSMutableDictionary<std::string, CCAnimation*>();
+		m_pAnimations = new NSMutableDictionary<CCXInternedString, CCAnimation*>();
 		return true;
 	}
 
@@ -66,7 +66,7 @@ namespace cocos2d
 
 	void CCAnimationCache::addAnimation(CCAnimation *animation, const char * name)
 	{
-		m_pAnimations->setObject(animation, std::string(name));
+		m_pAnimations->setObject(animation, CCXInternedString(name));
 	}
 
 	void CCAnimationCache::removeAnimationByName(const char* name)
@@ -76,11 +76,21 @@ namespace cocos2d
 			return;
 		}
 
-		m_pAnimations->removeObjectForKey(std::string(name));
+		m_pAnimations->removeObjectForKey(name);
 	}
 
 	CCAnimation* CCAnimationCache::animationByName(const char* name)
 	{
-		return m_pAnimations->objectForKey(std::string(name));
+		return m_pAnimations->objectForKey(name);
+	}
+
+	CCAnimation* CCAnimationCache::animationByName(const CCXInternedString& name)
+	{
+		if (! name.c_str())
+		{
+			return NULL;
+		}
+
+		return m_pAnimations->objectForKey(name);
 	}
 }
\ No newline at end of file
@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "CGGeometry.h"
 #include "CCTexture2D.h"
 #include "CGAffineTransform.h"
+#include "CCDirector.h"
 
 #include <string.h>
 
@@ -187,6 +188,8 @@ bool CCSprite::init(void)
 
 	m_eHonorParentTransform = CC_HONOR_PARENT_TRANSFORM_ALL;
 	m_bHasChildren = false;
+	m_bIsVisibleInBatch = true;
+	m_tTransformToBatch = CGAffineTransformIdentity;
 
 	// Atlas: Color
 	ccColor4B tmpColor = { 255, 255, 255, 255 };
@@ -372,6 +375,12 @@ void CCSprite::setTextureRectInPixels(CGRect rect, bool rotated, CGSize size)
 	setContentSizeInPixels(size);
 	updateTextureCoords(m_obRectInPixels);
 
+	updateRectVertices(ccp((m_tContentSizeInPixels.width - m_obRectInPixels.size.width) / 2,
+		(m_tContentSizeInPixels.height - m_obRectInPixels.size.height) / 2));
+}
+
+void CCSprite::updateRectVertices(CGPoint trimOffsetInPixels)
+{
 	CGPoint relativeOffsetInPixels = m_obUnflippedOffsetPositionFromCenter;
 
 	// issue #732
@@ -384,8 +393,8 @@ void CCSprite::setTextureRectInPixels(CGRect rect, bool rotated, CGSize size)
 		relativeOffsetInPixels.y = -relativeOffsetInPixels.y;
 	}
 
-	m_obOffsetPositionInPixels.x = relativeOffsetInPixels.x + (m_tContentSizeInPixels.width - m_obRectInPixels.size.width) / 2;
-	m_obOffsetPositionInPixels.y = relativeOffsetInPixels.y + (m_tContentSizeInPixels.height - m_obRectInPixels.size.height) / 2;
+	m_obOffsetPositionInPixels.x = relativeOffsetInPixels.x + trimOffsetInPixels.x;
+	m_obOffsetPositionInPixels.y = relativeOffsetInPixels.y + trimOffsetInPixels.y;
 
 	// rendering using SpriteSheet
 	if (m_bUsesBatchNode)
@@ -411,6 +420,18 @@ void CCSprite::setTextureRectInPixels(CGRect rect, bool rotated, CGSize size)
 	}
 }
 
+void CCSprite::setTextureCoords(const ccTex2F *pTexCoords)
+{
+	// pTexCoords is in the order bl, br, tl, tr.
+	// flipping in x swaps bl with br and tl with tr, flipping in y swaps bl with tl and br with tr,
+	// whether the rect is rotated or not
+	unsigned int uFlip = (m_bFlipX ? 1 : 0) | (m_bFlipY ? 2 : 0);
+
+	m_sQuad.bl.texCoords = pTexCoords[0 ^ uFlip];
+	m_sQuad.br.texCoords = pTexCoords[1 ^ uFlip];
+	m_sQuad.tl.texCoords = pTexCoords[2 ^ uFlip];
+	m_sQuad.tr.texCoords = pTexCoords[3 ^ uFlip];
+}
 
 void CCSprite::updateTextureCoords(CGRect rect)
 {
@@ -511,6 +532,7 @@ void CCSprite::updateTransform(void)
 		m_sQuad.br.vertices = m_sQuad.tl.vertices = m_sQuad.tr.vertices = m_sQuad.bl.vertices = vertex3(0,0,0);
 		m_pobTextureAtlas->updateQuad(&m_sQuad, m_uAtlasIndex);
 		m_bDirty = m_bRecursiveDirty = false;
+		m_bIsVisibleInBatch = false;
 		return;
 	}
 
@@ -518,66 +540,152 @@ void CCSprite::updateTransform(void)
 	// build Affine transform manually
 	if (! m_pParent || m_pParent == m_pobBatchNode)
 	{
-		float radians = -CC_DEGREES_TO_RADIANS(m_fRotation);
-		float c = cosf(radians);
-		float s = sinf(radians);
-
-        matrix = CGAffineTransformMake(c * m_fScaleX, s * m_fScaleX,
-			-s * m_fScaleY, c * m_fScaleY,
-			m_tPositionInPixels.x, m_tPositionInPixels.y);
-		matrix = CGAffineTransformTranslate(matrix, -m_tAnchorPointInPixels.x, -m_tAnchorPointInPixels.y);
+		matrix = localTransformInBatch();
 	} else // parent_ != batchNode_ 
 	{
 		// else do affine transformation according to the HonorParentTransform
-		matrix = CGAffineTransformIdentity;
-		ccHonorParentTransform prevHonor = CC_HONOR_PARENT_TRANSFORM_ALL;
+		// If any of the parents are not visible, then don't draw this node
+		if (! transformToBatchFromAncestors(&matrix))
+		{
+			m_sQuad.br.vertices = m_sQuad.tl.vertices = m_sQuad.tr.vertices = m_sQuad.bl.vertices = vertex3(0,0,0);
+			m_pobTextureAtlas->updateQuad(&m_sQuad, m_uAtlasIndex);
+			m_bDirty = m_bRecursiveDirty = false;
+			m_bIsVisibleInBatch = false;
+
+			return;
+		}
+	}
+
+	updateQuadVertices(matrix);
+
+	m_pobTextureAtlas->updateQuad(&m_sQuad, m_uAtlasIndex);
+	m_bDirty = m_bRecursiveDirty = false;
+	m_bIsVisibleInBatch = true;
+	m_tTransformToBatch = matrix;
+}
+
+void CCSprite::updateTransformRecursively(void)
+{
+	assert(m_bUsesBatchNode);
+
+	// a sprite whose ancestors changed is dirty too (SET_DIRTY_RECURSIVELY),
+	// so the transform cached by a clean parent is up to date
+	if (m_bDirty)
+	{
+		CCSprite *pParent = (! m_pParent || m_pParent == m_pobBatchNode) ? NULL : (CCSprite*)m_pParent;
 
-		for (CCNode *p = this; p && p != m_pobBatchNode; p = p->getParent())
+		m_bIsVisibleInBatch = m_bIsVisible && (! pParent || pParent->m_bIsVisibleInBatch);
+
+		if (! m_bIsVisibleInBatch)
+		{
+			m_sQuad.br.vertices = m_sQuad.tl.vertices = m_sQuad.tr.vertices = m_sQuad.bl.vertices = vertex3(0,0,0);
+		}
+		else
 		{
-			// Might happen. Issue #1053
-			// how to implement, we can not use dynamic
-			// NSAssert( [p isKindOfClass:[CCSprite class]], @"CCSprite should be a CCSprite subclass. Probably you initialized an sprite with a batchnode, but you didn't add it to the batch node." );
-			struct transformValues_ tv;
-			((CCSprite*)p)->getTransformValues(&tv);
-
-			// If any of the parents are not visible, then don't draw this node
-			if (! tv.visible)
+			if (! pParent)
 			{
-				m_sQuad.br.vertices = m_sQuad.tl.vertices = m_sQuad.tr.vertices = m_sQuad.bl.vertices = vertex3(0,0,0);
-				m_pobTextureAtlas->updateQuad(&m_sQuad, m_uAtlasIndex);
-				m_bDirty = m_bRecursiveDirty = false;
-
-				return;
+				m_tTransformToBatch = localTransformInBatch();
 			}
-
-			CGAffineTransform newMatrix = CGAffineTransformIdentity;
-
-			// 2nd: Translate, Rotate, Scale
-			if( prevHonor & CC_HONOR_PARENT_TRANSFORM_TRANSLATE )
+			else if (m_eHonorParentTransform == CC_HONOR_PARENT_TRANSFORM_ALL)
 			{
-				newMatrix = CGAffineTransformTranslate(newMatrix, tv.pos.x, tv.pos.y);
+				m_tTransformToBatch = CGAffineTransformConcat(localTransformInBatch(), pParent->m_tTransformToBatch);
 			}
-
-			if( prevHonor & CC_HONOR_PARENT_TRANSFORM_ROTATE )
+			else
 			{
-				newMatrix = CGAffineTransformRotate(newMatrix, -CC_DEGREES_TO_RADIANS(tv.rotation));
+				// only part of the parent transform applies, and the parent's cache holds all of it
+				transformToBatchFromAncestors(&m_tTransformToBatch);
 			}
 
-			if( prevHonor & CC_HONOR_PARENT_TRANSFORM_SCALE ) 
+			updateQuadVertices(m_tTransformToBatch);
+		}
+
+		// the quad is already in the atlas. updateQuad would also write the quad count,
+		// which other threads may be doing at the same time
+		m_pobTextureAtlas->getQuads()[m_uAtlasIndex] = m_sQuad;
+		m_bDirty = m_bRecursiveDirty = false;
+	}
+
+	if (m_bHasChildren)
+	{
+		// don't use getChildren(), it may sort the children and this can run on a worker thread
+		NSMutableArray<CCNode*>::NSMutableArrayIterator iter;
+		for (iter = m_pChildren->begin(); iter != m_pChildren->end(); ++iter)
+		{
+			if (! *iter)
 			{
-				newMatrix = CGAffineTransformScale(newMatrix, tv.scale.x, tv.scale.y);
+				break;
 			}
 
-			// 3rd: Translate anchor point
-			newMatrix = CGAffineTransformTranslate(newMatrix, -tv.ap.x, -tv.ap.y);
+			((CCSprite*)(*iter))->updateTransformRecursively();
+		}
+	}
+}
 
-			// 4th: Matrix multiplication
-			matrix = CGAffineTransformConcat( matrix, newMatrix);
+CGAffineTransform CCSprite::localTransformInBatch(void)
+{
+	float radians = -CC_DEGREES_TO_RADIANS(m_fRotation);
+	float c = cosf(radians);
+	float s = sinf(radians);
+
+	CGAffineTransform matrix = CGAffineTransformMake(c * m_fScaleX, s * m_fScaleX,
+		-s * m_fScaleY, c * m_fScaleY,
+		m_tPositionInPixels.x, m_tPositionInPixels.y);
+
+	return CGAffineTransformTranslate(matrix, -m_tAnchorPointInPixels.x, -m_tAnchorPointInPixels.y);
+}
+
+bool CCSprite::transformToBatchFromAncestors(CGAffineTransform *pMatrix)
+{
+	CGAffineTransform matrix = CGAffineTransformIdentity;
+	ccHonorParentTransform prevHonor = CC_HONOR_PARENT_TRANSFORM_ALL;
 
-			prevHonor = ((CCSprite*)p)->getHornorParentTransform();
+	for (CCNode *p = this; p && p != m_pobBatchNode; p = p->getParent())
+	{
+		// Might happen. Issue #1053
+		// how to implement, we can not use dynamic
+		// NSAssert( [p isKindOfClass:[CCSprite class]], @"CCSprite should be a CCSprite subclass. Probably you initialized an sprite with a batchnode, but you didn't add it to the batch node." );
+		struct transformValues_ tv;
+		((CCSprite*)p)->getTransformValues(&tv);
+
+		// If any of the parents are not visible, then don't draw this node
+		if (! tv.visible)
+		{
+			return false;
 		}
+
+		CGAffineTransform newMatrix = CGAffineTransformIdentity;
+
+		// 2nd: Translate, Rotate, Scale
+		if( prevHonor & CC_HONOR_PARENT_TRANSFORM_TRANSLATE )
+		{
+			newMatrix = CGAffineTransformTranslate(newMatrix, tv.pos.x, tv.pos.y);
+		}
+
+		if( prevHonor & CC_HONOR_PARENT_TRANSFORM_ROTATE )
+		{
+			newMatrix = CGAffineTransformRotate(newMatrix, -CC_DEGREES_TO_RADIANS(tv.rotation));
+		}
+
+		if( prevHonor & CC_HONOR_PARENT_TRANSFORM_SCALE ) 
+		{
+			newMatrix = CGAffineTransformScale(newMatrix, tv.scale.x, tv.scale.y);
+		}
+
+		// 3rd: Translate anchor point
+		newMatrix = CGAffineTransformTranslate(newMatrix, -tv.ap.x, -tv.ap.y);
+
+		// 4th: Matrix multiplication
+		matrix = CGAffineTransformConcat( matrix, newMatrix);
+
+		prevHonor = ((CCSprite*)p)->getHornorParentTransform();
 	}
 
+	*pMatrix = matrix;
+	return true;
+}
+
+void CCSprite::updateQuadVertices(const CGAffineTransform& matrix)
+{
 	//
 	// calculate the Quad based on the Affine Matrix
 	//
@@ -611,9 +719,6 @@ void CCSprite::updateTransform(void)
 	m_sQuad.br.vertices = vertex3((float)RENDER_IN_SUBPIXEL(bx), (float)RENDER_IN_SUBPIXEL(by), m_fVertexZ);
 	m_sQuad.tl.vertices = vertex3((float)RENDER_IN_SUBPIXEL(dx), (float)RENDER_IN_SUBPIXEL(dy), m_fVertexZ);
 	m_sQuad.tr.vertices = vertex3((float)RENDER_IN_SUBPIXEL(cx), (float)RENDER_IN_SUBPIXEL(cy), m_fVertexZ);
-
-	m_pobTextureAtlas->updateQuad(&m_sQuad, m_uAtlasIndex);
-	m_bDirty = m_bRecursiveDirty = false;
 }
 
 // XXX: Optimization: instead of calling 5 times the parent sprite to obtain: position, scale.x, scale.y, anchorpoint and rotation,
@@ -634,6 +739,17 @@ void CCSprite::draw(void)
 {
 	assert(! m_bUsesBatchNode);
 
+	if (CCDirector::sharedDirector()->isCullingActive())
+	{
+		bool bCulled = isRectCulled(CGRectMake(0, 0, m_tContentSizeInPixels.width, m_tContentSizeInPixels.height));
+		CCDirector::sharedDirector()->addCullingStats(1, bCulled ? 1 : 0);
+
+		if (bCulled)
+		{
+			return;
+		}
+	}
+
 	// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
 	// Needed states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
 	// Unneeded states: -
@@ -986,7 +1102,21 @@ void CCSprite::setDisplayFrame(CCSpriteFrame *pNewFrame)
 
 	// update rect
 	m_bRectRotated = pNewFrame->isRotated();
-	setTextureRectInPixels(pNewFrame->getRectInPixels(), pNewFrame->isRotated(), pNewFrame->getOriginalSizeInPixels());
+
+	CCTexture2D *tex = m_bUsesBatchNode ? m_pobTextureAtlas->getTexture() : m_pobTexture;
+	if (tex != pNewFrame->getTexture())
+	{
+		setTextureRectInPixels(pNewFrame->getRectInPixels(), pNewFrame->isRotated(), pNewFrame->getOriginalSizeInPixels());
+		return;
+	}
+
+	// the frame caches its texture coordinates and its trim offset, they are only copied
+	m_obRectInPixels = pNewFrame->getRectInPixels();
+	m_obRect = CC_RECT_PIXELS_TO_POINTS(m_obRectInPixels);
+
+	setContentSizeInPixels(pNewFrame->getOriginalSizeInPixels());
+	setTextureCoords(pNewFrame->getTexCoords());
+	updateRectVertices(pNewFrame->getTrimOffsetInPixels());
 }
 
 // XXX deprecated
@@ -997,7 +1127,7 @@ void CCSprite::setDisplayFrame(const char *pszAnimationName, int nFrameIndex)
 		initAnimationDictionary();
 	}
 
-	CCAnimation *pAnimation = m_pAnimations->objectForKey(std::string(pszAnimationName));
+	CCAnimation *pAnimation = m_pAnimations->objectForKey(pszAnimationName);
 	CCSpriteFrame *pFrame = pAnimation->getFrames()->getObjectAtIndex(nFrameIndex);
 
 	assert(pFrame);
@@ -1048,7 +1178,7 @@ CCAnimation* CCSprite::animationByName(const char *pszAnimationName)
 {
 	assert(pszAnimationName != NULL);
 
-	return m_pAnimations->objectForKey(std::string(pszAnimationName));
+	return m_pAnimations->objectForKey(pszAnimationName);
 }
 
 // Texture protocol
@@ -28,11 +28,26 @@ THE SOFTWARE.
 #include "CCDrawingPrimitives.h"
 #include "CCTextureCache.h"
 #include "CGPointExtension.h"
+#include "platform/CCXThread.h"
+#include "CCDirector.h"
 
 namespace cocos2d
 {
 	const int defaultCapacity = 29;
 
+	static unsigned int s_uParallelTransformThreshold = 0;
+
+	// pData is the first child of the batch node
+	static void updateTransformsInRange(void *pData, unsigned int uBegin, unsigned int uEnd)
+	{
+		CCNode **ppChildren = (CCNode**)pData;
+
+		for (unsigned int i = uBegin; i < uEnd; ++i)
+		{
+			((CCSprite*)ppChildren[i])->updateTransformRecursively();
+		}
+	}
+
 	/*
 	* creation with CCTexture2D
 	*/
@@ -111,6 +126,9 @@ namespace cocos2d
 		m_pChildren = new NSMutableArray<CCNode*>();
 		m_pobDescendants = new NSMutableArray<CCSprite*>();
 
+		m_bIsUnordered = false;
+		m_bIsUnorderedActive = false;
+
 		return true;
 	}
 
@@ -192,6 +210,17 @@ namespace cocos2d
 		// check CCSprite is using the same texture id
 		assert(pSprite->getTexture()->getName() == m_pobTextureAtlas->getTexture()->getName());
 
+		// an unordered batch node only holds childless sprites of the same z order
+		if (m_bIsUnorderedActive)
+		{
+			NSMutableArray<CCNode*> *pGrandChildren = pSprite->getChildren();
+			if ((pGrandChildren && pGrandChildren->count() > 0)
+				|| (m_pChildren->count() > 0 && m_pChildren->getObjectAtIndex(0)->getZOrder() != zOrder))
+			{
+				rebuildOrderedAtlas();
+			}
+		}
+
 		CCNode::addChild(child, zOrder, tag);
 
 		unsigned int uIndex = atlasIndexForChild(pSprite, zOrder);
@@ -237,12 +266,41 @@ namespace cocos2d
 			return;
 		}
 
+		if (m_bIsUnorderedActive)
+		{
+			assert(pSprite->getParent() == this);
+
+			// move the sprite to the end of the children, removeSpriteFromAtlas does the same with its quad
+			unsigned int uIndex = pSprite->getAtlasIndex();
+			unsigned int uLast = m_pobDescendants->count() - 1;
+			if (uIndex != uLast)
+			{
+				CCNode *pLast = m_pChildren->getObjectAtIndex(uLast);
+
+				pSprite->retain();
+				m_pChildren->replaceObjectAtIndex(uIndex, pLast);
+				m_pChildren->replaceObjectAtIndex(uLast, pSprite);
+				pSprite->release();
+			}
+
+			removeSpriteFromAtlas(pSprite);
+
+			// the sprite is the last child now, no need to search for it
+			detachChild(pSprite, cleanup);
+			return;
+		}
+
 		assert(m_pChildren->containsObject(pSprite));
 
 		// cleanup before removing
 		removeSpriteFromAtlas(pSprite);
 
 		CCNode::removeChild(pSprite, cleanup);
+
+		if (m_pobDescendants->count() == 0)
+		{
+			m_bIsUnorderedActive = m_bIsUnordered;
+		}
 	}
 
 	void CCSpriteBatchNode::removeChildAtIndex(unsigned int uIndex, bool bDoCleanup)
@@ -274,6 +332,8 @@ namespace cocos2d
 
 		m_pobDescendants->removeAllObjects();
 		m_pobTextureAtlas->removeAllQuads();
+
+		m_bIsUnorderedActive = m_bIsUnordered;
 	}
 
 	// draw
@@ -285,10 +345,27 @@ namespace cocos2d
 			return;
 		}
 
+		unsigned int uCount = m_pChildren->count();
+		if (uCount > 0)
+		{
+			// update the transforms from the top of the hierarchy down, each one is computed once.
+			// subtrees use disjoint quads, so they can be split between threads
+			if (s_uParallelTransformThreshold > 0 && m_pobDescendants->count() >= s_uParallelTransformThreshold)
+			{
+				ccxParallelFor(updateTransformsInRange, &(*m_pChildren->begin()), uCount);
+			}
+			else
+			{
+				updateTransformsInRange(&(*m_pChildren->begin()), 0, uCount);
+			}
+		}
+
+#if CC_SPRITESHEET_DEBUG_DRAW
 		if (m_pobDescendants && m_pobDescendants->count() > 0)
 		{
 			CCSprite *pSprite;
 			NSMutableArray<CCSprite*>::NSMutableArrayIterator iter;
+			ccDrawBeginBatch();
 			for (iter = m_pobDescendants->begin(); iter != m_pobDescendants->end(); ++iter)
 			{
 				pSprite = *iter;
@@ -298,11 +375,6 @@ namespace cocos2d
 					break;
 				}
 
-                // fast dispatch
-				pSprite->updateTransform();
-
-
-#if CC_SPRITESHEET_DEBUG_DRAW
 				// issue #528
 				CGRect rect = pSprite->boundingBox();
 				CGPoint vertices[4]={
@@ -312,9 +384,10 @@ namespace cocos2d
 					ccp(rect.origin.x,rect.origin.y+rect.size.height),
 				};
 				ccDrawPoly(vertices, 4, true);
-#endif // CC_SPRITESHEET_DEBUG_DRAW
 			}
+			ccDrawEndBatch();
 		}
+#endif // CC_SPRITESHEET_DEBUG_DRAW
 
 		// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
 		// Needed states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
@@ -325,7 +398,19 @@ namespace cocos2d
 			glBlendFunc(m_blendFunc.src, m_blendFunc.dst);
 		}
 
-		m_pobTextureAtlas->drawQuads();
+		// the quads are in the coordinates of the batch node
+		CGRect visibleRect;
+		if (visibleRectInNodeSpace(&visibleRect))
+		{
+			unsigned int uTotalQuads = m_pobTextureAtlas->getTotalQuads();
+			unsigned int uDrawn = m_pobTextureAtlas->drawNumberOfQuadsInRect(uTotalQuads, visibleRect);
+			CCDirector::sharedDirector()->addCullingStats(uTotalQuads, uTotalQuads - uDrawn);
+		}
+		else
+		{
+			m_pobTextureAtlas->drawQuads();
+		}
+
 		if (newBlend)
 		{
 			glBlendFunc(CC_BLEND_SRC, CC_BLEND_DST);
@@ -434,6 +519,18 @@ namespace cocos2d
 
 	unsigned int CCSpriteBatchNode::atlasIndexForChild(CCSprite *pobSprite, int nZ)
 	{
+		if (m_bIsUnorderedActive)
+		{
+			// addChild already checked the z order, append the sprite
+			if (pobSprite->getParent() == this)
+			{
+				return m_pobDescendants->count();
+			}
+
+			// a sprite is being added to one of the children
+			rebuildOrderedAtlas();
+		}
+
 		NSMutableArray<CCNode*> *pBrothers = pobSprite->getParent()->getChildren();
 		unsigned int uChildIndex = pBrothers->getIndexOfObject(pobSprite);
 
@@ -509,26 +606,13 @@ namespace cocos2d
 
 		m_pobDescendants->insertObjectAtIndex(pobSprite, uIndex);
 
-		// update indices
-		unsigned int i = 0;
-		if (m_pobDescendants && m_pobDescendants->count() > 0)
+		// update indices of the sprites after the new one
+		unsigned int uCount = m_pobDescendants->count();
+		for (unsigned int i = uIndex + 1; i < uCount; ++i)
 		{
-			NSMutableArray<CCSprite*>::NSMutableArrayIterator iter;
-			for (iter = m_pobDescendants->begin(); iter != m_pobDescendants->end(); ++iter)
-			{
-				if (! *iter)
-				{
-					break;
-				}
-
-				if (i > uIndex)
-				{
-					(*iter)->setAtlasIndex((*iter)->getAtlasIndex() + 1);
-				}
-
-				++i;
-			}
-		}	
+			CCSprite *pSprite = m_pobDescendants->getObjectAtIndex(i);
+			pSprite->setAtlasIndex(pSprite->getAtlasIndex() + 1);
+		}
 
 		// add children recursively
 		NSMutableArray<CCNode*> *pChildren = pobSprite->getChildren();
@@ -553,6 +637,30 @@ namespace cocos2d
 
 	void CCSpriteBatchNode::removeSpriteFromAtlas(CCSprite *pobSprite)
 	{
+		if (m_bIsUnorderedActive)
+		{
+			unsigned int uIndex = pobSprite->getAtlasIndex();
+			unsigned int uLast = m_pobDescendants->count() - 1;
+
+			// Cleanup sprite. It might be reused (issue #569)
+			pobSprite->useSelfRender();
+
+			// fill the slot with the last sprite instead of shifting all the following ones
+			if (uIndex != uLast)
+			{
+				CCSprite *pLast = m_pobDescendants->getObjectAtIndex(uLast);
+				ccV3F_C4B_T2F_Quad *pQuads = m_pobTextureAtlas->getQuads();
+
+				pQuads[uIndex] = pQuads[uLast];
+				pLast->setAtlasIndex(uIndex);
+				m_pobDescendants->replaceObjectAtIndex(uIndex, pLast);
+			}
+
+			m_pobTextureAtlas->removeQuadAtIndex(uLast);
+			m_pobDescendants->removeLastObject();
+			return;
+		}
+
 		// remove from TextureAtlas
 		m_pobTextureAtlas->removeQuadAtIndex(pobSprite->getAtlasIndex());
 
@@ -594,6 +702,94 @@ namespace cocos2d
 		}
 	}
 
+	void CCSpriteBatchNode::setIsUnordered(bool bUnordered)
+	{
+		m_bIsUnordered = bUnordered;
+
+		if (! bUnordered)
+		{
+			rebuildOrderedAtlas();
+			return;
+		}
+
+		if (m_bIsUnorderedActive)
+		{
+			return;
+		}
+
+		// the current layout can be kept if it only holds childless sprites of the same z order
+		NSMutableArray<CCNode*> *pChildren = getChildren();
+		unsigned int uCount = m_pobDescendants->count();
+		if (uCount != pChildren->count())
+		{
+			return;
+		}
+
+		for (unsigned int i = 0; i < uCount; ++i)
+		{
+			CCSprite *pSprite = (CCSprite*)(pChildren->getObjectAtIndex(i));
+
+			if (pSprite->getZOrder() != pChildren->getObjectAtIndex(0)->getZOrder()
+				|| pSprite->getAtlasIndex() != i
+				|| m_pobDescendants->getObjectAtIndex(i) != pSprite)
+			{
+				return;
+			}
+		}
+
+		m_bIsUnorderedActive = true;
+	}
+
+	bool CCSpriteBatchNode::getIsUnordered(void)
+	{
+		return m_bIsUnordered;
+	}
+
+	void CCSpriteBatchNode::setParallelTransformThreshold(unsigned int uSprites)
+	{
+		s_uParallelTransformThreshold = uSprites;
+	}
+
+	unsigned int CCSpriteBatchNode::getParallelTransformThreshold(void)
+	{
+		return s_uParallelTransformThreshold;
+	}
+
+	void CCSpriteBatchNode::rebuildOrderedAtlas(void)
+	{
+		if (! m_bIsUnorderedActive)
+		{
+			return;
+		}
+
+		m_bIsUnorderedActive = false;
+
+		unsigned int uCount = m_pobDescendants->count();
+		if (uCount < 2)
+		{
+			return;
+		}
+
+		// sprites of the same z order go back to the order in which they were added
+		m_bIsReorderChildDirty = true;
+		sortAllChildren();
+
+		ccV3F_C4B_T2F_Quad *pQuads = m_pobTextureAtlas->getQuads();
+		ccV3F_C4B_T2F_Quad *pOldQuads = new ccV3F_C4B_T2F_Quad[uCount];
+		memcpy(pOldQuads, pQuads, sizeof(pQuads[0]) * uCount);
+
+		for (unsigned int i = 0; i < uCount; ++i)
+		{
+			CCSprite *pSprite = (CCSprite*)(m_pChildren->getObjectAtIndex(i));
+
+			pQuads[i] = pOldQuads[pSprite->getAtlasIndex()];
+			pSprite->setAtlasIndex(i);
+			m_pobDescendants->replaceObjectAtIndex(i, pSprite);
+		}
+
+		CCX_SAFE_DELETE_ARRAY(pOldQuads);
+	}
+
 	void CCSpriteBatchNode::updateBlendFunc(void)
 	{
 		if (! m_pobTextureAtlas->getTexture()->getHasPremultipliedAlpha())
@@ -634,6 +830,9 @@ namespace cocos2d
         NSAssert( sprite != NULL, "Argument must be non-nil");
         /// @todo NSAssert( [sprite isKindOfClass:[CCSprite class]], @"CCSpriteSheet only supports CCSprites as children");
 
+        // the quad index is chosen by the caller, leave the unordered mode until the batch node is empty
+        rebuildOrderedAtlas();
+
         while(index >= m_pobTextureAtlas->getCapacity() || m_pobTextureAtlas->getCapacity() == m_pobTextureAtlas->getTotalQuads())
         {
             this->increaseAtlasCapacity();
@@ -658,6 +857,9 @@ namespace cocos2d
         NSAssert( child != NULL, "Argument must be non-nil");
         /// @todo NSAssert( [child isKindOfClass:[CCSprite class]], @"CCSpriteSheet only supports CCSprites as children");
 
+        // the quad index is chosen by the caller, leave the unordered mode until the batch node is empty
+        rebuildOrderedAtlas();
+
         // quad index is Z
         child->setAtlasIndex(z);
 
@@ -23,6 +23,8 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "CCSpriteFrame.h"
+#include "CCTexture2D.h"
+#include "ccConfig.h"
 
 namespace   cocos2d {
 // implementation of CCSpriteFrame
@@ -62,9 +64,91 @@ bool CCSpriteFrame::initWithTexture(CCTexture2D* pobTexture, CGRect rect, bool r
 
 	m_obOriginalSizeInPixels = originalSize;
 
+	m_bIsQuadDirty = true;
+
 	return true;
 }
 
+const ccTex2F* CCSpriteFrame::getTexCoords(void)
+{
+	if (m_bIsQuadDirty)
+	{
+		updateQuad();
+	}
+
+	return m_tTexCoords;
+}
+
+CGPoint CCSpriteFrame::getTrimOffsetInPixels(void)
+{
+	if (m_bIsQuadDirty)
+	{
+		updateQuad();
+	}
+
+	return m_obTrimOffsetInPixels;
+}
+
+// same computations as CCSprite::updateTextureCoords and CCSprite::setTextureRectInPixels
+void CCSpriteFrame::updateQuad(void)
+{
+	m_bIsQuadDirty = false;
+
+	m_obTrimOffsetInPixels.x = (m_obOriginalSizeInPixels.width - m_obRectInPixels.size.width) / 2;
+	m_obTrimOffsetInPixels.y = (m_obOriginalSizeInPixels.height - m_obRectInPixels.size.height) / 2;
+
+	if (! m_pobTexture)
+	{
+		memset(m_tTexCoords, 0, sizeof(m_tTexCoords));
+		return;
+	}
+
+	float atlasWidth = (float)m_pobTexture->getPixelsWide();
+	float atlasHeight = (float)m_pobTexture->getPixelsHigh();
+	CGRect rect = m_obRectInPixels;
+
+	float left, right, top, bottom;
+
+	if (m_bRotated)
+	{
+#if CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+		left	= (2*rect.origin.x+1)/(2*atlasWidth);
+		right	= left+(rect.size.height*2-2)/(2*atlasWidth);
+		top		= (2*rect.origin.y+1)/(2*atlasHeight);
+		bottom	= top+(rect.size.width*2-2)/(2*atlasHeight);
+#else
+		left	= rect.origin.x/atlasWidth;
+		right	= left+(rect.size.height/atlasWidth);
+		top		= rect.origin.y/atlasHeight;
+		bottom	= top+(rect.size.width/atlasHeight);
+#endif // CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+
+		m_tTexCoords[0] = tex2(left, top);		// bl
+		m_tTexCoords[1] = tex2(left, bottom);	// br
+		m_tTexCoords[2] = tex2(right, top);		// tl
+		m_tTexCoords[3] = tex2(right, bottom);	// tr
+	}
+	else
+	{
+#if CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+		left	= (2*rect.origin.x+1)/(2*atlasWidth);
+		right	= left + (rect.size.width*2-2)/(2*atlasWidth);
+		top		= (2*rect.origin.y+1)/(2*atlasHeight);
+		bottom	= top + (rect.size.height*2-2)/(2*atlasHeight);
+#else
+		left	= rect.origin.x/atlasWidth;
+		right	= left + rect.size.width/atlasWidth;
+		top		= rect.origin.y/atlasHeight;
+		bottom	= top + rect.size.height/atlasHeight;
+#endif // ! CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+
+		m_tTexCoords[0] = tex2(left, bottom);	// bl
+		m_tTexCoords[1] = tex2(right, bottom);	// br
+		m_tTexCoords[2] = tex2(left, top);		// tl
+		m_tTexCoords[3] = tex2(right, top);		// tr
+	}
+}
+
 CCSpriteFrame::~CCSpriteFrame(void)
 {
 	CCLOGINFO("cocos2d: deallocing %p", this);
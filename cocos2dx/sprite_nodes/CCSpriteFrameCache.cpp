@@ -76,8 +76,8 @@ void CCSpriteFrameCache::addSpriteFramesWithDictionary(NSDictionary<std::string,
 	ZWTCoordinatesFormatOptionXML1_2 = 3, // Desktop Version 1.0.2+
 	*/
 
-	NSDictionary<std::string, NSObject*> *metadataDict = (NSDictionary<std::string, NSObject*>*)dictionary->objectForKey(std::string("metadata"));
-	NSDictionary<std::string, NSObject*> *framesDict = (NSDictionary<std::string, NSObject*>*)dictionary->objectForKey(std::string("frames"));
+	NSDictionary<std::string, NSObject*> *metadataDict = (NSDictionary<std::string, NSObject*>*)dictionary->objectForKey("metadata");
+	NSDictionary<std::string, NSObject*> *framesDict = (NSDictionary<std::string, NSObject*>*)dictionary->objectForKey("frames");
 	int format = 0;
 
 	// get the format
@@ -164,7 +164,7 @@ void CCSpriteFrameCache::addSpriteFramesWithDictionary(NSDictionary<std::string,
 			bool textureRotated = atoi(valueForKey("textureRotated", frameDict)) == 0;
 
 			// get aliases
-			NSArray<NSString*> *aliases = NSArray<NSString*>dictionary->objectForKey(std::string("aliases"));
+			NSArray<NSString*> *aliases = NSArray<NSString*>dictionary->objectForKey("aliases");
 
 			while( alias = (NSDictionary<std::string, NSObject*>*)aliases->next(&key) )
 			{
@@ -213,9 +213,25 @@ void CCSpriteFrameCache::addSpriteFramesWithFile(const char *pszPlist)
 	const char *pszPath = CCFileUtils::fullPathFromRelativePath(pszPlist);
 	NSDictionary<std::string, NSObject*> *dict = CCFileUtils::dictionaryWithContentsOfFile(pszPath);
 	
+	string texturePath = texturePathForDictionary(dict, pszPath);
+
+	CCTexture2D *pTexture = CCTextureCache::sharedTextureCache()->addImage(texturePath.c_str());
+
+	if (pTexture)
+	{
+        addSpriteFramesWithDictionary(dict, pTexture);
+	}
+	else
+	{
+		CCLOG("cocos2d: CCSpriteFrameCache: Couldn't load texture");
+	}
+}
+
+std::string CCSpriteFrameCache::texturePathForDictionary(NSDictionary<std::string, NSObject*> *pobDictionary, const char *pszPlistPath)
+{
 	string texturePath("");
 
-	NSDictionary<std::string, NSObject*>* metadataDict = (NSDictionary<std::string, NSObject*>*)dict->objectForKey(string("metadata"));
+	NSDictionary<std::string, NSObject*>* metadataDict = (NSDictionary<std::string, NSObject*>*)pobDictionary->objectForKey("metadata");
     if (metadataDict)
 	{
 		// try to read  texture file name from meta data
@@ -227,7 +243,7 @@ void CCSpriteFrameCache::addSpriteFramesWithFile(const char *pszPlist)
 		// build texture path relative to plist file
 
 		// stringByDeletingLastPathComponent
-		string textureBase(pszPath);
+		string textureBase(pszPlistPath);
 		int indexOfLastSeperator = textureBase.find_last_of('/');
         if (indexOfLastSeperator == textureBase.length() - 1)
 		{
@@ -245,7 +261,7 @@ void CCSpriteFrameCache::addSpriteFramesWithFile(const char *pszPlist)
 	else
 	{
 		// build texture path by replacing file extension
-        texturePath = pszPath;
+        texturePath = pszPlistPath;
 
 		// remove .xxx
 		size_t startPos = texturePath.find_last_of("."); 
@@ -257,16 +273,7 @@ void CCSpriteFrameCache::addSpriteFramesWithFile(const char *pszPlist)
 		CCLOG("cocos2d: CCSpriteFrameCache: Trying to use file %s as texture", texturePath);
 	}
 
-	CCTexture2D *pTexture = CCTextureCache::sharedTextureCache()->addImage(texturePath.c_str());
-
-	if (pTexture)
-	{
-        addSpriteFramesWithDictionary(dict, pTexture);
-	}
-	else
-	{
-		CCLOG("cocos2d: CCSpriteFrameCache: Couldn't load texture");
-	}
+	return texturePath;
 }
 
 void CCSpriteFrameCache::addSpriteFrame(CCSpriteFrame *pobFrame, const char *pszFrameName)
@@ -306,7 +313,7 @@ void CCSpriteFrameCache::removeSpriteFrameByName(const char *pszName)
 	}
 
 	// Is this an alias ?
-	NSString *key = (NSString*)m_pSpriteFramesAliases->objectForKey(string(pszName));
+	NSString *key = (NSString*)m_pSpriteFramesAliases->objectForKey(pszName);
 
 	if (key)
 	{
@@ -315,7 +322,7 @@ void CCSpriteFrameCache::removeSpriteFrameByName(const char *pszName)
 	}
 	else
 	{
-        m_pSpriteFrames->removeObjectForKey(std::string(pszName));
+        m_pSpriteFrames->removeObjectForKey(pszName);
 	}
 }
 
@@ -329,7 +336,7 @@ void CCSpriteFrameCache::removeSpriteFramesFromFile(const char* plist)
 
 void CCSpriteFrameCache::removeSpriteFramesFromDictionary(NSDictionary<std::string, CCSpriteFrame*> *dictionary)
 {
-	NSDictionary<std::string, NSObject*>* framesDict = (NSDictionary<std::string, NSObject*>*)dictionary->objectForKey(string("frames"));
+	NSDictionary<std::string, NSObject*>* framesDict = (NSDictionary<std::string, NSObject*>*)dictionary->objectForKey("frames");
 	vector<string> keysToRemove;
 
 	framesDict->begin();
@@ -377,11 +384,11 @@ void CCSpriteFrameCache::removeSpriteFramesFromTexture(CCTexture2D* texture)
 
 CCSpriteFrame* CCSpriteFrameCache::spriteFrameByName(const char *pszName)
 {
-	CCSpriteFrame *frame = m_pSpriteFrames->objectForKey(std::string(pszName));
+	CCSpriteFrame *frame = m_pSpriteFrames->objectForKey(pszName);
 	if (! frame)
 	{
 		// try alias dictionary
-		NSString *key = (NSString*)m_pSpriteFramesAliases->objectForKey(string(pszName));  
+		NSString *key = (NSString*)m_pSpriteFramesAliases->objectForKey(pszName);  
 		if (key)
 		{
 			frame = m_pSpriteFrames->objectForKey(key->m_sString);
@@ -396,14 +403,14 @@ CCSpriteFrame* CCSpriteFrameCache::spriteFrameByName(const char *pszName)
 
 CCSprite* CCSpriteFrameCache::createSpriteWithFrameName(const char *pszName)
 {
-	CCSpriteFrame *frame = m_pSpriteFrames->objectForKey(std::string(pszName));
+	CCSpriteFrame *frame = m_pSpriteFrames->objectForKey(pszName);
 	return CCSprite::spriteWithSpriteFrame(frame);
 }
 const char * CCSpriteFrameCache::valueForKey(const char *key, NSDictionary<std::string, NSObject*> *dict)
 {
 	if (dict)
 	{
-		NSString *pString = (NSString*)dict->objectForKey(std::string(key));
+		NSString *pString = (NSString*)dict->objectForKey(key);
 		return pString ? pString->m_sString.c_str() : "";
 	}
 	return "";
@@ -28,6 +28,8 @@ THE SOFTWARE.
 Misc free functions
 */
 
+#include <math.h>
+
 namespace cocos2d
 {
 	/*
@@ -45,6 +47,28 @@ namespace cocos2d
 	*/
 
 	unsigned int ccNextPOT( unsigned int value );
+
+	/** returns an approximation of sinf(x), with an absolute error of about 0.001.
+	It has no branches and no table, it is meant for per vertex effects.
+	@since v0.99.5
+	*/
+	inline float ccFastSin(float x)
+	{
+		// wrap x into [-PI, PI]
+		x -= 6.28318531f * floorf(x * 0.159154943f + 0.5f);
+
+		// parabola through the zeros and the extremes, then one refinement step
+		float y = 1.27323954f * x - 0.405284735f * x * fabsf(x);
+		return 0.225f * (y * fabsf(y) - y) + y;
+	}
+
+	/** returns an approximation of cosf(x), see ccFastSin
+	@since v0.99.5
+	*/
+	inline float ccFastCos(float x)
+	{
+		return ccFastSin(x + 1.57079633f);
+	}
 }
 
 #endif // __SUPPORT_CC_UTILS_H__
@@ -0,0 +1,924 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "CCPlistParser.h"
+#include "NSString.h"
+#include "NSData.h"
+#include "NSMutableArray.h"
+#include "CCXFileUtils.h"
+#include "ccMacros.h"
+
+namespace   cocos2d {
+
+// deepest nesting of dictionaries and arrays accepted by the parser
+#define kCCPlistMaxDepth		128
+
+// the arena grows by blocks of this size, bigger requests get a block of their own
+#define kCCPlistBlockSize		(16 * 1024)
+
+// seconds between the unix epoch and the reference date of binary plists (2001-01-01)
+#define kCCPlistDateOffset		978307200.0
+
+struct CCPlistParser::Block
+{
+	Block			*pNext;
+	unsigned int	uUsed;
+	unsigned int	uCapacity;
+	double			dAlign;		///< the data that follows is 8 bytes aligned
+};
+
+CCPlistParser::CCPlistParser(void)
+: m_pBlocks(NULL)
+, m_pData(NULL)
+, m_uObjectsEnd(0)
+, m_pOffsetTable(NULL)
+, m_uOffsetSize(0)
+, m_uRefSize(0)
+, m_uNumObjects(0)
+{
+}
+
+CCPlistParser::~CCPlistParser(void)
+{
+	while (m_pBlocks)
+	{
+		Block *pNext = m_pBlocks->pNext;
+		free(m_pBlocks);
+		m_pBlocks = pNext;
+	}
+}
+
+void CCPlistParser::clear(void)
+{
+	if (! m_pBlocks)
+	{
+		return;
+	}
+
+	// keep the oldest block, it has the default size
+	while (m_pBlocks->pNext)
+	{
+		Block *pNext = m_pBlocks->pNext;
+		free(m_pBlocks);
+		m_pBlocks = pNext;
+	}
+	m_pBlocks->uUsed = 0;
+}
+
+void* CCPlistParser::allocate(unsigned int uSize)
+{
+	uSize = (uSize + 7) & ~7u;
+
+	if (! m_pBlocks || m_pBlocks->uUsed + uSize > m_pBlocks->uCapacity)
+	{
+		unsigned int uCapacity = uSize > kCCPlistBlockSize ? uSize : kCCPlistBlockSize;
+		Block *pBlock = (Block*)malloc(sizeof(Block) + uCapacity);
+		if (! pBlock)
+		{
+			return NULL;
+		}
+
+		pBlock->pNext = m_pBlocks;
+		pBlock->uUsed = 0;
+		pBlock->uCapacity = uCapacity;
+		m_pBlocks = pBlock;
+	}
+
+	void *pRet = (char*)(m_pBlocks + 1) + m_pBlocks->uUsed;
+	m_pBlocks->uUsed += uSize;
+	return pRet;
+}
+
+ccPlistValue* CCPlistParser::newValue(ccPlistType eType)
+{
+	ccPlistValue *pValue = (ccPlistValue*)allocate(sizeof(ccPlistValue));
+	if (pValue)
+	{
+		memset(pValue, 0, sizeof(ccPlistValue));
+		pValue->type = eType;
+	}
+	return pValue;
+}
+
+static void appendChild(ccPlistValue *pParent, ccPlistValue *pChild)
+{
+	if (pParent->pLastChild)
+	{
+		pParent->pLastChild->pNext = pChild;
+	}
+	else
+	{
+		pParent->pFirstChild = pChild;
+	}
+	pParent->pLastChild = pChild;
+	++pParent->uCount;
+}
+
+const ccPlistValue* CCPlistParser::parse(const unsigned char *pData, unsigned long uSize)
+{
+	clear();
+
+	if (! pData)
+	{
+		return NULL;
+	}
+
+	if (uSize >= 8 && memcmp(pData, "bplist00", 8) == 0)
+	{
+		return parseBinary(pData, uSize);
+	}
+
+	return parseXML((const char*)pData, (const char*)pData + uSize);
+}
+
+//
+// XML
+//
+
+static inline bool isSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static inline bool isNameChar(char c)
+{
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static inline bool startsWith(const char *p, const char *pEnd, const char *pszPrefix)
+{
+	size_t uLength = strlen(pszPrefix);
+	return (size_t)(pEnd - p) >= uLength && memcmp(p, pszPrefix, uLength) == 0;
+}
+
+// returns the position right after pszNeedle, NULL if it is not found
+static const char* skipPast(const char *p, const char *pEnd, const char *pszNeedle)
+{
+	size_t uLength = strlen(pszNeedle);
+	while ((size_t)(pEnd - p) >= uLength)
+	{
+		p = (const char*)memchr(p, pszNeedle[0], pEnd - p - uLength + 1);
+		if (! p)
+		{
+			return NULL;
+		}
+		if (memcmp(p, pszNeedle, uLength) == 0)
+		{
+			return p + uLength;
+		}
+		++p;
+	}
+	return NULL;
+}
+
+static inline bool nameIs(const char *pName, unsigned int uLength, const char *pszTag)
+{
+	return strlen(pszTag) == uLength && memcmp(pName, pszTag, uLength) == 0;
+}
+
+static unsigned int encodeUTF8(unsigned int uCode, char *pOut)
+{
+	if (uCode < 0x80)
+	{
+		pOut[0] = (char)uCode;
+		return 1;
+	}
+	if (uCode < 0x800)
+	{
+		pOut[0] = (char)(0xc0 | (uCode >> 6));
+		pOut[1] = (char)(0x80 | (uCode & 0x3f));
+		return 2;
+	}
+	if (uCode < 0x10000)
+	{
+		pOut[0] = (char)(0xe0 | (uCode >> 12));
+		pOut[1] = (char)(0x80 | ((uCode >> 6) & 0x3f));
+		pOut[2] = (char)(0x80 | (uCode & 0x3f));
+		return 3;
+	}
+	pOut[0] = (char)(0xf0 | (uCode >> 18));
+	pOut[1] = (char)(0x80 | ((uCode >> 12) & 0x3f));
+	pOut[2] = (char)(0x80 | ((uCode >> 6) & 0x3f));
+	pOut[3] = (char)(0x80 | (uCode & 0x3f));
+	return 4;
+}
+
+// Text without entities is returned as is. Otherwise it is decoded into the arena,
+// an entity is never shorter than what it stands for.
+const char* CCPlistParser::decodeText(const char *pszText, unsigned int *pLength)
+{
+	const char *pEnd = pszText + *pLength;
+	if (! memchr(pszText, '&', *pLength))
+	{
+		return pszText;
+	}
+
+	char *pOut = (char*)allocate(*pLength);
+	if (! pOut)
+	{
+		return NULL;
+	}
+
+	unsigned int uLength = 0;
+	const char *p = pszText;
+	while (p < pEnd)
+	{
+		const char *pSemicolon = NULL;
+		if (*p == '&')
+		{
+			pSemicolon = (const char*)memchr(p, ';', pEnd - p);
+		}
+		if (! pSemicolon)
+		{
+			pOut[uLength++] = *p++;
+			continue;
+		}
+
+		const char *pName = p + 1;
+		unsigned int uNameLength = (unsigned int)(pSemicolon - pName);
+		unsigned int uCode = 0;
+
+		if (nameIs(pName, uNameLength, "lt"))			uCode = '<';
+		else if (nameIs(pName, uNameLength, "gt"))		uCode = '>';
+		else if (nameIs(pName, uNameLength, "amp"))		uCode = '&';
+		else if (nameIs(pName, uNameLength, "quot"))	uCode = '"';
+		else if (nameIs(pName, uNameLength, "apos"))	uCode = '\'';
+		else if (uNameLength > 1 && pName[0] == '#')
+		{
+			char *pNumberEnd = NULL;
+			if (pName[1] == 'x' || pName[1] == 'X')
+			{
+				uCode = (unsigned int)strtoul(pName + 2, &pNumberEnd, 16);
+			}
+			else
+			{
+				uCode = (unsigned int)strtoul(pName + 1, &pNumberEnd, 10);
+			}
+
+			if (pNumberEnd != pSemicolon || uCode > 0x10ffff)
+			{
+				uCode = 0;
+			}
+		}
+
+		if (! uCode)
+		{
+			// not an entity we know, keep it literally
+			pOut[uLength++] = *p++;
+			continue;
+		}
+
+		uLength += encodeUTF8(uCode, pOut + uLength);
+		p = pSemicolon + 1;
+	}
+
+	*pLength = uLength;
+	return pOut;
+}
+
+const ccPlistValue* CCPlistParser::parseXML(const char *p, const char *pEnd)
+{
+	ccPlistValue *pStack[kCCPlistMaxDepth];
+	unsigned int uDepth = 0;
+	ccPlistValue *pRoot = NULL;
+	const char *pszKey = NULL;
+	unsigned int uKeyLength = 0;
+
+	while (p < pEnd)
+	{
+		p = (const char*)memchr(p, '<', pEnd - p);
+		if (! p)
+		{
+			break;
+		}
+
+		++p;
+		if (startsWith(p, pEnd, "?") || startsWith(p, pEnd, "!"))
+		{
+			// the XML declaration, comments and <!DOCTYPE ...>
+			p = startsWith(p, pEnd, "!--") ? skipPast(p + 3, pEnd, "-->") : skipPast(p, pEnd, ">");
+			if (! p)
+			{
+				return NULL;
+			}
+			continue;
+		}
+
+		bool bClosing = (p < pEnd && *p == '/');
+		if (bClosing)
+		{
+			++p;
+		}
+
+		const char *pName = p;
+		while (p < pEnd && isNameChar(*p))
+		{
+			++p;
+		}
+		unsigned int uNameLength = (unsigned int)(p - pName);
+
+		const char *pGreater = (const char*)memchr(p, '>', pEnd - p);
+		if (! pGreater)
+		{
+			return NULL;
+		}
+		bool bEmpty = (pGreater[-1] == '/');
+		p = pGreater + 1;
+
+		bool bContainer = nameIs(pName, uNameLength, "dict") || nameIs(pName, uNameLength, "array");
+		if (bClosing)
+		{
+			if (bContainer)
+			{
+				if (uDepth == 0)
+				{
+					return NULL;
+				}
+				--uDepth;
+			}
+			continue;
+		}
+
+		ccPlistType eType = kCCPlistString;
+		bool bKey = false;
+		bool bHasText = true;
+		if (nameIs(pName, uNameLength, "key"))				bKey = true;
+		else if (nameIs(pName, uNameLength, "string"))		eType = kCCPlistString;
+		else if (nameIs(pName, uNameLength, "integer"))		eType = kCCPlistInteger;
+		else if (nameIs(pName, uNameLength, "real"))		eType = kCCPlistReal;
+		else if (nameIs(pName, uNameLength, "date"))		eType = kCCPlistDate;
+		else if (nameIs(pName, uNameLength, "data"))		eType = kCCPlistData;
+		else
+		{
+			bHasText = false;
+			if (nameIs(pName, uNameLength, "dict"))			eType = kCCPlistDict;
+			else if (nameIs(pName, uNameLength, "array"))	eType = kCCPlistArray;
+			else if (nameIs(pName, uNameLength, "true"))	eType = kCCPlistTrue;
+			else if (nameIs(pName, uNameLength, "false"))	eType = kCCPlistFalse;
+			else
+			{
+				// <plist> and the elements plists don't use
+				continue;
+			}
+		}
+
+		// the text runs up to the next tag, the closing tag is skipped by the loop
+		const char *pszText = p;
+		unsigned int uLength = 0;
+		if (bHasText && ! bEmpty)
+		{
+			const char *pLess = (const char*)memchr(p, '<', pEnd - p);
+			if (! pLess)
+			{
+				return NULL;
+			}
+
+			if (pLess == p && startsWith(pLess, pEnd, "<![CDATA["))
+			{
+				pszText = pLess + 9;
+				p = skipPast(pszText, pEnd, "]]>");
+				if (! p)
+				{
+					return NULL;
+				}
+				uLength = (unsigned int)(p - 3 - pszText);
+			}
+			else
+			{
+				uLength = (unsigned int)(pLess - p);
+				p = pLess;
+				pszText = decodeText(pszText, &uLength);
+				if (! pszText)
+				{
+					return NULL;
+				}
+			}
+		}
+
+		if (bKey)
+		{
+			pszKey = pszText;
+			uKeyLength = uLength;
+			continue;
+		}
+
+		if (eType == kCCPlistInteger || eType == kCCPlistReal || eType == kCCPlistDate)
+		{
+			while (uLength && isSpace(*pszText))
+			{
+				++pszText;
+				--uLength;
+			}
+			while (uLength && isSpace(pszText[uLength - 1]))
+			{
+				--uLength;
+			}
+		}
+
+		ccPlistValue *pValue = newValue(eType);
+		if (! pValue)
+		{
+			return NULL;
+		}
+		pValue->pszText = pszText;
+		pValue->uLength = uLength;
+
+		if (uDepth == 0)
+		{
+			if (pRoot)
+			{
+				return NULL;
+			}
+			pRoot = pValue;
+		}
+		else
+		{
+			ccPlistValue *pParent = pStack[uDepth - 1];
+			if (pParent->type == kCCPlistDict)
+			{
+				if (! pszKey)
+				{
+					return NULL;
+				}
+				pValue->pszKey = pszKey;
+				pValue->uKeyLength = uKeyLength;
+				pszKey = NULL;
+			}
+			appendChild(pParent, pValue);
+		}
+
+		if (bContainer && ! bEmpty)
+		{
+			if (uDepth == kCCPlistMaxDepth)
+			{
+				return NULL;
+			}
+			pStack[uDepth++] = pValue;
+		}
+	}
+
+	return uDepth == 0 ? pRoot : NULL;
+}
+
+//
+// bplist00
+//
+
+static unsigned long long readBigEndian(const unsigned char *p, unsigned int uSize)
+{
+	unsigned long long uRet = 0;
+	for (unsigned int i = 0; i < uSize; ++i)
+	{
+		uRet = (uRet << 8) | p[i];
+	}
+	return uRet;
+}
+
+static double readReal(const unsigned char *p, unsigned int uSize)
+{
+	unsigned long long uBits = readBigEndian(p, uSize);
+	if (uSize == 4)
+	{
+		unsigned int u32 = (unsigned int)uBits;
+		float f;
+		memcpy(&f, &u32, 4);
+		return f;
+	}
+
+	double d;
+	memcpy(&d, &uBits, 8);
+	return d;
+}
+
+static const char s_szBase64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static unsigned int encodeBase64(const unsigned char *pIn, unsigned int uLength, char *pOut)
+{
+	char *p = pOut;
+	for (unsigned int i = 0; i < uLength; i += 3)
+	{
+		unsigned int uRemaining = uLength - i;
+		unsigned int n = pIn[i] << 16;
+		if (uRemaining > 1) n |= pIn[i + 1] << 8;
+		if (uRemaining > 2) n |= pIn[i + 2];
+
+		*p++ = s_szBase64[(n >> 18) & 0x3f];
+		*p++ = s_szBase64[(n >> 12) & 0x3f];
+		*p++ = uRemaining > 1 ? s_szBase64[(n >> 6) & 0x3f] : '=';
+		*p++ = uRemaining > 2 ? s_szBase64[n & 0x3f] : '=';
+	}
+	return (unsigned int)(p - pOut);
+}
+
+const ccPlistValue* CCPlistParser::parseBinary(const unsigned char *pData, unsigned long uSize)
+{
+	// header, at least one object and the trailer
+	if (uSize < 8 + 1 + 32)
+	{
+		return NULL;
+	}
+
+	const unsigned char *pTrailer = pData + uSize - 32;
+	unsigned long long uTableOffset = readBigEndian(pTrailer + 24, 8);
+	unsigned long long uTopObject = readBigEndian(pTrailer + 16, 8);
+
+	m_uOffsetSize = pTrailer[6];
+	m_uRefSize = pTrailer[7];
+	m_uNumObjects = readBigEndian(pTrailer + 8, 8);
+
+	if (m_uOffsetSize < 1 || m_uOffsetSize > 8 || m_uRefSize < 1 || m_uRefSize > 8
+		|| m_uNumObjects == 0 || uTopObject >= m_uNumObjects
+		|| uTableOffset <= 8 || uTableOffset > uSize - 32
+		|| m_uNumObjects > (uSize - 32 - uTableOffset) / m_uOffsetSize)
+	{
+		return NULL;
+	}
+
+	m_pData = pData;
+	m_uObjectsEnd = uTableOffset;
+	m_pOffsetTable = pData + uTableOffset;
+
+	const ccPlistValue *pRoot = binaryObject(uTopObject, 0);
+	m_pData = NULL;
+	m_pOffsetTable = NULL;
+	return pRoot;
+}
+
+// reads the element count of a marker, which may be stored in an integer object
+// right after it, and moves pOffset to the payload of the object
+bool CCPlistParser::binaryCount(unsigned long long *pOffset, unsigned int uMarker, unsigned long long *pCount)
+{
+	unsigned long long uOffset = *pOffset + 1;
+
+	if ((uMarker & 0xf) != 0xf)
+	{
+		*pCount = uMarker & 0xf;
+		*pOffset = uOffset;
+		return true;
+	}
+
+	if (uOffset >= m_uObjectsEnd || (m_pData[uOffset] & 0xf0) != 0x10 || (m_pData[uOffset] & 0xf) > 3)
+	{
+		return false;
+	}
+
+	unsigned int uBytes = 1 << (m_pData[uOffset] & 0xf);
+	if (uBytes > m_uObjectsEnd - uOffset - 1)
+	{
+		return false;
+	}
+
+	*pCount = readBigEndian(m_pData + uOffset + 1, uBytes);
+	*pOffset = uOffset + 1 + uBytes;
+	return true;
+}
+
+ccPlistValue* CCPlistParser::binaryObject(unsigned long long uRef, unsigned int uDepth)
+{
+	if (uRef >= m_uNumObjects || uDepth >= kCCPlistMaxDepth)
+	{
+		return NULL;
+	}
+
+	unsigned long long uOffset = readBigEndian(m_pOffsetTable + uRef * m_uOffsetSize, m_uOffsetSize);
+	if (uOffset < 8 || uOffset >= m_uObjectsEnd)
+	{
+		return NULL;
+	}
+
+	unsigned int uMarker = m_pData[uOffset];
+	unsigned int uLow = uMarker & 0xf;
+	// bytes following the marker
+	unsigned long long uAvailable = m_uObjectsEnd - uOffset - 1;
+	const unsigned char *p = m_pData + uOffset + 1;
+	char szNumber[64];
+	ccPlistType eType;
+
+	switch (uMarker >> 4)
+	{
+	case 0x0:
+		if (uLow != 8 && uLow != 9)
+		{
+			// null and fill bytes have no XML counterpart
+			return NULL;
+		}
+		return newValue(uLow == 9 ? kCCPlistTrue : kCCPlistFalse);
+
+	case 0x1:
+	case 0x8:
+		{
+			// integers have 2^n bytes, the 16 bytes ones keep their value in the low half.
+			// uids have n + 1 bytes and are read as integers.
+			unsigned int uBytes = (uMarker >> 4) == 0x1 ? (1u << uLow) : uLow + 1;
+			if (uLow > 4 || uBytes > uAvailable)
+			{
+				return NULL;
+			}
+			if (uBytes == 16)
+			{
+				p += 8;
+				uBytes = 8;
+			}
+
+			unsigned long long uValue = readBigEndian(p, uBytes);
+			if (uBytes == 8)
+			{
+				sprintf(szNumber, "%lld", (long long)uValue);
+			}
+			else
+			{
+				sprintf(szNumber, "%llu", uValue);
+			}
+			eType = kCCPlistInteger;
+		}
+		break;
+
+	case 0x2:
+		{
+			if ((uLow != 2 && uLow != 3) || (1u << uLow) > uAvailable)
+			{
+				return NULL;
+			}
+
+			double dValue = readReal(p, 1 << uLow);
+			// the shortest text that reads back as the same number
+			sprintf(szNumber, "%.15g", dValue);
+			if (strtod(szNumber, NULL) != dValue)
+			{
+				sprintf(szNumber, "%.17g", dValue);
+			}
+			eType = kCCPlistReal;
+		}
+		break;
+
+	case 0x3:
+		{
+			if (uLow != 3 || uAvailable < 8)
+			{
+				return NULL;
+			}
+
+			time_t tTime = (time_t)(readReal(p, 8) + kCCPlistDateOffset);
+			struct tm *pTime = gmtime(&tTime);
+			if (! pTime)
+			{
+				return NULL;
+			}
+			sprintf(szNumber, "%04d-%02d-%02dT%02d:%02d:%02dZ",
+				pTime->tm_year + 1900, pTime->tm_mon + 1, pTime->tm_mday,
+				pTime->tm_hour, pTime->tm_min, pTime->tm_sec);
+			eType = kCCPlistDate;
+		}
+		break;
+
+	case 0x4:
+	case 0x5:
+	case 0x6:
+		{
+			unsigned long long uCount;
+			if (! binaryCount(&uOffset, uMarker, &uCount))
+			{
+				return NULL;
+			}
+
+			unsigned int uUnitSize = (uMarker >> 4) == 0x6 ? 2 : 1;
+			if (uCount > (m_uObjectsEnd - uOffset) / uUnitSize || uCount > 0x3fffffff)
+			{
+				return NULL;
+			}
+			p = m_pData + uOffset;
+
+			ccPlistValue *pValue = newValue((uMarker >> 4) == 0x4 ? kCCPlistData : kCCPlistString);
+			if (! pValue)
+			{
+				return NULL;
+			}
+
+			if ((uMarker >> 4) == 0x5)
+			{
+				// ASCII strings are used as is
+				pValue->pszText = (const char*)p;
+				pValue->uLength = (unsigned int)uCount;
+				return pValue;
+			}
+
+			char *pText;
+			if ((uMarker >> 4) == 0x4)
+			{
+				pText = (char*)allocate((unsigned int)((uCount + 2) / 3 * 4));
+				if (! pText)
+				{
+					return NULL;
+				}
+				pValue->uLength = encodeBase64(p, (unsigned int)uCount, pText);
+			}
+			else
+			{
+				// UTF-16BE, a unit never takes more than 3 bytes in UTF-8
+				pText = (char*)allocate((unsigned int)(uCount * 3));
+				if (! pText)
+				{
+					return NULL;
+				}
+
+				unsigned int uLength = 0;
+				for (unsigned int i = 0; i < uCount; ++i)
+				{
+					unsigned int uCode = (p[i * 2] << 8) | p[i * 2 + 1];
+					if (uCode >= 0xd800 && uCode < 0xdc00 && i + 1 < uCount)
+					{
+						unsigned int uLowSurrogate = (p[i * 2 + 2] << 8) | p[i * 2 + 3];
+						if (uLowSurrogate >= 0xdc00 && uLowSurrogate < 0xe000)
+						{
+							uCode = 0x10000 + ((uCode - 0xd800) << 10) + (uLowSurrogate - 0xdc00);
+							++i;
+						}
+					}
+					uLength += encodeUTF8(uCode, pText + uLength);
+				}
+				pValue->uLength = uLength;
+			}
+			pValue->pszText = pText;
+			return pValue;
+		}
+
+	case 0xA:
+	case 0xD:
+		{
+			bool bDict = (uMarker >> 4) == 0xD;
+			unsigned long long uCount;
+			if (! binaryCount(&uOffset, uMarker, &uCount))
+			{
+				return NULL;
+			}
+
+			// dictionaries list their key references, then their value references
+			unsigned int uRefsPerEntry = bDict ? 2 : 1;
+			if (uCount > (m_uObjectsEnd - uOffset) / (m_uRefSize * uRefsPerEntry))
+			{
+				return NULL;
+			}
+			p = m_pData + uOffset;
+
+			ccPlistValue *pContainer = newValue(bDict ? kCCPlistDict : kCCPlistArray);
+			if (! pContainer)
+			{
+				return NULL;
+			}
+
+			for (unsigned long long i = 0; i < uCount; ++i)
+			{
+				ccPlistValue *pKey = NULL;
+				if (bDict)
+				{
+					pKey = binaryObject(readBigEndian(p + i * m_uRefSize, m_uRefSize), uDepth + 1);
+					if (! pKey || pKey->type != kCCPlistString)
+					{
+						return NULL;
+					}
+				}
+
+				unsigned long long uValueRef = readBigEndian(p + (bDict ? uCount + i : i) * m_uRefSize, m_uRefSize);
+				ccPlistValue *pChild = binaryObject(uValueRef, uDepth + 1);
+				if (! pChild)
+				{
+					return NULL;
+				}
+
+				if (pKey)
+				{
+					pChild->pszKey = pKey->pszText;
+					pChild->uKeyLength = pKey->uLength;
+				}
+				appendChild(pContainer, pChild);
+			}
+			return pContainer;
+		}
+
+	default:
+		return NULL;
+	}
+
+	// integers, reals and dates are formatted into the arena
+	unsigned int uLength = (unsigned int)strlen(szNumber);
+	char *pText = (char*)allocate(uLength);
+	ccPlistValue *pValue = newValue(eType);
+	if (! pText || ! pValue)
+	{
+		return NULL;
+	}
+	memcpy(pText, szNumber, uLength);
+	pValue->pszText = pText;
+	pValue->uLength = uLength;
+	return pValue;
+}
+
+//
+// cocoa objects
+//
+
+NSObject* CCPlistParser::objectWithValue(const ccPlistValue *pValue)
+{
+	if (! pValue)
+	{
+		return NULL;
+	}
+
+	switch (pValue->type)
+	{
+	case kCCPlistDict:
+		{
+			NSDictionary<std::string, NSObject*> *pDict = new NSDictionary<std::string, NSObject*>();
+			for (const ccPlistValue *pChild = pValue->pFirstChild; pChild; pChild = pChild->pNext)
+			{
+				NSObject *pObject = objectWithValue(pChild);
+				pDict->setObject(pObject, std::string(pChild->pszKey, pChild->uKeyLength));
+				pObject->release();
+			}
+			return pDict;
+		}
+
+	case kCCPlistArray:
+		{
+			NSMutableArray<NSObject*> *pArray = new NSMutableArray<NSObject*>(pValue->uCount);
+			for (const ccPlistValue *pChild = pValue->pFirstChild; pChild; pChild = pChild->pNext)
+			{
+				NSObject *pObject = objectWithValue(pChild);
+				pArray->addObject(pObject);
+				pObject->release();
+			}
+			return pArray;
+		}
+
+	default:
+		{
+			NSString *pString = new NSString();
+			if (pValue->type == kCCPlistTrue)
+			{
+				pString->m_sString = "1";
+			}
+			else if (pValue->type == kCCPlistFalse)
+			{
+				pString->m_sString = "0";
+			}
+			else
+			{
+				pString->m_sString.assign(pValue->pszText, pValue->uLength);
+			}
+			return pString;
+		}
+	}
+}
+
+NSDictionary<std::string, NSObject*>* CCPlistParser::dictionaryWithContentsOfFile(const char *pszFileName)
+{
+	NSData *pData = CCFileUtils::getFileDataView(pszFileName);
+	if (! pData)
+	{
+		return NULL;
+	}
+
+	NSDictionary<std::string, NSObject*> *pRet = NULL;
+	CCPlistParser parser;
+	const ccPlistValue *pRoot = parser.parse((const unsigned char*)pData->bytes(), pData->getSize());
+	if (pRoot && pRoot->type == kCCPlistDict)
+	{
+		pRet = (NSDictionary<std::string, NSObject*>*)objectWithValue(pRoot);
+		pRet->autorelease();
+	}
+	else
+	{
+		CCLOG("cocos2d: CCPlistParser: %s is not a plist with a dictionary at its root", pszFileName);
+	}
+
+	pData->release();
+	return pRet;
+}
+
+}//namespace   cocos2d 
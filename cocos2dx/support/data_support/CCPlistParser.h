@@ -0,0 +1,126 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __SUPPORT_DATA_SUPPORT_CCPLISTPARSER_H__
+#define __SUPPORT_DATA_SUPPORT_CCPLISTPARSER_H__
+
+#include <string>
+#include "NSObject.h"
+#include "NSMutableDictionary.h"
+
+namespace   cocos2d {
+
+typedef enum
+{
+	kCCPlistDict,
+	kCCPlistArray,
+	kCCPlistString,
+	kCCPlistInteger,
+	kCCPlistReal,
+	kCCPlistTrue,
+	kCCPlistFalse,
+	kCCPlistDate,
+	kCCPlistData,
+} ccPlistType;
+
+/** a node of a parsed property list.
+ The text and the key are not NUL terminated. They point into the parsed buffer
+ when the plist stores them as is, and into the parser's memory otherwise.
+ Dates are ISO 8601 strings and data is base64 text, as in XML plists.
+ */
+typedef struct _ccPlistValue
+{
+	ccPlistType		type;
+	const char		*pszKey;		///< key inside the parent dictionary, NULL in arrays
+	unsigned int	uKeyLength;
+	const char		*pszText;		///< text of the scalar values
+	unsigned int	uLength;
+	unsigned int	uCount;			///< number of children of dictionaries and arrays
+	struct _ccPlistValue *pFirstChild;
+	struct _ccPlistValue *pLastChild;
+	struct _ccPlistValue *pNext;
+} ccPlistValue;
+
+/** @brief Parses XML and binary (bplist00) property lists in a single pass.
+ The values of a parse are allocated from one arena owned by the parser and are
+ valid until the next parse, clear() or the destruction of the parser.
+ The parsed buffer is never written to and must outlive the values.
+ @since v0.99.5
+ */
+class CCX_DLL CCPlistParser
+{
+public:
+	CCPlistParser(void);
+	~CCPlistParser(void);
+
+	/** parses uSize bytes of pData, either XML or bplist00
+	 @return the root value or NULL if the data is not a valid plist
+	 */
+	const ccPlistValue* parse(const unsigned char *pData, unsigned long uSize);
+
+	/** releases the values of the last parse. The first arena block is kept for the next one. */
+	void clear(void);
+
+	/** converts a value into cocoa objects: dictionaries become NSDictionary, arrays NSMutableArray
+	 and the other values NSString, with "1" and "0" for the booleans.
+	 The returned object is not autoreleased.
+	 */
+	static NSObject* objectWithValue(const ccPlistValue *pValue);
+
+	/** reads a plist file through CCFileUtils::getFileDataView and converts its root dictionary
+	 @return an autoreleased dictionary, NULL if the file is missing or its root is not a dictionary
+	 */
+	static NSDictionary<std::string, NSObject*>* dictionaryWithContentsOfFile(const char *pszFileName);
+
+private:
+	void* allocate(unsigned int uSize);
+	ccPlistValue* newValue(ccPlistType eType);
+
+	const ccPlistValue* parseXML(const char *p, const char *pEnd);
+	const char* decodeText(const char *pszText, unsigned int *pLength);
+
+	const ccPlistValue* parseBinary(const unsigned char *pData, unsigned long uSize);
+	ccPlistValue* binaryObject(unsigned long long uRef, unsigned int uDepth);
+	bool binaryCount(unsigned long long *pOffset, unsigned int uMarker, unsigned long long *pCount);
+
+private:
+	struct Block;
+	Block *m_pBlocks;
+
+	// state of the binary parse
+	const unsigned char *m_pData;
+	unsigned long long m_uObjectsEnd;
+	const unsigned char *m_pOffsetTable;
+	unsigned int m_uOffsetSize;
+	unsigned int m_uRefSize;
+	unsigned long long m_uNumObjects;
+
+private:
+	CCPlistParser(const CCPlistParser&);
+	CCPlistParser& operator=(const CCPlistParser&);
+};
+
+}//namespace   cocos2d 
+
+#endif // __SUPPORT_DATA_SUPPORT_CCPLISTPARSER_H__
@@ -25,10 +25,20 @@ THE SOFTWARE.
 #include "FileUtils.h"
 #include <stdio.h>
 #include "CCXCocos2dDefine.h"
+#include "NSData.h"
 #include "support/zip_support/unzip.h"
 #include <string>
 #include <assert.h>
 
+#if defined(CCX_PLATFORM_WIN32)
+#include <windows.h>
+#elif ! defined(CCX_PLATFORM_UPHONE)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace cocos2d {
 
 unsigned char* FileUtils::getFileData(const char* pszFileName, const char* pszMode, unsigned long * pSize)
@@ -95,6 +105,143 @@ unsigned char* FileUtils::getFileDataFromZip(const char* pszZipFilePath, const c
     return pBuffer;
 }
 
+unsigned char* FileUtils::mapFileData(const char* pszFileName, unsigned long * pSize)
+{
+    unsigned char * pData = NULL;
+    *pSize = 0;
+
+#if defined(CCX_PLATFORM_WIN32)
+    HANDLE hFile = CreateFileA(pszFileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE != hFile)
+    {
+        DWORD dwSize = GetFileSize(hFile, NULL);
+        // an empty file can't be mapped
+        HANDLE hMapping = (dwSize > 0 && INVALID_FILE_SIZE != dwSize) ? CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+        if (hMapping)
+        {
+            // the view keeps the mapping alive
+            pData = (unsigned char*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(hMapping);
+        }
+        if (pData)
+        {
+            *pSize = dwSize;
+        }
+        CloseHandle(hFile);
+    }
+#elif ! defined(CCX_PLATFORM_UPHONE)
+    int fd = open(pszFileName, O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        if (0 == fstat(fd, &st) && st.st_size > 0)
+        {
+            // the mapping stays valid once the file is closed
+            void *pMapped = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (MAP_FAILED != pMapped)
+            {
+                pData = (unsigned char*)pMapped;
+                *pSize = (unsigned long)st.st_size;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    return pData;
+}
+
+void FileUtils::unmapFileData(unsigned char* pData, unsigned long uSize)
+{
+    if (! pData)
+    {
+        return;
+    }
+
+#if defined(CCX_PLATFORM_WIN32)
+    UnmapViewOfFile(pData);
+#elif ! defined(CCX_PLATFORM_UPHONE)
+    munmap(pData, (size_t)uSize);
+#endif
+}
+
+NSData* FileUtils::getFileDataView(const char* pszFileName)
+{
+    unsigned long nSize = 0;
+    unsigned char * pData = mapFileData(pszFileName, &nSize);
+    if (pData)
+    {
+        return NSData::dataWithMappedBytes(pData, nSize);
+    }
+
+    // no mapping, read the file
+    pData = FileUtils::getFileData(pszFileName, "rb", &nSize);
+    return NSData::dataWithBytesNoCopy(pData, nSize);
+}
+
+NSData* FileUtils::getFileDataViewFromZip(const char* pszZipFilePath, const char* pszFileName)
+{
+    NSData * pRet = NULL;
+    NSData * pZipData = NULL;
+    unzFile pFile = NULL;
+    bool bMissing = false;
+
+    do 
+    {
+        CCX_BREAK_IF(!pszZipFilePath || !pszFileName);
+        CCX_BREAK_IF(strlen(pszZipFilePath) == 0);
+
+        unsigned long nZipSize = 0;
+        unsigned char * pZipBytes = mapFileData(pszZipFilePath, &nZipSize);
+        CCX_BREAK_IF(!pZipBytes);
+        pZipData = NSData::dataWithMappedBytes(pZipBytes, nZipSize);
+
+        pFile = unzOpen(pszZipFilePath);
+        CCX_BREAK_IF(!pFile);
+
+        int nRet = unzLocateFile(pFile, pszFileName, 1);
+        bMissing = (UNZ_OK != nRet);
+        CCX_BREAK_IF(bMissing);
+
+        char szFilePathA[260];
+        unz_file_info FileInfo;
+        nRet = unzGetCurrentFileInfo(pFile, &FileInfo, szFilePathA, sizeof(szFilePathA), NULL, 0, NULL, 0);
+        CCX_BREAK_IF(UNZ_OK != nRet);
+
+        // only the stored entries, not encrypted, are laid out as is in the zip file
+        CCX_BREAK_IF(0 != FileInfo.compression_method || (FileInfo.flag & 1));
+        CCX_BREAK_IF(FileInfo.compressed_size != FileInfo.uncompressed_size);
+
+        nRet = unzOpenCurrentFile(pFile);
+        CCX_BREAK_IF(UNZ_OK != nRet);
+        unsigned long uOffset = (unsigned long)unzGetCurrentFileZStreamPos64(pFile);
+        unzCloseCurrentFile(pFile);
+
+        pRet = pZipData->subdataWithRange(uOffset, FileInfo.uncompressed_size);
+    } while (0);
+
+    if (pFile)
+    {
+        unzClose(pFile);
+    }
+
+    if (pZipData)
+    {
+        // the view keeps the mapping alive
+        pZipData->release();
+    }
+
+    if (! pRet && ! bMissing)
+    {
+        // compressed entry or no mapping, inflate it
+        unsigned long nSize = 0;
+        unsigned char * pData = getFileDataFromZip(pszZipFilePath, pszFileName, &nSize);
+        pRet = NSData::dataWithBytesNoCopy(pData, nSize);
+    }
+
+    return pRet;
+}
+
 const char* FileUtils::ccRemoveHDSuffixFromFile(const char* path)
 {
 #if CC_IS_RETINA_DISPLAY_SUPPORTED
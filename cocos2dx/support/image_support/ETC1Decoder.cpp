@@ -0,0 +1,150 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <string.h>
+
+#include "ETC1Decoder.h"
+
+namespace   cocos2d {
+
+// intensity modifiers, indexed by the table codeword of a subblock
+static const int s_nETC1Modifiers[8][2] = {
+	{ 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 },
+	{ 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 },
+};
+
+static inline unsigned char clampColor(int n)
+{
+	return (unsigned char)(n < 0 ? 0 : (n > 255 ? 255 : n));
+}
+
+static inline int extend4(int n)
+{
+	return (n << 4) | n;
+}
+
+static inline int extend5(int n)
+{
+	return (n << 3) | (n >> 2);
+}
+
+// 3 bits two's complement
+static inline int signed3(int n)
+{
+	return (n & 4) ? n - 8 : n;
+}
+
+unsigned int ccETC1DataSize(unsigned int uWidth, unsigned int uHeight)
+{
+	return ((uWidth + 3) / 4) * ((uHeight + 3) / 4) * 8;
+}
+
+void ccETC1DecodeBlock(const unsigned char *pBlock, unsigned char *pOut, unsigned int uStride)
+{
+	int base[2][3];
+
+	if (pBlock[3] & 2)
+	{
+		// differential mode: 5 bits base color, and a 3 bits delta for the second subblock
+		for (int c = 0; c < 3; ++c)
+		{
+			int n = pBlock[c] >> 3;
+			base[0][c] = extend5(n);
+			base[1][c] = extend5((n + signed3(pBlock[c] & 7)) & 0x1f);
+		}
+	}
+	else
+	{
+		// individual mode: two 4 bits base colors
+		for (int c = 0; c < 3; ++c)
+		{
+			base[0][c] = extend4(pBlock[c] >> 4);
+			base[1][c] = extend4(pBlock[c] & 0x0f);
+		}
+	}
+
+	const int *pTables[2] = { s_nETC1Modifiers[(pBlock[3] >> 5) & 7], s_nETC1Modifiers[(pBlock[3] >> 2) & 7] };
+	bool bFlip = (pBlock[3] & 1) != 0;
+
+	unsigned int uMsb = (pBlock[4] << 8) | pBlock[5];
+	unsigned int uLsb = (pBlock[6] << 8) | pBlock[7];
+
+	// the pixel indices go down the columns first
+	for (int x = 0; x < 4; ++x)
+	{
+		for (int y = 0; y < 4; ++y)
+		{
+			int i = x * 4 + y;
+			int nSub = bFlip ? (y >> 1) : (x >> 1);
+
+			int nModifier = pTables[nSub][(uLsb >> i) & 1];
+			if ((uMsb >> i) & 1)
+			{
+				nModifier = -nModifier;
+			}
+
+			unsigned char *p = pOut + y * uStride + x * 3;
+			p[0] = clampColor(base[nSub][0] + nModifier);
+			p[1] = clampColor(base[nSub][1] + nModifier);
+			p[2] = clampColor(base[nSub][2] + nModifier);
+		}
+	}
+}
+
+bool ccETC1DecodeImage(const unsigned char *pIn, unsigned int uInLength, unsigned int uWidth, unsigned int uHeight, unsigned char *pOut)
+{
+	if (! pIn || ! pOut || uInLength < ccETC1DataSize(uWidth, uHeight))
+	{
+		return false;
+	}
+
+	unsigned int uStride = uWidth * 3;
+	unsigned char block[4 * 4 * 3];
+
+	for (unsigned int by = 0; by < uHeight; by += 4)
+	{
+		for (unsigned int bx = 0; bx < uWidth; bx += 4, pIn += 8)
+		{
+			if (bx + 4 <= uWidth && by + 4 <= uHeight)
+			{
+				ccETC1DecodeBlock(pIn, pOut + by * uStride + bx * 3, uStride);
+				continue;
+			}
+
+			// partial block on the right or bottom edge
+			ccETC1DecodeBlock(pIn, block, 4 * 3);
+
+			unsigned int uCols = (uWidth - bx < 4 ? uWidth - bx : 4);
+			unsigned int uRows = (uHeight - by < 4 ? uHeight - by : 4);
+			for (unsigned int y = 0; y < uRows; ++y)
+			{
+				memcpy(pOut + (by + y) * uStride + bx * 3, block + y * 4 * 3, uCols * 3);
+			}
+		}
+	}
+
+	return true;
+}
+
+}//namespace   cocos2d 
@@ -0,0 +1,50 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __SUPPORT_IMAGE_SUPPORT_ETC1DECODER_H__
+#define __SUPPORT_IMAGE_SUPPORT_ETC1DECODER_H__
+
+#include "ccxCommon.h"
+
+namespace   cocos2d {
+
+/// size in bytes of an ETC1 image: 8 bytes for every 4x4 block, partial blocks included
+unsigned int CCX_DLL ccETC1DataSize(unsigned int uWidth, unsigned int uHeight);
+
+/** decodes one 8 bytes ETC1 block into 4x4 RGB888 pixels
+ @param uStride bytes between the rows of pOut
+ */
+void CCX_DLL ccETC1DecodeBlock(const unsigned char *pBlock, unsigned char *pOut, unsigned int uStride);
+
+/** decodes an ETC1 image into tightly packed, top-down RGB888 pixels.
+ The pixels of the partial blocks that are outside of the image are dropped.
+ @param pOut receives uWidth * uHeight * 3 bytes
+ @return false if uInLength is too short for the size
+ @warning Doesn't depend on OpenGL or on any cocos2d object, so it is safe to call from a worker thread.
+ */
+bool CCX_DLL ccETC1DecodeImage(const unsigned char *pIn, unsigned int uInLength, unsigned int uWidth, unsigned int uHeight, unsigned char *pOut);
+
+}//namespace   cocos2d 
+
+#endif // __SUPPORT_IMAGE_SUPPORT_ETC1DECODER_H__
@@ -0,0 +1,291 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ImageEncoder.h"
+#include "CCRenderTexture.h"
+
+#include "png.h"
+
+// in order to compile correct in andLinux, because ssTypes(uphone)
+// and jmorecfg.h all typedef xxx INT32
+#define  QGLOBAL_H
+#include "jpeglib.h"
+#undef   QGLOBAL_H
+
+namespace   cocos2d {
+
+void ccImageFlipRows(unsigned char *pPixels, int nWidth, int nHeight, int nBytesPerPixel)
+{
+	int nRowBytes = nWidth * nBytesPerPixel;
+	unsigned char *pRow = new unsigned char[nRowBytes];
+
+	for (int y = 0; y < nHeight / 2; ++y)
+	{
+		unsigned char *pTop = pPixels + y * nRowBytes;
+		unsigned char *pBottom = pPixels + (nHeight - 1 - y) * nRowBytes;
+		memcpy(pRow, pTop, nRowBytes);
+		memcpy(pTop, pBottom, nRowBytes);
+		memcpy(pBottom, pRow, nRowBytes);
+	}
+
+	delete [] pRow;
+}
+
+// growable output buffer shared by the png and jpeg writers
+typedef struct
+{
+	unsigned char *data;
+	unsigned long size;
+	unsigned long capacity;
+} tImageBuffer;
+
+static bool imageBufferAppend(tImageBuffer *pBuffer, const unsigned char *pData, unsigned long nLen)
+{
+	if (pBuffer->size + nLen > pBuffer->capacity)
+	{
+		unsigned long nCapacity = pBuffer->capacity ? pBuffer->capacity * 2 : 4096;
+		while (nCapacity < pBuffer->size + nLen)
+		{
+			nCapacity *= 2;
+		}
+
+		unsigned char *pData = new unsigned char[nCapacity];
+		if (pBuffer->data)
+		{
+			memcpy(pData, pBuffer->data, pBuffer->size);
+			delete [] pBuffer->data;
+		}
+		pBuffer->data = pData;
+		pBuffer->capacity = nCapacity;
+	}
+
+	memcpy(pBuffer->data + pBuffer->size, pData, nLen);
+	pBuffer->size += nLen;
+	return true;
+}
+
+static void pngWriteCallback(png_structp png_ptr, png_bytep data, png_size_t length)
+{
+	tImageBuffer *pBuffer = (tImageBuffer*)png_get_io_ptr(png_ptr);
+	imageBufferAppend(pBuffer, data, (unsigned long)length);
+}
+
+static void pngFlushCallback(png_structp png_ptr)
+{
+}
+
+static bool encodePng(const unsigned char *pPixels, int nWidth, int nHeight, tImageBuffer *pBuffer)
+{
+	png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+	if (! png_ptr)
+	{
+		return false;
+	}
+
+	png_infop info_ptr = png_create_info_struct(png_ptr);
+	if (! info_ptr)
+	{
+		png_destroy_write_struct(&png_ptr, NULL);
+		return false;
+	}
+
+	png_bytep *rowPointers = new png_bytep[nHeight];
+
+	if (setjmp(png_jmpbuf(png_ptr)))
+	{
+		png_destroy_write_struct(&png_ptr, &info_ptr);
+		delete [] rowPointers;
+		return false;
+	}
+
+	png_set_write_fn(png_ptr, pBuffer, pngWriteCallback, pngFlushCallback);
+	png_set_IHDR(png_ptr, info_ptr, nWidth, nHeight, 8, PNG_COLOR_TYPE_RGB_ALPHA,
+		PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+
+	for (int i = 0; i < nHeight; ++i)
+	{
+		rowPointers[i] = (png_bytep)pPixels + i * nWidth * 4;
+	}
+
+	png_set_rows(png_ptr, info_ptr, rowPointers);
+	png_write_png(png_ptr, info_ptr, PNG_TRANSFORM_IDENTITY, NULL);
+
+	png_destroy_write_struct(&png_ptr, &info_ptr);
+	delete [] rowPointers;
+	return true;
+}
+
+// libjpeg of android has no jpeg_mem_dest(), so write through our own destination manager
+typedef struct
+{
+	struct jpeg_destination_mgr pub;
+	tImageBuffer *buffer;
+	JOCTET chunk[4096];
+} tJpegDestination;
+
+typedef struct
+{
+	struct jpeg_error_mgr pub;
+	jmp_buf jump;
+} tJpegError;
+
+static void jpegInitDestination(j_compress_ptr cinfo)
+{
+	tJpegDestination *pDest = (tJpegDestination*)cinfo->dest;
+	pDest->pub.next_output_byte = pDest->chunk;
+	pDest->pub.free_in_buffer = sizeof(pDest->chunk);
+}
+
+static boolean jpegEmptyOutputBuffer(j_compress_ptr cinfo)
+{
+	tJpegDestination *pDest = (tJpegDestination*)cinfo->dest;
+	imageBufferAppend(pDest->buffer, pDest->chunk, sizeof(pDest->chunk));
+	pDest->pub.next_output_byte = pDest->chunk;
+	pDest->pub.free_in_buffer = sizeof(pDest->chunk);
+	return TRUE;
+}
+
+static void jpegTermDestination(j_compress_ptr cinfo)
+{
+	tJpegDestination *pDest = (tJpegDestination*)cinfo->dest;
+	imageBufferAppend(pDest->buffer, pDest->chunk, sizeof(pDest->chunk) - pDest->pub.free_in_buffer);
+}
+
+static void jpegErrorExit(j_common_ptr cinfo)
+{
+	tJpegError *pError = (tJpegError*)cinfo->err;
+	longjmp(pError->jump, 1);
+}
+
+static bool encodeJpg(const unsigned char *pPixels, int nWidth, int nHeight, tImageBuffer *pBuffer)
+{
+	struct jpeg_compress_struct cinfo;
+	tJpegError jerr;
+	tJpegDestination dest;
+	JSAMPROW row_pointer[1];
+
+	// jpeg has no alpha channel, each row is converted to RGB before it is written
+	unsigned char *pRow = new unsigned char[nWidth * 3];
+
+	cinfo.err = jpeg_std_error(&jerr.pub);
+	jerr.pub.error_exit = jpegErrorExit;
+	if (setjmp(jerr.jump))
+	{
+		jpeg_destroy_compress(&cinfo);
+		delete [] pRow;
+		return false;
+	}
+
+	jpeg_create_compress(&cinfo);
+
+	dest.buffer = pBuffer;
+	dest.pub.init_destination = jpegInitDestination;
+	dest.pub.empty_output_buffer = jpegEmptyOutputBuffer;
+	dest.pub.term_destination = jpegTermDestination;
+	cinfo.dest = &dest.pub;
+
+	cinfo.image_width = nWidth;
+	cinfo.image_height = nHeight;
+	cinfo.input_components = 3;
+	cinfo.in_color_space = JCS_RGB;
+	jpeg_set_defaults(&cinfo);
+	jpeg_set_quality(&cinfo, 90, TRUE);
+
+	jpeg_start_compress(&cinfo, TRUE);
+
+	while (cinfo.next_scanline < cinfo.image_height)
+	{
+		const unsigned char *pSrc = pPixels + cinfo.next_scanline * nWidth * 4;
+		for (int x = 0; x < nWidth; ++x)
+		{
+			pRow[x * 3 + 0] = pSrc[x * 4 + 0];
+			pRow[x * 3 + 1] = pSrc[x * 4 + 1];
+			pRow[x * 3 + 2] = pSrc[x * 4 + 2];
+		}
+
+		row_pointer[0] = pRow;
+		jpeg_write_scanlines(&cinfo, row_pointer, 1);
+	}
+
+	jpeg_finish_compress(&cinfo);
+	jpeg_destroy_compress(&cinfo);
+	delete [] pRow;
+	return true;
+}
+
+bool ccImageEncodeRGBA(const unsigned char *pPixels, int nWidth, int nHeight, int nFormat,
+                       unsigned char **ppOut, unsigned long *pOutLen)
+{
+	if (! pPixels || ! ppOut || ! pOutLen || nWidth <= 0 || nHeight <= 0)
+	{
+		return false;
+	}
+
+	tImageBuffer buffer = { NULL, 0, 0 };
+	bool bRet = false;
+
+	switch (nFormat)
+	{
+	case kCCImageFormatPNG:
+		bRet = encodePng(pPixels, nWidth, nHeight, &buffer);
+		break;
+	case kCCImageFormatJPG:
+		bRet = encodeJpg(pPixels, nWidth, nHeight, &buffer);
+		break;
+	case kCCImageFormatRawData:
+		bRet = imageBufferAppend(&buffer, pPixels, (unsigned long)nWidth * nHeight * 4);
+		break;
+	default:
+		break;
+	}
+
+	if (! bRet)
+	{
+		delete [] buffer.data;
+		return false;
+	}
+
+	*ppOut = buffer.data;
+	*pOutLen = buffer.size;
+	return true;
+}
+
+bool ccImageWriteFile(const char *pszPath, const unsigned char *pData, unsigned long nLen)
+{
+	FILE *fp = fopen(pszPath, "wb");
+	if (! fp)
+	{
+		return false;
+	}
+
+	bool bRet = (fwrite(pData, 1, nLen, fp) == nLen);
+	fclose(fp);
+	return bRet;
+}
+
+}//namespace   cocos2d 
@@ -0,0 +1,48 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __SUPPORT_IMAGE_SUPPORT_IMAGEENCODER_H__
+#define __SUPPORT_IMAGE_SUPPORT_IMAGEENCODER_H__
+
+namespace   cocos2d {
+
+/// flips the rows of a tightly packed image in place (GL read backs are bottom-up)
+void ccImageFlipRows(unsigned char *pPixels, int nWidth, int nHeight, int nBytesPerPixel);
+
+/** encodes tightly packed, top-down RGBA8888 pixels
+ @param nFormat one of the eImageFormat values (PNG, JPG or raw data)
+ @param ppOut receives a buffer allocated with new[], the caller deletes it
+ @param pOutLen receives the length of the encoded data
+ @return true on success
+ @warning Does not touch any cocos2d object, so it is safe to call from a worker thread.
+ */
+bool ccImageEncodeRGBA(const unsigned char *pPixels, int nWidth, int nHeight, int nFormat,
+                       unsigned char **ppOut, unsigned long *pOutLen);
+
+/// writes a buffer to the given absolute path
+bool ccImageWriteFile(const char *pszPath, const unsigned char *pData, unsigned long nLen);
+
+}//namespace   cocos2d 
+
+#endif // __SUPPORT_IMAGE_SUPPORT_IMAGEENCODER_H__
@@ -26,7 +26,8 @@ THE SOFTWARE.
 #include <stdlib.h>
 
 #include "TGAlib.h"
-#include "support/file_support/FileData.h"
+#include "CCXFileUtils.h"
+#include "NSData.h"
 #include "CCXCocos2dDefine.h"
 
 namespace   cocos2d {
@@ -195,9 +196,10 @@ tImageTGA * tgaLoad(const char *pszFilename)
 {
     int mode,total;
     tImageTGA *info = NULL;
-    FileData data;
-    unsigned long nSize = 0;
-    unsigned char* pBuffer = data.getFileData(pszFilename, "rb", &nSize);
+    // the pixels are copied out of the file data
+    NSData *pData = CCFileUtils::getFileDataView(pszFilename);
+    unsigned char* pBuffer = pData ? (unsigned char*)pData->bytes() : NULL;
+    unsigned long nSize = pData ? pData->getSize() : 0;
 
     do
     {
@@ -268,6 +270,11 @@ tImageTGA * tgaLoad(const char *pszFilename)
         }
     } while(0);
 
+    if (pData)
+    {
+        pData->release();
+    }
+
     return info;
 }
 
@@ -24,9 +24,12 @@ THE SOFTWARE.
 #include <zlib.h>
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "ZipUtils.h"
 #include "ccMacros.h"
+#include "CCXFileUtils.h"
+#include "NSData.h"
 
 namespace cocos2d
 {
@@ -76,24 +79,31 @@ namespace cocos2d
 				return err;
 			}
 
-			// not enough memory ?
-			if (err != Z_STREAM_END) 
+			// the input ended before the stream did
+			if (d_stream.avail_out > 0)
 			{
-				delete [] *out;
-				*out = new unsigned char[bufferSize * BUFFER_INC_FACTOR];
-
-				/* not enough memory, ouch */
-				if (! *out ) 
-				{
-					CCLOG("cocos2d: ZipUtils: realloc failed");
-					inflateEnd(&d_stream);
-					return Z_MEM_ERROR;
-				}
-
-				d_stream.next_out = *out + bufferSize;
-				d_stream.avail_out = bufferSize;
-				bufferSize *= BUFFER_INC_FACTOR;
+				inflateEnd(&d_stream);
+				return Z_DATA_ERROR;
+			}
+
+			// not enough memory: grow the buffer, keeping what was inflated so far
+			unsigned char *tmp = new unsigned char[bufferSize * BUFFER_INC_FACTOR];
+
+			/* not enough memory, ouch */
+			if (! tmp ) 
+			{
+				CCLOG("cocos2d: ZipUtils: realloc failed");
+				inflateEnd(&d_stream);
+				return Z_MEM_ERROR;
 			}
+
+			memcpy(tmp, *out, bufferSize);
+			delete [] *out;
+			*out = tmp;
+
+			d_stream.next_out = *out + bufferSize;
+			d_stream.avail_out = bufferSize * (BUFFER_INC_FACTOR - 1);
+			bufferSize *= BUFFER_INC_FACTOR;
 		}
 
 
@@ -203,77 +213,126 @@ namespace cocos2d
 		return offset;
 	}
 
+	// the CCZ header is big endian, whatever the host is
+	static unsigned int readBigEndian(const unsigned char *p, unsigned int bytes)
+	{
+		unsigned int ret = 0;
+		for (unsigned int i = 0; i < bytes; ++i)
+		{
+			ret = (ret << 8) | p[i];
+		}
+		return ret;
+	}
+
+	#define CCZ_HEADER_SIZE	16
+
+	bool ZipUtils::ccIsCCZData(const unsigned char *in, unsigned int inLength)
+	{
+		return in && inLength >= CCZ_HEADER_SIZE
+			&& in[0] == 'C' && in[1] == 'C' && in[2] == 'Z' && in[3] == '!';
+	}
+
+	int ZipUtils::ccInflateCCZData(const unsigned char *in, unsigned int inLength, unsigned char **out)
+	{
+		assert( out );
+
+		*out = NULL;
+
+		// verify header
+		if (! ccIsCCZData(in, inLength))
+		{
+			CCLOG("cocos2d: Invalid CCZ file");
+			return -1;
+		}
+
+		// verify header version
+		unsigned int compression = readBigEndian(in + 4, 2);
+		unsigned int version = readBigEndian(in + 6, 2);
+		unsigned int len = readBigEndian(in + 12, 4);
+		if( version > 2 ) 
+		{
+			CCLOG("cocos2d: Unsupported CCZ header format");
+			return -1;
+		}
+
+		// verify compression format
+		if (compression != CCZ_COMPRESSION_ZLIB && compression != CCZ_COMPRESSION_NONE)
+		{
+			CCLOG("cocos2d: CCZ Unsupported compression method");
+			return -1;
+		}
+
+		// the size is known up front, so the payload goes straight to its final buffer
+		*out = (unsigned char*)malloc( len );
+		if(! *out )
+		{
+			CCLOG("cocos2d: CCZ: Failed to allocate memory for texture");
+			return -1;
+		}
+
+		const unsigned char *payload = in + CCZ_HEADER_SIZE;
+		unsigned int payloadLength = inLength - CCZ_HEADER_SIZE;
+
+		if (compression == CCZ_COMPRESSION_NONE)
+		{
+			if (payloadLength < len)
+			{
+				CCLOG("cocos2d: CCZ: Truncated file");
+				free( *out );
+				*out = NULL;
+				return -1;
+			}
+
+			memcpy(*out, payload, len);
+			return len;
+		}
+
+		z_stream d_stream; /* decompression stream */
+		d_stream.zalloc = (alloc_func)0;
+		d_stream.zfree = (free_func)0;
+		d_stream.opaque = (voidpf)0;
+
+		d_stream.next_in  = (Bytef*)payload;
+		d_stream.avail_in = payloadLength;
+		d_stream.next_out = *out;
+		d_stream.avail_out = len;
+
+		int ret = inflateInit(&d_stream);
+		if (ret == Z_OK)
+		{
+			ret = inflate(&d_stream, Z_FINISH);
+			inflateEnd(&d_stream);
+		}
+
+		if( ret != Z_STREAM_END || d_stream.total_out != len )
+		{
+			CCLOG("cocos2d: CCZ: Failed to uncompress data");
+			free( *out );
+			*out = NULL;
+			return -1;
+		}
+
+		return len;
+	}
+
 	int ZipUtils::ccInflateCCZFile(const char *path, unsigned char **out)
 	{
-		///@todo implement CFSwapInt16BigToHost CFSwapInt32BigToHost
-		return -1;
-
-// 		assert( out );
-// 		assert( &*out );
-// 
-// 		// load file into memory
-// 		unsigned char *compressed = NULL;
-// 		int fileLen  = ccLoadFileIntoMemory( path, &compressed );
-// 		if( fileLen < 0 ) 
-// 		{
-// 			CCLOG("cocos2d: Error loading CCZ compressed file");
-// 		}
-// 
-// 		struct CCZHeader *header = (struct CCZHeader*) compressed;
-// 
-// 		// verify header
-// 		if( header->sig[0] != 'C' || header->sig[1] != 'C' || header->sig[2] != 'Z' || header->sig[3] != '!' ) 
-// 		{
-// 			CCLOG("cocos2d: Invalid CCZ file");
-// 			free(compressed);
-// 			return -1;
-// 		}
-// 
-// 		// verify header version
-// 		
-// 		unsigned int version = CFSwapInt16BigToHost( header->version );
-// 		if( version > 2 ) 
-// 		{
-// 			CCLOG("cocos2d: Unsupported CCZ header format");
-// 			free(compressed);
-// 			return -1;
-// 		}
-// 
-// 		// verify compression format
-// 		if( CFSwapInt16BigToHost(header->compression_type) != CCZ_COMPRESSION_ZLIB ) 
-// 		{
-// 			CCLOG("cocos2d: CCZ Unsupported compression method");
-// 			free(compressed);
-// 			return -1;
-// 		}
-// 
-// 		uint32_t len = CFSwapInt32BigToHost( header->len );
-// 
-// 		*out = malloc( len );
-// 		if(! *out )
-// 		{
-// 			CCLOG("cocos2d: CCZ: Failed to allocate memory for texture");
-// 			free(compressed);
-// 			return -1;
-// 		}
-// 
-// 
-// 		uLongf destlen = len;
-// 		uLongf source = (uLongf) compressed + sizeof(*header);
-// 		int ret = uncompress(*out, &destlen, (Bytef*)source, fileLen - sizeof(*header) );
-// 
-// 		free( compressed );
-// 
-// 		if( ret != Z_OK )
-// 		{
-// 			CCLOG("cocos2d: CCZ: Failed to uncompress data");
-// 			free( *out );
-// 			*out = NULL;
-// 			return -1;
-// 		}
-// 
-// 
-// 		return len;
+		assert( out );
+		assert( &*out );
+
+		// load file into memory
+		NSData *pCompressed = CCFileUtils::getFileDataView(path);
+		if( ! pCompressed ) 
+		{
+			CCLOG("cocos2d: Error loading CCZ compressed file");
+			*out = NULL;
+			return -1;
+		}
+
+		int len = ccInflateCCZData((unsigned char*)pCompressed->bytes(), (unsigned int)pCompressed->getSize(), out);
+		pCompressed->release();
+
+		return len;
 	}
 
 } // end of namespace cocos2d
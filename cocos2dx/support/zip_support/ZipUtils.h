@@ -26,13 +26,13 @@ THE SOFTWARE.
 
 namespace cocos2d
 {
-	/* XXX: pragma pack ??? */
 	/** @struct CCZHeader
+	The fields are big endian and the header is 16 bytes long, without any padding.
 	*/
 	struct CCZHeader {
 		unsigned char			sig[4];				// signature. Should be 'CCZ!' 4 bytes
 		unsigned short		    compression_type;	// should 0
-		unsigned char		    version;			// should be 2 (although version type==1 is also supported)
+		unsigned short		    version;			// should be 2 (although version type==1 is also supported)
 		unsigned int 		    reserved;			// Reserverd for users.
 		unsigned int		    len;				// size of the uncompressed file
 	};
@@ -41,7 +41,7 @@ namespace cocos2d
 		CCZ_COMPRESSION_ZLIB,				// zlib format.
 		CCZ_COMPRESSION_BZIP2,				// bzip2 format (not supported yet)
 		CCZ_COMPRESSION_GZIP,				// gzip format (not supported yet)
-		CCZ_COMPRESSION_NONE,				// plain (not supported yet)
+		CCZ_COMPRESSION_NONE,				// plain
 	};
 
     class ZipUtils
@@ -73,6 +73,21 @@ namespace cocos2d
 		*/
 		static int ccInflateCCZFile(const char *filename, unsigned char **out);
 
+		/** inflates CCZ data that is already in memory. The payload is inflated straight into
+		* a buffer of the size stored in the header, which is expected to be freed by the caller
+		* with free().
+		*
+		* @returns the length of the inflated buffer, or -1 on error
+		*
+		* @since v0.99.5
+		*/
+		static int ccInflateCCZData(const unsigned char *in, unsigned int inLength, unsigned char **out);
+
+		/** whether or not the data starts with the CCZ signature
+		* @since v0.99.5
+		*/
+		static bool ccIsCCZData(const unsigned char *in, unsigned int inLength);
+
 	private:
 		static int inflateMemory_(unsigned char *in, unsigned int inLength, unsigned char **out, unsigned int *outLengh);
 	};
@@ -0,0 +1,648 @@
+/****************************************************************************
+Copyright (c) 2010 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <string>
+#include <cctype>
+#include "CCResourcePreloader.h"
+#include "CCTextureCache.h"
+#include "CCTexture2D.h"
+#include "CCSpriteFrameCache.h"
+#include "CCLabelBMFont.h"
+#include "CCTMXXMLParser.h"
+#include "CCScheduler.h"
+#include "CCConfiguration.h"
+#include "ccMacros.h"
+#include "platform/platform.h"
+#include "platform/CCXThread.h"
+#include "CCXFileUtils.h"
+#include "CCXUIImage.h"
+
+namespace cocos2d {
+
+typedef enum
+{
+	// texture waiting for a worker thread to decode it
+	kCCPreloadStateQueued,
+	kCCPreloadStateDecoding,
+	// waiting for the main thread: texture to create or file to parse
+	kCCPreloadStateReady,
+	// parsed, waiting for its textures
+	kCCPreloadStateWaiting,
+	kCCPreloadStateDone,
+} ccPreloadState;
+
+typedef struct _ccPreloadItem
+{
+	ccPreloadType	eType;
+	ccPreloadState	eState;
+	// the path as given, the full path and, for textures, the CCTextureCache key
+	std::string		file;
+	std::string		fullPath;
+	std::string		key;
+	eImageFormat	eFormat;
+	int				nPriority;
+	// decoded by a worker thread
+	UIImage			*pImage;
+	// sprite frames dictionary, retained until its texture is loaded
+	NSObject		*pObject;
+	struct _ccPreloadItem *pParent;
+	unsigned int	uPendingChildren;
+} ccPreloadItem;
+
+static bool hasSuffix(const std::string& str, const char *pszSuffix)
+{
+	size_t len = strlen(pszSuffix);
+	return str.length() > len && str.compare(str.length() - len, len, pszSuffix) == 0;
+}
+
+CCResourcePreloader::CCResourcePreloader(void)
+: m_pDelegate(NULL)
+, m_bRunning(false)
+, m_bScheduled(false)
+, m_bCancelled(false)
+, m_bThreadless(false)
+, m_uWorkers(0)
+, m_uMaxThreads(2)
+, m_uLoaded(0)
+, m_uTotal(0)
+, m_fFrameBudget(0.008f)
+{
+	m_pLock = new NSLock();
+}
+
+CCResourcePreloader::~CCResourcePreloader(void)
+{
+	// the scheduler retains the preloader until the worker threads are gone
+	NSAssert(m_uWorkers == 0, "CCResourcePreloader: deleted while worker threads are running");
+
+	for (unsigned int i = 0; i < m_items.size(); ++i)
+	{
+		ccPreloadItem *pItem = m_items[i];
+		CCX_SAFE_DELETE(pItem->pImage);
+		CCX_SAFE_RELEASE(pItem->pObject);
+		delete pItem;
+	}
+	m_items.clear();
+
+	CCX_SAFE_DELETE(m_pLock);
+}
+
+CCResourcePreloader* CCResourcePreloader::preloader(void)
+{
+	CCResourcePreloader *pRet = new CCResourcePreloader();
+	pRet->autorelease();
+	return pRet;
+}
+
+void CCResourcePreloader::selectorProtocolRetain(void)
+{
+	retain();
+}
+
+void CCResourcePreloader::selectorProtocolRelease(void)
+{
+	release();
+}
+
+void CCResourcePreloader::addResource(ccPreloadType eType, const char *pszFile, int nPriority)
+{
+	NSAssert(pszFile != NULL, "CCResourcePreloader: file MUST not be NULL");
+
+	if (findItem(pszFile))
+	{
+		return;
+	}
+
+	addItem(eType, pszFile, nPriority, NULL);
+	++m_uTotal;
+}
+
+void CCResourcePreloader::addTexture(const char *pszFile, int nPriority)
+{
+	addResource(kCCPreloadTypeTexture, pszFile, nPriority);
+}
+
+void CCResourcePreloader::addSpriteFrames(const char *pszPlist, int nPriority)
+{
+	addResource(kCCPreloadTypeSpriteFrames, pszPlist, nPriority);
+}
+
+void CCResourcePreloader::addBMFont(const char *pszFntFile, int nPriority)
+{
+	addResource(kCCPreloadTypeBMFont, pszFntFile, nPriority);
+}
+
+void CCResourcePreloader::addTMX(const char *pszTmxFile, int nPriority)
+{
+	addResource(kCCPreloadTypeTMX, pszTmxFile, nPriority);
+}
+
+bool CCResourcePreloader::addManifestFile(const char *pszManifest)
+{
+	unsigned long nSize = 0;
+	unsigned char *pBuffer = CCFileUtils::getFileData(CCFileUtils::fullPathFromRelativePath(pszManifest), "rb", &nSize);
+	if (! pBuffer)
+	{
+		CCLOG("cocos2d: CCResourcePreloader: Couldn't read manifest %s", pszManifest);
+		return false;
+	}
+
+	std::string contents((const char*)pBuffer, nSize);
+	delete [] pBuffer;
+
+	size_t lineStart = 0;
+	while (lineStart < contents.length())
+	{
+		size_t lineEnd = contents.find('\n', lineStart);
+		if (lineEnd == std::string::npos)
+		{
+			lineEnd = contents.length();
+		}
+
+		// split the line in whitespace separated tokens
+		std::vector<std::string> tokens;
+		size_t pos = lineStart;
+		while (pos < lineEnd)
+		{
+			while (pos < lineEnd && isspace((unsigned char)contents[pos]))
+			{
+				++pos;
+			}
+			size_t tokenStart = pos;
+			while (pos < lineEnd && ! isspace((unsigned char)contents[pos]))
+			{
+				++pos;
+			}
+			if (pos > tokenStart)
+			{
+				tokens.push_back(contents.substr(tokenStart, pos - tokenStart));
+			}
+		}
+		lineStart = lineEnd + 1;
+
+		if (tokens.empty() || tokens[0][0] == '#')
+		{
+			continue;
+		}
+
+		int nPriority = tokens.size() > 2 ? atoi(tokens[2].c_str()) : 0;
+		if (tokens.size() < 2)
+		{
+			CCLOG("cocos2d: CCResourcePreloader: Missing file name for %s in %s", tokens[0].c_str(), pszManifest);
+		}
+		else if (tokens[0] == "texture")
+		{
+			addTexture(tokens[1].c_str(), nPriority);
+		}
+		else if (tokens[0] == "plist")
+		{
+			addSpriteFrames(tokens[1].c_str(), nPriority);
+		}
+		else if (tokens[0] == "fnt")
+		{
+			addBMFont(tokens[1].c_str(), nPriority);
+		}
+		else if (tokens[0] == "tmx")
+		{
+			addTMX(tokens[1].c_str(), nPriority);
+		}
+		else
+		{
+			CCLOG("cocos2d: CCResourcePreloader: Unknown resource type %s in %s", tokens[0].c_str(), pszManifest);
+		}
+	}
+
+	return true;
+}
+
+void CCResourcePreloader::setPriority(const char *pszFile, int nPriority)
+{
+	ccPreloadItem *pItem = findItem(pszFile);
+	if (! pItem)
+	{
+		return;
+	}
+
+	m_pLock->lock();
+	pItem->nPriority = nPriority;
+	for (unsigned int i = 0; i < m_items.size(); ++i)
+	{
+		if (m_items[i]->pParent == pItem)
+		{
+			m_items[i]->nPriority = nPriority;
+		}
+	}
+	m_pLock->unlock();
+}
+
+void CCResourcePreloader::start(CCResourcePreloaderDelegate *pDelegate)
+{
+	NSAssert(! m_bRunning, "CCResourcePreloader: already running");
+
+	m_pDelegate = pDelegate;
+
+	m_pLock->lock();
+	m_bCancelled = false;
+	m_pLock->unlock();
+	m_bRunning = true;
+
+	if (! m_bScheduled)
+	{
+		CCScheduler::sharedScheduler()->scheduleSelector(schedule_selector(CCResourcePreloader::tick), this, 0, false);
+		m_bScheduled = true;
+	}
+}
+
+void CCResourcePreloader::cancel(void)
+{
+	if (! m_bRunning)
+	{
+		return;
+	}
+
+	m_pLock->lock();
+	m_bCancelled = true;
+	m_pLock->unlock();
+
+	finish(true);
+}
+
+float CCResourcePreloader::getProgress(void)
+{
+	return m_uTotal ? (float)m_uLoaded / m_uTotal : 1.0f;
+}
+
+void CCResourcePreloader::tick(ccTime dt)
+{
+	if (m_bRunning)
+	{
+		startWorkers();
+
+		struct cc_timeval begin, now, elapsed;
+		CCTime::gettimeofdayCocos2d(&begin, NULL);
+
+		ccTime fElapsed = 0;
+		do 
+		{
+			ccPreloadItem *pItem = nextMainThreadItem();
+			if (! pItem)
+			{
+				break;
+			}
+			loadItem(pItem);
+
+			CCTime::gettimeofdayCocos2d(&now, NULL);
+			CCTime::timersubCocos2d(&elapsed, &begin, &now);
+			fElapsed = elapsed.tv_sec + elapsed.tv_usec / 1000000.0f;
+		} while (m_bRunning && fElapsed < m_fFrameBudget);
+
+		if (m_bRunning && m_uLoaded == m_uTotal)
+		{
+			finish(false);
+		}
+	}
+
+	if (! m_bRunning)
+	{
+		// the worker threads use the preloader until they see there is nothing left to decode
+		m_pLock->lock();
+		unsigned int uWorkers = m_uWorkers;
+		m_pLock->unlock();
+
+		if (uWorkers == 0 && m_bScheduled)
+		{
+			m_bScheduled = false;
+			// may release the last reference
+			CCScheduler::sharedScheduler()->unscheduleSelector(schedule_selector(CCResourcePreloader::tick), this);
+		}
+	}
+}
+
+ccPreloadItem* CCResourcePreloader::addItem(ccPreloadType eType, const std::string& file, int nPriority, ccPreloadItem *pParent)
+{
+	ccPreloadItem *pItem = new ccPreloadItem();
+	pItem->eType = eType;
+	pItem->eState = kCCPreloadStateReady;
+	pItem->file = file;
+	pItem->fullPath = CCFileUtils::fullPathFromRelativePath(file.c_str());
+	pItem->eFormat = kCCImageFormatPNG;
+	pItem->nPriority = nPriority;
+	pItem->pImage = NULL;
+	pItem->pObject = NULL;
+	pItem->pParent = pParent;
+	pItem->uPendingChildren = 0;
+
+	if (eType == kCCPreloadTypeTexture)
+	{
+		// same key as CCTextureCache::addImage
+		pItem->key = CCFileUtils::ccRemoveHDSuffixFromFile(pItem->fullPath.c_str());
+
+		std::string lowerCase(file);
+		for (unsigned int i = 0; i < lowerCase.length(); ++i)
+		{
+			lowerCase[i] = tolower(lowerCase[i]);
+		}
+
+		// the other formats are loaded by CCTextureCache::addImage on the main thread
+		bool bDecodable = true;
+		if (hasSuffix(lowerCase, ".jpg") || hasSuffix(lowerCase, ".jpeg"))
+		{
+			pItem->eFormat = kCCImageFormatJPG;
+		}
+		else if (! hasSuffix(lowerCase, ".png"))
+		{
+			bDecodable = false;
+		}
+
+		if (bDecodable && ! CCTextureCache::sharedTextureCache()->textureForKey(pItem->key.c_str()))
+		{
+			pItem->eState = kCCPreloadStateQueued;
+		}
+	}
+
+	if (pParent)
+	{
+		++pParent->uPendingChildren;
+	}
+
+	m_pLock->lock();
+	m_items.push_back(pItem);
+	m_pLock->unlock();
+
+	return pItem;
+}
+
+ccPreloadItem* CCResourcePreloader::findItem(const char *pszFile)
+{
+	for (unsigned int i = 0; i < m_items.size(); ++i)
+	{
+		if (! m_items[i]->pParent && m_items[i]->file == pszFile)
+		{
+			return m_items[i];
+		}
+	}
+	return NULL;
+}
+
+// called with m_pLock held
+ccPreloadItem* CCResourcePreloader::nextDecodeItem(void)
+{
+	ccPreloadItem *pRet = NULL;
+	for (unsigned int i = 0; i < m_items.size(); ++i)
+	{
+		ccPreloadItem *pItem = m_items[i];
+		if (pItem->eState == kCCPreloadStateQueued && (! pRet || pItem->nPriority > pRet->nPriority))
+		{
+			pRet = pItem;
+		}
+	}
+	return pRet;
+}
+
+ccPreloadItem* CCResourcePreloader::nextMainThreadItem(void)
+{
+	m_pLock->lock();
+
+	// without worker threads the queued textures are loaded here too
+	bool bDecodeHere = (m_uWorkers == 0 && (m_bThreadless || m_uMaxThreads == 0));
+
+	ccPreloadItem *pRet = NULL;
+	for (unsigned int i = 0; i < m_items.size(); ++i)
+	{
+		ccPreloadItem *pItem = m_items[i];
+		if ((pItem->eState == kCCPreloadStateReady || (bDecodeHere && pItem->eState == kCCPreloadStateQueued))
+			&& (! pRet || pItem->nPriority > pRet->nPriority))
+		{
+			pRet = pItem;
+		}
+	}
+
+	m_pLock->unlock();
+	return pRet;
+}
+
+void CCResourcePreloader::startWorkers(void)
+{
+	if (m_bThreadless)
+	{
+		return;
+	}
+
+	// the decoders read the max texture size, it has to be queried on this thread
+	CCConfiguration::sharedConfiguration();
+
+	m_pLock->lock();
+
+	unsigned int uQueued = 0;
+	for (unsigned int i = 0; i < m_items.size(); ++i)
+	{
+		if (m_items[i]->eState == kCCPreloadStateQueued)
+		{
+			++uQueued;
+		}
+	}
+
+	while (m_uWorkers < m_uMaxThreads && m_uWorkers < uQueued)
+	{
+		// the new thread waits for the lock before looking at the queue
+		++m_uWorkers;
+		if (! ccxStartThread(workerProc, this))
+		{
+			--m_uWorkers;
+			m_bThreadless = true;
+			break;
+		}
+	}
+
+	m_pLock->unlock();
+}
+
+void CCResourcePreloader::workerProc(void *pData)
+{
+	CCResourcePreloader *pPreloader = (CCResourcePreloader*)pData;
+	NSLock *pLock = pPreloader->m_pLock;
+
+	pLock->lock();
+	while (! pPreloader->m_bCancelled)
+	{
+		ccPreloadItem *pItem = pPreloader->nextDecodeItem();
+		if (! pItem)
+		{
+			break;
+		}
+
+		pItem->eState = kCCPreloadStateDecoding;
+		std::string path = pItem->fullPath;
+		eImageFormat eFormat = pItem->eFormat;
+		pLock->unlock();
+
+		// decoding doesn't touch the caches or OpenGL
+		UIImage *pImage = new UIImage();
+		if (! pImage->initWithContentsOfFile(path, eFormat))
+		{
+			// CCTextureCache::addImage will retry and log it
+			CCX_SAFE_DELETE(pImage);
+		}
+
+		pLock->lock();
+		pItem->pImage = pImage;
+		pItem->eState = kCCPreloadStateReady;
+	}
+	--pPreloader->m_uWorkers;
+	pLock->unlock();
+}
+
+void CCResourcePreloader::loadItem(ccPreloadItem *pItem)
+{
+	switch (pItem->eType)
+	{
+	case kCCPreloadTypeTexture:
+		{
+			CCTextureCache *pCache = CCTextureCache::sharedTextureCache();
+			if (! pCache->textureForKey(pItem->key.c_str()))
+			{
+				if (pItem->pImage)
+				{
+					pCache->addUIImage(pItem->pImage, pItem->key.c_str());
+				}
+				else
+				{
+					pCache->addImage(pItem->fullPath.c_str());
+				}
+			}
+			CCX_SAFE_DELETE(pItem->pImage);
+		}
+		break;
+
+	case kCCPreloadTypeSpriteFrames:
+		{
+			NSDictionary<std::string, NSObject*> *pDict = CCFileUtils::dictionaryWithContentsOfFile(pItem->fullPath.c_str());
+			if (pDict)
+			{
+				pDict->retain();
+				pItem->pObject = pDict;
+
+				std::string texturePath = CCSpriteFrameCache::sharedSpriteFrameCache()->texturePathForDictionary(pDict, pItem->fullPath.c_str());
+				addItem(kCCPreloadTypeTexture, texturePath, pItem->nPriority, pItem);
+			}
+		}
+		break;
+
+	case kCCPreloadTypeBMFont:
+		{
+			// same key as CCLabelBMFont
+			CCBMFontConfiguration *pConfiguration = FNTConfigLoadFile(pItem->file.c_str());
+			if (pConfiguration && ! pConfiguration->m_sAtlasName.empty())
+			{
+				addItem(kCCPreloadTypeTexture, pConfiguration->m_sAtlasName, pItem->nPriority, pItem);
+			}
+		}
+		break;
+
+	case kCCPreloadTypeTMX:
+		{
+			// the map is parsed again by CCTMXTiledMap, only its tileset textures are kept
+			CCTMXMapInfo *pMapInfo = CCTMXMapInfo::formatWithTMXFile(pItem->file.c_str());
+			if (pMapInfo && pMapInfo->getTilesets())
+			{
+				NSMutableArray<CCTMXTilesetInfo*> *pTilesets = pMapInfo->getTilesets();
+				NSMutableArray<CCTMXTilesetInfo*>::NSMutableArrayIterator it;
+				for (it = pTilesets->begin(); it != pTilesets->end(); ++it)
+				{
+					if (*it && ! (*it)->m_sSourceImage.empty())
+					{
+						addItem(kCCPreloadTypeTexture, (*it)->m_sSourceImage, pItem->nPriority, pItem);
+					}
+				}
+			}
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	if (pItem->uPendingChildren > 0)
+	{
+		m_pLock->lock();
+		pItem->eState = kCCPreloadStateWaiting;
+		m_pLock->unlock();
+	}
+	else
+	{
+		completeItem(pItem);
+	}
+}
+
+void CCResourcePreloader::completeItem(ccPreloadItem *pItem)
+{
+	m_pLock->lock();
+	pItem->eState = kCCPreloadStateDone;
+	m_pLock->unlock();
+
+	ccPreloadItem *pParent = pItem->pParent;
+	if (pParent)
+	{
+		if (--pParent->uPendingChildren == 0)
+		{
+			if (pParent->eType == kCCPreloadTypeSpriteFrames && pParent->pObject)
+			{
+				CCTexture2D *pTexture = CCTextureCache::sharedTextureCache()->textureForKey(pItem->key.c_str());
+				if (pTexture)
+				{
+					CCSpriteFrameCache::sharedSpriteFrameCache()->addSpriteFramesWithDictionary(
+						(NSDictionary<std::string, NSObject*>*)pParent->pObject, pTexture);
+				}
+				else
+				{
+					CCLOG("cocos2d: CCResourcePreloader: Couldn't load texture %s", pItem->file.c_str());
+				}
+			}
+			CCX_SAFE_RELEASE_NULL(pParent->pObject);
+
+			completeItem(pParent);
+		}
+		return;
+	}
+
+	++m_uLoaded;
+	if (m_pDelegate)
+	{
+		m_pDelegate->preloaderDidLoadResource(this, pItem->file.c_str(), m_uLoaded, m_uTotal);
+	}
+}
+
+void CCResourcePreloader::finish(bool bCancelled)
+{
+	m_bRunning = false;
+
+	if (m_pDelegate)
+	{
+		CCResourcePreloaderDelegate *pDelegate = m_pDelegate;
+		m_pDelegate = NULL;
+		pDelegate->preloaderDidFinish(this, bCancelled);
+	}
+}
+
+}//namespace   cocos2d 
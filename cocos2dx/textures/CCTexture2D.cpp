@@ -40,6 +40,7 @@ THE SOFTWARE.
 #include "CCGL.h"
 #include "support/ccUtils.h"
 #include "platform/CCPlatformMacros.h"
+#include "support/image_support/ETC1Decoder.h"
 
 #ifdef _POWERVR_SUPPORT_
     #include "CCPVRTexture.h"
@@ -63,6 +64,8 @@ namespace   cocos2d {
     protected:
         CCTexture2D *texture;
         unsigned char *data;
+        unsigned char *ktxData;
+        unsigned int ktxDataLength;
         CCTexture2DPixelFormat pixelFormat;
         unsigned int pixelsWide;
         unsigned int pixelsHigh;
@@ -73,7 +76,7 @@ namespace   cocos2d {
         static std::list<VolatileTexture*> textures;
         static bool isReloading;
 
-        VolatileTexture(CCTexture2D *t) : texture(t), data(0)
+        VolatileTexture(CCTexture2D *t) : texture(t), data(0), ktxData(0), ktxDataLength(0)
         {
             textures.push_back(this);
         }
@@ -82,6 +85,8 @@ namespace   cocos2d {
         {
             if (data)
                 delete [] data;
+            if (ktxData)
+                delete [] ktxData;
             textures.remove(this);
         }
 
@@ -120,20 +125,85 @@ namespace   cocos2d {
                 delete [] vt->data;
                 vt->data = 0;   
             }
+            if (vt->ktxData) {
+                delete [] vt->ktxData;
+                vt->ktxData = 0;
+            }
 
-            switch(f) {          
-    case kCCTexture2DPixelFormat_RGBA8888:
-    case kCCTexture2DPixelFormat_RGBA4444:
-    case kCCTexture2DPixelFormat_RGB5A1:
-    case kCCTexture2DPixelFormat_RGB565:
-    case kCCTexture2DPixelFormat_A8:
-        vt->data = new UINT8[w * h * 4];
-        memcpy(vt->data, d, w * h * 4);
-        break;    
-    case kCCTexture2DPixelFormat_RGB888:
-        vt->data = new UINT8[w * h * 3];
-        memcpy(vt->data, d, w * h * 3);
-        break;
+            // only the pixels of the format, a 2 or 1 byte per pixel buffer is smaller than w * h * 4
+            unsigned int length = w * h * bytesPerPixel(f);
+            vt->data = new UINT8[length];
+            memcpy(vt->data, d, length);
+        }
+
+        static VolatileTexture * findTexture(CCTexture2D *tt)
+        {
+            std::list<VolatileTexture *>::iterator i = textures.begin();
+            while( i != textures.end() )
+            {
+                VolatileTexture *v = *i++;
+                if (v->texture == tt) {
+                    return v;
+                }
+            }
+
+            return new VolatileTexture(tt);
+        }
+
+        // compressed textures are reloaded from their container
+        static void addTextureWithKTXData(CCTexture2D *tt, const unsigned char *d, unsigned int length)
+        {
+            if (isReloading)
+                return;
+
+            VolatileTexture *vt = findTexture(tt);
+
+            if (vt->data) {
+                delete [] vt->data;
+                vt->data = 0;
+            }
+            if (vt->ktxData) {
+                delete [] vt->ktxData;
+            }
+
+            vt->ktxData = new UINT8[length];
+            vt->ktxDataLength = length;
+            memcpy(vt->ktxData, d, length);
+        }
+
+        static void updateTextureData(CCTexture2D *tt, 
+            const void *d, 
+            unsigned int x, 
+            unsigned int y, 
+            unsigned int w, 
+            unsigned int h)
+        {
+            std::list<VolatileTexture *>::iterator i = textures.begin();
+            while( i != textures.end() )
+            {
+                VolatileTexture *vt = *i++;
+                if (vt->texture == tt && vt->data) {
+                    unsigned int bpp = bytesPerPixel(vt->pixelFormat);
+                    for (unsigned int row = 0; row < h; ++row)
+                    {
+                        memcpy(vt->data + ((y + row) * vt->pixelsWide + x) * bpp, (const UINT8 *)d + row * w * bpp, w * bpp);
+                    }
+                    break;
+                }
+            }
+        }
+
+        static unsigned int bytesPerPixel(CCTexture2DPixelFormat f)
+        {
+            switch(f) {
+    case kCCTexture2DPixelFormat_RGBA8888:
+        return 4;
+    case kCCTexture2DPixelFormat_RGB888:
+        return 3;
+    case kCCTexture2DPixelFormat_A8:
+        return 1;
+    default:
+        return 2;
             }
         }
 
@@ -163,6 +233,9 @@ namespace   cocos2d {
                 if (vt->data) {
                     unsigned int n = vt->texture->getName();
                     vt->texture->initWithData((const void *)vt->data, vt->pixelFormat, vt->pixelsWide, vt->pixelsHigh, vt->contentSize);
+                }
+                else if (vt->ktxData) {
+                    vt->texture->initWithKTXData(vt->ktxData, vt->ktxDataLength);
                 }
             }
 
@@ -319,6 +392,45 @@ bool CCTexture2D::initWithData(const void *data, CCTexture2DPixelFormat pixelFor
 }
 
 
+void CCTexture2D::updateWithData(const void *data, unsigned int x, unsigned int y, unsigned int pixelsWide, unsigned int pixelsHigh)
+{
+#if CC_ENABLE_CACHE_TEXTTURE_DATA
+	// keep the cached copy in sync, so that the region survives a reload
+	VolatileTexture::updateTextureData(this, data, x, y, pixelsWide, pixelsHigh);
+#endif
+
+	glBindTexture(GL_TEXTURE_2D, m_uName);
+
+	// the rows are tightly packed, which breaks the default alignment of 4 for A8 and RGB888
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	switch(m_ePixelFormat)
+	{
+	case kCCTexture2DPixelFormat_RGBA8888:
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, pixelsWide, pixelsHigh, GL_RGBA, GL_UNSIGNED_BYTE, data);
+		break;
+	case kCCTexture2DPixelFormat_RGB888:
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, pixelsWide, pixelsHigh, GL_RGB, GL_UNSIGNED_BYTE, data);
+		break;
+	case kCCTexture2DPixelFormat_RGBA4444:
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, pixelsWide, pixelsHigh, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, data);
+		break;
+	case kCCTexture2DPixelFormat_RGB5A1:
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, pixelsWide, pixelsHigh, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1, data);
+		break;
+	case kCCTexture2DPixelFormat_RGB565:
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, pixelsWide, pixelsHigh, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, data);
+		break;
+	case kCCTexture2DPixelFormat_A8:
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, pixelsWide, pixelsHigh, GL_ALPHA, GL_UNSIGNED_BYTE, data);
+		break;
+	default:;
+		NSAssert(0, "NSInternalInconsistencyException");
+	}
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
 char * CCTexture2D::description(void)
 {
 	char *ret = new char[100];
@@ -685,6 +797,250 @@ CCTexture2D * CCTexture2D::initWithPVRTCFile(const char* file)
 }
 #endif
 
+//
+// PVR (v2) container, uncompressed pixel formats
+//
+#define kPVRHeaderSize		52
+#define kPVRFormatMask		0xff
+
+enum
+{
+	kPVRPixelTypeRGBA_4444 = 0x10,
+	kPVRPixelTypeRGBA_5551 = 0x11,
+	kPVRPixelTypeRGBA_8888 = 0x12,
+	kPVRPixelTypeRGB_565 = 0x13,
+	kPVRPixelTypeRGB_888 = 0x15,
+	kPVRPixelTypeA_8 = 0x1b,
+};
+
+static bool g_bPVRHaveAlphaPremultiplied = false;
+
+// the PVR header is little endian, whatever the host is
+static unsigned int readPVRUInt(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+bool CCTexture2D::initWithPVRData(const unsigned char *data, unsigned int dataLength)
+{
+	if (! data || dataLength < kPVRHeaderSize)
+	{
+		CCLOG("cocos2d: WARNING: Invalid PVR data");
+		return false;
+	}
+
+	unsigned int headerLength = readPVRUInt(data);
+	unsigned int height = readPVRUInt(data + 4);
+	unsigned int width = readPVRUInt(data + 8);
+	unsigned int flags = readPVRUInt(data + 16);
+	unsigned int bpp = readPVRUInt(data + 24);
+
+	// 'PVR!'
+	if (data[44] != 'P' || data[45] != 'V' || data[46] != 'R' || data[47] != '!')
+	{
+		CCLOG("cocos2d: WARNING: Invalid PVR data");
+		return false;
+	}
+
+	CCTexture2DPixelFormat pixelFormat;
+	switch (flags & kPVRFormatMask)
+	{
+	case kPVRPixelTypeRGBA_4444:
+		pixelFormat = kCCTexture2DPixelFormat_RGBA4444;
+		break;
+	case kPVRPixelTypeRGBA_5551:
+		pixelFormat = kCCTexture2DPixelFormat_RGB5A1;
+		break;
+	case kPVRPixelTypeRGBA_8888:
+		pixelFormat = kCCTexture2DPixelFormat_RGBA8888;
+		break;
+	case kPVRPixelTypeRGB_565:
+		pixelFormat = kCCTexture2DPixelFormat_RGB565;
+		break;
+	case kPVRPixelTypeRGB_888:
+		pixelFormat = kCCTexture2DPixelFormat_RGB888;
+		break;
+	case kPVRPixelTypeA_8:
+		pixelFormat = kCCTexture2DPixelFormat_A8;
+		break;
+	default:
+		CCLOG("cocos2d: WARNING: Unsupported PVR pixel format: 0x%02x", flags & kPVRFormatMask);
+		return false;
+	}
+
+	if (headerLength < kPVRHeaderSize || headerLength > dataLength
+		|| (unsigned long long)width * height * (bpp / 8) > dataLength - headerLength)
+	{
+		CCLOG("cocos2d: WARNING: Truncated PVR data");
+		return false;
+	}
+
+	// the rows are tightly packed, which breaks the default alignment of 4 for A8 and RGB888
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	bool bRet = initWithData(data + headerLength, pixelFormat, width, height, CGSizeMake((float)width, (float)height));
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	m_bHasPremultipliedAlpha = g_bPVRHaveAlphaPremultiplied;
+
+	return bRet;
+}
+
+void CCTexture2D::PVRImagesHavePremultipliedAlpha(bool haveAlphaPremultiplied)
+{
+	g_bPVRHaveAlphaPremultiplied = haveAlphaPremultiplied;
+}
+
+//
+// KTX container, ETC1 payload
+//
+#ifndef GL_ETC1_RGB8_OES
+#define GL_ETC1_RGB8_OES	0x8D64
+#endif
+
+#define kKTXHeaderSize		64
+
+static const unsigned char s_pKTXIdentifier[12] = {
+	0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'
+};
+
+// the header tells the endianness of the writer
+static unsigned int readKTXUInt(const unsigned char *p, bool bSwap)
+{
+	return bSwap ? (((unsigned int)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3])
+		: (p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24));
+}
+
+// converts RGB888 pixels to RGB565, the buffer can be the same
+static void convertRGB888ToRGB565(const unsigned char *pIn, unsigned short *pOut, unsigned int uPixels)
+{
+	for (unsigned int i = 0; i < uPixels; ++i, pIn += 3)
+	{
+		pOut[i] = (unsigned short)(((pIn[0] >> 3) << 11) | ((pIn[1] >> 2) << 5) | (pIn[2] >> 3));
+	}
+}
+
+bool CCTexture2D::initWithKTXData(const unsigned char *data, unsigned int dataLength)
+{
+	if (! data || dataLength < kKTXHeaderSize || memcmp(data, s_pKTXIdentifier, sizeof(s_pKTXIdentifier)) != 0)
+	{
+		CCLOG("cocos2d: WARNING: Invalid KTX data");
+		return false;
+	}
+
+	bool bSwap = (data[12] != 0x01);
+	unsigned int internalFormat = readKTXUInt(data + 28, bSwap);
+	unsigned int width = readKTXUInt(data + 36, bSwap);
+	unsigned int height = readKTXUInt(data + 40, bSwap);
+	unsigned int depth = readKTXUInt(data + 44, bSwap);
+	unsigned int arrayElements = readKTXUInt(data + 48, bSwap);
+	unsigned int faces = readKTXUInt(data + 52, bSwap);
+	unsigned int levels = MAX(1, readKTXUInt(data + 56, bSwap));
+	unsigned int keyValueLength = readKTXUInt(data + 60, bSwap);
+
+	if (internalFormat != GL_ETC1_RGB8_OES || depth > 1 || arrayElements > 0 || faces != 1 || width == 0 || height == 0)
+	{
+		CCLOG("cocos2d: WARNING: Unsupported KTX texture, only 2D ETC1 is supported");
+		return false;
+	}
+
+	// locate the levels before touching GL, so a truncated file doesn't leave a half made texture
+	const unsigned int kMaxLevels = 16;
+	const unsigned char *pLevels[kMaxLevels];
+	unsigned int uLevelSizes[kMaxLevels];
+	unsigned int uOffset = kKTXHeaderSize + keyValueLength;
+
+	levels = MIN(levels, kMaxLevels);
+	for (unsigned int i = 0; i < levels; ++i)
+	{
+		unsigned int w = MAX(width >> i, 1);
+		unsigned int h = MAX(height >> i, 1);
+
+		if (uOffset > dataLength || dataLength - uOffset < 4)
+		{
+			CCLOG("cocos2d: WARNING: Truncated KTX data");
+			return false;
+		}
+
+		uLevelSizes[i] = readKTXUInt(data + uOffset, bSwap);
+		pLevels[i] = data + uOffset + 4;
+		if (uLevelSizes[i] < ccETC1DataSize(w, h) || uLevelSizes[i] > dataLength - uOffset - 4)
+		{
+			CCLOG("cocos2d: WARNING: Truncated KTX data");
+			return false;
+		}
+
+		// levels are padded to 4 bytes
+		uOffset += 4 + ((uLevelSizes[i] + 3) & ~3);
+	}
+
+	bool bRet = true;
+	if (CCConfiguration::sharedConfiguration()->checkForGLExtension("GL_OES_compressed_ETC1_RGB8_texture"))
+	{
+		glGenTextures(1, &m_uName);
+		glBindTexture(GL_TEXTURE_2D, m_uName);
+
+		for (unsigned int i = 0; i < levels; ++i)
+		{
+			glCompressedTexImage2D(GL_TEXTURE_2D, i, GL_ETC1_RGB8_OES, MAX(width >> i, 1), MAX(height >> i, 1), 0, uLevelSizes[i], pLevels[i]);
+		}
+
+		m_tContentSize = CGSizeMake((float)width, (float)height);
+		m_uPixelsWide = width;
+		m_uPixelsHigh = height;
+		m_ePixelFormat = kCCTexture2DPixelFormat_RGB565;
+		m_fMaxS = 1.0f;
+		m_fMaxT = 1.0f;
+		m_bHasPremultipliedAlpha = false;
+	}
+	else
+	{
+		// no ETC1 on this GPU: decode on the CPU into 16-bit levels
+		unsigned char *pPixels = new unsigned char[width * height * 3];
+		for (unsigned int i = 0; i < levels && bRet; ++i)
+		{
+			unsigned int w = MAX(width >> i, 1);
+			unsigned int h = MAX(height >> i, 1);
+
+			ccETC1DecodeImage(pLevels[i], uLevelSizes[i], w, h, pPixels);
+			convertRGB888ToRGB565(pPixels, (unsigned short*)pPixels, w * h);
+
+			if (i == 0)
+			{
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+				bRet = initWithData(pPixels, kCCTexture2DPixelFormat_RGB565, w, h, CGSizeMake((float)w, (float)h));
+			}
+			else
+			{
+				glTexImage2D(GL_TEXTURE_2D, i, GL_RGB, w, h, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, pPixels);
+			}
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		delete [] pPixels;
+	}
+
+	if (! bRet)
+	{
+		return false;
+	}
+
+	// mipmaps are only used when the chain goes down to 1x1, otherwise the texture is incomplete
+	unsigned int uFullChain = 1;
+	while ((MAX(width, height) >> uFullChain) > 0)
+	{
+		++uFullChain;
+	}
+
+	ccTexParams texParams = { (GLuint)(levels >= uFullChain ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR), GL_LINEAR, GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE };
+	setTexParameters(&texParams);
+
+#if CC_ENABLE_CACHE_TEXTTURE_DATA
+	// after initWithData, which caches the decoded first level only
+	VolatileTexture::addTextureWithKTXData(this, data, dataLength);
+#endif
+
+	return true;
+}
+
 //
 // Use to apply MIN/MAG filter
 //
@@ -42,6 +42,7 @@ namespace   cocos2d {
 CCTextureAtlas::CCTextureAtlas()
 	:m_pTexture(NULL)
 	,m_pIndices(NULL)
+	,m_pCulledIndices(NULL)
 	,m_pQuads(NULL)
 {}
 
@@ -51,6 +52,7 @@ CCTextureAtlas::~CCTextureAtlas()
 
 	CCX_SAFE_FREE(m_pQuads)
 	CCX_SAFE_FREE(m_pIndices)
+	CCX_SAFE_FREE(m_pCulledIndices)
 
 #if CC_USES_VBO
 	glDeleteBuffers(2, m_pBuffersVBO);
@@ -318,6 +320,9 @@ bool CCTextureAtlas::resizeCapacity(unsigned int newCapacity)
 	m_pQuads = (ccV3F_C4B_T2F_Quad *)tmpQuads;
 	m_pIndices = (GLushort *)tmpIndices;
 
+	// allocated again with the new capacity when needed
+	CCX_SAFE_FREE(m_pCulledIndices)
+
 	this->initIndices();
 
 	return true;
@@ -331,6 +336,55 @@ void CCTextureAtlas::drawQuads()
 }
 
 void CCTextureAtlas::drawNumberOfQuads(unsigned int n)
+{
+	drawElements(n, NULL, n * 6);
+}
+
+unsigned int CCTextureAtlas::drawNumberOfQuadsInRect(unsigned int n, const CGRect& rect)
+{
+	if (! m_pCulledIndices)
+	{
+		m_pCulledIndices = (GLushort *)malloc(sizeof(m_pCulledIndices[0]) * m_uCapacity * 6);
+		if (! m_pCulledIndices)
+		{
+			drawNumberOfQuads(n);
+			return n;
+		}
+	}
+
+	float fMinX = CGRect::CGRectGetMinX(rect);
+	float fMaxX = CGRect::CGRectGetMaxX(rect);
+	float fMinY = CGRect::CGRectGetMinY(rect);
+	float fMaxY = CGRect::CGRectGetMaxY(rect);
+
+	// the indices of a quad don't refer to its neighbours (strips are joined with degenerate triangles),
+	// so the indices of the visible quads can be copied one after the other
+	unsigned int uIndexCount = 0;
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		const ccV3F_C4B_T2F_Quad& quad = m_pQuads[i];
+
+		if (max(max(quad.bl.vertices.x, quad.br.vertices.x), max(quad.tl.vertices.x, quad.tr.vertices.x)) < fMinX
+			|| min(min(quad.bl.vertices.x, quad.br.vertices.x), min(quad.tl.vertices.x, quad.tr.vertices.x)) > fMaxX
+			|| max(max(quad.bl.vertices.y, quad.br.vertices.y), max(quad.tl.vertices.y, quad.tr.vertices.y)) < fMinY
+			|| min(min(quad.bl.vertices.y, quad.br.vertices.y), min(quad.tl.vertices.y, quad.tr.vertices.y)) > fMaxY)
+		{
+			continue;
+		}
+
+		memcpy(&m_pCulledIndices[uIndexCount], &m_pIndices[i * 6], sizeof(m_pIndices[0]) * 6);
+		uIndexCount += 6;
+	}
+
+	if (uIndexCount > 0)
+	{
+		drawElements(n, m_pCulledIndices, uIndexCount);
+	}
+
+	return uIndexCount / 6;
+}
+
+void CCTextureAtlas::drawElements(unsigned int n, GLushort *pIndices, unsigned int uIndexCount)
 {	
 	// Default GL states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
 	// Needed states: GL_TEXTURE_2D, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
@@ -340,6 +394,11 @@ void CCTextureAtlas::drawNumberOfQuads(unsigned int n)
 
 #define kQuadSize sizeof(m_pQuads[0].bl)
 
+#if CC_TEXTURE_ATLAS_USE_TRIANGLE_STRIP
+	GLenum mode = GL_TRIANGLE_STRIP;
+#else
+	GLenum mode = GL_TRIANGLES;
+#endif
 
 #if CC_USES_VBO
 
@@ -361,17 +420,22 @@ void CCTextureAtlas::drawNumberOfQuads(unsigned int n)
 	// texture coords
 	glTexCoordPointer(2, GL_FLOAT, kQuadSize, (GLvoid*) offsetof( ccV3F_C4B_T2F, texCoords));
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_pBuffersVBO[1]);
+	if (pIndices)
+	{
+		// the compacted indices change every frame, they are read from client memory
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		glDrawElements(mode, uIndexCount, GL_UNSIGNED_SHORT, pIndices);
+	}
+	else
+	{
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_pBuffersVBO[1]);
 
 #if CC_ENABLE_CACHE_TEXTTURE_DATA
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(m_pIndices[0]) * m_uCapacity * 6, m_pIndices, GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(m_pIndices[0]) * m_uCapacity * 6, m_pIndices, GL_STATIC_DRAW);
 #endif
 
-#if CC_TEXTURE_ATLAS_USE_TRIANGLE_STRIP
-	glDrawElements(GL_TRIANGLE_STRIP, n*6, GL_UNSIGNED_SHORT, (GLvoid*)0);    
-#else
-	glDrawElements(GL_TRIANGLES, n*6, GL_UNSIGNED_SHORT, (GLvoid*)0); 
-#endif // CC_USES_VBO
+		glDrawElements(mode, uIndexCount, GL_UNSIGNED_SHORT, (GLvoid*)0);
+	}
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -392,11 +456,7 @@ void CCTextureAtlas::drawNumberOfQuads(unsigned int n)
 	diff = offsetof( ccV3F_C4B_T2F, texCoords);
 	glTexCoordPointer(2, GL_FLOAT, kQuadSize, (GLvoid*)(offset + diff));
 
-#if CC_TEXTURE_ATLAS_USE_TRIANGLE_STRIP
-	glDrawElements(GL_TRIANGLE_STRIP, n*6, GL_UNSIGNED_SHORT, m_pIndices);	
-#else
-	glDrawElements(GL_TRIANGLES, n*6, GL_UNSIGNED_SHORT, m_pIndices);	
-#endif
+	glDrawElements(mode, uIndexCount, GL_UNSIGNED_SHORT, pIndices ? pIndices : m_pIndices);
 
 #endif // CC_USES_VBO
 }
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "platform/platform.h"
 #include "CCXFileUtils.h"
 #include "CCXUIImage.h"
+#include "support/zip_support/ZipUtils.h"
 
 namespace   cocos2d {
 
@@ -196,7 +197,57 @@ CCTexture2D * CCTextureCache::addImage(const char * path)
 		// if ( [[path lowercaseString] hasSuffix:@".pvr"] )
 		do 
 		{
-			if (std::string::npos != lowerCase.find(".pvr"))
+			if (lowerCase.length() > 4 && lowerCase.compare(lowerCase.length() - 4, 4, ".ccz") == 0)
+			{
+				// .pvr.ccz, .png.ccz: the inflated buffer is uploaded as is, without another copy
+				unsigned char *pData = NULL;
+				int nLength = ZipUtils::ccInflateCCZFile(fullpath.c_str(), &pData);
+				CCX_BREAK_IF(nLength <= 0);
+
+				texture = new CCTexture2D();
+				bool bRet = false;
+				if (std::string::npos != lowerCase.find(".pvr.ccz"))
+				{
+					bRet = texture->initWithPVRData(pData, nLength);
+				}
+				else
+				{
+					UIImage image;
+					bRet = image.initWithData(pData, nLength) && texture->initWithImage(&image);
+				}
+				free(pData);
+
+				if (bRet)
+				{
+					m_pTextures->setObject(texture, fullpath);
+					texture->release();
+				}
+				else
+				{
+					CCLOG("cocos2d: Couldn't add image:%s in CCTextureCache", path);
+					CCX_SAFE_RELEASE_NULL(texture);
+				}
+			}
+			else if (lowerCase.length() > 4 && lowerCase.compare(lowerCase.length() - 4, 4, ".ktx") == 0)
+			{
+				// the compressed levels are uploaded from the mapped file
+				NSData *pData = CCFileUtils::getFileDataView(fullpath.c_str());
+				CCX_BREAK_IF(! pData);
+
+				texture = new CCTexture2D();
+				if (texture->initWithKTXData((unsigned char*)pData->bytes(), pData->getSize()))
+				{
+					m_pTextures->setObject(texture, fullpath);
+					texture->release();
+				}
+				else
+				{
+					CCLOG("cocos2d: Couldn't add image:%s in CCTextureCache", path);
+					CCX_SAFE_RELEASE_NULL(texture);
+				}
+				pData->release();
+			}
+			else if (std::string::npos != lowerCase.find(".pvr"))
 			{
 #ifdef _POWERVR_SUPPORT_
 				texture = this->addPVRTCImage(fullpath.c_str());
@@ -425,12 +476,12 @@ void CCTextureCache::removeTextureForKey(const char *textureKeyName)
 		return;
 	}
 
-	m_pTextures->removeObjectForKey(string(textureKeyName));
+	m_pTextures->removeObjectForKey(textureKeyName);
 }
 
 CCTexture2D* CCTextureCache::textureForKey(const char* key)
 {
-	return m_pTextures->objectForKey(string(key));
+	return m_pTextures->objectForKey(key);
 }
 
 }//namespace   cocos2d 
@@ -192,6 +192,8 @@ namespace cocos2d{
 	CCTMXLayer * CCTMXTiledMap::layerNamed(const char *layerName)
 	{
 		std::string sLayerName = layerName;
+		// the first layer with the name in z order
+		sortAllChildren();
 		if (m_pChildren && m_pChildren->count()>0)
 		{
 			CCTMXLayer *layer;
@@ -237,7 +239,7 @@ namespace cocos2d{
 	}
 	NSString * CCTMXTiledMap::propertyNamed(const char *propertyName)
 	{
-		return m_pProperties->objectForKey(std::string(propertyName));
+		return m_pProperties->objectForKey(propertyName);
 	}
 	NSDictionary<std::string, NSString*> * CCTMXTiledMap::propertiesForGID(int GID)
 	{
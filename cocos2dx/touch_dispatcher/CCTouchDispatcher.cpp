@@ -28,11 +28,17 @@ THE SOFTWARE.
 #include "NSSet.h"
 #include "CCTouch.h"
 #include "CCTexture2D.h"
+#include "CCDirector.h"
+#include "CCNode.h"
 #include "support/data_support/ccCArray.h"
 
 #include <assert.h>
+#include <math.h>
 namespace   cocos2d {
 
+// side of a cell of the hit test grid, in points
+#define kCCHitTestCellSize	64.0f
+
 bool CCTouchDispatcher::isDispatchEvents(void)
 {
 	return m_bDispatchEvents;
@@ -87,6 +93,12 @@ bool CCTouchDispatcher::init(void)
 	m_sHandlerHelperData[ccTouchEnded].m_type = ccTouchEnded;
 	m_sHandlerHelperData[ccTouchCancelled].m_type = ccTouchCancelled;
 
+	m_bHitTestIndexEnabled = true;
+	m_bHitTestIndexDirty = true;
+	m_uHitTestGeneration = 0;
+	m_nHitTestCols = 0;
+	m_nHitTestRows = 0;
+
 	return true;
 }
 
@@ -130,6 +142,7 @@ void CCTouchDispatcher::forceAddHandler(CCTouchHandler *pHandler, NSMutableArray
  	}
 
 	pArray->insertObjectAtIndex(pHandler, u);
+	m_bHitTestIndexDirty = true;
 }
 
 void CCTouchDispatcher::addStandardDelegate(CCTouchDelegate *pDelegate, int nPriority)
@@ -186,6 +199,7 @@ void CCTouchDispatcher::forceRemoveDelegate(CCTouchDelegate *pDelegate)
 		if (pHandler && pHandler->getDelegate() == pDelegate)
 		{
 			m_pTargetedHandlers->removeObject(pHandler);
+			m_bHitTestIndexDirty = true;
 			break;
 		}
 	}
@@ -213,6 +227,7 @@ void CCTouchDispatcher::forceRemoveAllDelegates(void)
 {
  	m_pStandardHandlers->removeAllObjects();
  	m_pTargetedHandlers->removeAllObjects();
+	m_bHitTestIndexDirty = true;
 }
 
 void CCTouchDispatcher::removeAllDelegates(void)
@@ -232,6 +247,125 @@ void CCTouchDispatcher::setPriority(int nPriority, CCTouchDelegate *pDelegate)
 	assert(0);
 }
 
+bool CCTouchDispatcher::isHitTestIndexEnabled(void)
+{
+	return m_bHitTestIndexEnabled;
+}
+
+void CCTouchDispatcher::setIsHitTestIndexEnabled(bool bEnabled)
+{
+	m_bHitTestIndexEnabled = bEnabled;
+	m_bHitTestIndexDirty = true;
+}
+
+//
+// hit test index
+//
+void CCTouchDispatcher::rebuildHitTestIndex(void)
+{
+	m_bHitTestIndexDirty = false;
+	m_uHitTestGeneration = CCNode::getTransformGeneration();
+
+	CGSize winSize = CCDirector::sharedDirector()->getWinSize();
+	m_nHitTestCols = MAX(1, (int)ceilf(winSize.width / kCCHitTestCellSize));
+	m_nHitTestRows = MAX(1, (int)ceilf(winSize.height / kCCHitTestCellSize));
+
+	unsigned int uCount = m_pTargetedHandlers->count();
+	unsigned int uCells = (unsigned int)(m_nHitTestCols * m_nHitTestRows);
+
+	m_tHitRects.resize(uCount);
+	m_tUnindexed.clear();
+	m_tCellEntries.clear();
+	m_tCellStarts.assign(uCells + 1, 0);
+
+	// the cell range of every rect, or an empty range for the rects that miss the window
+	std::vector<int> ranges(uCount * 4, 0);
+	unsigned int i;
+	for (i = 0; i < uCount; ++i)
+	{
+		CCTouchHandler *pHandler = m_pTargetedHandlers->getObjectAtIndex(i);
+		CGRect &rect = m_tHitRects[i];
+
+		if (! pHandler->getDelegate()->getTouchHitRect(&rect))
+		{
+			m_tUnindexed.push_back(i);
+			continue;
+		}
+
+		int *r = &ranges[i * 4];
+		r[0] = MAX(0, (int)floorf(CGRect::CGRectGetMinX(rect) / kCCHitTestCellSize));
+		r[1] = MAX(0, (int)floorf(CGRect::CGRectGetMinY(rect) / kCCHitTestCellSize));
+		r[2] = MIN(m_nHitTestCols - 1, (int)floorf(CGRect::CGRectGetMaxX(rect) / kCCHitTestCellSize));
+		r[3] = MIN(m_nHitTestRows - 1, (int)floorf(CGRect::CGRectGetMaxY(rect) / kCCHitTestCellSize));
+		if (rect.size.width <= 0 || rect.size.height <= 0)
+		{
+			// never hit
+			r[2] = r[0] - 1;
+		}
+
+		for (int y = r[1]; y <= r[3]; ++y)
+		{
+			for (int x = r[0]; x <= r[2]; ++x)
+			{
+				++m_tCellStarts[y * m_nHitTestCols + x + 1];
+			}
+		}
+	}
+
+	for (i = 0; i < uCells; ++i)
+	{
+		m_tCellStarts[i + 1] += m_tCellStarts[i];
+	}
+
+	// handlers are visited in order, so every cell stays sorted by priority
+	m_tCellEntries.resize(m_tCellStarts[uCells]);
+	std::vector<unsigned int> fill(m_tCellStarts.begin(), m_tCellStarts.end() - 1);
+	for (i = 0; i < uCount; ++i)
+	{
+		int *r = &ranges[i * 4];
+		for (int y = r[1]; y <= r[3]; ++y)
+		{
+			for (int x = r[0]; x <= r[2]; ++x)
+			{
+				m_tCellEntries[fill[y * m_nHitTestCols + x]++] = i;
+			}
+		}
+	}
+}
+
+void CCTouchDispatcher::findHitTestCandidates(const CGPoint& point)
+{
+	m_tCandidates.clear();
+
+	int x = (int)floorf(point.x / kCCHitTestCellSize);
+	int y = (int)floorf(point.y / kCCHitTestCellSize);
+	x = MAX(0, MIN(m_nHitTestCols - 1, x));
+	y = MAX(0, MIN(m_nHitTestRows - 1, y));
+
+	unsigned int uCell = y * m_nHitTestCols + x;
+	std::vector<unsigned int>::iterator itCell = m_tCellEntries.begin() + m_tCellStarts[uCell];
+	std::vector<unsigned int>::iterator itCellEnd = m_tCellEntries.begin() + m_tCellStarts[uCell + 1];
+	std::vector<unsigned int>::iterator itAll = m_tUnindexed.begin();
+
+	// merge the hits of the cell with the unindexed handlers, keeping the priority order
+	while (itCell != itCellEnd || itAll != m_tUnindexed.end())
+	{
+		if (itAll == m_tUnindexed.end() || (itCell != itCellEnd && *itCell < *itAll))
+		{
+			if (CGRect::CGRectContainsPoint(m_tHitRects[*itCell], point))
+			{
+				m_tCandidates.push_back(*itCell);
+			}
+			++itCell;
+		}
+		else
+		{
+			m_tCandidates.push_back(*itAll);
+			++itAll;
+		}
+	}
+}
+
 //
 // dispatch events
 //
@@ -250,6 +384,10 @@ void CCTouchDispatcher::touches(NSSet *pTouches, UIEvent *pEvent, unsigned int u
 	pMutableTouches = (bNeedsMutableSet ? pTouches->mutableCopy() : pTouches);
 
 	struct ccTouchHandlerHelperData sHelper = m_sHandlerHelperData[uIndex];
+
+	// only the began touches are hit tested, the others go to the handlers that claimed them
+	bool bUseHitTestIndex = (m_bHitTestIndexEnabled && uIndex == ccTouchBegan);
+
 	//
 	// process the target handlers 1st
 	//
@@ -260,12 +398,25 @@ void CCTouchDispatcher::touches(NSSet *pTouches, UIEvent *pEvent, unsigned int u
 		for (setIter = pTouches->begin(); setIter != pTouches->end(); ++setIter)
 		{
 			pTouch = (CCTouch *)(*setIter);
+
+			unsigned int uHandlersCount = uTargetedHandlersCount;
+			if (bUseHitTestIndex)
+			{
+				// a delegate may have moved nodes while handling the previous touch
+				if (m_bHitTestIndexDirty || m_uHitTestGeneration != CCNode::getTransformGeneration())
+				{
+					rebuildHitTestIndex();
+				}
+
+				CGPoint point = CCDirector::sharedDirector()->convertToGL(pTouch->locationInView(pTouch->view()));
+				findHitTestCandidates(point);
+				uHandlersCount = (unsigned int)m_tCandidates.size();
+			}
+
 			CCTargetedTouchHandler *pHandler;
-			NSMutableArray<CCTouchHandler*>::NSMutableArrayIterator arrayIter;
-			for (arrayIter = m_pTargetedHandlers->begin(); arrayIter != m_pTargetedHandlers->end(); ++arrayIter)
-			/*for (unsigned int i = 0; i < m_pTargetedHandlers->num; ++i)*/
+			for (unsigned int i = 0; i < uHandlersCount; ++i)
 			{
-                pHandler = (CCTargetedTouchHandler *)(*arrayIter);
+                pHandler = (CCTargetedTouchHandler *)m_pTargetedHandlers->getObjectAtIndex(bUseHitTestIndex ? m_tCandidates[i] : i);
 
                 if (! pHandler)
                 {
@@ -60,7 +60,8 @@ LOCAL_SRC_FILES := tests.cpp \
 ../../../tests/controller.cpp \
 ../../../tests/testBasic.cpp \
 ../../../AppDelegate.cpp \
-../../../tests/CocosDenshionTest/CocosDenshionTest.cpp
+../../../tests/CocosDenshionTest/CocosDenshionTest.cpp \
+../../../tests/SupportTest/SupportTest.cpp
 
 LOCAL_C_INCLUDES := $(LOCAL_PATH)/../../../../cocos2dx \
                    $(LOCAL_PATH)/../../../../cocos2dx/include \
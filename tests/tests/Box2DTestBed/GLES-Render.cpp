@@ -1,12 +1,24 @@
 #include "GLES-Render.h"
-#include <GLES/gl.h>
-
+#include "cocos2d.h"
 
 #include <cstdio>
 #include <cstdarg>
 
 #include <cstring>
 
+using namespace cocos2d;
+
+// All the shapes go through the cocos2d primitive batch: when DrawDebugData() is
+// called between ccDrawBeginBatch() and ccDrawEndBatch() the whole world is drawn
+// with one glDrawArrays per kind of primitive.
+
+static const int k_circleSegments = 16;
+
+static void setDebugDrawColor(const b2Color& color, float alpha)
+{
+	ccDrawColor4B((GLubyte)(color.r * 255), (GLubyte)(color.g * 255), (GLubyte)(color.b * 255), (GLubyte)(alpha * 255));
+}
+
 GLESDebugDraw::GLESDebugDraw()
 	: mRatio( 1.0f )
 {
@@ -16,106 +28,76 @@ GLESDebugDraw::GLESDebugDraw( float32 ratio )
 {
 }
 
-
-void GLESDebugDraw::DrawPolygon(const b2Vec2* old_vertices, int vertexCount, const b2Color& color)
+void GLESDebugDraw::toPoints(const b2Vec2* vertices, int vertexCount, CGPoint* points)
 {
-	b2Vec2* vertices = new b2Vec2[vertexCount];
 	for( int i=0;i<vertexCount;i++) 
 	{
-		vertices[i] = old_vertices[i];
-		vertices[i] *= mRatio;
+		points[i] = CGPointMake(vertices[i].x * mRatio, vertices[i].y * mRatio);
 	}
+}
 
-	glColor4f(color.r, color.g, color.b,1);
-	glVertexPointer(2, GL_FLOAT, 0, vertices);
-	glDrawArrays(GL_LINE_LOOP, 0, vertexCount);	
+void GLESDebugDraw::circleToPoints(const b2Vec2& center, float32 radius, CGPoint* points)
+{
+	const float32 k_increment = 2.0f * b2_pi / k_circleSegments;
+	float32 theta = 0.0f;
 
-	delete[] vertices;
+	for (int i = 0; i < k_circleSegments; ++i)
+	{
+		b2Vec2 v = center + radius * b2Vec2(cosf(theta), sinf(theta));
+		points[i] = CGPointMake(v.x * mRatio, v.y * mRatio);
+		theta += k_increment;
+	}
+}
+
+void GLESDebugDraw::DrawPolygon(const b2Vec2* old_vertices, int vertexCount, const b2Color& color)
+{
+	CGPoint vertices[b2_maxPolygonVertices];
+	toPoints(old_vertices, vertexCount, vertices);
+
+	setDebugDrawColor(color, 1);
+	ccDrawPoly(vertices, vertexCount, true);
 }
 
 void GLESDebugDraw::DrawSolidPolygon(const b2Vec2* old_vertices, int vertexCount, const b2Color& color)
 {
-	b2Vec2* vertices = new b2Vec2[vertexCount];
-	for( int i=0;i<vertexCount;i++) {
-		vertices[i] = old_vertices[i];
-		vertices[i] *= mRatio;
-	}
-	
-	glVertexPointer(2, GL_FLOAT, 0, vertices);
-	
-	glColor4f(color.r, color.g, color.b,0.5f);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, vertexCount);
-	
-	glColor4f(color.r, color.g, color.b,1);
-	glDrawArrays(GL_LINE_LOOP, 0, vertexCount);
+	CGPoint vertices[b2_maxPolygonVertices];
+	toPoints(old_vertices, vertexCount, vertices);
 
-	delete[] vertices;
+	setDebugDrawColor(color, 0.5f);
+	ccDrawSolidPoly(vertices, vertexCount);
+
+	setDebugDrawColor(color, 1);
+	ccDrawPoly(vertices, vertexCount, true);
 }
 
 void GLESDebugDraw::DrawCircle(const b2Vec2& center, float32 radius, const b2Color& color)
 {
-		
-	const float32 k_segments = 16.0f;
-	int vertexCount=16;
-	const float32 k_increment = 2.0f * b2_pi / k_segments;
-	float32 theta = 0.0f;
-	
-	GLfloat*	glVertices = new GLfloat[vertexCount*2];
-	for (int i = 0; i < k_segments; ++i)
-	{
-		b2Vec2 v = center + radius * b2Vec2(cosf(theta), sinf(theta));
-		glVertices[i*2]=v.x * mRatio;
-		glVertices[i*2+1]=v.y * mRatio;
-		theta += k_increment;
-	}
-	
-	glColor4f(color.r, color.g, color.b,1);
-	glVertexPointer(2, GL_FLOAT, 0, glVertices);
-	
-	glDrawArrays(GL_TRIANGLE_FAN, 0, vertexCount);
+	CGPoint vertices[k_circleSegments];
+	circleToPoints(center, radius, vertices);
 
-	delete[] glVertices;
+	setDebugDrawColor(color, 1);
+	ccDrawPoly(vertices, k_circleSegments, true);
 }
 
 void GLESDebugDraw::DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color& color)
 {
-		
-	const float32 k_segments = 16.0f;
-	int vertexCount=16;
-	const float32 k_increment = 2.0f * b2_pi / k_segments;
-	float32 theta = 0.0f;
-	
-	GLfloat*	glVertices = new GLfloat[vertexCount*2];
-	for (int i = 0; i < k_segments; ++i)
-	{
-		b2Vec2 v = center + radius * b2Vec2(cosf(theta), sinf(theta));
-		glVertices[i*2]=v.x * mRatio;
-		glVertices[i*2+1]=v.y * mRatio;
-		theta += k_increment;
-	}
-	
-	glColor4f(color.r, color.g, color.b,0.5f);
-	glVertexPointer(2, GL_FLOAT, 0, glVertices);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, vertexCount);
-	glColor4f(color.r, color.g, color.b,1);
-	glDrawArrays(GL_LINE_LOOP, 0, vertexCount);
+	CGPoint vertices[k_circleSegments];
+	circleToPoints(center, radius, vertices);
+
+	setDebugDrawColor(color, 0.5f);
+	ccDrawSolidPoly(vertices, k_circleSegments);
+
+	setDebugDrawColor(color, 1);
+	ccDrawPoly(vertices, k_circleSegments, true);
 	
 	// Draw the axis line
 	DrawSegment(center,center+radius*axis,color);
-
-	delete[] glVertices;
 }
 
 void GLESDebugDraw::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color)
 {
-	glColor4f(color.r, color.g, color.b,1);
-	GLfloat	glVertices[] = 
-	{
-		p1.x * mRatio, p1.y * mRatio,
-		p2.x * mRatio, p2.y * mRatio
-	};
-	glVertexPointer(2, GL_FLOAT, 0, glVertices);
-	glDrawArrays(GL_LINES, 0, 2);
+	setDebugDrawColor(color, 1);
+	ccDrawLine(CGPointMake(p1.x * mRatio, p1.y * mRatio), CGPointMake(p2.x * mRatio, p2.y * mRatio));
 }
 
 void GLESDebugDraw::DrawTransform(const b2Transform& xf)
@@ -132,14 +114,17 @@ void GLESDebugDraw::DrawTransform(const b2Transform& xf)
 
 void GLESDebugDraw::DrawPoint(const b2Vec2& p, float32 size, const b2Color& color)
 {
-	glColor4f(color.r, color.g, color.b,1);
-	glPointSize(size);
-	GLfloat				glVertices[] = {
-		p.x * mRatio, p.y * mRatio
+	// a square instead of a GL point, so that points of any size share the batch
+	float32 half = size * 0.5f;
+	CGPoint vertices[4] = {
+		CGPointMake(p.x * mRatio - half, p.y * mRatio - half),
+		CGPointMake(p.x * mRatio + half, p.y * mRatio - half),
+		CGPointMake(p.x * mRatio + half, p.y * mRatio + half),
+		CGPointMake(p.x * mRatio - half, p.y * mRatio + half)
 	};
-	glVertexPointer(2, GL_FLOAT, 0, glVertices);
-	glDrawArrays(GL_POINTS, 0, 1);
-	glPointSize(1.0f);
+
+	setDebugDrawColor(color, 1);
+	ccDrawSolidPoly(vertices, 4);
 }
 
 void GLESDebugDraw::DrawString(int x, int y, const char *string, ...)
@@ -151,15 +136,13 @@ void GLESDebugDraw::DrawString(int x, int y, const char *string, ...)
 
 void GLESDebugDraw::DrawAABB(b2AABB* aabb, const b2Color& c)
 {
-	glColor4f(c.r, c.g, c.b,1);
-
-	GLfloat				glVertices[] = {
-		aabb->lowerBound.x * mRatio, aabb->lowerBound.y * mRatio,
-		aabb->upperBound.x * mRatio, aabb->lowerBound.y * mRatio,
-		aabb->upperBound.x * mRatio, aabb->upperBound.y * mRatio,
-		aabb->lowerBound.x * mRatio, aabb->upperBound.y * mRatio
+	CGPoint vertices[4] = {
+		CGPointMake(aabb->lowerBound.x * mRatio, aabb->lowerBound.y * mRatio),
+		CGPointMake(aabb->upperBound.x * mRatio, aabb->lowerBound.y * mRatio),
+		CGPointMake(aabb->upperBound.x * mRatio, aabb->upperBound.y * mRatio),
+		CGPointMake(aabb->lowerBound.x * mRatio, aabb->upperBound.y * mRatio)
 	};
-	glVertexPointer(2, GL_FLOAT, 0, glVertices);
-	glDrawArrays(GL_LINE_LOOP, 0, 8);
-	
+
+	setDebugDrawColor(c, 1);
+	ccDrawPoly(vertices, 4, true);
 }
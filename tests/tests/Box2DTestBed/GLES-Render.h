@@ -7,14 +7,20 @@
 //#import <OpenGLES/ES1/glext.h>
 
 #include "Box2D/Box2D.h"
+#include "CGGeometry.h"
 
 struct b2AABB;
 
 // This class implements debug drawing callbacks that are invoked
-// inside b2World::Step.
+// inside b2World::Step. The shapes are drawn with the cocos2d primitives,
+// so they can be batched with ccDrawBeginBatch()/ccDrawEndBatch().
 class GLESDebugDraw : public b2DebugDraw
 {
 	float32 mRatio;
+
+	void toPoints(const b2Vec2* vertices, int vertexCount, cocos2d::CGPoint* points);
+
+	void circleToPoints(const b2Vec2& center, float32 radius, cocos2d::CGPoint* points);
 public:
 	GLESDebugDraw();
 
@@ -58,8 +58,8 @@ public:
 		sweepB.localCenter.SetZero();
 
 		b2TOIInput input;
-		input.proxyA.Set(&m_shapeA);
-		input.proxyB.Set(&m_shapeB);
+		input.proxyA.Set(&m_shapeA, 0);
+		input.proxyB.Set(&m_shapeB, 0);
 		input.sweepA = sweepA;
 		input.sweepB = sweepB;
 		input.tMax = 1.0f;
@@ -1,11 +1,13 @@
 #include "EffectsTest.h"
 #include "../testResource.h"
+#include "platform/platform.h"
 
 enum {
     kTagTextLayer = 1,
 
     kTagBackground = 1,
     kTagLabel = 2,
+    kTagTiming = 3,
 };
 
 static int actionIdx=0; 
@@ -326,6 +328,45 @@ CCActionInterval* getAction()
 	return pEffect;
 } 
 
+// the grid the effects are timed on, and the updates each timing runs
+#define TIMING_GRID_SIZE	64
+#define TIMING_UPDATES		100
+
+// the effect of the demo nIndex on a 64x64 grid,
+// NULL for the flips which only work on a 1x1 grid
+CCGridAction* createTimingEffect(int nIndex)
+{
+	CGSize size = CCDirector::sharedDirector()->getWinSize();
+	CGPoint center = CGPointMake(size.width/2, size.height/2);
+	ccGridSize grid = ccg(TIMING_GRID_SIZE, TIMING_GRID_SIZE);
+
+	switch(nIndex)
+	{
+		case 0: return CCShaky3D::actionWithRange(5, true, grid, 3);
+		case 1: return CCWaves3D::actionWithWaves(5, 40, grid, 3);
+		case 4: return CCLens3D::actionWithPosition(center, 240, grid, 3);
+		case 5: return CCRipple3D::actionWithPosition(center, 240, 4, 160, grid, 3);
+		case 6: return CCLiquid::actionWithWaves(4, 20, grid, 3);
+		case 7: return CCWaves::actionWithWaves(4, 20, true, true, grid, 3);
+		case 8: return CCTwirl::actionWithPosition(center, 1, 2.5f, grid, 3);
+		case 9: return CCShakyTiles3D::actionWithRange(5, true, grid, 3);
+		case 10: return CCShatteredTiles3D::actionWithRange(5, true, grid, 3);
+		case 11: return CCShuffleTiles::actionWithSeed(25, grid, 3);
+		case 12: return CCFadeOutTRTiles::actionWithSize(grid, 3);
+		case 13: return CCFadeOutBLTiles::actionWithSize(grid, 3);
+		case 14: return CCFadeOutUpTiles::actionWithSize(grid, 3);
+		case 15: return CCFadeOutDownTiles::actionWithSize(grid, 3);
+		case 16: return CCTurnOffTiles::actionWithSeed(25, grid, 3);
+		case 17: return CCWavesTiles3D::actionWithWaves(4, 120, grid, 3);
+		case 18: return CCJumpTiles3D::actionWithJumps(2, 30, grid, 3);
+		case 19: return CCSplitRows::actionWithRows(TIMING_GRID_SIZE, 3);
+		case 20: return CCSplitCols::actionWithCols(TIMING_GRID_SIZE, 3);
+		case 21: return CCPageTurn3D::actionWithSize(grid, 3);
+	}
+
+	return NULL;
+}
+
 void EffectTestScene::runThisTest()
 {
     addChild(TextLayer::node());
@@ -379,14 +420,21 @@ TextLayer::TextLayer(void)
 	CCMenuItemImage *item2 = CCMenuItemImage::itemFromNormalImage(s_pPathR1, s_pPathR2, this, menu_selector(TextLayer::restartCallback) );
 	CCMenuItemImage *item3 = CCMenuItemImage::itemFromNormalImage(s_pPathF1, s_pPathF2, this, menu_selector(TextLayer::nextCallback) );
 
-	CCMenu *menu = CCMenu::menuWithItems(item1, item2, item3, NULL);
+	CCMenuItemFont *item4 = CCMenuItemFont::itemFromString("Time 64x64", this, menu_selector(TextLayer::timeCallback) );
+
+	CCMenu *menu = CCMenu::menuWithItems(item1, item2, item3, item4, NULL);
 
 	menu->setPosition( CGPointZero );
 	item1->setPosition( CGPointMake( size.width/2 - 100,30) );
 	item2->setPosition( CGPointMake( size.width/2, 30) );
 	item3->setPosition( CGPointMake( size.width/2 + 100,30) );
+	item4->setPosition( CGPointMake( size.width - 100, 30) );
 	
 	addChild(menu, 1);	
+
+	CCLabelTTF* timing = CCLabelTTF::labelWithString("", "Marker Felt", 24);
+	timing->setPosition( CGPointMake(x/2,y-120) );
+	addChild(timing, 1, kTagTiming);
 
 	schedule( schedule_selector(TextLayer::checkAnim) );
 }
@@ -474,3 +522,37 @@ void TextLayer::backCallback(NSObject* pSender)
 	/*newOrientation();*/
 	newScene();
 } 
+
+void TextLayer::timeCallback(NSObject* pSender)
+{
+	char szResult[64];
+	CCGridAction* pEffect = createTimingEffect(actionIdx);
+
+	if (! pEffect)
+	{
+		sprintf(szResult, "only runs on a 1x1 grid");
+	}
+	else
+	{
+		// a node of its own, the demo keeps running on the background
+		CCNode* pTarget = CCNode::node();
+		pEffect->startWithTarget(pTarget);
+
+		struct cc_timeval start, end, elapsed;
+		CCTime::gettimeofdayCocos2d(&start, NULL);
+		for (int i = 0; i < TIMING_UPDATES; ++i)
+		{
+			pEffect->update((float)i / TIMING_UPDATES);
+		}
+		CCTime::gettimeofdayCocos2d(&end, NULL);
+		CCTime::timersubCocos2d(&elapsed, &start, &end);
+
+		pEffect->stop();
+
+		float fMilliseconds = (elapsed.tv_sec * 1000000.0f + elapsed.tv_usec) / 1000.0f / TIMING_UPDATES;
+		sprintf(szResult, "%.3f ms per update", fMilliseconds);
+	}
+
+	CCLOG("%s 64x64: %s", effectsList[actionIdx].c_str(), szResult);
+	((CCLabelTTF*)getChildByTag(kTagTiming))->setString(szResult);
+}
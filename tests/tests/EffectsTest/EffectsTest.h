@@ -25,6 +25,7 @@ public:
 	void restartCallback(NSObject* pSender);
 	void nextCallback(NSObject* pSender);
 	void backCallback(NSObject* pSender);
+	void timeCallback(NSObject* pSender);
 
 	void newOrientation();
 	void newScene();
@@ -0,0 +1,346 @@
+#include "SupportTest.h"
+#include "../testResource.h"
+#include "support/image_support/ETC1Decoder.h"
+#include "support/data_support/CCPlistParser.h"
+
+static int sceneIdx = -1;
+
+#define MAX_LAYER	2
+
+CCLayer* createSupportTestLayer(int nIndex)
+{
+	switch(nIndex)
+	{
+		case 0: return new ETC1DecodeTest();
+		case 1: return new PlistParserTest();
+	}
+
+	return NULL;
+}
+
+CCLayer* nextSupportTest()
+{
+	sceneIdx++;
+	sceneIdx = sceneIdx % MAX_LAYER;
+
+	CCLayer* pLayer = createSupportTestLayer(sceneIdx);
+	pLayer->autorelease();
+
+	return pLayer;
+}
+
+CCLayer* backSupportTest()
+{
+	sceneIdx--;
+	int total = MAX_LAYER;
+	if( sceneIdx < 0 )
+		sceneIdx += total;
+
+	CCLayer* pLayer = createSupportTestLayer(sceneIdx);
+	pLayer->autorelease();
+
+	return pLayer;
+}
+
+CCLayer* restartSupportTest()
+{
+	CCLayer* pLayer = createSupportTestLayer(sceneIdx);
+	pLayer->autorelease();
+
+	return pLayer;
+}
+
+//------------------------------------------------------------------
+//
+// SupportTest
+//
+//------------------------------------------------------------------
+
+SupportTest::SupportTest(void)
+: m_uChecks(0)
+, m_uFailures(0)
+{
+}
+
+std::string SupportTest::title()
+{
+	return "No title";
+}
+
+void SupportTest::runChecks()
+{
+}
+
+void SupportTest::check(bool bPassed, const char *pszDescription)
+{
+	++m_uChecks;
+	if (! bPassed)
+	{
+		++m_uFailures;
+		CCLOG("%s: FAILED %s", title().c_str(), pszDescription);
+	}
+}
+
+void SupportTest::onEnter()
+{
+	CCLayer::onEnter();
+
+	CGSize s = CCDirector::sharedDirector()->getWinSize();
+
+	CCLabelTTF* label = CCLabelTTF::labelWithString(title().c_str(), "Arial", 32);
+	addChild(label, 1);
+	label->setPosition( CGPointMake(s.width/2, s.height-50) );
+
+	m_uChecks = 0;
+	m_uFailures = 0;
+	runChecks();
+
+	char szResult[64];
+	sprintf(szResult, "%u of %u checks passed", m_uChecks - m_uFailures, m_uChecks);
+	CCLabelTTF* result = CCLabelTTF::labelWithString(szResult, "Thonburi", 24);
+	addChild(result, 1);
+	result->setPosition( CGPointMake(s.width/2, s.height/2) );
+	result->setColor(m_uFailures ? ccRED : ccGREEN);
+
+	CCMenuItemImage *item1 = CCMenuItemImage::itemFromNormalImage(s_pPathB1, s_pPathB2, this, menu_selector(SupportTest::backCallback) );
+	CCMenuItemImage *item2 = CCMenuItemImage::itemFromNormalImage(s_pPathR1, s_pPathR2, this, menu_selector(SupportTest::restartCallback) );
+	CCMenuItemImage *item3 = CCMenuItemImage::itemFromNormalImage(s_pPathF1, s_pPathF2, this, menu_selector(SupportTest::nextCallback));
+
+	CCMenu *menu = CCMenu::menuWithItems(item1, item2, item3, NULL);
+
+	menu->setPosition( CGPointZero );
+	item1->setPosition( CGPointMake( s.width/2 - 100,30) );
+	item2->setPosition( CGPointMake( s.width/2, 30) );
+	item3->setPosition( CGPointMake( s.width/2 + 100,30) );
+
+	addChild(menu, 1);
+}
+
+void SupportTest::restartCallback(NSObject* pSender)
+{
+	CCScene* s = new SupportTestScene();
+	s->addChild(restartSupportTest());
+
+	CCDirector::sharedDirector()->replaceScene(s);
+	s->release();
+}
+
+void SupportTest::nextCallback(NSObject* pSender)
+{
+	CCScene* s = new SupportTestScene();
+	s->addChild( nextSupportTest() );
+	CCDirector::sharedDirector()->replaceScene(s);
+	s->release();
+}
+
+void SupportTest::backCallback(NSObject* pSender)
+{
+	CCScene* s = new SupportTestScene();
+	s->addChild( backSupportTest() );
+	CCDirector::sharedDirector()->replaceScene(s);
+	s->release();
+}
+
+//------------------------------------------------------------------
+//
+// ETC1DecodeTest
+//
+//------------------------------------------------------------------
+
+// blocks with their pixels worked out by hand from the ETC1 specification
+static const unsigned char s_ETC1Blocks[3][8] = {
+	// individual mode, base (136,68,34) in both halves, table 0, every pixel +2
+	{ 0x88, 0x44, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	// individual mode, left half (255,0,0) table 7, right half (0,255,0) table 1,
+	// (0,0) uses +183, (2,0) uses -5 and (3,3) uses -17, the others the small positive modifier
+	{ 0xf0, 0x0f, 0x00, 0xe4, 0x81, 0x00, 0x80, 0x01 },
+	// differential mode, flipped: top half (132,0,255) table 0, bottom half (123,24,255) table 2
+	{ 0x87, 0x03, 0xf8, 0x0b, 0x00, 0x00, 0x00, 0x00 },
+};
+
+static bool isPixel(const unsigned char *pPixels, unsigned int uStride, int x, int y, int r, int g, int b)
+{
+	const unsigned char *p = pPixels + y * uStride + x * 3;
+	return p[0] == r && p[1] == g && p[2] == b;
+}
+
+std::string ETC1DecodeTest::title()
+{
+	return "ETC1 decoder";
+}
+
+void ETC1DecodeTest::runChecks()
+{
+	unsigned char pixels[4 * 4 * 3];
+	bool bAll;
+
+	ccETC1DecodeBlock(s_ETC1Blocks[0], pixels, 12);
+	bAll = true;
+	for (int i = 0; i < 16; ++i)
+	{
+		bAll = bAll && isPixel(pixels, 12, i % 4, i / 4, 138, 70, 36);
+	}
+	check(bAll, "individual block, single color");
+
+	ccETC1DecodeBlock(s_ETC1Blocks[1], pixels, 12);
+	check(isPixel(pixels, 12, 0, 0, 255, 183, 183), "individual block, large modifier");
+	check(isPixel(pixels, 12, 1, 2, 255, 47, 47), "individual block, left half");
+	check(isPixel(pixels, 12, 2, 0, 0, 250, 0), "individual block, negative modifier clamped");
+	check(isPixel(pixels, 12, 3, 3, 0, 238, 0), "individual block, large negative modifier");
+	check(isPixel(pixels, 12, 2, 1, 5, 255, 5), "individual block, right half");
+
+	ccETC1DecodeBlock(s_ETC1Blocks[2], pixels, 12);
+	check(isPixel(pixels, 12, 3, 0, 134, 2, 255) && isPixel(pixels, 12, 0, 1, 134, 2, 255), "differential block, top half");
+	check(isPixel(pixels, 12, 0, 2, 132, 33, 255) && isPixel(pixels, 12, 3, 3, 132, 33, 255), "differential block, bottom half");
+
+	// a 6x5 image is 2x2 blocks, the pixels outside of it must not be written
+	unsigned char image[4 * 8];
+	for (int i = 0; i < 4; ++i)
+	{
+		memcpy(image + i * 8, s_ETC1Blocks[0], 8);
+	}
+
+	check(ccETC1DataSize(6, 5) == 32, "data size of partial blocks");
+	check(! ccETC1DecodeImage(image, 31, 6, 5, pixels), "truncated image rejected");
+
+	unsigned char imagePixels[6 * 5 * 3 + 4];
+	memset(imagePixels, 0xcd, sizeof(imagePixels));
+	check(ccETC1DecodeImage(image, 32, 6, 5, imagePixels), "image decoded");
+
+	bAll = true;
+	for (int i = 0; i < 6 * 5; ++i)
+	{
+		bAll = bAll && isPixel(imagePixels, 6 * 3, i % 6, i / 6, 138, 70, 36);
+	}
+	check(bAll, "image pixels");
+
+	bAll = true;
+	for (int i = 6 * 5 * 3; i < (int)sizeof(imagePixels); ++i)
+	{
+		bAll = bAll && imagePixels[i] == 0xcd;
+	}
+	check(bAll, "nothing written past the image");
+}
+
+//------------------------------------------------------------------
+//
+// PlistParserTest
+//
+//------------------------------------------------------------------
+
+static const char s_szXMLPlist[] =
+	"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	"<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n"
+	"<plist version=\"1.0\">\n"
+	"<dict>\n"
+	"\t<!-- <key>commented</key> -->\n"
+	"\t<key>name</key>\n"
+	"\t<string>a &lt;b&gt; &amp; &#233;</string>\n"
+	"\t<key>count</key>\n"
+	"\t<integer> 42 </integer>\n"
+	"\t<key>scale</key>\n"
+	"\t<real>0.5</real>\n"
+	"\t<key>visible</key>\n"
+	"\t<true/>\n"
+	"\t<key>frames</key>\n"
+	"\t<array>\n"
+	"\t\t<string>one</string>\n"
+	"\t\t<string><![CDATA[<two>]]></string>\n"
+	"\t</array>\n"
+	"\t<key>empty</key>\n"
+	"\t<string/>\n"
+	"</dict>\n"
+	"</plist>\n";
+
+// { name = "é"; size = ( 300, true ); } written by hand: the header, 7 objects,
+// an offset table of one byte entries at 33 and the trailer
+static const unsigned char s_BinaryPlist[] = {
+	'b', 'p', 'l', 'i', 's', 't', '0', '0',
+	0xd2, 0x01, 0x02, 0x03, 0x04,			// 8: dictionary, keys 1 2, values 3 4
+	0x54, 'n', 'a', 'm', 'e',				// 13: ASCII string
+	0x54, 's', 'i', 'z', 'e',				// 18: ASCII string
+	0x61, 0x00, 0xe9,						// 23: UTF-16 string
+	0xa2, 0x05, 0x06,						// 26: array, values 5 6
+	0x11, 0x01, 0x2c,						// 29: two bytes integer
+	0x09,									// 32: true
+	8, 13, 18, 23, 26, 29, 32,				// 33: offset table
+	0, 0, 0, 0, 0, 0, 1, 1,					// 40: trailer, offset and reference sizes
+	0, 0, 0, 0, 0, 0, 0, 7,					// number of objects
+	0, 0, 0, 0, 0, 0, 0, 0,					// top object
+	0, 0, 0, 0, 0, 0, 0, 33,				// offset of the offset table
+};
+
+static const ccPlistValue* childForKey(const ccPlistValue *pDict, const char *pszKey)
+{
+	for (const ccPlistValue *pChild = pDict ? pDict->pFirstChild : NULL; pChild; pChild = pChild->pNext)
+	{
+		if (pChild->uKeyLength == strlen(pszKey) && memcmp(pChild->pszKey, pszKey, pChild->uKeyLength) == 0)
+		{
+			return pChild;
+		}
+	}
+	return NULL;
+}
+
+static bool isText(const ccPlistValue *pValue, ccPlistType eType, const char *pszText)
+{
+	return pValue && pValue->type == eType
+		&& pValue->uLength == strlen(pszText) && memcmp(pValue->pszText, pszText, pValue->uLength) == 0;
+}
+
+std::string PlistParserTest::title()
+{
+	return "Plist parser";
+}
+
+void PlistParserTest::runChecks()
+{
+	CCPlistParser parser;
+
+	const ccPlistValue *pRoot = parser.parse((const unsigned char*)s_szXMLPlist, sizeof(s_szXMLPlist) - 1);
+	check(pRoot && pRoot->type == kCCPlistDict && pRoot->uCount == 6, "XML root dictionary");
+	check(isText(childForKey(pRoot, "name"), kCCPlistString, "a <b> & \xc3\xa9"), "XML entities");
+	check(isText(childForKey(pRoot, "count"), kCCPlistInteger, "42"), "XML integer");
+	check(isText(childForKey(pRoot, "scale"), kCCPlistReal, "0.5"), "XML real");
+	check(childForKey(pRoot, "visible") && childForKey(pRoot, "visible")->type == kCCPlistTrue, "XML boolean");
+	check(isText(childForKey(pRoot, "empty"), kCCPlistString, ""), "XML empty string");
+
+	const ccPlistValue *pFrames = childForKey(pRoot, "frames");
+	check(pFrames && pFrames->type == kCCPlistArray && pFrames->uCount == 2
+		&& isText(pFrames->pFirstChild, kCCPlistString, "one")
+		&& isText(pFrames->pLastChild, kCCPlistString, "<two>"), "XML array and CDATA");
+
+	NSDictionary<std::string, NSObject*> *pDict = (NSDictionary<std::string, NSObject*>*)CCPlistParser::objectWithValue(pRoot);
+	NSString *pVisible = pDict ? (NSString*)pDict->objectForKey("visible") : NULL;
+	NSMutableArray<NSObject*> *pArray = pDict ? (NSMutableArray<NSObject*>*)pDict->objectForKey("frames") : NULL;
+	check(pVisible && pVisible->m_sString == "1" && pArray && pArray->count() == 2, "XML cocoa objects");
+	CCX_SAFE_RELEASE(pDict);
+
+	const char szUnbalanced[] = "<plist><dict><key>a</key><string>b</string></plist>";
+	check(! parser.parse((const unsigned char*)szUnbalanced, sizeof(szUnbalanced) - 1), "unbalanced XML rejected");
+
+	pRoot = parser.parse(s_BinaryPlist, sizeof(s_BinaryPlist));
+	check(pRoot && pRoot->type == kCCPlistDict && pRoot->uCount == 2, "binary root dictionary");
+	check(isText(childForKey(pRoot, "name"), kCCPlistString, "\xc3\xa9"), "binary UTF-16 string");
+
+	const ccPlistValue *pSize = childForKey(pRoot, "size");
+	check(pSize && pSize->type == kCCPlistArray && pSize->uCount == 2
+		&& isText(pSize->pFirstChild, kCCPlistInteger, "300")
+		&& pSize->pLastChild->type == kCCPlistTrue, "binary array");
+
+	check(! parser.parse(s_BinaryPlist, sizeof(s_BinaryPlist) - 1), "truncated binary rejected");
+}
+
+//------------------------------------------------------------------
+//
+// SupportTestScene
+//
+//------------------------------------------------------------------
+
+void SupportTestScene::runThisTest()
+{
+	CCLayer* pLayer = nextSupportTest();
+	addChild(pLayer);
+
+	CCDirector::sharedDirector()->replaceScene(this);
+}
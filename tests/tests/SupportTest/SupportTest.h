@@ -0,0 +1,48 @@
+#ifndef _SUPPORT_TEST_H_
+#define _SUPPORT_TEST_H_
+
+#include "../testBasic.h"
+
+// checks the decoders and parsers of cocos2dx/support against known data,
+// the result is shown on the screen and the failed checks are logged
+class SupportTest : public CCLayer
+{
+protected:
+	unsigned int m_uChecks;
+	unsigned int m_uFailures;
+
+public:
+	SupportTest(void);
+
+	virtual std::string title();
+	virtual void runChecks();
+	virtual void onEnter();
+
+	void check(bool bPassed, const char *pszDescription);
+
+	void restartCallback(NSObject* pSender);
+	void nextCallback(NSObject* pSender);
+	void backCallback(NSObject* pSender);
+};
+
+class ETC1DecodeTest : public SupportTest
+{
+public:
+	virtual std::string title();
+	virtual void runChecks();
+};
+
+class PlistParserTest : public SupportTest
+{
+public:
+	virtual std::string title();
+	virtual void runChecks();
+};
+
+class SupportTestScene : public TestScene
+{
+public:
+	virtual void runThisTest();
+};
+
+#endif
@@ -77,6 +77,8 @@ static TestScene* CreateTestScene(int nIdx)
         pScene = new KeypadTestScene(); break;
 	case TEST_COCOSDENSHION:
 		pScene = new CocosDenshionTestScene(); break;
+    case TEST_SUPPORT:
+        pScene = new SupportTestScene(); break;
     default:
         break;
     }